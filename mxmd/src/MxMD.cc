@@ -22,14 +22,11 @@ void MxMDTickSizeTbl::addTickSize(
 
 void MxMDPxLevel_::reset(MxDateTime transactTime, MxMDOrderFn fn)
 {
-  {
-    auto i = m_orders.iterator();
-    while (MxMDOrder *order = i.iterate()) {
-      deletedOrder_(order, transactTime);
-      fn(order, transactTime);
-      i.del();
-    }
-  }
+  iterateOrders_([this, transactTime, &fn](MxMDOrder *order, bool &del) {
+    deletedOrder_(order, transactTime);
+    fn(order, transactTime);
+    return del = true;
+  });
   m_data.transactTime = transactTime;
   m_data.qty = 0;
   m_data.nOrders = 0;
@@ -39,11 +36,11 @@ void MxMDPxLevel_::updateNDP(
     MxNDP oldPxNDP, MxNDP oldQtyNDP, MxNDP pxNDP, MxNDP qtyNDP,
     const MxMDOrderNDPFn &fn)
 {
-  auto i = m_orders.iterator();
-  while (MxMDOrder *order = i.iterate()) {
+  iterateOrders_([&](MxMDOrder *order, bool &) {
     order->updateNDP(oldPxNDP, oldQtyNDP, pxNDP, qtyNDP);
     fn(order, oldPxNDP, oldQtyNDP, pxNDP, qtyNDP);
-  }
+    return true;
+  });
   if (*qtyNDP && qtyNDP != oldQtyNDP)
     m_data.qty = MxValNDP{m_data.qty, oldQtyNDP}.adjust(qtyNDP);
 }
@@ -103,14 +100,20 @@ void MxMDPxLevel_::update(
 
 void MxMDPxLevel_::addOrder(MxMDOrder *order)
 {
+  MxFlags venueFlags = obSide()->orderBook()->venue()->flags();
+  if (venueFlags & (1U<<MxMDVenueFlags::FIFO)) {
+    // ranks are never re-used within a level, even if the tail is deleted
+    if (!*order->data().rank) order->data_().rank = m_queueRank++;
+    m_queue.push(order);
+    return;
+  }
   if (!*order->data().rank) {
     if (!m_orders.count())
       order->data_().rank = 0;
     else
       order->data_().rank = m_orders.maximum()->data().rank + 1;
   }
-  if (obSide()->orderBook()->venue()->flags() &
-      (1U<<MxMDVenueFlags::UniformRanks)) {
+  if (venueFlags & (1U<<MxMDVenueFlags::UniformRanks)) {
     MxUInt rank = order->data().rank;
     auto i = m_orders.iterator<ZmRBTreeGreaterEqual>(rank);
     MxMDOrder *order_;
@@ -120,8 +123,14 @@ void MxMDPxLevel_::addOrder(MxMDOrder *order)
   m_orders.add(order);
 }
 
-void MxMDPxLevel_::delOrder(MxUInt rank)
+void MxMDPxLevel_::delOrder(MxMDOrder *order)
 {
+  if (obSide()->orderBook()->venue()->flags() &
+      (1U<<MxMDVenueFlags::FIFO)) {
+    m_queue.del(order);
+    return;
+  }
+  MxUInt rank = order->data().rank;
   m_orders.del(rank);
   if (obSide()->orderBook()->venue()->flags() &
       (1U<<MxMDVenueFlags::UniformRanks)) {
@@ -165,6 +174,10 @@ MxMDOrderBook::MxMDOrderBook( // single leg
   m_instruments[0] = instrument;
   m_l1Data.pxNDP = instrument->refData().pxNDP;
   m_l1Data.qtyNDP = instrument->refData().qtyNDP;
+  if (md()->pxLadder()) {
+    m_bids->initPxLadder();
+    m_asks->initPxLadder();
+  }
 }
 
 MxMDOrderBook::MxMDOrderBook( // multi-leg
@@ -191,6 +204,10 @@ MxMDOrderBook::MxMDOrderBook( // multi-leg
   }
   m_l1Data.pxNDP = pxNDP;
   m_l1Data.qtyNDP = qtyNDP;
+  if (md()->pxLadder()) {
+    m_bids->initPxLadder();
+    m_asks->initPxLadder();
+  }
 }
 
 void MxMDOrderBook::subscribe(MxMDInstrHandler *handler)
@@ -297,6 +314,7 @@ void MxMDOrderBook::l1(MxMDL1Data &l1Data)
   m_l1Data.flags = l1Data.flags;
   
   md()->l1(this, l1Data);
+  shmUpdate_();
   if (m_handler) m_handler->l1(this, l1Data);
 }
 
@@ -373,12 +391,206 @@ void MxMDOrderBook::updateLast(
   }
   
   md()->l1(this, l1Data);
+  shmUpdate_();
   if (m_handler) m_handler->l1(this, l1Data);
 }
 
+MxMDPxLadder::~MxMDPxLadder()
+{
+  delete [] m_slots;
+}
+
+void MxMDPxLadder::init(MxMDTickSizeTbl *tickSizeTbl, MxNDP pxNDP)
+{
+  if (m_count) evict(m_base, m_base + Size);
+  m_tickSizeTbl = tickSizeTbl;
+  m_pxNDP = pxNDP;
+  m_tick = 0;
+  if (!tickSizeTbl) {
+    delete [] m_slots;
+    m_slots = nullptr;
+    return;
+  }
+  if (!m_slots) m_slots = new ZmRef<MxMDPxLevel>[Size];
+}
+
+// tick size at price, in the order book's price NDP
+MxValue MxMDPxLadder::tickSize(MxValue price) const
+{
+  MxNDP tblNDP = m_tickSizeTbl->pxNDP();
+  MxValue tickSize = m_tickSizeTbl->tickSize(
+      MxValNDP{price, m_pxNDP}.adjust(tblNDP));
+  if (!*tickSize || tickSize <= 0) return MxValue();
+  return MxValNDP{tickSize, tblNDP}.adjust(m_pxNDP);
+}
+
+// move levels in [lo, hi) from the ring to the sparse tree
+void MxMDPxLadder::evict(int64_t lo, int64_t hi)
+{
+  while ((lo = lowest(lo, hi)) < hi) {
+    m_sparse.add(slot(lo));
+    clear(lo++);
+  }
+}
+
+// centre the ring on price - re-uses slots for ticks that remain in range
+void MxMDPxLadder::recentre(MxValue price)
+{
+  MxValue tickSize = this->tickSize(price);
+  if (!*tickSize || tickSize <= 0) {
+    if (m_count) evict(m_base, m_base + Size);
+    m_tick = 0;
+    return;
+  }
+  int64_t tick = tickSize;
+  int64_t px = price;
+  int64_t base = px / tick - (px % tick < 0) - (Size>>1);
+  if (tick != m_tick) {
+    if (m_count) evict(m_base, m_base + Size);
+    m_tick = tick;
+  } else if (m_count) {
+    if (base > m_base)
+      evict(m_base, base < m_base + Size ? base : m_base + Size);
+    else if (base < m_base)
+      evict(base + Size > m_base ? base + Size : m_base, m_base + Size);
+  }
+  m_base = base;
+  // import sparse levels that are now within range
+  if (!m_sparse.count()) return;
+  auto i = m_sparse.iterator<ZmRBTreeGreaterEqual>(MxValue(base * tick));
+  MxValue end = (base + Size) * tick;
+  while (MxMDPxLevel *pxLevel = i.iterate()) {
+    MxValue price = pxLevel->price();
+    if (price >= end) break;
+    int64_t px = price;
+    if (px % tick) continue;
+    ZmRef<MxMDPxLevel> pxLevel_ = pxLevel;
+    i.del();
+    slot(px / tick, pxLevel_);
+  }
+}
+
+void MxMDPxLadder::add(MxMDPxLevel *pxLevel)
+{
+  if (m_slots) {
+    MxValue price = pxLevel->price();
+    int64_t tick;
+    if (!m_count)
+      recentre(price);
+    else if (!inRing(price, tick)) {
+      // re-centre if price is at or near the touch
+      MxMDPxLevel *best = m_side == MxSide::Buy ? maximum() : minimum();
+      MxValue bestPx = best->price();
+      bool better = m_side == MxSide::Buy ? price > bestPx : price < bestPx;
+      if (better)
+	recentre(price);
+      else {
+	int64_t d = int64_t(bestPx) - int64_t(price);
+	if (d < 0) d = -d;
+	if (m_tick && d < m_tick * (Size>>2)) recentre(bestPx);
+      }
+    }
+    if (inRing(price, tick)) {
+      slot(tick, pxLevel);
+      return;
+    }
+  }
+  m_sparse.add(pxLevel);
+}
+
+void MxMDPxLadder::del(MxMDPxLevel *pxLevel)
+{
+  int64_t tick;
+  if (m_count && inRing(pxLevel->price(), tick) && slot(tick) == pxLevel) {
+    clear(tick);
+    return;
+  }
+  m_sparse.del(pxLevel);
+}
+
+void MxMDPxLadder::clean()
+{
+  if (m_count) {
+    int64_t lo = m_base, hi = m_base + Size;
+    while ((lo = lowest(lo, hi)) < hi) clear(lo++);
+  }
+  m_sparse.clean();
+}
+
+MxMDPxLevel *MxMDPxLadder::minimum() const
+{
+  MxMDPxLevel *pxLevel = m_sparse.minimumPtr();
+  if (m_count) {
+    int64_t tick = lowest(m_base, m_base + Size);
+    MxMDPxLevel *ringLevel = slot(tick);
+    if (!pxLevel || ringLevel->price() < pxLevel->price()) return ringLevel;
+  }
+  return pxLevel;
+}
+
+MxMDPxLevel *MxMDPxLadder::maximum() const
+{
+  MxMDPxLevel *pxLevel = m_sparse.maximumPtr();
+  if (m_count) {
+    int64_t tick = highest(m_base, m_base + Size);
+    MxMDPxLevel *ringLevel = slot(tick);
+    if (!pxLevel || ringLevel->price() > pxLevel->price()) return ringLevel;
+  }
+  return pxLevel;
+}
+
+// merges the ring with the sparse tree
+MxMDPxLevel *MxMDPxLadder::next_(
+    MxValue price, bool inclusive, bool ascending) const
+{
+  MxMDPxLevel *ringLevel = nullptr, *pxLevel = nullptr;
+  if (m_count) {
+    int64_t px = price;
+    int64_t tick = px / m_tick - (px % m_tick < 0); // floor
+    bool exact = tick * m_tick == px;
+    int64_t lo = m_base, hi = m_base + Size;
+    if (ascending) {
+      if (!exact || !inclusive) ++tick;
+      if (tick < lo) tick = lo;
+      if ((tick = lowest(tick, hi)) < hi) ringLevel = slot(tick);
+    } else {
+      if (exact && !inclusive) --tick;
+      if (tick >= hi) tick = hi - 1;
+      if ((tick = highest(lo, tick + 1)) >= lo) ringLevel = slot(tick);
+    }
+  }
+  if (m_sparse.count()) {
+    if (ascending) {
+      if (inclusive)
+	pxLevel =
+	  m_sparse.readIterator<ZmRBTreeGreaterEqual>(price).iterate();
+      else
+	pxLevel = m_sparse.readIterator<ZmRBTreeGreater>(price).iterate();
+    } else {
+      if (inclusive)
+	pxLevel = m_sparse.readIterator<ZmRBTreeLessEqual>(price).iterate();
+      else
+	pxLevel = m_sparse.readIterator<ZmRBTreeLess>(price).iterate();
+    }
+  }
+  if (!ringLevel) return pxLevel;
+  if (!pxLevel) return ringLevel;
+  if (ascending)
+    return pxLevel->price() < ringLevel->price() ? pxLevel : ringLevel;
+  return pxLevel->price() > ringLevel->price() ? pxLevel : ringLevel;
+}
+
+MxMDOBSide::MxMDOBSide(MxMDOrderBook *ob, MxEnum side) :
+  m_orderBook(ob), m_side(side), m_data{0, 0}, m_pxLevels(side) { }
+
+void MxMDOBSide::initPxLadder()
+{
+  m_pxLevels.init(m_orderBook->tickSizeTbl(), pxNDP());
+}
+
 bool MxMDOBSide::updateL1Bid(MxMDL1Data &l1Data, MxMDL1Data &delta)
 {
-  MxMDPxLevel *bid = m_pxLevels.maximumPtr();
+  MxMDPxLevel *bid = m_pxLevels.maximum();
   if (bid) {
     if (l1Data.bid != bid->price() ||
 	l1Data.bidQty != bid->data().qty) {
@@ -398,7 +610,7 @@ bool MxMDOBSide::updateL1Bid(MxMDL1Data &l1Data, MxMDL1Data &delta)
 
 bool MxMDOBSide::updateL1Ask(MxMDL1Data &l1Data, MxMDL1Data &delta)
 {
-  MxMDPxLevel *ask = m_pxLevels.minimumPtr();
+  MxMDPxLevel *ask = m_pxLevels.minimum();
   if (ask) {
     if (l1Data.ask != ask->price() ||
 	l1Data.askQty != ask->data().qty) {
@@ -418,6 +630,11 @@ bool MxMDOBSide::updateL1Ask(MxMDL1Data &l1Data, MxMDL1Data &delta)
 
 void MxMDOrderBook::l2(MxDateTime stamp, bool updateL1)
 {
+  if (ZuUnlikely(batching_())) {
+    m_batchL2 = true;
+    return;
+  }
+
   MxMDL1Data delta{.pxNDP = m_l1Data.pxNDP, .qtyNDP = m_l1Data.qtyNDP};
   bool l1Updated = false;
 
@@ -426,6 +643,7 @@ void MxMDOrderBook::l2(MxDateTime stamp, bool updateL1)
     l1Updated = m_asks->updateL1Ask(m_l1Data, delta) || l1Updated;
     if (l1Updated) m_l1Data.stamp = delta.stamp = stamp;
     md()->l2(this, stamp, updateL1);
+    shmUpdate_();
   }
 
   if (m_handler) {
@@ -434,6 +652,89 @@ void MxMDOrderBook::l2(MxDateTime stamp, bool updateL1)
   }
 }
 
+// publish the shared memory snapshot, once per batch if batching
+void MxMDOrderBook::shmUpdate_()
+{
+  if (ZuUnlikely(batching_())) {
+    m_batchShm = true;
+    return;
+  }
+  md()->shmUpdate(this);
+}
+
+bool MxMDOrderBook::batching_()
+{
+  if (ZuLikely(!m_batching)) {
+    MxMDShard *shard = this->shard();
+    if (ZuLikely(!shard->batching())) return false;
+    shard->batched(this);
+    m_batching = true;
+  }
+  return true;
+}
+
+void MxMDOrderBook::pxLevelFn_(const MxMDPxLevelFn *fn,
+    MxMDPxLevel *pxLevel, MxDateTime transactTime)
+{
+  if (!fn) return;
+  if (ZuLikely(!batching_())) {
+    (*fn)(pxLevel, transactTime);
+    return;
+  }
+  if (!pxLevel->m_batched) {
+    pxLevel->m_batched =
+      (fn == &m_handler->addPxLevel || fn == &m_handler->addMktLevel) ? 2 : 1;
+    m_batchLevels.push(pxLevel);
+  }
+}
+
+void MxMDOrderBook::batchEnd(MxDateTime stamp)
+{
+  if (!m_batching) return;
+  m_batching = false;
+  unsigned n = m_batchLevels.length();
+  if (n && m_handler) {
+    const MxMDInstrHandler *handler = m_handler;
+    for (unsigned i = 0; i < n; i++) {
+      MxMDPxLevel *pxLevel = m_batchLevels[i];
+      bool added = pxLevel->m_batched == 2;
+      bool mkt = !*pxLevel->price();
+      const MxMDPxLevelFn *fn;
+      pxLevel->m_batched = 0;
+      if (pxLevel->data().qty) {
+	if (added)
+	  fn = mkt ? &handler->addMktLevel : &handler->addPxLevel;
+	else
+	  fn = mkt ? &handler->updatedMktLevel : &handler->updatedPxLevel;
+      } else {
+	if (added) continue; // added and deleted within batch
+	fn = mkt ? &handler->deletedMktLevel : &handler->deletedPxLevel;
+      }
+      (*fn)(pxLevel, stamp);
+    }
+    handler->batch(this,
+	ZuArray<const ZmRef<MxMDPxLevel> >{m_batchLevels.data(), n}, stamp);
+  } else {
+    for (unsigned i = 0; i < n; i++) m_batchLevels[i]->m_batched = 0;
+  }
+  m_batchLevels.length(0);
+  bool shm = m_batchShm;
+  m_batchShm = false;
+  if (n || m_batchL2) {
+    m_batchL2 = false;
+    l2(stamp, true); // publishes the snapshot
+  } else if (shm)
+    md()->shmUpdate(this);
+}
+
+void MxMDShard::batchEnd(MxDateTime stamp)
+{
+  m_batching = false;
+  unsigned n = m_batchOBs.length();
+  for (unsigned i = 0; i < n; i++) m_batchOBs[i]->batchEnd(stamp);
+  m_batchOBs.length(0);
+}
+
 void MxMDOrderBook::pxLevel(
   MxEnum side, MxDateTime transactTime, bool delta,
   MxValue price, MxValue qty, MxUInt nOrders, MxFlags flags)
@@ -542,7 +843,7 @@ void MxMDOrderBook::pxLevel_(
 	  this, side, transactTime, delta, price, qty, nOrders, flags);
   }
 
-  if (pxLevelFn) (*pxLevelFn)(pxLevel, transactTime);
+  pxLevelFn_(pxLevelFn, pxLevel, transactTime);
 
   if (d_qty_) *d_qty_ = d_qty;
   if (d_nOrders_) *d_nOrders_ = d_nOrders;
@@ -613,7 +914,7 @@ void MxMDOBSide::delOrder_(
       return;
     }
     m_mktLevel->updateDelta(transactTime, -orderData.qty, -1, 0);
-    m_mktLevel->delOrder(orderData.rank);
+    m_mktLevel->delOrder(order);
     pxLevel = m_mktLevel;
     if (!m_mktLevel->data().qty) {
       if (handler) pxLevelFn = &handler->deletedMktLevel;
@@ -631,7 +932,7 @@ void MxMDOBSide::delOrder_(
     return;
   }
   pxLevel->updateDelta(transactTime, -orderData.qty, -1, 0);
-  pxLevel->delOrder(orderData.rank);
+  pxLevel->delOrder(order);
   if (!pxLevel->data().qty) {
     if (handler) pxLevelFn = &handler->deletedPxLevel;
     pxLevel->reset(transactTime, [](MxMDOrder *, MxDateTime) { });
@@ -658,6 +959,45 @@ void MxMDOrderBook::delOrder_(
   }
 }
 
+void MxMDOBSide::updateOrder_(
+    MxMDOrder *order, MxDateTime transactTime, MxValue qty,
+    const MxMDInstrHandler *handler,
+    const MxMDPxLevelFn *&pxLevelFn, ZmRef<MxMDPxLevel> &pxLevel)
+{
+  const MxMDOrderData &orderData = order->data();
+  pxLevel = static_cast<MxMDPxLevel *>(order->pxLevel());
+  if (ZuUnlikely(!pxLevel)) {
+    m_orderBook->md()->raise(ZeEVENT(Error, MxMDNoPxLevel("updateOrder")));
+    return;
+  }
+  MxValue d_qty = qty - orderData.qty;
+  pxLevel->updateDelta(transactTime, d_qty, 0, 0);
+  if (!*orderData.price) {
+    if (handler) pxLevelFn = &handler->updatedMktLevel;
+  } else {
+    if (handler) pxLevelFn = &handler->updatedPxLevel;
+    m_data.nv +=
+      (MxValNDP{orderData.price, pxNDP()} *
+       MxValNDP{d_qty, qtyNDP()}).value;
+  }
+  m_data.qty += d_qty;
+}
+
+bool MxMDOrderBook::fifo() const
+{
+  return m_venue->flags() & (1U<<MxMDVenueFlags::FIFO);
+}
+
+void MxMDOrderBook::updateOrder_(
+  MxMDOrder *order, MxDateTime transactTime, MxValue qty,
+  const MxMDInstrHandler *handler,
+  const MxMDPxLevelFn *&pxLevelFn, ZmRef<MxMDPxLevel> &pxLevel)
+{
+  const MxMDOrderData &orderData = order->data();
+  MxMDOBSide *obSide = orderData.side == MxSide::Buy ? m_bids : m_asks;
+  obSide->updateOrder_(order, transactTime, qty, handler, pxLevelFn, pxLevel);
+}
+
 ZmRef<MxMDOrder> MxMDOrderBook::addOrder(
   ZuString orderID, MxDateTime transactTime,
   MxEnum side, MxUInt rank, MxValue price, MxValue qty, MxFlags flags)
@@ -687,7 +1027,7 @@ ZmRef<MxMDOrder> MxMDOrderBook::addOrder(
       pxLevel->side(), transactTime, true,
       pxLevel->price(), qty, 1, flags, 0, 0);
 
-  if (pxLevelFn) (*pxLevelFn)(pxLevel, transactTime);
+  pxLevelFn_(pxLevelFn, pxLevel, transactTime);
 
   if (m_handler) m_handler->addOrder(order, transactTime);
 
@@ -739,14 +1079,44 @@ void MxMDOrderBook::modifyOrder_(MxMDOrder *order, MxDateTime transactTime,
 {
   const MxMDPxLevelFn *pxLevelFn[2] = { 0 };
   ZmRef<MxMDPxLevel> pxLevel[2];
-  delOrder_(order, transactTime, m_handler, pxLevelFn[0], pxLevel[0]);
 
   MxValue oldQty = order->data().qty;
+
+  // FIFO venues - if only the qty changes, and is not increased, the
+  // order keeps its place
+  if (fifo() && qty && oldQty && qty <= oldQty &&
+      side == order->data().side && price == order->data().price) {
+    updateOrder_(order, transactTime, qty, m_handler,
+	pxLevelFn[0], pxLevel[0]);
+    order->update_(order->data().rank, price, qty, flags);
+
+    md()->modifyOrder(
+	this, order->id(), transactTime, side,
+	order->data().rank, price, qty, flags);
+
+    if (MxMDOrderBook *out = this->out())
+      out->pxLevel_(
+	pxLevel[0]->side(), transactTime, true,
+	pxLevel[0]->price(), qty - oldQty, 0, 0, 0, 0);
+
+    pxLevelFn_(pxLevelFn[0], pxLevel[0], transactTime);
+
+    if (m_handler) m_handler->modifiedOrder(order, transactTime);
+    return;
+  }
+
+  // FIFO venues - otherwise the order is re-queued at the back of the
+  // level, with a new rank
+  if (fifo()) rank = MxUInt();
+
+  delOrder_(order, transactTime, m_handler, pxLevelFn[0], pxLevel[0]);
+
   order->update_(rank, price, qty, flags);
 
-  if (ZuLikely(qty))
+  if (ZuLikely(qty)) {
     addOrder_(order, transactTime, m_handler, pxLevelFn[1], pxLevel[1]);
-  else
+    if (fifo()) rank = order->data().rank;
+  } else
     m_venueShard->delOrder(key(), side, order->id());
 
   md()->modifyOrder(
@@ -763,9 +1133,8 @@ void MxMDOrderBook::modifyOrder_(MxMDOrder *order, MxDateTime transactTime,
 	pxLevel[1]->price(), qty, 1, 0, 0, 0);
   }
 
-  if (pxLevelFn[0]) (*(pxLevelFn[0]))(pxLevel[0], transactTime);
-  if (ZuLikely(qty))
-    if (pxLevelFn[1]) (*(pxLevelFn[1]))(pxLevel[1], transactTime);
+  pxLevelFn_(pxLevelFn[0], pxLevel[0], transactTime);
+  if (ZuLikely(qty)) pxLevelFn_(pxLevelFn[1], pxLevel[1], transactTime);
 
   if (m_handler) m_handler->modifiedOrder(order, transactTime);
 }
@@ -808,11 +1177,34 @@ void MxMDOrderBook::reduceOrder_(MxMDOrder *order,
 {
   const MxMDPxLevelFn *pxLevelFn[2] = { 0 };
   ZmRef<MxMDPxLevel> pxLevel[2];
-  delOrder_(order, transactTime, m_handler, pxLevelFn[0], pxLevel[0]);
 
   MxValue oldQty = order->data().qty;
   MxValue qty = oldQty - reduceQty;
   if (!qty || (ZuUnlikely(qty < 0 || !*qty))) qty = 0;
+
+  // FIFO venues - a partial reduce keeps the order's place in the queue
+  if (fifo() && qty && oldQty) {
+    updateOrder_(order, transactTime, qty, m_handler,
+	pxLevelFn[0], pxLevel[0]);
+    order->updateQty_(qty);
+
+    md()->modifyOrder(
+	this, order->id(), transactTime, order->data().side,
+	MxUInt(), MxValue(), qty, MxFlags());
+
+    if (MxMDOrderBook *out = this->out())
+      out->pxLevel_(
+	pxLevel[0]->side(), transactTime, true,
+	pxLevel[0]->price(), qty - oldQty, 0, 0, 0, 0);
+
+    pxLevelFn_(pxLevelFn[0], pxLevel[0], transactTime);
+
+    if (m_handler) m_handler->modifiedOrder(order, transactTime);
+    return;
+  }
+
+  delOrder_(order, transactTime, m_handler, pxLevelFn[0], pxLevel[0]);
+
   order->updateQty_(qty);
 
   if (ZuLikely(qty))
@@ -834,9 +1226,8 @@ void MxMDOrderBook::reduceOrder_(MxMDOrder *order,
 	pxLevel[1]->price(), qty, 1, 0, 0, 0);
   }
 
-  if (pxLevelFn[0]) (*(pxLevelFn[0]))(pxLevel[0], transactTime);
-  if (ZuLikely(qty))
-    if (pxLevelFn[1]) (*(pxLevelFn[1]))(pxLevel[1], transactTime);
+  pxLevelFn_(pxLevelFn[0], pxLevel[0], transactTime);
+  if (ZuLikely(qty)) pxLevelFn_(pxLevelFn[1], pxLevel[1], transactTime);
 
   if (m_handler) m_handler->modifiedOrder(order, transactTime);
 }
@@ -880,7 +1271,7 @@ void MxMDOrderBook::cancelOrder_(MxMDOrder *order, MxDateTime transactTime)
       pxLevel->side(), transactTime, true,
       pxLevel->price(), -qty, -1, 0, 0, 0);
 
-  if (pxLevelFn) (*pxLevelFn)(pxLevel, transactTime);
+  pxLevelFn_(pxLevelFn, pxLevel, transactTime);
   if (m_handler) m_handler->deletedOrder(order, transactTime);
 }
 
@@ -892,8 +1283,7 @@ void MxMDOBSide::reset(MxDateTime transactTime, MxMDOrderFn fn)
     m_mktLevel = 0;
   }
   {
-    auto i = m_pxLevels.readIterator();
-    while (MxMDPxLevel *pxLevel = i.iterate()) {
+    auto l = [this, transactTime, &fn](MxMDPxLevel *pxLevel) -> bool {
       MxValue d_qty = -pxLevel->data().qty;
       MxUInt d_nOrders = -pxLevel->data().nOrders;
       pxLevel->reset(transactTime, fn);
@@ -902,7 +1292,9 @@ void MxMDOBSide::reset(MxDateTime transactTime, MxMDOrderFn fn)
 	out->pxLevel_(
 	  m_side, transactTime, true,
 	  pxLevel->price(), d_qty, d_nOrders, 0, 0, 0);
-    }
+      return true;
+    };
+    m_pxLevels.all<ZmRBTreeGreaterEqual>(l);
   }
   m_pxLevels.clean();
   m_data.nv = m_data.qty = 0;
@@ -944,9 +1336,30 @@ void MxMDOBSide::updateNDP(
 {
   if (m_mktLevel)
     m_mktLevel->updateNDP(oldPxNDP, oldQtyNDP, pxNDP, qtyNDP, fn);
-  auto i = m_pxLevels.readIterator();
-  while (MxMDPxLevel *pxLevel = i.iterate())
-    pxLevel->updateNDP(oldPxNDP, oldQtyNDP, pxNDP, qtyNDP, fn);
+  if (!m_pxLevels.ring()) {
+    // rescaling preserves the tree's ordering
+    auto l = [oldPxNDP, oldQtyNDP, pxNDP, qtyNDP, &fn](
+	MxMDPxLevel *pxLevel) -> bool {
+      pxLevel->updateNDP(oldPxNDP, oldQtyNDP, pxNDP, qtyNDP, fn);
+      return true;
+    };
+    m_pxLevels.all<ZmRBTreeGreaterEqual>(l);
+    return;
+  }
+  // the ladder is indexed by price - collect the levels, rescale them,
+  // then rebuild the ladder
+  ZtArray<ZmRef<MxMDPxLevel> > pxLevels(m_pxLevels.count());
+  auto l = [&pxLevels](MxMDPxLevel *pxLevel) -> bool {
+    pxLevels.push(pxLevel);
+    return true;
+  };
+  m_pxLevels.all<ZmRBTreeGreaterEqual>(l);
+  unsigned n = pxLevels.length();
+  for (unsigned i = 0; i < n; i++) m_pxLevels.del(pxLevels[i]);
+  for (unsigned i = 0; i < n; i++)
+    pxLevels[i]->updateNDP(oldPxNDP, oldQtyNDP, pxNDP, qtyNDP, fn);
+  initPxLadder();
+  for (unsigned i = 0; i < n; i++) m_pxLevels.add(pxLevels[i]);
 }
 
 void MxMDOrderBook::updateNDP(
@@ -998,8 +1411,14 @@ void MxMDOrderBook::update(
     const MxMDLotSizes &lotSizes,
     MxDateTime transactTime)
 {
-  if (tickSizeTbl)
+  if (tickSizeTbl && tickSizeTbl != m_tickSizeTbl) {
     m_tickSizeTbl = const_cast<MxMDTickSizeTbl *>(tickSizeTbl);
+    // enables the ladder if the book was created without a table
+    if (md()->pxLadder()) {
+      m_bids->initPxLadder();
+      m_asks->initPxLadder();
+    }
+  }
   if (*lotSizes.oddLotSize)
     m_lotSizes.oddLotSize = lotSizes.oddLotSize;
   if (*lotSizes.lotSize)
@@ -1320,6 +1739,7 @@ void MxMDLib::init_(void *cf_)
     now += ZuTime((time_t)(now.offset(timezone) + 43200)); // midday local time
     m_tzOffset = now.offset(timezone);
   }
+  m_pxLadder = cf->getBool("pxLadder");
 }
 
 void MxMDLib::subscribe(MxMDLibHandler *handler)
@@ -1825,6 +2245,12 @@ void MxMDLib::l2(const MxMDOrderBook *ob, MxDateTime stamp, bool updateL1)
 	stamp, ob->key(), updateL1);
 }
 
+void MxMDLib::shmUpdate(const MxMDOrderBook *ob)
+{
+  MxMDCore *core = static_cast<MxMDCore *>(this);
+  if (MxMDShmPublisher *shm = core->shm()) shm->update(ob);
+}
+
 void MxMDLib::addOrder(const MxMDOrderBook *ob,
     ZuString orderID, MxDateTime transactTime,
     MxEnum side, MxUInt rank, MxValue price, MxValue qty, MxFlags flags)
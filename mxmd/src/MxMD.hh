@@ -14,6 +14,7 @@
 #endif
 
 #include <zlib/ZuIndex.hh>
+#include <zlib/ZuArray.hh>
 #include <zlib/ZuObject.hh>
 #include <zlib/ZuRef.hh>
 
@@ -139,6 +140,7 @@ class MxMDOrderBook;
 class MxMDOBSide;
 class MxMDPxLevel_;
 class MxMDOrder_;
+class MxMDOrderQueue;
 
 typedef ZmSharded<MxMDShard> MxMDSharded;
 
@@ -355,6 +357,7 @@ friend MxMDVenueShard;
 friend MxMDOrderBook;
 friend MxMDOBSide;
 friend MxMDPxLevel_;
+friend MxMDOrderQueue;
 
 private:
   static MxMDOBSide *bids_(const MxMDOrderBook *);
@@ -424,6 +427,8 @@ private:
 
   MxMDOrderBook		*m_orderBook;
   MxMDPxLevel_		*m_pxLevel = 0;
+  MxMDOrder_		*m_prev = nullptr;	// MxMDOrderQueue links
+  MxMDOrder_		*m_next = nullptr;
 
   MxIDString		m_id;
   MxMDOrderData		m_data;
@@ -447,6 +452,62 @@ using MxMDOrders =
 		  ZmRBTreeHeapID<MxMDOrder_HeapID> > > > > >;
 using MxMDOrder = MxMDOrders::Node;
 
+// price-time FIFO order queue - intrusive double-linked list, O(1)
+// append and removal by handle; holds a reference to each queued order
+class MxMDOrderQueue {
+  MxMDOrderQueue(const MxMDOrderQueue &) = delete;
+  MxMDOrderQueue &operator =(const MxMDOrderQueue &) = delete;
+
+public:
+  MxMDOrderQueue() { }
+  ~MxMDOrderQueue() { clean(); }
+
+  unsigned count() const { return m_count; }
+
+  MxMDOrder *head() const { return static_cast<MxMDOrder *>(m_head); }
+  MxMDOrder *tail() const { return static_cast<MxMDOrder *>(m_tail); }
+  static MxMDOrder *next(const MxMDOrder_ *order) {
+    return static_cast<MxMDOrder *>(order->m_next);
+  }
+
+  void push(MxMDOrder *order) {
+    ZmREF(order);
+    MxMDOrder_ *order_ = order;
+    order_->m_prev = m_tail;
+    order_->m_next = nullptr;
+    if (m_tail)
+      m_tail->m_next = order_;
+    else
+      m_head = order_;
+    m_tail = order_;
+    ++m_count;
+  }
+  void del(MxMDOrder *order) {
+    MxMDOrder_ *order_ = order;
+    if (order_->m_prev)
+      order_->m_prev->m_next = order_->m_next;
+    else if (m_head == order_)
+      m_head = order_->m_next;
+    else
+      return; // not queued
+    if (order_->m_next)
+      order_->m_next->m_prev = order_->m_prev;
+    else
+      m_tail = order_->m_prev;
+    order_->m_prev = order_->m_next = nullptr;
+    --m_count;
+    ZmDEREF(order);
+  }
+  void clean() {
+    while (MxMDOrder *order = head()) del(order);
+  }
+
+private:
+  MxMDOrder_	*m_head = nullptr;
+  MxMDOrder_	*m_tail = nullptr;
+  unsigned	m_count = 0;
+};
+
 struct MxMDOrders1_HeapID {
   static constexpr const char *id() { return "MxMDOrders1"; }
 };
@@ -593,8 +654,11 @@ public:
   MxValue price() const { return m_price; }
   const MxMDPxLvlData &data() const { return m_data; }
 
+  // iterate over all orders in priority order
   template <typename L> // (MxMDOrder *) -> bool
   bool allOrders(L l) const {
+    for (MxMDOrder *order = m_queue.head(); order; order = m_queue.next(order))
+      if (!l(order)) return false;
     auto i = m_orders.readIterator();
     while (MxMDOrder *order = i.iterate())
       if (!l(order)) return false;
@@ -616,8 +680,27 @@ private:
       MxValue qty, MxUInt nOrders, MxFlags flags,
       MxValue &d_qty, MxUInt &d_nOrders);
 
+  // iterate over all orders in priority order, removing those for which
+  // del is set; iteration ends when l returns false
+  template <typename L> // (MxMDOrder *, bool &del) -> bool
+  void iterateOrders_(L l) {
+    MxMDOrder *next;
+    for (MxMDOrder *order = m_queue.head(); order; order = next) {
+      next = m_queue.next(order);
+      bool del = false, more = l(order, del);
+      if (del) m_queue.del(order);
+      if (!more) return;
+    }
+    auto i = m_orders.iterator();
+    while (MxMDOrder *order = i.iterate()) {
+      bool del = false, more = l(order, del);
+      if (del) i.del();
+      if (!more) return;
+    }
+  }
+
   void addOrder(MxMDOrder *order);
-  void delOrder(MxUInt rank);
+  void delOrder(MxMDOrder *order);
 
   template <typename Fill>
   bool match(MxDateTime transactTime,
@@ -636,8 +719,11 @@ private:
   MxNDP			m_pxNDP;
   MxNDP			m_qtyNDP;
   MxValue		m_price;
+  uint8_t		m_batched = 0;	// 1 - changed, 2 - added in batch
   MxMDPxLvlData	  	m_data;
-  MxMDOrders		m_orders;
+  MxMDOrderQueue	m_queue;	// FIFO venues
+  uint32_t		m_queueRank = 0;	// next FIFO rank
+  MxMDOrders		m_orders;	// ranked venues
 };
 
 // FIXME
@@ -658,6 +744,154 @@ typedef ZmRBTree<MxMDPxLevel_,
 
 typedef MxMDPxLevels::Node MxMDPxLevel;
 
+// tick-indexed price ladder - a ring of Size contiguous per-tick slots
+// centred on the touch, indexed via the order book's tick size table,
+// with a sparse MxMDPxLevels fallback for levels that are far from the
+// touch or off the tick grid; if disabled, all levels are sparse
+class MxMDAPI MxMDPxLadder {
+  MxMDPxLadder(const MxMDPxLadder &) = delete;
+  MxMDPxLadder &operator =(const MxMDPxLadder &) = delete;
+
+public:
+  enum { Bits = 8, Size = (1<<Bits), Mask = Size - 1 };
+
+  MxMDPxLadder(MxEnum side) : m_side(side) { }
+  ~MxMDPxLadder();
+
+  // (re-)initialize, null tickSizeTbl disables the ring
+  void init(MxMDTickSizeTbl *tickSizeTbl, MxNDP pxNDP);
+
+  bool ring() const { return m_slots; }
+  unsigned count() const { return m_count + m_sparse.count(); }
+
+  ZmRef<MxMDPxLevel> find(MxValue price) const {
+    int64_t tick;
+    if (m_count && inRing(price, tick)) return m_slots[tick & Mask];
+    return m_sparse.find(price);
+  }
+  void add(MxMDPxLevel *pxLevel);
+  void del(MxMDPxLevel *pxLevel);
+  void clean();
+
+  MxMDPxLevel *minimum() const;
+  MxMDPxLevel *maximum() const;
+
+  // Direction is ZmRBTreeGreaterEqual (ascending) or ZmRBTreeLessEqual
+  template <int Direction> MxMDPxLevel *first() const {
+    return Direction == ZmRBTreeGreaterEqual ? minimum() : maximum();
+  }
+  // first level at price or beyond it in Direction
+  template <int Direction> MxMDPxLevel *first(MxValue price) const {
+    return next_(price, true, Direction == ZmRBTreeGreaterEqual);
+  }
+  // next level beyond price in Direction (price need not be present)
+  template <int Direction> MxMDPxLevel *next(MxValue price) const {
+    return next_(price, false, Direction == ZmRBTreeGreaterEqual);
+  }
+
+  // iterate over levels in Direction, starting at price if specified;
+  // without the ring, the tree is iterated in order, otherwise levels
+  // are stepped through by price (l may update the level's data, but
+  // must not add or delete levels)
+  template <int Direction, typename L> // (MxMDPxLevel *) -> bool
+  bool all(L &l) const {
+    if (!m_slots) {
+      auto i = m_sparse.readIterator<Direction>();
+      while (MxMDPxLevel *pxLevel = i.iterate())
+	if (!l(pxLevel)) return false;
+      return true;
+    }
+    return step<Direction>(first<Direction>(), l);
+  }
+  template <int Direction, typename L> // (MxMDPxLevel *) -> bool
+  bool all(MxValue price, L &l) const {
+    if (!m_slots) {
+      auto i = m_sparse.readIterator<Direction>(price);
+      while (MxMDPxLevel *pxLevel = i.iterate())
+	if (!l(pxLevel)) return false;
+      return true;
+    }
+    return step<Direction>(first<Direction>(price), l);
+  }
+
+  // all levels, if the ring is disabled
+  MxMDPxLevels &tree() { return m_sparse; }
+
+private:
+  template <int Direction, typename L>
+  bool step(MxMDPxLevel *pxLevel, L &l) const {
+    while (pxLevel) {
+      MxValue price = pxLevel->price();
+      if (!l(pxLevel)) return false;
+      pxLevel = next<Direction>(price);
+    }
+    return true;
+  }
+
+  bool inRing(MxValue price, int64_t &tick) const {
+    if (!m_tick) return false;
+    int64_t px = price;
+    if (px % m_tick) return false;
+    tick = px / m_tick;
+    return tick >= m_base && tick < m_base + Size;
+  }
+
+  // lowest occupied tick in [lo, hi), hi if none
+  int64_t lowest(int64_t lo, int64_t hi) const {
+    while (lo < hi) {
+      unsigned slot = lo & Mask;
+      if (uint64_t w = m_occupied[slot>>6]>>(slot & 63)) {
+	lo += ZuIntrin::ctz(w);
+	return lo < hi ? lo : hi;
+      }
+      lo += 64 - (slot & 63);
+    }
+    return hi;
+  }
+  // highest occupied tick in [lo, hi), lo - 1 if none
+  int64_t highest(int64_t lo, int64_t hi) const {
+    while (hi > lo) {
+      unsigned slot = (hi - 1) & Mask;
+      if (uint64_t w = m_occupied[slot>>6]<<(63 - (slot & 63))) {
+	hi -= 1 + ZuIntrin::clz(w);
+	return hi >= lo ? hi : lo - 1;
+      }
+      hi -= (slot & 63) + 1;
+    }
+    return lo - 1;
+  }
+
+  MxMDPxLevel *slot(int64_t tick) const { return m_slots[tick & Mask].ptr(); }
+  void slot(int64_t tick, MxMDPxLevel *pxLevel) {
+    unsigned i = tick & Mask;
+    m_slots[i] = pxLevel;
+    m_occupied[i>>6] |= (uint64_t(1)<<(i & 63));
+    ++m_count;
+  }
+  void clear(int64_t tick) {
+    unsigned i = tick & Mask;
+    m_slots[i] = nullptr;
+    m_occupied[i>>6] &= ~(uint64_t(1)<<(i & 63));
+    --m_count;
+  }
+
+  MxValue tickSize(MxValue price) const;
+  void recentre(MxValue price);
+  void evict(int64_t lo, int64_t hi);
+
+  MxMDPxLevel *next_(MxValue price, bool inclusive, bool ascending) const;
+
+  MxEnum		m_side;
+  MxMDTickSizeTbl	*m_tickSizeTbl = nullptr;
+  MxNDP			m_pxNDP;
+  int64_t		m_tick = 0;	// tick size (0 - ring is empty)
+  int64_t		m_base = 0;	// first tick in ring
+  unsigned		m_count = 0;	// number of levels in ring
+  uint64_t		m_occupied[Size>>6] = { 0 };
+  ZmRef<MxMDPxLevel>	*m_slots = nullptr;
+  MxMDPxLevels		m_sparse;
+};
+
 // event handlers (callbacks)
 
 typedef ZmFn<void(MxMDLib *)> MxMDLibFn;
@@ -678,6 +912,10 @@ typedef ZmFn<void(MxMDOrderBook *, MxDateTime)> MxMDOrderBookFn;
 typedef ZmFn<void(MxMDOrderBook *, const MxMDL1Data &)> MxMDLevel1Fn;
 // price level, time stamp
 typedef ZmFn<void(MxMDPxLevel *, MxDateTime)> MxMDPxLevelFn;
+// order book, price levels changed by batch, time stamp
+typedef ZmFn<void(
+    MxMDOrderBook *, ZuArray<const ZmRef<MxMDPxLevel> >, MxDateTime)>
+  MxMDBatchFn;
 // trade, time stamp
 typedef ZmFn<void(MxMDTrade *, MxDateTime)> MxMDTradeFn;
 // time stamp, next time stamp
@@ -728,6 +966,7 @@ struct MxMDInstrHandler : public ZuObject {
   MxMDInstrHandler_Fn(MxMDPxLevelFn,	updatedPxLevel);
   MxMDInstrHandler_Fn(MxMDPxLevelFn,	deletedPxLevel);
   MxMDInstrHandler_Fn(MxMDOrderBookFn,	l2);
+  MxMDInstrHandler_Fn(MxMDBatchFn,	batch);
   MxMDInstrHandler_Fn(MxMDOrderFn,	addOrder);
   MxMDInstrHandler_Fn(MxMDOrderFn,	modifiedOrder);
   MxMDInstrHandler_Fn(MxMDOrderFn,	deletedOrder);
@@ -752,8 +991,7 @@ friend MxMDOrderBook;
 friend MxMDPxLevel_;
 
 private:
-  MxMDOBSide(MxMDOrderBook *ob, MxEnum side) :
-    m_orderBook(ob), m_side(side), m_data{0, 0} { }
+  MxMDOBSide(MxMDOrderBook *ob, MxEnum side);
 
 public:
   MxMDOrderBook *orderBook() const { return m_orderBook; }
@@ -771,42 +1009,37 @@ public:
   // iterate over all price levels, best -> worst
   template <typename L> // (MxMDPxLevel *) -> bool
   bool allPxLevels(L l) const {
-    if (m_side == MxSide::Buy) {
-      auto i = m_pxLevels.readIterator<ZmRBTreeLessEqual>();
-      while (MxMDPxLevel *pxLevel = i.iterate())
-	if (!l(pxLevel)) return false;
-    } else {
-      auto i = m_pxLevels.readIterator<ZmRBTreeGreaterEqual>();
-      while (MxMDPxLevel *pxLevel = i.iterate())
-	if (!l(pxLevel)) return false;
-    }
-    return true;
+    if (m_side == MxSide::Buy)
+      return allPxLevels_<ZmRBTreeLessEqual>(l);
+    else
+      return allPxLevels_<ZmRBTreeGreaterEqual>(l);
   }
 
   // iterate over price levels in range, best -> worst
   template <typename L> // (MxMDPxLevel *)-> bool
   bool pxLevels(MxValue minPrice, MxValue maxPrice, L l) {
+    bool ok = true;
     if (m_side == MxSide::Buy) {
-      auto i = m_pxLevels.readIterator<ZmRBTreeLessEqual>(maxPrice);
-      while (MxMDPxLevel *pxLevel = i.iterate()) {
-	if (pxLevel->price() <= minPrice) break;
-	if (!l(pxLevel)) return false;
-      }
+      auto l_ = [minPrice, &l, &ok](MxMDPxLevel *pxLevel) -> bool {
+	if (pxLevel->price() <= minPrice) return false;
+	return ok = l(pxLevel);
+      };
+      m_pxLevels.all<ZmRBTreeLessEqual>(maxPrice, l_);
     } else {
-      auto i = m_pxLevels.readIterator<ZmRBTreeGreaterEqual>(minPrice);
-      while (MxMDPxLevel *pxLevel = i.iterate()) {
-	if (pxLevel->price() >= maxPrice) break;
-	if (!l(pxLevel)) return false;
-      }
+      auto l_ = [maxPrice, &l, &ok](MxMDPxLevel *pxLevel) -> bool {
+	if (pxLevel->price() >= maxPrice) return false;
+	return ok = l(pxLevel);
+      };
+      m_pxLevels.all<ZmRBTreeGreaterEqual>(minPrice, l_);
     }
-    return true;
+    return ok;
   }
 
   MxNDP pxNDP() const;
   MxNDP qtyNDP() const;
 
-  MxMDPxLevel *minimum() { return m_pxLevels.minimumPtr(); }
-  MxMDPxLevel *maximum() { return m_pxLevels.maximumPtr(); }
+  MxMDPxLevel *minimum() { return m_pxLevels.minimum(); }
+  MxMDPxLevel *maximum() { return m_pxLevels.maximum(); }
 
   // returns effective limit Px for matching up to qty (market orders)
   MxValue matchPx(MxValue qty) {
@@ -819,51 +1052,58 @@ public:
       px = pxLevel->price();
       return qty -= lvlQty;
     };
-    if (m_side == MxSide::Buy) {
-      auto i = m_pxLevels.readIterator<ZmRBTreeLessEqual>();
-      while (MxMDPxLevel *pxLevel = i.iterate())
-	if (!l(pxLevel)) break;
-    } else {
-      auto i = m_pxLevels.readIterator<ZmRBTreeGreaterEqual>();
-      while (MxMDPxLevel *pxLevel = i.iterate())
-	if (!l(pxLevel)) break;
-    }
+    allPxLevels(l);
     return px;
   }
 
   // returns qty available for matching at limit price or better (limit orders)
   MxValue matchQty(MxValue px) {
     MxValue qty = 0;
-    if (m_side == MxSide::Buy) {
-      auto i = m_pxLevels.readIterator<ZmRBTreeLessEqual>();
-      while (MxMDPxLevel *pxLevel = i.iterate()) {
-	MxValue cPx = pxLevel->price();
-	if (px > cPx) break;
+    if (m_side == MxSide::Buy)
+      allPxLevels([px, &qty](MxMDPxLevel *pxLevel) -> bool {
+	if (px > pxLevel->price()) return false;
 	qty += pxLevel->data().qty;
-      }
-    } else {
-      auto i = m_pxLevels.readIterator<ZmRBTreeGreaterEqual>();
-      while (MxMDPxLevel *pxLevel = i.iterate()) {
-	MxValue cPx = pxLevel->price();
-	if (px < cPx) break;
+	return true;
+      });
+    else
+      allPxLevels([px, &qty](MxMDPxLevel *pxLevel) -> bool {
+	if (px < pxLevel->price()) return false;
 	qty += pxLevel->data().qty;
-      }
-    }
+	return true;
+      });
     return qty;
   }
 
 private:
+  template <int Direction, typename L>
+  bool allPxLevels_(L &l) const {
+    return m_pxLevels.all<Direction>(l);
+  }
+
   template <int Direction, typename Fill, typename Limit>
   bool match(
       MxDateTime transactTime, MxValue px, MxValue &qty, MxValue &cumQty,
       Fill &&fill, Limit &&limit) {
-    auto i = m_pxLevels.iterator<Direction>();
-    while (MxMDPxLevel *pxLevel = i.iterate()) {
-      if (!limit(px, pxLevel->price())) break;
+    if (!m_pxLevels.ring()) {
+      auto i = m_pxLevels.tree().iterator<Direction>();
+      while (MxMDPxLevel *pxLevel = i.iterate()) {
+	if (!limit(px, pxLevel->price())) break;
+	bool v = pxLevel->match(transactTime, qty, cumQty, fill);
+	if (!pxLevel->data().qty) i.del();
+	if (!v) return false;
+	if (!qty) break;
+      }
+      return true;
+    }
+    ZmRef<MxMDPxLevel> pxLevel = m_pxLevels.first<Direction>();
+    while (pxLevel) {
+      MxValue price = pxLevel->price();
+      if (!limit(px, price)) break;
       bool v = pxLevel->match(transactTime, qty, cumQty, fill);
-      if (!pxLevel->data().qty) i.del();
+      if (!pxLevel->data().qty) m_pxLevels.del(pxLevel);
       if (!v) return false;
       if (!qty) break;
+      pxLevel = m_pxLevels.next<Direction>(price);
     }
     return true;
   }
@@ -892,6 +1132,10 @@ private:
       MxMDOrder *order, MxDateTime transactTime,
       const MxMDInstrHandler *handler,
       const MxMDPxLevelFn *&fn, ZmRef<MxMDPxLevel> &pxLevel);
+  void updateOrder_(
+      MxMDOrder *order, MxDateTime transactTime, MxValue qty,
+      const MxMDInstrHandler *handler,
+      const MxMDPxLevelFn *&fn, ZmRef<MxMDPxLevel> &pxLevel);
 
   void reset(MxDateTime transactTime, MxMDOrderFn);
 
@@ -899,11 +1143,13 @@ private:
       MxNDP oldPxNDP, MxNDP oldQtyNDP, MxNDP pxNDP, MxNDP qtyNDP,
       const MxMDOrderNDPFn &);
 
+  void initPxLadder();
+
   MxMDOrderBook		*m_orderBook;
   MxEnum		m_side;
   MxMDOBSideData	m_data;
   ZmRef<MxMDPxLevel>	m_mktLevel;
-  MxMDPxLevels		m_pxLevels;
+  MxMDPxLadder		m_pxLevels;
 };
 
 MxEnum MxMDPxLevel_::side() const
@@ -999,6 +1245,19 @@ public:
       MxFlags flags = MxFlags());
   void l2(MxDateTime stamp, bool updateL1 = false);
 
+  // batch apply - price level callbacks are coalesced to one per changed
+  // level, followed by batch(), then L1 is recomputed and l2() is called
+  // once when the batch ends
+  template <typename L> // (MxMDOrderBook *) -> void
+  void batch(MxDateTime stamp, L l) {
+    batchBegin();
+    l(this);
+    batchEnd(stamp);
+  }
+  void batchBegin() { m_batching = true; }
+  void batchEnd(MxDateTime stamp);
+  bool batching() const { return m_batching; }
+
   ZmRef<MxMDOrder> addOrder(
     ZuString orderID, MxDateTime transactTime,
     MxEnum side, MxUInt rank, MxValue price, MxValue qty, MxFlags flags);
@@ -1132,9 +1391,20 @@ private:
     MxMDOrder *order, MxDateTime transactTime,
     const MxMDInstrHandler *handler,
     const MxMDPxLevelFn *&fn, ZmRef<MxMDPxLevel> &pxLevel);
+  // FIFO venues - update qty in place, retaining queue priority
+  bool fifo() const;
+  void updateOrder_(
+    MxMDOrder *order, MxDateTime transactTime, MxValue qty,
+    const MxMDInstrHandler *handler,
+    const MxMDPxLevelFn *&fn, ZmRef<MxMDPxLevel> &pxLevel);
 
   void reset_(MxMDPxLevel *pxLevel, MxDateTime transactTime);
 
+  bool batching_();
+  void shmUpdate_();
+  void pxLevelFn_(const MxMDPxLevelFn *fn,
+      MxMDPxLevel *pxLevel, MxDateTime transactTime);
+
   void deletedOrder_(MxMDOrder *order, MxDateTime transactTime) {
     if (m_handler) m_handler->deletedOrder(order, transactTime);
   }
@@ -1173,6 +1443,11 @@ private:
 
   ZmRef<MxMDInstrHandler>	m_handler;
 
+  bool				m_batching = false;
+  bool				m_batchL2 = false;	// l2() deferred
+  bool				m_batchShm = false;	// snapshot deferred
+  ZtArray<ZmRef<MxMDPxLevel> >	m_batchLevels;		// changed levels
+
   ZmAtomic<uintptr_t>		m_libData = 0;
   ZmAtomic<uintptr_t>		m_appData = 0;
 };
@@ -1692,6 +1967,7 @@ inline ZmRef<MxMDOrder> MxMDVenueShard::delOrder(
 
 class MxMDAPI MxMDShard : public ZuObject, public ZmShard {
 friend MxMDLib;
+friend MxMDOrderBook;
 
   // FIXME
   struct Instruments_HeapID : public ZmHeapSharded {
@@ -1736,7 +2012,21 @@ public:
   }
   bool allOrderBooks(ZmFn<void(MxMDOrderBook *)>) const;
 
+  // batch apply across order books within this shard - each order book
+  // joins the batch when first updated (see MxMDOrderBook::batch())
+  template <typename L> // (MxMDShard *) -> void
+  void batch(MxDateTime stamp, L l) {
+    batchBegin();
+    l(this);
+    batchEnd(stamp);
+  }
+  void batchBegin() { m_batching = true; }
+  void batchEnd(MxDateTime stamp);
+  bool batching() const { return m_batching; }
+
 private:
+  void batched(MxMDOrderBook *ob) { m_batchOBs.push(ob); }
+
   void addInstrument(MxMDInstrument *instrument) {
     m_instruments->add(instrument);
   }
@@ -1754,6 +2044,8 @@ private:
   unsigned		m_id;
   ZmRef<Instruments>	m_instruments;
   ZmRef<OrderBooks>	m_orderBooks;
+  bool			m_batching = false;
+  ZtArray<ZmRef<MxMDOrderBook> > m_batchOBs;
 };
 
 MxMDLib *MxMDOrderBook::md() const { return shard()->md(); }
@@ -1818,6 +2110,10 @@ public:
   virtual void dumpOrderBooks(
       ZuString path, MxID venue = MxID(), MxID segment = MxID()) = 0;
 
+  // order books created hereafter use tick-indexed price ladders
+  bool pxLadder() const { return m_pxLadder; }
+  void pxLadder(bool v) { m_pxLadder = v; }
+
   unsigned nShards() const { return m_shards.length(); }
   MxMDShard *shard(unsigned i) const { return m_shards[i]; }
   template <typename L>
@@ -1957,6 +2253,9 @@ friend ZmShard;
 
   void l2(const MxMDOrderBook *ob, MxDateTime stamp, bool updateL1);
 
+  // shared memory snapshot, following L1 and L2 updates
+  void shmUpdate(const MxMDOrderBook *ob);
+
   void addOrder(const MxMDOrderBook *ob,
       ZuString orderID, MxDateTime transactTime,
       MxEnum side, MxUInt rank, MxValue price, MxValue qty, MxFlags flags);
@@ -2201,6 +2500,8 @@ private:
 
   int			m_tzOffset = 0;
 
+  bool			m_pxLadder = false;
+
   SubLock		m_subLock;
     ZmRef<MxMDLibHandler> m_handler;
 
@@ -2234,12 +2535,11 @@ inline bool MxMDPxLevel_::match(MxDateTime transactTime,
   MxValue oldNOrders = m_data.nOrders;
   bool v = true;
 
-  auto i = this->m_orders.iterator();
-  while (MxMDOrder *contra = i.iterate()) {
+  iterateOrders_([&](MxMDOrder *contra, bool &del) -> bool {
     MxValue cQty = contra->data().qty;
     MxValue nv;
     if (cQty <= qty) {
-      if (!(v = !fill(qty, cumQty, m_price, cQty, contra))) break;
+      if (!(v = !fill(qty, cumQty, m_price, cQty, contra))) return false;
       cumQty += cQty;
       nv = (MxValNDP{m_price, m_pxNDP} * MxValNDP{cQty, m_qtyNDP}).value;
       deletedOrder_(contra, transactTime);
@@ -2248,24 +2548,23 @@ inline bool MxMDPxLevel_::match(MxDateTime transactTime,
       qty -= cQty;
       updateLast(transactTime, cQty, nv, qty);
       md->cancelOrder(ob, contra->id(), transactTime, side);
-      i.del();
-      if (!qty) break;
-    } else {
-      if (!(v = !fill(qty, cumQty, m_price, qty, contra))) break;
-      cumQty += qty;
-      nv = (MxValNDP{m_price, m_pxNDP} * MxValNDP{qty, m_qtyNDP}).value;
-      contra->updateQty_(cQty -= qty);
-      m_data.qty -= qty;
-      updateLast(transactTime, qty, nv, 0);
-      {
-	const auto &contraData = contra->data();
-	md->modifyOrder(ob, contra->id(), transactTime,
-	    side, contraData.rank, m_price, cQty, contraData.flags);
-      }
-      qty = 0;
-      break;
+      del = true;
+      return !!qty;
     }
-  }
+    if (!(v = !fill(qty, cumQty, m_price, qty, contra))) return false;
+    cumQty += qty;
+    nv = (MxValNDP{m_price, m_pxNDP} * MxValNDP{qty, m_qtyNDP}).value;
+    contra->updateQty_(cQty -= qty);
+    m_data.qty -= qty;
+    updateLast(transactTime, qty, nv, 0);
+    {
+      const auto &contraData = contra->data();
+      md->modifyOrder(ob, contra->id(), transactTime,
+	  side, contraData.rank, m_price, cQty, contraData.flags);
+    }
+    qty = 0;
+    return false;
+  });
   if (m_data.qty != oldQty) {
     m_obSide->matched(m_price, m_data.qty - oldQty);
     if (MxMDOrderBook *out = ob->out())
@@ -363,6 +363,11 @@ void MxMDCore::init_(const ZvCf *cf)
 
   m_broadcast.init(this);
 
+  if (ZmRef<ZvCf> shmCf = cf->getCf("shm")) {
+    m_shm = new MxMDShmPublisher();
+    m_shm->init(this, shmCf);
+  }
+
   if (ZmRef<ZvCf> cmdCf = cf->getCf("cmd")) {
     m_cmdServer = new MxMDCmdServer();
     Mx *mx = this->mx(cmdCf->get("mx", "cmd"));
@@ -490,6 +495,11 @@ void MxMDCore::start()
     m_cmdServer->start();
   }
 
+  if (m_shm) {
+    raise(ZeEVENT(Info, "opening shared memory snapshot..."));
+    m_shm->open();
+  }
+
   if (m_publisher) {
     raise(ZeEVENT(Info, "starting publisher..."));
     m_publisher->start();
@@ -530,6 +540,11 @@ void MxMDCore::stop()
   stopReplaying();
   stopRecording();
 
+  if (m_shm) {
+    raise(ZeEVENT(Info, "closing shared memory snapshot..."));
+    m_shm->close();
+  }
+
   if (m_cmdServer) {
     raise(ZeEVENT(Info, "stopping command server..."));
     m_cmdServer->stop();
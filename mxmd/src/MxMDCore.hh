@@ -32,6 +32,7 @@
 #include <mxmd/MxMDStream.hh>
 
 #include <mxmd/MxMDBroadcast.hh>
+#include <mxmd/MxMDShm.hh>
 
 #include <mxmd/MxMDRecord.hh>
 #include <mxmd/MxMDReplay.hh>
@@ -198,6 +199,9 @@ public:
 
   bool streaming() { return m_broadcast.active(); }
 
+  // null if unconfigured
+  MxMDShmPublisher *shm() const { return m_shm.ptr(); }
+
   template <typename Snapshot>
   bool snapshot(Snapshot &snapshot, MxID id, MxSeqNo seqNo) {
     bool ok = allVenues([&snapshot](MxMDVenue *venue) {
@@ -305,6 +309,7 @@ private:
   ZmRef<MxMDCmdServer>	m_cmdServer; // FIXME
 
   MxMDBroadcast		m_broadcast;	// broadcasts updates
+  ZmRef<MxMDShmPublisher> m_shm;	// shared memory top-N snapshots
 
   ZmRef<MxMDRecord>	m_record;	// records to file
   ZmRef<MxMDReplay>	m_replay;	// replays from file
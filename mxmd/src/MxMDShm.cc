@@ -0,0 +1,145 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// MxMD conflated top-N order book snapshots in shared memory
+
+#include <mxmd/MxMDCore.hh>
+
+#include <mxmd/MxMDShm.hh>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+void MxMDShmPublisher::init(MxMDCore *core, const ZvCf *cf)
+{
+  m_core = core;
+  m_name = cf->get("name", "MxMDShm");
+  m_depth = cf->getInt("depth", 1, 1000, 10);
+  m_size = cf->getInt("books", 1, 1000000, 1024);
+  m_slotSize = MxMDShm::slotSize(m_depth);
+}
+
+bool MxMDShmPublisher::open()
+{
+  if (m_hdr) return true;
+  int mmapFlags =
+#ifdef linux
+    MAP_POPULATE;
+#else
+    0;
+#endif
+  uint64_t size = MxMDShm::mmapSize(m_depth, m_size);
+  ZeError e;
+  if (m_file.mmap(m_name, ZiFile::Create | ZiFile::Shm, size,
+	true, mmapFlags, 0666, &e) != Zi::OK) {
+    m_core->raise(ZeEVENT(Error,
+      ([name = MxTxtString(m_name), e](auto &s) {
+	s << '"' << name
+	  << "\": failed to open shared memory snapshot: " << e;
+      })));
+    return false;
+  }
+  memset(m_file.addr(), 0, size);
+  // discard slot indices from any previous open()
+  m_core->allOrderBooks([](MxMDOrderBook *ob) -> bool {
+    ob->libData(static_cast<uintptr_t>(0));
+    return true;
+  });
+  MxMDShmHdr *hdr = reinterpret_cast<MxMDShmHdr *>(m_file.addr());
+  hdr->depth = m_depth;
+  hdr->size = m_size;
+  hdr->slotSize = m_slotSize;
+  hdr->count.store_(0);
+  ZmAtomic_release();
+  hdr->magic = MxMDShmHdr::Magic;
+  m_hdr = hdr;
+  m_open = 1; // store/release
+  return true;
+}
+
+void MxMDShmPublisher::close()
+{
+  if (!m_open.xch(0)) return;
+  while (m_writers.load_()) Zm::yield();
+  m_hdr = nullptr;
+  m_file.close();
+}
+
+MxMDShmBook *MxMDShmPublisher::alloc(const MxMDOrderBook *ob)
+{
+  MxMDOrderBook *ob_ = const_cast<MxMDOrderBook *>(ob);
+  Guard guard(m_lock);
+  unsigned i = m_hdr->count.load_();
+  if (ZuUnlikely(i >= m_size)) {
+    ob_->libData(~static_cast<uintptr_t>(0));
+    guard.unlock();
+    m_core->raise(ZeEVENT(Warning,
+      ([name = MxTxtString(m_name), key = ob->key()](auto &s) {
+	s << '"' << name << "\": shared memory snapshot full - "
+	  << key << " not published";
+      })));
+    return nullptr;
+  }
+  MxMDShmBook *book = slot(i);
+  book->key = ob->key(); // invisible to readers until count is released
+  m_hdr->count = i + 1;
+  ob_->libData(static_cast<uintptr_t>(i) + 1);
+  return book;
+}
+
+void MxMDShmPublisher::update(const MxMDOrderBook *ob)
+{
+  ++m_writers;
+  if (ZuLikely(m_open)) update_(ob); // load/acquire
+  --m_writers;
+}
+
+void MxMDShmPublisher::update_(const MxMDOrderBook *ob)
+{
+  MxMDShmBook *book;
+  {
+    uintptr_t i = ob->libData();
+    if (ZuLikely(i)) {
+      if (ZuUnlikely(!~i)) return;
+      book = slot(i - 1);
+    } else {
+      if (!(book = alloc(ob))) return;
+    }
+  }
+
+  // seqlock - odd while writing
+  uint64_t seqNo = book->seqNo.load_();
+  book->seqNo.store_(seqNo + 1);
+  ZmAtomic_release();
+
+  const MxMDL1Data &l1Data = ob->l1Data();
+  book->stamp = l1Data.stamp;
+  book->last = l1Data.last;
+  book->lastQty = l1Data.lastQty;
+  book->pxNDP = ob->pxNDP();
+  book->qtyNDP = ob->qtyNDP();
+
+  unsigned depth = m_depth;
+  auto fill = [depth](MxMDOBSide *obSide, MxMDShmLevel *level) {
+    unsigned n = 0;
+    obSide->allPxLevels([depth, level, &n](MxMDPxLevel *pxLevel) {
+      const MxMDPxLvlData &data = pxLevel->data();
+      MxMDShmLevel &level_ = level[n];
+      level_.price = pxLevel->price();
+      level_.qty = data.qty;
+      level_.nOrders = data.nOrders;
+      level_.flags = data.flags;
+      return ++n < depth;
+    });
+    return n;
+  };
+  MxMDShmLevel *levels = book->levels();
+  book->nBids = fill(ob->bids(), levels);
+  book->nAsks = fill(ob->asks(), levels + depth);
+
+  book->seqNo = seqNo + 2; // store/release
+}
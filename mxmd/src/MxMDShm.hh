@@ -0,0 +1,223 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// MxMD conflated top-N order book snapshots in shared memory
+//
+// one fixed-size slot per order book, each protected by a seqlock;
+// the publisher overwrites the slot in place following each L1 or L2
+// update (once per batch), readers poll the latest state without copying
+// or per-reader fan-out; readers index slots by key as they are allocated
+
+#ifndef MxMDShm_HH
+#define MxMDShm_HH
+
+#ifndef MxMDLib_HH
+#include <mxmd/MxMDLib.hh>
+#endif
+
+#include <zlib/ZmAtomic.hh>
+#include <zlib/ZmPLock.hh>
+#include <zlib/ZmGuard.hh>
+#include <zlib/ZmObject.hh>
+#include <zlib/ZmLHash.hh>
+
+#include <zlib/ZiFile.hh>
+
+#include <zlib/ZvCf.hh>
+
+#include <mxbase/MxBase.hh>
+
+#include <mxmd/MxMDTypes.hh>
+
+class MxMDCore;
+class MxMDOrderBook;
+
+#pragma pack(push, 8)
+
+struct MxMDShmLevel {
+  MxValue	price;
+  MxValue	qty;
+  uint32_t	nOrders;
+  uint32_t	flags;
+};
+
+struct alignas(64) MxMDShmHdr {
+  enum { Magic = 0x4d784d53 }; // "MxMS"
+
+  uint32_t		magic;
+  uint32_t		depth;		// levels per side
+  uint32_t		size;		// number of slots
+  uint32_t		slotSize;	// bytes per slot
+  ZmAtomic<uint32_t>	count;		// slots allocated
+};
+
+// seqNo is odd while the slot is being written, 0 if never written
+struct alignas(64) MxMDShmBook {
+  ZmAtomic<uint64_t>	seqNo;
+  MxInstrKey		key;
+  MxDateTime		stamp;
+  MxValue		last;
+  MxValue		lastQty;
+  MxNDP			pxNDP;
+  MxNDP			qtyNDP;
+  uint16_t		nBids;
+  uint16_t		nAsks;
+
+  // depth bids (best first), followed by depth asks (best first)
+  const MxMDShmLevel *levels() const {
+    return reinterpret_cast<const MxMDShmLevel *>(this + 1);
+  }
+  MxMDShmLevel *levels() {
+    return reinterpret_cast<MxMDShmLevel *>(this + 1);
+  }
+};
+
+#pragma pack(pop)
+
+namespace MxMDShm {
+  inline unsigned slotSize(unsigned depth) {
+    return (sizeof(MxMDShmBook) + (depth<<1) * sizeof(MxMDShmLevel) + 63) &
+      ~static_cast<unsigned>(63);
+  }
+  inline uint64_t mmapSize(unsigned depth, unsigned size) {
+    return sizeof(MxMDShmHdr) + static_cast<uint64_t>(slotSize(depth)) * size;
+  }
+}
+
+// publisher - updated by MxMDCore in each order book's shard thread
+class MxMDAPI MxMDShmPublisher : public ZmObject {
+public:
+  void init(MxMDCore *core, const ZvCf *cf);
+
+  const ZtString &name() const { return m_name; }
+  unsigned depth() const { return m_depth; }
+
+  bool open(); // returns true if successful, false otherwise
+  void close(); // waits for in-progress updates before unmapping
+
+  void update(const MxMDOrderBook *ob);
+
+private:
+  typedef ZmPLock Lock;
+  typedef ZmGuard<Lock> Guard;
+
+  MxMDShmBook *slot(unsigned i) const {
+    return reinterpret_cast<MxMDShmBook *>(
+	reinterpret_cast<uint8_t *>(m_hdr + 1) + i * m_slotSize);
+  }
+  MxMDShmBook *alloc(const MxMDOrderBook *ob);
+  void update_(const MxMDOrderBook *ob);
+
+  MxMDCore	*m_core = nullptr;
+  ZtString	m_name;
+  unsigned	m_depth = 10;
+  unsigned	m_size = 1024;
+  unsigned	m_slotSize = 0;
+  Lock		m_lock;		// serializes slot allocation across shards
+  ZiFile	m_file;
+  MxMDShmHdr	*m_hdr = nullptr;
+  // shard threads in update() - close() waits for these to drain
+  ZmAtomic<unsigned>	m_open = 0;
+  ZmAtomic<unsigned>	m_writers = 0;
+};
+
+// reader - any number of processes, polls the latest snapshot
+class MxMDShmReader {
+public:
+  ~MxMDShmReader() { close(); }
+
+  int open(ZuString name, ZeError *e = nullptr) {
+    int r;
+    if ((r = m_file.mmap(name, ZiFile::Shm | ZiFile::ReadOnly,
+	    sizeof(MxMDShmHdr), true, 0, 0666, e)) != Zi::OK) return r;
+    const MxMDShmHdr *hdr =
+      reinterpret_cast<const MxMDShmHdr *>(m_file.addr());
+    if (hdr->magic != MxMDShmHdr::Magic) {
+      m_file.close();
+      if (e) *e = ZeError(EINVAL);
+      return Zi::IOError;
+    }
+    uint64_t size = MxMDShm::mmapSize(hdr->depth, hdr->size);
+    m_file.close();
+    if ((r = m_file.mmap(name, ZiFile::Shm | ZiFile::ReadOnly,
+	    size, true, 0, 0666, e)) != Zi::OK) return r;
+    m_hdr = reinterpret_cast<const MxMDShmHdr *>(m_file.addr());
+    return Zi::OK;
+  }
+  void close() {
+    m_file.close();
+    m_hdr = nullptr;
+    m_index.clean();
+    m_indexed = 0;
+  }
+
+  unsigned depth() const { return m_hdr->depth; }
+  unsigned count() const { return m_hdr->count.load_(); }
+
+  // maximum number of attempts by read() (default: 1000)
+  unsigned spins() const { return m_spins; }
+  void spins(unsigned n) { m_spins = n ? n : 1; }
+
+  // returns slot index, -1 if not (yet) published
+  int find(const MxInstrKey &key) {
+    // index newly allocated slots - a slot's key is written before
+    // count is released, and is not subsequently modified
+    for (unsigned n = m_hdr->count; m_indexed < n; m_indexed++) // acquire
+      m_index.add(slot(m_indexed)->key, m_indexed);
+    if (auto kv = m_index.find(key)) return kv->template p<1>();
+    return -1;
+  }
+
+  // l(const MxMDShmBook *) is called with the slot in place and is re-run
+  // if it raced with the publisher - l must not retain pointers or act
+  // on the data unless read() returns Zi::OK; returns Zi::EndOfFile if
+  // the slot has never been written, Zi::NotReady if no consistent
+  // snapshot was obtained within spins() attempts (e.g. the publisher
+  // stalled or failed mid-update), in which case the caller may retry
+  // or continue with its previous (stale) data
+  template <typename L>
+  int read(unsigned i, L l) const {
+    const MxMDShmBook *book = slot(i);
+    for (unsigned j = m_spins; j; --j) {
+      uint64_t seqNo = book->seqNo; // load/acquire
+      if (ZuUnlikely(!seqNo)) return Zi::EndOfFile;
+      if (ZuUnlikely(seqNo & 1)) continue;
+      l(book);
+      ZmAtomic_acquire();
+      if (ZuLikely(book->seqNo.load_() == seqNo)) return Zi::OK;
+    }
+    return Zi::NotReady;
+  }
+
+  // copying read - out must have room for slotSize() bytes
+  int read(unsigned i, MxMDShmBook *out) const {
+    unsigned size = slotSize();
+    return read(i, [out, size](const MxMDShmBook *book) {
+      memcpy(static_cast<void *>(out), book, size);
+    });
+  }
+
+  unsigned slotSize() const { return m_hdr->slotSize; }
+
+  // sequence number - changes when the slot is updated
+  uint64_t seqNo(unsigned i) const { return slot(i)->seqNo.load_(); }
+
+private:
+  const MxMDShmBook *slot(unsigned i) const {
+    return reinterpret_cast<const MxMDShmBook *>(
+	reinterpret_cast<const uint8_t *>(m_hdr + 1) + i * m_hdr->slotSize);
+  }
+
+  using Index = ZmLHashKV<MxInstrKey, unsigned, ZmLHashLocal<>>;
+
+  ZiFile		m_file;
+  const MxMDShmHdr	*m_hdr = nullptr;
+  unsigned		m_spins = 1000;
+  Index			m_index;	// key -> slot index
+  unsigned		m_indexed = 0;	// number of slots indexed
+};
+
+#endif /* MxMDShm_HH */
@@ -129,11 +129,13 @@ namespace MxMDVenueFlags {
   MxEnumValues("MxMDVenueFlags_",
       UniformRanks,		// order ranks are uniformly distributed
       Dark,			// lit if not dark
-      Synthetic);		// synthetic (aggregated from input venues)
+      Synthetic,		// synthetic (aggregated from input venues)
+      FIFO);			// price-time FIFO, ranks are not published
   MxEnumFlags("MxMDVenueFlags", Flags,
       "UniformRanks", UniformRanks,
       "Dark", Dark,
-      "Synthetic", Synthetic);
+      "Synthetic", Synthetic,
+      "FIFO", FIFO);
 }
 
 #endif /* MxMDTypes_HH */
@@ -0,0 +1,125 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// MxMD price ladder replay benchmark - tree vs. tick-indexed ladder
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mxmd/MxMD.hh>
+
+#include <zlib/ZmSemaphore.hh>
+
+#include <zlib/ZeLog.hh>
+
+ZmSemaphore done;	// posted on end of replay
+
+uint64_t nUpdates = 0;	// L2 updates
+uint64_t nLevels = 0;	// levels visited
+
+unsigned depth = 5;	// levels read per side per update
+
+// read the top of book on each update, as a typical consumer would
+void l2(MxMDOrderBook *ob, MxDateTime)
+{
+  ++nUpdates;
+  unsigned n = 0;
+  ob->bids()->allPxLevels([&n](MxMDPxLevel *) { return ++n < depth; });
+  nLevels += n, n = 0;
+  ob->asks()->allPxLevels([&n](MxMDPxLevel *) { return ++n < depth; });
+  nLevels += n;
+}
+
+void addOrderBook(MxMDOrderBook *ob, MxDateTime)
+{
+  static ZmRef<MxMDInstrHandler> handler =
+    &((new MxMDInstrHandler())->l2Fn(MxMDOrderBookFn::Ptr<&l2>::fn()));
+  ob->subscribe(handler);
+}
+
+void eof(MxMDLib *) { done.post(); }
+
+void usage()
+{
+  fputs(
+    "Usage: mdbench_ladder [OPTION]... RECFILE\n\n"
+    "Options:\n"
+    "  -l\t- use tick-indexed price ladders\n"
+    "  -d N\t- read N levels per side per update (default: 5)\n", stderr);
+  Zm::exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  bool ladder = false;
+  const char *path = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] != '-') {
+      if (path) usage();
+      path = argv[i];
+      continue;
+    }
+    if (!argv[i][1] || argv[i][2]) usage();
+    switch (argv[i][1]) {
+      case 'l':
+	ladder = true;
+	break;
+      case 'd':
+	if (++i >= argc || !(depth = atoi(argv[i]))) usage();
+	break;
+      default:
+	usage();
+	break;
+    }
+  }
+  if (!path) usage();
+
+  ZeLog::init("mdbench_ladder");
+  ZeLog::level(0);
+  ZeLog::sink(ZeLog::fileSink(ZeSinkOptions{}.path("&2")));
+  ZeLog::start();
+
+  try {
+    MxMDLib *md = MxMDLib::init("");
+    if (!md) return 1;
+
+    md->pxLadder(ladder);
+
+    md->subscribe(&((new MxMDLibHandler())->
+	  addOrderBookFn(MxMDOrderBookFn::Ptr<&addOrderBook>::fn()).
+	  eofFn(MxMDLibFn::Ptr<&eof>::fn())));
+
+    md->start();
+
+    ZuTime begin = Zm::now();
+    if (!md->replay(path)) {
+      md->stop();
+      md->final();
+      ZeLog::stop();
+      return 1;
+    }
+    done.wait();
+    ZuTime elapsed = Zm::now() - begin;
+
+    md->stop();
+
+    printf("%s: %llu updates, %llu levels read in %.3fs "
+	"(%.1f ns/update)\n",
+	ladder ? "ladder" : "tree",
+	static_cast<unsigned long long>(nUpdates),
+	static_cast<unsigned long long>(nLevels),
+	double(elapsed.as_fp()),
+	nUpdates ? double(elapsed.nanosecs()) / double(nUpdates) : 0.0);
+
+    md->final();
+  } catch (...) { }
+
+  ZeLog::stop();
+  return 0;
+}
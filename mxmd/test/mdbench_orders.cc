@@ -0,0 +1,175 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// MxMD order queue microbenchmark - FIFO queue vs. ranked tree
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mxmd/MxMD.hh>
+
+#include <zlib/ZmRandom.hh>
+#include <zlib/ZmSemaphore.hh>
+
+#include <zlib/ZeLog.hh>
+
+unsigned nOrders = 100000;	// orders per run
+unsigned nLevels = 10;		// price levels
+
+// FIFO venue and ranked venue
+static const char *venues[] = { "XFIF", "XRNK" };
+
+int setup(MxMDLib *md, MxMDFeed *feed);
+
+bool startFailed = false;
+
+struct Feed : public MxMDFeed {
+  Feed(MxMDLib *md, MxID id) : MxMDFeed(md, id, 3) { }
+  void start() { if (setup(md(), this) < 0) startFailed = true; }
+};
+
+int setup(MxMDLib *md, MxMDFeed *feed)
+{
+  try {
+    for (unsigned i = 0; i < 2; i++) {
+      ZmRef<MxMDVenue> venue = new MxMDVenue(md, feed,
+	venues[i], MxMDOrderIDScope::OrderBook,
+	!i ? (1U<<MxMDVenueFlags::FIFO) : 0U);
+      md->addVenue(venue);
+
+      MxMDTickSizeTbl *tickSizeTbl = venue->addTickSizeTbl("1", 0);
+      if (!tickSizeTbl) throw ZtString("MxMDVenue::addTickSizeTbl() failed");
+      tickSizeTbl->addTickSize(0, MxValueMax, 1);
+
+      MxMDLotSizes lotSizes{1, 1, 1};
+
+      MxInstrKey instrKey{"BENCH", venues[i], MxID()};
+      MxMDInstrRefData refData;
+      refData.idSrc = MxInstrIDSrc::EXCH;
+      refData.symbol = "BENCH";
+      refData.pxNDP = 0;
+      refData.qtyNDP = 0;
+
+      MxMDInstrHandle instr = md->instrument(instrKey, 0);
+
+      ZtString error;
+      ZmSemaphore sem;
+      instr.invokeMv([&error, &sem,
+	  instrKey, &refData, tickSizeTbl, &lotSizes](
+	    MxMDShard *shard, ZmRef<MxMDInstrument> instr) {
+	instr = shard->addInstrument(
+	    ZuMv(instr), instrKey, refData, MxDateTime());
+	if (ZuUnlikely(!instr))
+	  error = "MxMDLib::addInstrument() failed";
+	else if (ZuUnlikely(!instr->addOrderBook(
+		instrKey, tickSizeTbl, lotSizes, MxDateTime())))
+	  error = "MxMDInstrument::addOrderBook() failed";
+	sem.post();
+      });
+      sem.wait();
+      if (ZuUnlikely(error)) throw error;
+      md->loaded(venue);
+    }
+  } catch (const ZtString &s) {
+    ZeLOG(Error, s);
+    return -1;
+  } catch (...) {
+    ZeLOG(Error, "Unknown Exception");
+    return -1;
+  }
+  return 0;
+}
+
+// add nOrders orders across nLevels, then cancel them in random order
+void bench(
+    const char *name, MxMDOrderBook *ob, const ZtArray<unsigned> &cancels)
+{
+  MxDateTime now = MxNow();
+
+  ZuTime begin = Zm::now();
+  for (unsigned i = 0; i < nOrders; i++)
+    ob->addOrder(ZuStringN<16>{} << i, now, MxSide::Buy,
+	MxUInt(), MxValue(100 + i % nLevels), MxValue(1), 0);
+  ZuTime added = Zm::now();
+  for (unsigned i = 0; i < nOrders; i++)
+    ob->cancelOrder(ZuStringN<16>{} << cancels[i], now, MxSide::Buy);
+  ZuTime cancelled = Zm::now();
+
+  printf("%s: add %.1f ns/order, cancel %.1f ns/order\n", name,
+      double((added - begin).nanosecs()) / nOrders,
+      double((cancelled - added).nanosecs()) / nOrders);
+}
+
+void usage()
+{
+  fputs(
+    "Usage: mdbench_orders [OPTION]...\n\n"
+    "Options:\n"
+    "  -n N\t- N orders (default: 100000)\n"
+    "  -l N\t- N price levels (default: 10)\n", stderr);
+  Zm::exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] != '-' || !argv[i][1] || argv[i][2]) usage();
+    switch (argv[i][1]) {
+      case 'n':
+	if (++i >= argc || !(nOrders = atoi(argv[i]))) usage();
+	break;
+      case 'l':
+	if (++i >= argc || !(nLevels = atoi(argv[i]))) usage();
+	break;
+      default:
+	usage();
+	break;
+    }
+  }
+
+  ZeLog::init("mdbench_orders");
+  ZeLog::level(0);
+  ZeLog::sink(ZeLog::fileSink(ZeSinkOptions{}.path("&2")));
+  ZeLog::start();
+
+  try {
+    MxMDLib *md = MxMDLib::init("");
+    if (!md) return 1;
+
+    md->addFeed(new Feed(md, "BNCH"));
+    md->start();
+    if (startFailed) { md->stop(); md->final(); return 1; }
+
+    // random cancellation order (Fisher-Yates)
+    ZtArray<unsigned> cancels;
+    cancels.length(nOrders);
+    for (unsigned i = 0; i < nOrders; i++) cancels[i] = i;
+    for (unsigned i = nOrders; i > 1; ) {
+      unsigned j = ZmRand::randExc(i--);
+      unsigned k = cancels[i]; cancels[i] = cancels[j]; cancels[j] = k;
+    }
+
+    for (unsigned i = 0; i < 2; i++) {
+      ZmSemaphore sem;
+      md->instrInvoke(MxInstrKey{"BENCH", venues[i], MxID()},
+	  [&sem, &cancels, i, venue = venues[i]](MxMDInstrument *instr) {
+	if (instr)
+	  if (ZmRef<MxMDOrderBook> ob = instr->orderBook(venue, MxID()))
+	    bench(!i ? "fifo" : "ranked", ob, cancels);
+	sem.post();
+      });
+      sem.wait();
+    }
+
+    md->stop();
+    md->final();
+  } catch (...) { }
+
+  ZeLog::stop();
+  return 0;
+}
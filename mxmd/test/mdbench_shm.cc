@@ -0,0 +1,217 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// MxMD shared memory snapshot latency benchmark
+//
+// the shard thread updates the top of book, a reader thread polls the
+// snapshot and measures update-to-read latency; the reader uses the same
+// API as an out-of-process reader would
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mxmd/MxMD.hh>
+#include <mxmd/MxMDCore.hh>
+#include <mxmd/MxMDShm.hh>
+
+#include <zlib/ZmThread.hh>
+#include <zlib/ZmSemaphore.hh>
+
+#include <zlib/ZeLog.hh>
+
+unsigned nUpdates = 1000000;
+unsigned interval = 1000;	// nanosecs between updates
+
+ZtArray<ZuTime> sent;		// update time, indexed by qty - 1
+ZmAtomic<unsigned> done = 0;
+
+int setup(MxMDLib *md, MxMDFeed *feed);
+
+bool startFailed = false;
+
+struct Feed : public MxMDFeed {
+  Feed(MxMDLib *md, MxID id) : MxMDFeed(md, id, 2) { }
+  void start() { if (setup(md(), this) < 0) startFailed = true; }
+};
+
+MxInstrKey key{"BENCH", "XSHM", MxID()};
+
+int setup(MxMDLib *md, MxMDFeed *feed)
+{
+  try {
+    ZmRef<MxMDVenue> venue = new MxMDVenue(md, feed, "XSHM");
+    md->addVenue(venue);
+
+    MxMDTickSizeTbl *tickSizeTbl = venue->addTickSizeTbl("1", 0);
+    if (!tickSizeTbl) throw ZtString("MxMDVenue::addTickSizeTbl() failed");
+    tickSizeTbl->addTickSize(0, MxValueMax, 1);
+
+    MxMDInstrRefData refData;
+    refData.idSrc = MxInstrIDSrc::EXCH;
+    refData.symbol = "BENCH";
+    refData.pxNDP = 0;
+    refData.qtyNDP = 0;
+
+    MxMDInstrHandle instr = md->instrument(key, 0);
+
+    ZtString error;
+    ZmSemaphore sem;
+    instr.invokeMv([&error, &sem, &refData, tickSizeTbl](
+	  MxMDShard *shard, ZmRef<MxMDInstrument> instr) {
+      instr = shard->addInstrument(ZuMv(instr), key, refData, MxDateTime());
+      if (ZuUnlikely(!instr))
+	error = "MxMDLib::addInstrument() failed";
+      else if (ZuUnlikely(!instr->addOrderBook(
+	      key, tickSizeTbl, MxMDLotSizes{1, 1, 1}, MxDateTime())))
+	error = "MxMDInstrument::addOrderBook() failed";
+      sem.post();
+    });
+    sem.wait();
+    if (ZuUnlikely(error)) throw error;
+    md->loaded(venue);
+  } catch (const ZtString &s) {
+    ZeLOG(Error, s);
+    return -1;
+  } catch (...) {
+    ZeLOG(Error, "Unknown Exception");
+    return -1;
+  }
+  return 0;
+}
+
+// runs in the shard thread
+void publish(MxMDOrderBook *ob)
+{
+  for (unsigned i = 0; i < nUpdates; i++) {
+    ZuTime now = Zm::now();
+    sent[i] = now;
+    ob->pxLevel(MxSide::Buy, now, false, MxValue(100), MxValue(i + 1), 1);
+    ob->l2(now, true);
+    ZuTime next = now + ZuTime{ZuTime::Nano{interval}};
+    while (Zm::now() < next);
+  }
+  done = 1;
+}
+
+// runs in the reader thread
+void consume(ZtString name)
+{
+  MxMDShmReader reader;
+  ZeError e;
+  if (reader.open(name, &e) != Zi::OK) {
+    ZeLOG(Error, ([name = ZuMv(name), e](auto &s) {
+      s << '"' << name << "\": open failed: " << e; }));
+    return;
+  }
+  int slot;
+  while ((slot = reader.find(key)) < 0) if (done) return;
+
+  uint64_t seqNo = 0, n = 0, total = 0, min = 0, max = 0;
+  while (!done) {
+    uint64_t seqNo_ = reader.seqNo(slot);
+    if (seqNo_ == seqNo || (seqNo_ & 1)) continue;
+    int64_t qty = 0;
+    if (reader.read(slot, [&qty](const MxMDShmBook *book) {
+      qty = book->nBids ? int64_t(book->levels()[0].qty) : int64_t(0);
+    }) != Zi::OK) continue;
+    ZuTime now = Zm::now();
+    seqNo = seqNo_;
+    if (qty <= 0 || qty > nUpdates) continue;
+    uint64_t ns = (now - sent[qty - 1]).nanosecs();
+    total += ns;
+    if (!min || ns < min) min = ns;
+    if (ns > max) max = ns;
+    ++n;
+  }
+  if (n)
+    printf("%llu reads of %u updates (%.1f%% conflated): "
+	"latency mean %.0fns min %lluns max %lluns\n",
+	static_cast<unsigned long long>(n), nUpdates,
+	100.0 - double(n) * 100.0 / double(nUpdates),
+	double(total) / double(n),
+	static_cast<unsigned long long>(min),
+	static_cast<unsigned long long>(max));
+}
+
+void usage()
+{
+  fputs(
+    "Usage: mdbench_shm [OPTION]... CONFIG\n\n"
+    "CONFIG must configure shm {} and shard 0 (see shm.cf)\n\n"
+    "Options:\n"
+    "  -n N\t- N updates (default: 1000000)\n"
+    "  -i N\t- N nanosecs between updates (default: 1000)\n", stderr);
+  Zm::exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  const char *cf = nullptr;
+
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] != '-') {
+      if (cf) usage();
+      cf = argv[i];
+      continue;
+    }
+    if (!argv[i][1] || argv[i][2]) usage();
+    switch (argv[i][1]) {
+      case 'n':
+	if (++i >= argc || !(nUpdates = atoi(argv[i]))) usage();
+	break;
+      case 'i':
+	if (++i >= argc) usage();
+	interval = atoi(argv[i]);
+	break;
+      default:
+	usage();
+	break;
+    }
+  }
+  if (!cf) usage();
+
+  ZeLog::init("mdbench_shm");
+  ZeLog::level(0);
+  ZeLog::sink(ZeLog::fileSink(ZeSinkOptions{}.path("&2")));
+  ZeLog::start();
+
+  try {
+    MxMDLib *md = MxMDLib::init(cf);
+    if (!md) return 1;
+    MxMDShmPublisher *shm = static_cast<MxMDCore *>(md)->shm();
+    if (!shm) {
+      fputs("shm {} not configured\n", stderr);
+      md->final();
+      return 1;
+    }
+
+    md->addFeed(new Feed(md, "BNCH"));
+    md->start();
+    if (startFailed) { md->stop(); md->final(); return 1; }
+
+    sent.length(nUpdates);
+
+    ZmThread reader(0, [name = shm->name()]() { consume(name); },
+	ZmThreadParams().name("reader"));
+
+    md->instrInvoke(key, [](MxMDInstrument *instr) {
+      if (instr)
+	if (ZmRef<MxMDOrderBook> ob = instr->orderBook(key.venue, MxID()))
+	  publish(ob);
+      done = 1;
+    });
+
+    reader.join();
+
+    md->stop();
+    md->final();
+  } catch (...) { }
+
+  ZeLog::stop();
+  return 0;
+}
@@ -0,0 +1,212 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// MxMD FIFO queue priority test - a reduce, or a modify that leaves the
+// price unchanged and does not increase the qty, keeps the order's place
+// in the queue and its rank; a qty increase sends it to the back of the
+// level, and a price change to the back of the new level
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+
+#include <mxmd/MxMD.hh>
+
+#include <zlib/ZmSemaphore.hh>
+
+#include <zlib/ZeLog.hh>
+
+void fail()
+{
+  Zm::exit(1);
+}
+#define check(x) check_(x, __LINE__, #x)
+void check_(bool ok, unsigned line, const char *exp)
+{
+  printf("%s %6d %s\n", ok ? " OK " : "NOK ", line, exp);
+  fflush(stdout);
+  if (!ok) fail();
+}
+
+int setup(MxMDLib *md, MxMDFeed *feed);
+
+bool startFailed = false;
+
+struct Feed : public MxMDFeed {
+  Feed(MxMDLib *md, MxID id) : MxMDFeed(md, id, 3) { }
+  void start() { if (setup(md(), this) < 0) startFailed = true; }
+};
+
+int setup(MxMDLib *md, MxMDFeed *feed)
+{
+  try {
+    ZmRef<MxMDVenue> venue = new MxMDVenue(md, feed,
+      "XFIF", MxMDOrderIDScope::OrderBook, (1U<<MxMDVenueFlags::FIFO));
+    md->addVenue(venue);
+
+    MxMDTickSizeTbl *tickSizeTbl = venue->addTickSizeTbl("1", 0);
+    if (!tickSizeTbl) throw ZtString("MxMDVenue::addTickSizeTbl() failed");
+    tickSizeTbl->addTickSize(0, MxValueMax, 1);
+
+    MxMDLotSizes lotSizes{1, 1, 1};
+
+    MxInstrKey instrKey{"TEST", "XFIF", MxID()};
+    MxMDInstrRefData refData;
+    refData.idSrc = MxInstrIDSrc::EXCH;
+    refData.symbol = "TEST";
+    refData.pxNDP = 0;
+    refData.qtyNDP = 0;
+
+    MxMDInstrHandle instr = md->instrument(instrKey, 0);
+
+    ZtString error;
+    ZmSemaphore sem;
+    instr.invokeMv([&error, &sem,
+	instrKey, &refData, tickSizeTbl, &lotSizes](
+	  MxMDShard *shard, ZmRef<MxMDInstrument> instr) {
+      instr = shard->addInstrument(
+	  ZuMv(instr), instrKey, refData, MxDateTime());
+      if (ZuUnlikely(!instr))
+	error = "MxMDLib::addInstrument() failed";
+      else if (ZuUnlikely(!instr->addOrderBook(
+	      instrKey, tickSizeTbl, lotSizes, MxDateTime())))
+	error = "MxMDInstrument::addOrderBook() failed";
+      sem.post();
+    });
+    sem.wait();
+    if (ZuUnlikely(error)) throw error;
+    md->loaded(venue);
+  } catch (const ZtString &s) {
+    ZeLOG(Error, s);
+    return -1;
+  } catch (...) {
+    ZeLOG(Error, "Unknown Exception");
+    return -1;
+  }
+  return 0;
+}
+
+// order IDs at price, in queue order
+ZtString queue(MxMDOrderBook *ob, MxValue price)
+{
+  ZtString s;
+  ob->bids()->pxLevels(price - 1, price, [&s](MxMDPxLevel *pxLevel) {
+    pxLevel->allOrders([&s](MxMDOrder *order) {
+      if (s) s << ' ';
+      s << order->id();
+      return true;
+    });
+    return true;
+  });
+  return s;
+}
+
+void test(MxMDOrderBook *ob)
+{
+  MxDateTime now = MxNow();
+
+  MxUInt rankB;
+  for (const char *id : { "A", "B", "C" }) {
+    ZmRef<MxMDOrder> order =
+      ob->addOrder(id, now, MxSide::Buy, MxUInt(), 100, 10, 0);
+    if (order && order->id() == "B") rankB = order->data().rank;
+  }
+  check(queue(ob, 100) == "A B C");
+  check(*rankB);
+
+  // a partial reduce keeps queue position and rank
+  {
+    ZmRef<MxMDOrder> order = ob->reduceOrder("B", now, MxSide::Buy, 4);
+    check(!!order);
+    check(order->data().qty == 6);
+    check(order->data().rank == rankB);
+    check(queue(ob, 100) == "A B C");
+    check(ob->bids()->maximum()->data().qty == 26);
+    check(ob->bids()->maximum()->data().nOrders == 3);
+  }
+
+  // a modify at the same price keeps queue position
+  {
+    ZmRef<MxMDOrder> order = ob->modifyOrder(
+	"A", now, MxSide::Buy, MxUInt(), 100, 5, 0);
+    check(!!order);
+    check(order->data().qty == 5);
+    check(queue(ob, 100) == "A B C");
+    check(ob->bids()->maximum()->data().qty == 21);
+  }
+
+  // a modify that increases the qty sends the order to the back,
+  // with a new rank
+  {
+    ZmRef<MxMDOrder> order = ob->modifyOrder(
+	"A", now, MxSide::Buy, MxUInt(), 100, 8, 0);
+    check(!!order);
+    check(order->data().qty == 8);
+    check(order->data().rank > rankB);
+    check(queue(ob, 100) == "B C A");
+    check(ob->bids()->maximum()->data().qty == 24);
+    check(ob->bids()->maximum()->data().nOrders == 3);
+  }
+
+  // ranks are unique, even after the tail is cancelled
+  ob->cancelOrder("C", now, MxSide::Buy);
+  ob->addOrder("D", now, MxSide::Buy, MxUInt(), 100, 10, 0);
+  check(queue(ob, 100) == "B A D");
+  {
+    MxUInt last;
+    bool ascending = true;
+    ob->bids()->maximum()->allOrders([&last, &ascending](MxMDOrder *order) {
+      if (*last && order->data().rank <= last) ascending = false;
+      last = order->data().rank;
+      return true;
+    });
+    check(ascending);
+  }
+
+  // a price change sends the order to the back of the new level
+  ob->addOrder("E", now, MxSide::Buy, MxUInt(), 99, 10, 0);
+  ob->modifyOrder("B", now, MxSide::Buy, MxUInt(), 99, 6, 0);
+  check(queue(ob, 100) == "A D");
+  check(queue(ob, 99) == "E B");
+
+  // reducing an order to zero removes it
+  ob->reduceOrder("E", now, MxSide::Buy, 10);
+  check(queue(ob, 99) == "B");
+}
+
+int main()
+{
+  ZeLog::init("mdtest_fifo");
+  ZeLog::level(0);
+  ZeLog::sink(ZeLog::fileSink(ZeSinkOptions{}.path("&2")));
+  ZeLog::start();
+
+  MxMDLib *md = MxMDLib::init("");
+  if (!md) return 1;
+
+  md->addFeed(new Feed(md, "TEST"));
+  md->start();
+  if (startFailed) { md->stop(); md->final(); return 1; }
+
+  {
+    ZmSemaphore sem;
+    md->instrInvoke(MxInstrKey{"TEST", "XFIF", MxID()},
+	[&sem](MxMDInstrument *instr) {
+      ZmRef<MxMDOrderBook> ob;
+      if (instr) ob = instr->orderBook("XFIF", MxID());
+      check(!!ob);
+      test(ob);
+      sem.post();
+    });
+    sem.wait();
+  }
+
+  md->stop();
+  md->final();
+
+  ZeLog::stop();
+  return 0;
+}
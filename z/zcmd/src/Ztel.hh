@@ -11,6 +11,8 @@
 #include <zlib/ZcmdLib.hh>
 #endif
 
+#include <zlib/ZmHistogram.hh>
+
 #include <zlib/Zfb.hh>
 #include <zlib/ZfbField.hh>
 
@@ -106,15 +108,18 @@ struct Heap : public Heap_ {
 };
 ZfbFieldTbl(Heap,
     (((id),		(Ctor<0>, Keys<0>)),			(String)),
-    (((size),		(Ctor<6>, Keys<0>)),			(UInt32)),
-    (((alignment),	(Ctor<9>)),				(UInt8)),
-    (((partition),	(Ctor<7>, Keys<0>)),			(UInt16)),
-    (((sharded),	(Ctor<8>)),				(Bool)),
+    (((size),		(Ctor<8>, Keys<0>)),			(UInt32)),
+    (((alignment),	(Ctor<12>)),				(UInt8)),
+    (((partition),	(Ctor<10>, Keys<0>)),			(UInt16)),
+    (((sharded),	(Ctor<11>)),				(Bool)),
     (((cacheSize),	(Ctor<1>)),				(UInt64)),
     (((cpuset),		(Ctor<2>)),				(Bitmap)),
+    (((magSize),	(Ctor<9>)),				(UInt32)),
     (((cacheAllocs),	(Ctor<3>, Mutable, Series, Delta)),	(UInt64)),
     (((heapAllocs),	(Ctor<4>, Mutable, Series, Delta)),	(UInt64)),
     (((frees),		(Ctor<5>, Mutable, Series, Delta)),	(UInt64)),
+    (((magAllocs),	(Ctor<6>, Mutable, Series, Delta)),	(UInt64)),
+    (((magFrees),	(Ctor<7>, Mutable, Series, Delta)),	(UInt64)),
     (((allocated, RdFn), (Synthetic, Series)),			(UInt64)),
     (((rag, RdFn),	(Synthetic, Series, Enum<RAG::Map>)),	(Int8)));
 
@@ -205,6 +210,16 @@ ZfbFieldTbl(Mx,
     (((ll),		(Ctor<11>)),				(Bool)),
     (((spin),		(Ctor<3>)),				(UInt32)),
     (((timeout),	(Ctor<4>)),				(UInt32)),
+    (((rxBatch1),	(Ctor<14>, Mutable, Series, Delta)),	(UInt64)),
+    (((rxBatch4),	(Ctor<15>, Mutable, Series, Delta)),	(UInt64)),
+    (((rxBatch16),	(Ctor<16>, Mutable, Series, Delta)),	(UInt64)),
+    (((rxBatch64),	(Ctor<17>, Mutable, Series, Delta)),	(UInt64)),
+    (((txBatch1),	(Ctor<18>, Mutable, Series, Delta)),	(UInt64)),
+    (((txBatch4),	(Ctor<19>, Mutable, Series, Delta)),	(UInt64)),
+    (((txBatch16),	(Ctor<20>, Mutable, Series, Delta)),	(UInt64)),
+    (((txBatch64),	(Ctor<21>, Mutable, Series, Delta)),	(UInt64)),
+    (((rxPolled),	(Ctor<22>, Mutable, Series, Delta)),	(UInt64)),
+    (((rxWaited),	(Ctor<23>, Mutable, Series, Delta)),	(UInt64)),
     (((rag, RdFn),	(Synthetic, Series, Enum<RAG::Map>)),	(Int8)));
 
 using Socket_ = ZiCxnTelemetry;
@@ -245,7 +260,7 @@ ZfbFieldTbl(Socket,
 
 // display sequence:
 //   id, type, size, full, count, seqNo,
-//   inCount, inBytes, outCount, outBytes
+//   inCount, inBytes, outCount, outBytes, steals, dropped
 using Queue_ = ZvQueueTelemetry;
 struct Queue : public Queue_ {
   Queue() = default;
@@ -274,6 +289,8 @@ ZfbFieldTbl(Queue,
     (((inBytes),	(Ctor<4>, Mutable, Series, Delta)),	(UInt64)),
     (((outCount),	(Ctor<5>, Mutable, Series, Delta)),	(UInt64)),
     (((outBytes),	(Ctor<6>, Mutable, Series, Delta)),	(UInt64)),
+    (((steals),		(Ctor<10>, Mutable, Series, Delta)),	(UInt64)),
+    (((dropped),	(Ctor<11>, Mutable, Series, Delta)),	(UInt64)),
     (((rag, RdFn),	(Synthetic, Series, Enum<RAG::Map>)),	(Int8)));
 
 // display sequence:
@@ -333,6 +350,7 @@ ZfbFieldTbl(Engine,
 //   path, warmup,
 //   count,
 //   cacheMode, cacheSize, cacheLoads, cacheMisses,
+//   writeQueue, writes, writesCoalesced, writeBatches,
 //   thread
 struct DBTable {
   using Name = ZuStringN<28>;
@@ -347,6 +365,10 @@ struct DBTable {
   uint32_t		cacheSize = 0;
   int8_t		cacheMode = -1;			// CacheMode
   bool			warmup = 0;
+  uint32_t		writeQueue = 0;			// dynamic
+  uint64_t		writes = 0;			// dynamic (*)
+  uint64_t		writesCoalesced = 0;		// dynamic (*)
+  uint64_t		writeBatches = 0;		// dynamic (*)
 
   int8_t rag() const {
     unsigned total = cacheLoads + cacheMisses;
@@ -370,6 +392,10 @@ ZfbFieldTbl(DBTable,
     (((cacheEvictions),	(Ctor<5>, Mutable, Series, Delta)),	(UInt64)),
     (((shards),		(Ctor<1>)),				(UInt32)),
     (((thread),		(Ctor<2>)),				(StringVec)),
+    (((writeQueue),	(Ctor<10>, Mutable, Series)),		(UInt32)),
+    (((writes),		(Ctor<11>, Mutable, Series, Delta)),	(UInt64)),
+    (((writesCoalesced), (Ctor<12>, Mutable, Series, Delta)),	(UInt64)),
+    (((writeBatches),	(Ctor<13>, Mutable, Series, Delta)),	(UInt64)),
     (((rag, RdFn),	(Synthetic, Series, Enum<RAG::Map>)),	(Int8)));
 
 // display sequence:
@@ -398,6 +424,7 @@ ZfbFieldTbl(DBHost,
 
 // display sequence: 
 //   self, leader, prev, next, state, active, recovering, replicating,
+//   recovered, recoveryRate,
 //   nDBs, nHosts, nPeers, nCxns,
 //   thread,
 //   heartbeatFreq, heartbeatTimeout, reconnectFreq, electionTimeout
@@ -419,6 +446,8 @@ struct DB {
   uint8_t	active = 0;
   uint8_t	recovering = 0;
   uint8_t	replicating = 0;
+  uint64_t	recovered = 0;		// records sent in recovery
+  uint64_t	recoveryRate = 0;	// records/sec
 
   int8_t rag() const { return DBHostState::rag(state); }
   void rag(int8_t) { } // unused
@@ -434,6 +463,8 @@ ZfbFieldTbl(DB,
     (((active),		(Ctor<15>, Mutable)),			(UInt8)),
     (((recovering),	(Ctor<16>, Mutable)),			(UInt8)),
     (((replicating),	(Ctor<17>, Mutable)),			(UInt8)),
+    (((recovered),	(Ctor<18>, Mutable, Series)),		(UInt64)),
+    (((recoveryRate),	(Ctor<19>, Mutable, Series)),		(UInt64)),
     (((nTables),	(Ctor<11>)),				(UInt16)),
     (((nHosts),		(Ctor<12>)),				(UInt8)),
     (((nPeers),		(Ctor<13>)),				(UInt8)),
@@ -482,20 +513,39 @@ ZfbFieldTbl(Alert,
     (((severity),	(Ctor<3>, Enum<Severity::Map>)),	(Int8)),
     (((message),	(Ctor<4>)),				(String)));
 
+using Histogram_ = ZmHistogramTelemetry;
+struct Histogram : public Histogram_ {
+  Histogram() = default;
+  template <typename ...Args>
+  Histogram(Args &&...args) : Histogram_{ZuFwd<Args>(args)...} { }
+
+  friend ZtFieldPrint ZuPrintType(Histogram *);
+};
+ZfbFieldTbl(Histogram,
+    (((id),		(Ctor<0>, Keys<0>)),			(String)),
+    (((count),		(Ctor<1>, Mutable, Series, Delta)),	(UInt64)),
+    (((min),		(Ctor<2>, Mutable, Series)),		(UInt64)),
+    (((mean),		(Ctor<4>, Mutable, Series)),		(UInt64)),
+    (((p50),		(Ctor<5>, Mutable, Series)),		(UInt64)),
+    (((p90),		(Ctor<6>, Mutable, Series)),		(UInt64)),
+    (((p99),		(Ctor<7>, Mutable, Series)),		(UInt64)),
+    (((p999),		(Ctor<8>, Mutable, Series)),		(UInt64)),
+    (((max),		(Ctor<3>, Mutable, Series)),		(UInt64)));
+
 namespace ReqType {
   ZfbEnumValues(ReqType,
-      Heap, HashTbl, Thread, Mx, Queue, Engine, DB, App, Alert);
+      Heap, HashTbl, Thread, Mx, Queue, Engine, DB, App, Alert, Histogram);
 }
 
 namespace TelData {
   ZfbEnumUnion(TelData,
       Heap, HashTbl, Thread, Mx, Socket, Queue, Engine, Link,
-      DBTable, DBHost, DB, App, Alert);
+      DBTable, DBHost, DB, App, Alert, Histogram);
 }
 
 using TypeList = ZuTypeList<
   Heap, HashTbl, Thread, Mx, Socket, Queue, Engine, Link,
-  DBTable, DBHost, DB, App, Alert>;
+  DBTable, DBHost, DB, App, Alert, Histogram>;
 
 } // Ztel
 
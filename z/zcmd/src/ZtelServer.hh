@@ -288,6 +288,7 @@ public:
       case ReqType::DB:		dbQuery(ZuMv(link), req, interval); break;
       case ReqType::App:	appQuery(ZuMv(link), req, interval); break;
       case ReqType::Alert:	alertQuery(ZuMv(link), req, interval); break;
+      case ReqType::Histogram:	histQuery(ZuMv(link), req, interval); break;
       default: break;
     }
   }
@@ -384,6 +385,9 @@ private:
 	case int(fbs::ReqType::Alert):
 	  reschedule(list, [](Server *server) { server->alertScan(); });
 	  break;
+	case int(fbs::ReqType::Histogram):
+	  reschedule(list, [](Server *server) { server->histScan(); });
+	  break;
       }
     }
   }
@@ -586,6 +590,54 @@ private:
     }
   }
 
+  // histogram processing
+
+  void histQuery(
+    ZmRef<Link> link, const fbs::Request *req, unsigned interval)
+  {
+    auto &list = m_watchLists[ReqType::Histogram];
+    if (interval && !req->subscribe()) {
+      unsubscribe(list, ZuMv(link), Zfb::Load::str(req->filter()));
+      return;
+    }
+    auto watch = new Watch{ZuMv(link), Zfb::Load::str(req->filter())};
+    if (interval)
+      this->subscribe<[](Server *server) { server->histScan(); }>(
+	  list, watch, interval);
+    ZmHistogramMgr::all(ZmFn<void(ZmHistogram *)>{
+      watch, [](Watch *watch, ZmHistogram *hist) {
+	watch->link->app()->histQuery_(watch, hist);
+      }});
+    if (!interval) delete watch;
+  }
+  void histQuery_(Watch *watch, const ZmHistogram *hist) {
+    Histogram data;
+    hist->telemetry(data);
+    if (!match(watch->filter, data.id)) return;
+    m_fbb.Finish(fbs::CreateTelemetry(m_fbb,
+	  fbs::TelData::Histogram, ZfbField::save(m_fbb, data).Union()));
+    watch->link->sendTelemetry(m_fbb.buf());
+  }
+
+  void histScan() {
+    if (!m_watchLists[ReqType::Histogram].list.count_()) return;
+    ZmHistogramMgr::all(ZmFn<void(ZmHistogram *)>{
+      this, [](Server *server, ZmHistogram *hist) {
+	server->histScan(hist);
+      }});
+  }
+  void histScan(const ZmHistogram *hist) {
+    Histogram data;
+    hist->telemetry(data);
+    auto i = m_watchLists[ReqType::Histogram].list.readIterator();
+    while (auto watch = i.iterate()) {
+      if (!match(watch->filter, data.id)) continue;
+      m_fbb.Finish(fbs::CreateTelemetry(m_fbb,
+	    fbs::TelData::Histogram, ZfbField::saveUpd(m_fbb, data).Union()));
+      watch->link->sendTelemetry(m_fbb.buf());
+    }
+  }
+
   // hash table processing
 
   void hashQuery(
@@ -742,6 +794,22 @@ private:
 		  fbs::QueueType::Thread).Union()));
 	  watch->link->sendTelemetry(m_fbb.buf());
 	}
+	if (!mx->params().stealing() ||
+	    mx->params().thread(tid).isolated()) continue;
+	queueID[queueID.length() - 1] = '~';
+	{
+	  const auto &stealRing = mx->stealRing(tid);
+	  stealRing.stats(inCount, outCount);
+	  m_fbb.Finish(fbs::CreateTelemetry(m_fbb,
+		fbs::TelData::Queue,
+		fbs::CreateQueue(m_fbb,
+		  str(m_fbb, queueID), 0, stealRing.count_(),
+		  inCount, inCount * sizeof(ZmFn<>),
+		  outCount, outCount * sizeof(ZmFn<>),
+		  stealRing.size_(), false,
+		  fbs::QueueType::Thread, mx->steals(tid)).Union()));
+	  watch->link->sendTelemetry(m_fbb.buf());
+	}
       }
     }
     mx->allCxns([this, watch](ZiConnection *cxn) {
@@ -808,6 +876,26 @@ private:
 		  fbs::TelData::Queue, b.Finish().Union()));
 	    watch->link->sendTelemetry(m_fbb.buf());
 	  }
+	  if (!mx->params().stealing() ||
+	      mx->params().thread(tid).isolated()) continue;
+	  queueID[queueID.length() - 1] = '~';
+	  {
+	    const auto &stealRing = mx->stealRing(tid);
+	    stealRing.stats(inCount, outCount);
+	    auto id_ = Zfb::Save::str(m_fbb, queueID);
+	    fbs::QueueBuilder b(m_fbb);
+	    b.add_id(id_);
+	    b.add_count(stealRing.count_());
+	    b.add_inCount(inCount);
+	    b.add_inBytes(inCount * sizeof(ZmFn<>));
+	    b.add_outCount(outCount);
+	    b.add_outBytes(outCount * sizeof(ZmFn<>));
+	    b.add_full(0);
+	    b.add_steals(mx->steals(tid));
+	    m_fbb.Finish(fbs::CreateTelemetry(m_fbb,
+		  fbs::TelData::Queue, b.Finish().Union()));
+	    watch->link->sendTelemetry(m_fbb.buf());
+	  }
 	}
       }
       mx->allCxns([this, watch](ZiConnection *cxn) {
@@ -850,6 +938,7 @@ private:
 	  list, watch, interval);
     auto i = m_queues.readIterator();
     while (auto node = i.iterate()) queueQuery_(watch, node->val());
+    logQueueQuery_(watch);
     if (!interval) delete watch;
   }
   void queueQuery_(Watch *watch, const QueueFn &fn) {
@@ -864,6 +953,7 @@ private:
     if (!m_watchLists[ReqType::Queue].list.count_()) return;
     auto i = m_queues.readIterator();
     while (auto node = i.iterate()) queueScan(node->val());
+    logQueueScan();
   }
   void queueScan(const QueueFn &fn) {
     Queue data;
@@ -877,6 +967,56 @@ private:
     }
   }
 
+  // per-thread logger ring buffers (see ZeLog::threadBufSize())
+  static void logQueueID(ZmIDString &queueID, const ZeLogThreadBuf *buf) {
+    queueID << "log." << buf->name();
+  }
+  void logQueueQuery_(Watch *watch) {
+    using namespace Zfb::Save;
+    ZeLog::allThreadBufs([this, watch](const ZeLogThreadBuf *buf) {
+      ZmIDString queueID;
+      logQueueID(queueID, buf);
+      if (!matchQueue(watch->filter, ZvQueueType::Thread, queueID)) return;
+      const auto &ring = buf->ring();
+      uint64_t inCount, inBytes, outCount, outBytes;
+      ring.stats(inCount, inBytes, outCount, outBytes);
+      m_fbb.Finish(fbs::CreateTelemetry(m_fbb,
+	    fbs::TelData::Queue,
+	    fbs::CreateQueue(m_fbb,
+	      str(m_fbb, queueID), 0, ring.count_(),
+	      inCount, inBytes, outCount, outBytes,
+	      ring.params().size, ring.full(),
+	      fbs::QueueType::Thread, 0, buf->dropped()).Union()));
+      watch->link->sendTelemetry(m_fbb.buf());
+    });
+  }
+  void logQueueScan() {
+    ZeLog::allThreadBufs([this](const ZeLogThreadBuf *buf) {
+      ZmIDString queueID;
+      logQueueID(queueID, buf);
+      const auto &ring = buf->ring();
+      uint64_t inCount, inBytes, outCount, outBytes;
+      ring.stats(inCount, inBytes, outCount, outBytes);
+      auto i = m_watchLists[ReqType::Queue].list.readIterator();
+      while (auto watch = i.iterate()) {
+	if (!matchQueue(watch->filter, ZvQueueType::Thread, queueID)) continue;
+	auto id_ = Zfb::Save::str(m_fbb, queueID);
+	fbs::QueueBuilder b(m_fbb);
+	b.add_id(id_);
+	b.add_count(ring.count_());
+	b.add_inCount(inCount);
+	b.add_inBytes(inBytes);
+	b.add_outCount(outCount);
+	b.add_outBytes(outBytes);
+	b.add_full(ring.full());
+	b.add_dropped(buf->dropped());
+	m_fbb.Finish(fbs::CreateTelemetry(m_fbb,
+	      fbs::TelData::Queue, b.Finish().Union()));
+	watch->link->sendTelemetry(m_fbb.buf());
+      }
+    });
+  }
+
   // engine processing
 
   void engineQuery(
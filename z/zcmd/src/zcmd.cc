@@ -582,7 +582,8 @@ private:
 	"telemetry capture",
 	"Usage: telcap [OPTION]... PATH [TYPE[:FILTER]]...\n\n"
 	"  PATH\t\tdirectory for capture CSV files\n"
-	"  TYPE\t\t[Heap|HashTbl|Thread|Mx|Queue|Engine|DB|App|Alert]\n"
+	"  TYPE\t\t[Heap|HashTbl|Thread|Mx|Queue|Engine|DB|App|Alert|"
+	  "Histogram]\n"
 	"  FILTER\tfilter specification in type-specific format\n\n"
 	"Options:\n"
 	"  -i, --interval=N\tset scan interval in milliseconds "
@@ -1364,6 +1365,11 @@ private:
 		TelCap::alertFn<Alert>(
 		    ZiFile::append(dir, "alert.csv"));
 	      break;
+	    case ReqType::Histogram:
+	      m_telcap[TelData::Histogram - TelData::MIN] =
+		TelCap::keyedFn<Histogram>(
+		    ZiFile::append(dir, "histogram.csv"));
+	      break;
 	  }
 	} catch (const ZvError &e) {
 	  out << e << '\n';
@@ -638,6 +638,8 @@ DB::telemetry(Zfb::Builder &fbb_, bool update) const
   fbb.add_active(state == HostState::Active);
   fbb.add_recovering(m_recovering);
   fbb.add_replicating(Host::replicating(m_next));
+  fbb.add_recovered(m_recovered.load_());
+  fbb.add_recoveryRate(recoveryRate());
   return fbb.Finish().Union();
 }
 
@@ -1040,17 +1042,19 @@ void DB::repStart()
 
   m_recover = m_next->dbState();
   m_recoverEnd = m_self->dbState();
+  m_recStart = Zm::now();
+  m_recBase = m_recovered.load_();
   if (ZmRef<Cxn> cxn = m_next->cxn()) {
     auto i = m_recover.readIterator();
     while (auto state = i.iterate()) {
       auto key = state->p<0>();
       if (auto endState = m_recoverEnd.find(key))
 	if (auto table = m_tables.findVal(key.p<0>())) {
-	  ++m_recovering;
 	  auto shard = key.p<1>();
 	  auto un = state->p<1>();
 	  auto endUN = endState->p<1>();
 	  if (endUN <= un) continue;
+	  ++m_recovering;
 	  table->run(shard, [table, cxn, shard, un, endUN]() mutable {
 	    table->recSend(ZuMv(cxn), shard, un, endUN);
 	  });
@@ -1059,63 +1063,194 @@ void DB::repStart()
   }
 }
 
-// send recovery record
+// outbound recovery of a shard
+// - records are recovered from the backing data store in batches of
+//   recBatch UNs, with up to recWindow batches in flight
+// - cached records are captured when the batch is fetched, since they
+//   may be evicted (once committed to the data store) before it is sent
+// - completed batches are merged with the captured records and sent in
+//   UN order, each as one or more RecoveryBatch messages of at most
+//   recBatchSize bytes (or a single record)
+struct AnyTable::RecBatch : public ZmObject {
+  UN				un;
+  UN				endUN;
+  ZtArray<ZmRef<const IOBuf>>	bufs;	// recovered from data store
+  ZtArray<ZmRef<const IOBuf>>	cached;	// captured from caches
+
+  RecBatch(UN un_, UN endUN_) : un{un_}, endUN{endUN_} { }
+};
+struct AnyTable::RecState : public ZmObject {
+  ZmRef<Cxn>			cxn;
+  unsigned			shard;
+  UN				un;		// next UN to recover
+  UN				endUN;
+  UN				head = 0;	// next batch to send
+  UN				tail = 0;	// next batch to recover
+  ZtArray<ZmRef<RecBatch>>	batches;	// ring of recovered batches
+
+  RecState(ZmRef<Cxn> cxn_, unsigned shard_, UN un_, UN endUN_,
+      unsigned window) :
+      cxn{ZuMv(cxn_)}, shard{shard_}, un{un_}, endUN{endUN_} {
+    batches.length(window);
+  }
+};
+
 void AnyTable::recSend(ZmRef<Cxn> cxn, unsigned shard, UN un, UN endUN)
 {
   ZmAssert(invoked(shard));
 
   if (!m_open) return;
 
-  if (!cxn->up()) return;
+  recFetch(new RecState{
+    ZuMv(cxn), shard, un, endUN, m_db->config().recWindow});
+}
 
-  if (auto buf = mkBuf(shard, un)) {
-    recSend_(ZuMv(cxn), shard, un, endUN, ZuMv(buf));
-    return;
-  }
+void AnyTable::recFetch(ZmRef<RecState> state)
+{
+  unsigned shard = state->shard;
+
+  ZmAssert(invoked(shard));
 
-  m_storeTbl->recover(shard, un, [
-    this, cxn = ZuMv(cxn), shard, un, endUN
-  ](RowResult result) mutable {
-    if (ZuLikely(result.is<RowData>())) {
-      ZmRef<const IOBuf> buf = result.p<RowData>().buf;
-      run(shard, [this, cxn = ZuMv(cxn), shard, un, endUN, buf = ZuMv(buf)]() mutable {
-	recSend_(ZuMv(cxn), shard, un, endUN, ZuMv(buf));
+  if (!m_open) return;
+
+  if (!state->cxn->up()) return;
+
+  const auto &config = m_db->config();
+  unsigned window = config.recWindow;
+
+  for (;;) {
+    // fill the window
+    while (state->tail - state->head < window && state->un < state->endUN) {
+      UN un = state->un;
+      UN endUN = un + config.recBatch;
+      if (endUN > state->endUN) endUN = state->endUN;
+      state->un = endUN;
+      UN seqNo = state->tail++;
+      ZmRef<RecBatch> batch = new RecBatch{un, endUN};
+      // skip the data store if the entire batch is cached
+      {
+	bool complete = true;
+	for (UN i = un; i < endUN; i++)
+	  if (auto buf = mkBuf(shard, i))
+	    batch->cached.push(ZuMv(buf));
+	  else
+	    complete = false;
+	if (complete) {
+	  state->batches[seqNo % window] = ZuMv(batch);
+	  continue;
+	}
+      }
+      m_storeTbl->recoverN(shard, un, endUN, [
+	this, state, seqNo, batch
+      ](RowResult result) mutable {
+	if (ZuLikely(result.is<RowData>())) {
+	  batch->bufs.push(ZuMv(result).p<RowData>().buf);
+	  return;
+	}
+	if (ZuUnlikely(result.is<Event>())) {
+	  ZeLogEvent(ZuMv(result).p<Event>());
+	  ZeLOG(Error, ([
+	    id = this->id(), shard = state->shard,
+	    un = batch->un, endUN = batch->endUN
+	  ](auto &s) {
+	    s << "Zdb recovery of " << id << '/' << shard << '/'
+	      << un << '-' << (endUN - 1) << " failed";
+	  }));
+	}
+	// missing is not an error, skip over updated/deleted records
+	run(state->shard, [this, state, seqNo, batch]() mutable {
+	  recFetched(ZuMv(state), seqNo, ZuMv(batch));
+	});
       });
-      return;
     }
-    if (ZuUnlikely(result.is<Event>())) {
-      ZeLogEvent(ZuMv(result).p<Event>());
-      ZeLOG(Error, ([id = this->id(), shard, un](auto &s) {
-	s << "Zdb recovery of " << id << '/' << shard << '/' << un << " failed";
-      }));
+
+    // send completed batches in order
+    bool sent = false;
+    while (state->head < state->tail) {
+      auto &batch = state->batches[state->head % window];
+      if (!batch) break;
+      recSend_(state, batch);
+      batch = nullptr;
+      ++state->head;
+      sent = true;
     }
-    // missing is not an error, skip over updated/deleted records
-    run(shard, [this, cxn = ZuMv(cxn), shard, un, endUN]() mutable {
-      recNext(ZuMv(cxn), shard, un, endUN);
-    });
-  });
+    if (!sent) break;
+  }
+
+  if (state->head == state->tail && state->un >= state->endUN)
+    m_db->invoke([db = m_db]() { db->recEnd(); });
 }
 
-void AnyTable::recSend_(
-  ZmRef<Cxn> cxn, unsigned shard, UN un, UN endUN, ZmRef<const IOBuf> buf)
+void AnyTable::recFetched(
+  ZmRef<RecState> state, UN seqNo, ZmRef<RecBatch> batch)
 {
-  cxn->send(ZuMv(buf));
-  recNext(ZuMv(cxn), shard, un, endUN);
+  state->batches[seqNo % state->batches.length()] = ZuMv(batch);
+  recFetch(ZuMv(state));
 }
 
-void AnyTable::recNext(ZmRef<Cxn> cxn, unsigned shard, UN un, UN endUN)
+void AnyTable::recSend_(RecState *state, RecBatch *batch)
 {
-  if (++un < endUN)
-    run(shard, [this, cxn = ZuMv(cxn), shard, un, endUN]() mutable {
-      recSend(ZuMv(cxn), shard, un, endUN);
-    });
-  else
-    m_db->invoke([db = m_db]() { db->recEnd(); });
+  // merge rows recovered from the data store with the captured records,
+  // which may since have been committed and also recovered
+  ZtArray<ZmRef<const IOBuf>> bufs(batch->endUN - batch->un);
+  {
+    auto un = [](const IOBuf *buf) { return record_(msg_(buf->hdr()))->un(); };
+    const auto &recovered = batch->bufs;
+    const auto &cached = batch->cached;
+    unsigned i = 0, n = recovered.length();
+    unsigned j = 0, m = cached.length();
+    while (i < n || j < m) {
+      if (j >= m || (i < n && un(recovered[i]) < un(cached[j]))) {
+	bufs.push(recovered[i++]);
+	continue;
+      }
+      if (i < n && un(recovered[i]) == un(cached[j])) ++i;
+      bufs.push(cached[j++]);
+    }
+  }
+  unsigned n = bufs.length();
+  if (!n) return;
+
+  unsigned maxSize = m_db->config().recBatchSize;
+  for (unsigned i = 0; i < n; ) {
+    unsigned j = i, size = bufs[j]->length;
+    while (++j < n && size + bufs[j]->length <= maxSize)
+      size += bufs[j]->length;
+    Zfb::IOBuilder fbb{allocBuf()};
+    {
+      auto records = Zfb::Save::vectorIter<fbs::Record>(fbb, j - i,
+	[&bufs, i](auto &fbb, unsigned k) {
+	  return copyRecord(fbb, record_(msg_(bufs[i + k]->hdr())));
+	});
+      auto msg = fbs::CreateMsg(fbb, fbs::Body::RecoveryBatch,
+	  fbs::CreateRecordBatch(fbb, records).Union());
+      fbb.Finish(msg);
+    }
+    state->cxn->send(saveHdr(fbb, this).constRef());
+    i = j;
+  }
+  m_db->recovered(n);
 }
 
 void DB::recEnd()
 {
-  if (m_recovering) --m_recovering;
+  if (!m_recovering || --m_recovering) return;
+  double elapsed = (Zm::now() - m_recStart).as_fp();
+  uint64_t n = m_recovered.load_() - m_recBase;
+  m_recRate = elapsed > 0.0 ? uint64_t(double(n) / elapsed) : uint64_t(0);
+  ZeLOG(Info, ([n, elapsed, rate = m_recRate](auto &s) {
+    s << "Zdb recovery sent " << n << " records in "
+      << ZuBoxed(elapsed).fmt<ZuFmt::FP<3>>() << "s ("
+      << rate << " records/sec)";
+  }));
+}
+
+uint64_t DB::recoveryRate() const
+{
+  if (!m_recovering) return m_recRate;
+  double elapsed = (Zm::now() - m_recStart).as_fp();
+  if (elapsed <= 0.0) return 0;
+  return double(m_recovered.load_() - m_recBase) / elapsed;
 }
 
 // build replication buffer
@@ -1128,19 +1263,10 @@ ZmRef<const IOBuf> AnyTable::mkBuf(unsigned shard, UN un)
   // build from outbound replication buffer cache
   if (auto buf = findBufUN(shard, un)) {
     auto record = record_(msg_(buf->hdr()));
-    auto repData = Zfb::Load::bytes(record->data());
-    Zfb::IOBuilder fbb{allocBuf()};
-    Zfb::Offset<Zfb::Vector<uint8_t>> data;
-    if (repData) {
-      uint8_t *ptr;
-      data = Zfb::Save::pvector_(fbb, repData.length(), ptr);
-      if (!data.IsNull() && ptr)
-	memcpy(ptr, repData.data(), repData.length());
-    }
     ZmAssert(record->shard() == shard);
+    Zfb::IOBuilder fbb{allocBuf()};
     auto msg = fbs::CreateMsg(fbb, fbs::Body::Recovery,
-	fbs::CreateRecord(fbb, record->table(), record->un(),
-	  record->sn(), record->vn(), shard, data).Union());
+	copyRecord(fbb, record).Union());
     fbb.Finish(msg);
     return saveHdr(fbb, this).constRef();
   }
@@ -1226,6 +1352,7 @@ int Cxn_::msgRead2(ZmRef<IOBuf> buf)
       case fbs::Body::Replication:
       case fbs::Body::Recovery:
       case fbs::Body::Commit:
+      case fbs::Body::RecoveryBatch:
 	if (ZuLikely(buf->length))
 	  m_db->run([cxn = ZmMkRef(this), buf = ZuMv(buf)]() mutable {
 	    cxn->msgRead3(ZuMv(buf));
@@ -1261,6 +1388,9 @@ void Cxn_::msgRead3(ZmRef<IOBuf> buf)
     case fbs::Body::Commit:
       repCommitRcvd(ZuMv(buf).constRef());
       break;
+    case fbs::Body::RecoveryBatch:
+      repBatchRcvd(ZuMv(buf).constRef());
+      break;
     default:
       break;
   }
@@ -1445,6 +1575,56 @@ void Cxn_::repRecordRcvd(ZmRef<const IOBuf> buf)
   });
 }
 
+// process received recovery batch
+// - the batch is split into individual recovery messages, which are
+//   then processed as if they had been received one at a time
+void Cxn_::repBatchRcvd(ZmRef<const IOBuf> buf)
+{
+  ZmAssert(m_db->invoked());
+
+  if (!m_host) return;
+  if (m_db->repStore()) return; // backing data store is replicated
+  auto batch = Zdb_::batch(msg_(buf->hdr())); // caller verified msg
+  if (!batch) return;
+  auto records = batch->records();
+  if (!records || !records->size()) return;
+  ZuID id;
+  unsigned shard;
+  {
+    auto record = records->Get(0);
+    id = Zfb::Load::id(record->table());
+    shard = record->shard();
+  }
+  ZmRef<AnyTable> table = m_db->table(id);
+  if (ZuUnlikely(!table)) return;
+
+  ZdbDEBUG(m_db, (ZtString{}
+    << "repBatchRcvd(host=" << m_host->id() << ", " << id << '/' << shard
+    << ", n=" << records->size() << ')'));
+
+  ZtArray<ZmRef<const IOBuf>> bufs(records->size());
+  const fbs::Record *last = nullptr;
+  Zfb::Load::all(records,
+    [&id, shard, &table, &bufs, &last](unsigned, const fbs::Record *record) {
+      // all records in a batch are from the same table and shard
+      if (Zfb::Load::id(record->table()) != id ||
+	  record->shard() != shard) return;
+      Zfb::IOBuilder fbb{table->allocBuf()};
+      auto msg = fbs::CreateMsg(fbb, fbs::Body::Recovery,
+	  copyRecord(fbb, record).Union());
+      fbb.Finish(msg);
+      bufs.push(saveHdr(fbb, table.ptr()).constRef());
+      last = record;
+    });
+  if (!last) return;
+
+  m_db->replicated(
+      m_host, id, shard, last->un(), Zfb::Load::uint128(last->sn()));
+  table->invoke(shard, [table, shard, bufs = ZuMv(bufs)]() mutable {
+    table->repBatchRcvd(shard, ZuMv(bufs));
+  });
+}
+
 // process received replication commit
 void Cxn_::repCommitRcvd(ZmRef<const IOBuf> buf)
 {
@@ -1488,6 +1668,7 @@ AnyTable::AnyTable(DB *db, TableCf *cf, IOBufAllocFn fn) :
   m_nextUN.length(n);
   m_cacheUN.length(n);
   m_bufCacheUN.length(n);
+  m_writeQueue.length(n);
   for (unsigned i = 0; i < n; i++) {
     m_nextUN[i] = 0;
     m_cacheUN[i] = new CacheUN{};
@@ -1526,6 +1707,15 @@ AnyTable::telemetry(Zfb::Builder &fbb_, bool update) const
     cacheMisses += stats.misses;
     cacheEvictions += stats.evictions;
   }
+  unsigned writeQueue = 0;
+  uint64_t writes = 0, writesCoalesced = 0, writeBatches = 0;
+  for (unsigned i = 0, n = config().nShards; i < n; i++) {
+    const auto &queue = m_writeQueue[i];
+    writeQueue += queue.depth.load_();
+    writes += queue.writes.load_();
+    writesCoalesced += queue.coalesced.load_();
+    writeBatches += queue.batches.load_();
+  }
   Ztel::fbs::DBTableBuilder fbb{fbb_};
   if (!update) {
     fbb.add_name(name);
@@ -1536,6 +1726,10 @@ AnyTable::telemetry(Zfb::Builder &fbb_, bool update) const
   fbb.add_cacheLoads(cacheLoads);
   fbb.add_cacheMisses(cacheMisses);
   fbb.add_cacheEvictions(cacheEvictions);
+  fbb.add_writeQueue(writeQueue);
+  fbb.add_writes(writes);
+  fbb.add_writesCoalesced(writesCoalesced);
+  fbb.add_writeBatches(writeBatches);
   if (!update) {
     fbb.add_cacheSize(cacheSize);
     fbb.add_cacheMode(static_cast<Ztel::fbs::DBCacheMode>(config().cacheMode));
@@ -1555,6 +1749,19 @@ void AnyTable::repRecordRcvd(unsigned shard, ZmRef<const IOBuf> buf)
   write(shard, buf, false);
 }
 
+// process inbound recovery - batch
+void AnyTable::repBatchRcvd(unsigned shard, ZtArray<ZmRef<const IOBuf>> bufs)
+{
+  ZmAssert(invoked(shard));
+
+  if (!m_open) return;
+
+  for (unsigned i = 0, n = bufs.length(); i < n; i++) {
+    recover(shard, record_(msg_(bufs[i]->hdr())));
+    write(shard, ZuMv(bufs[i]), false);
+  }
+}
+
 // process inbound replication - committed
 void AnyTable::repCommitRcvd(unsigned shard, UN un)
 {
@@ -1579,6 +1786,7 @@ void AnyTable::write(unsigned shard, ZmRef<const IOBuf> buf, bool active)
 {
   ZmAssert(invoked(shard));
 
+  if (config().memIndex) objIndex(buf.ptr());
   cacheBuf(shard, buf);
   auto db = this->db();
   if (ZuLikely(active) || !db->repStore()) {
@@ -1608,27 +1816,128 @@ void AnyTable::store(unsigned shard, ZmRef<const IOBuf> buf)
 }
 void AnyTable::store_(unsigned shard, ZmRef<const IOBuf> buf)
 {
-  m_storeTbl->write(ZuMv(buf), [
-    this, shard
-  ](ZmRef<const IOBuf> buf, CommitResult result) {
-    if (ZuUnlikely(result.is<Event>())) {
-      ZeLogEvent(ZuMv(result).p<Event>());
-      auto un = record_(msg_(buf->hdr()))->un();
-      ZeLOG(Fatal, ([id = this->id(), shard, un](auto &s) {
-	s << "Zdb store of " << id << '/' << shard << '/' << un << " failed";
-      }));
-      auto db = this->db();
-      db->invoke([db]() { db->fail(); }); // trigger failover
-      return;
+  auto &queue = m_writeQueue[shard];
+  unsigned i = queue.entries.length();
+  ZtArray<UN> superseded;
+  {
+    auto msg = msg_(buf->hdr());
+    if (msg->body_type() == fbs::Body::Replication && record_(msg)->vn()) {
+      int j = writeIndex(shard, buf.ptr(), i);
+      if (j >= 0) {
+	auto &prev = queue.entries[j];
+	auto record = record_(msg_(prev.buf->hdr()));
+	// only a pending update is superseded - inserts and deletes
+	// must always reach the data store
+	if (record->vn() > 0) {
+	  superseded = ZuMv(prev.superseded);
+	  superseded.push(record->un());
+	  prev.buf = nullptr;
+	  queue.coalesced.store_(queue.coalesced.load_() + 1);
+	}
+      }
     }
-    {
-      auto msg = msg_(buf->hdr());
-      bool recovery = msg->body_type() == fbs::Body::Recovery;
-      invoke(shard, [this, shard, un = record_(msg)->un(), recovery]() {
-	evictBuf(shard, un);
-	if (!recovery) commitSend(shard, un);
-      });
+  }
+  new (queue.entries.push()) WriteEntry{ZuMv(buf), ZuMv(superseded)};
+  queue.depth.store_(i + 1);
+  queue.writes.store_(queue.writes.load_() + 1);
+  // flush is enqueued behind any transactions already queued to the
+  // shard thread, which will be coalesced and batched with this write
+  if (!queue.scheduled) {
+    queue.scheduled = true;
+    run(shard, [this, shard]() { writeFlush(shard); });
+  }
+}
+
+// write batch - superseded UNs, indexed by superseding UN
+struct AnyTable::WriteBatch : public ZmObject {
+  using Superseded = ZuTuple<UN, ZtArray<UN>>;
+
+  ZtArray<Superseded>	superseded;	// in UN order
+
+  const ZtArray<UN> *find(UN un) const {
+    unsigned i = ZuSearch(&superseded[0], superseded.length(),
+      [un](const Superseded &v) { return ZuCmp<UN>::cmp(un, v.p<0>()); });
+    if (!ZuSearchFound(i)) return nullptr;
+    return &(superseded[ZuSearchPos(i)].p<1>());
+  }
+};
+
+void AnyTable::writeFlush(unsigned shard)
+{
+  auto &queue = m_writeQueue[shard];
+  queue.scheduled = false;
+  unsigned n = queue.entries.length();
+  if (!n) return;
+  writeIndexClean(shard);
+  if (ZuUnlikely(!m_storeTbl)) { // table is closed
+    queue.entries.clear();
+    queue.depth.store_(0);
+    return;
+  }
+  ZtArray<ZmRef<const IOBuf>> bufs;
+  bufs.size(n);
+  ZmRef<WriteBatch> batch;
+  for (unsigned i = 0; i < n; i++) {
+    auto &entry = queue.entries[i];
+    if (!entry.buf) continue;
+    if (!!entry.superseded) {
+      if (!batch) batch = new WriteBatch{};
+      new (batch->superseded.push()) WriteBatch::Superseded{
+	record_(msg_(entry.buf->hdr()))->un(), ZuMv(entry.superseded)};
     }
+    new (bufs.push()) ZmRef<const IOBuf>{ZuMv(entry.buf)};
+  }
+  queue.entries.clear();
+  queue.depth.store_(0);
+  queue.batches.store_(queue.batches.load_() + 1);
+  m_storeTbl->writeN(ZuMv(bufs), [
+    this, shard, batch = ZuMv(batch)
+  ](ZmRef<const IOBuf> buf, CommitResult result) {
+    committed(shard, ZuMv(buf), ZuMv(result), batch.ptr());
+  });
+}
+
+// flush write queues of all shards in turn, then call fn
+void AnyTable::writeFlushAll(unsigned shard, ZmFn<> fn)
+{
+  invoke(shard, [this, shard, fn = ZuMv(fn)]() mutable {
+    writeFlush(shard);
+    if (++shard < config().nShards)
+      writeFlushAll(shard, ZuMv(fn));
+    else
+      fn();
+  });
+}
+
+void AnyTable::committed(
+  unsigned shard, ZmRef<const IOBuf> buf, CommitResult result,
+  const WriteBatch *batch)
+{
+  if (ZuUnlikely(result.is<Event>())) {
+    ZeLogEvent(ZuMv(result).p<Event>());
+    auto un = record_(msg_(buf->hdr()))->un();
+    ZeLOG(Fatal, ([id = this->id(), shard, un](auto &s) {
+      s << "Zdb store of " << id << '/' << shard << '/' << un << " failed";
+    }));
+    auto db = this->db();
+    db->invoke([db]() { db->fail(); }); // trigger failover
+    return;
+  }
+  auto msg = msg_(buf->hdr());
+  bool recovery = msg->body_type() == fbs::Body::Recovery;
+  auto un = record_(msg)->un();
+  ZtArray<UN> superseded;
+  if (batch)
+    if (auto superseded_ = batch->find(un)) superseded = *superseded_;
+  invoke(shard, [
+    this, shard, un, recovery, superseded = ZuMv(superseded)
+  ]() {
+    for (unsigned i = 0, n = superseded.length(); i < n; i++) {
+      evictBuf(shard, superseded[i]);
+      commitSend(shard, superseded[i]);
+    }
+    evictBuf(shard, un);
+    if (!recovery) commitSend(shard, un);
   });
 }
 
@@ -1669,7 +1978,12 @@ void AnyTable::open(L l)
     objFields(), objKeyFields(), objSchema(), m_bufAllocFn,
     [this, l = ZuMv(l)](OpenResult result) mutable {
       invoke(0, [this, l = ZuMv(l), result = ZuMv(result)]() mutable {
-	l(opened(ZuMv(result)));
+	if (!opened(ZuMv(result)))
+	  l(false);
+	else if (!config().memIndex)
+	  l(true);
+	else
+	  objIndexLoad(ZmFn<void(bool)>{ZuMv(l)});
       });
     });
 }
@@ -1730,11 +2044,14 @@ void AnyTable::close(L l)
     return;
   }
 
-  m_storeTbl->close([this, l = ZuMv(l)]() mutable {
-    invoke(0, [this, l = ZuMv(l)]() mutable {
-      m_storeTbl = nullptr;
-      l();
-      m_open = 0;
+  // flush pending writes before closing the backing data store
+  writeFlushAll(0, [this, l = ZuMv(l)]() mutable {
+    m_storeTbl->close([this, l = ZuMv(l)]() mutable {
+      invoke(0, [this, l = ZuMv(l)]() mutable {
+	m_storeTbl = nullptr;
+	l();
+	m_open = 0;
+      });
     });
   });
 }
@@ -63,6 +63,8 @@
 #include <zlib/ZuHash.hh>
 #include <zlib/ZuPrint.hh>
 #include <zlib/ZuInt.hh>
+#include <zlib/ZuPtr.hh>
+#include <zlib/ZuSort.hh>
 
 #include <zlib/ZmAssert.hh>
 #include <zlib/ZmRef.hh>
@@ -73,6 +75,7 @@
 #include <zlib/ZmSemaphore.hh>
 #include <zlib/ZmEngine.hh>
 #include <zlib/ZmPolyCache.hh>
+#include <zlib/ZmRBTree.hh>
 #include <zlib/ZmPLock.hh>
 
 #include <zlib/ZtString.hh>
@@ -163,6 +166,7 @@ private:
   void hbSend();
 
   void repRecordRcvd(ZmRef<const IOBuf>);
+  void repBatchRcvd(ZmRef<const IOBuf>);
   void repCommitRcvd(ZmRef<const IOBuf>);
 
   DB			*m_db;
@@ -501,6 +505,7 @@ struct TableCf {
   mutable SIDArray	sid = 0;	// thread slot IDs
   int			cacheMode = CacheMode::Normal;
   bool			warmup = false;	// warm-up caches, backing store
+  bool			memIndex = false; // in-memory ordered key indices
 
   class InvalidNThreads : public ZvError {
   public:
@@ -535,6 +540,7 @@ struct TableCf {
     cacheMode = cf->getEnum<CacheMode::Map>(
 	"cacheMode", CacheMode::Normal);
     warmup = cf->getBool("warmup");
+    memIndex = cf->getBool("memIndex");
   }
 
   static ZuID IDAxor(const TableCf &cf) { return cf.id; }
@@ -655,6 +661,18 @@ protected:
   // cache statistics
   virtual void cacheStats(unsigned shard, ZmCacheStats &stats) const = 0;
 
+  // write queue - index a pending update/delete by primary key at
+  // position i, returning the position of the previous pending
+  // update/delete of the same object, -1 if none
+  virtual int writeIndex(unsigned shard, const IOBuf *buf, unsigned i) = 0;
+  // write queue - reset index when the queue is flushed
+  virtual void writeIndexClean(unsigned shard) = 0;
+
+  // in-memory indices - apply committed/replicated record
+  virtual void objIndex(const IOBuf *buf) = 0;
+  // in-memory indices - load from backing data store, then fn(ok)
+  virtual void objIndexLoad(ZmFn<void(bool)> fn) = 0;
+
 public:
   Zfb::Offset<void> telemetry(Zfb::Builder &fbb, bool update) const;
 
@@ -691,15 +709,44 @@ private:
   void store(unsigned shard, ZmRef<const IOBuf> buf);
   void store_(unsigned shard, ZmRef<const IOBuf> buf);
 
+  // write queue - pending writes to the backing data store are
+  // coalesced and handed to the data store in batches
+  // - a pending update is superseded by a subsequent update or delete
+  //   of the same object; the superseded UNs are committed together
+  //   with the superseding UN
+  struct WriteEntry {
+    ZmRef<const IOBuf>	buf;		// null if superseded
+    ZtArray<UN>		superseded;	// UNs superseded by buf
+  };
+  struct WriteQueue {
+    ZtArray<WriteEntry>	entries;
+    bool		scheduled = false;	// flush scheduled
+    // telemetry - SWMR
+    ZmAtomic<unsigned>	depth = 0;		// pending entries
+    ZmAtomic<uint64_t>	writes = 0;		// records enqueued
+    ZmAtomic<uint64_t>	coalesced = 0;		// records superseded
+    ZmAtomic<uint64_t>	batches = 0;		// batches written
+  };
+  struct WriteBatch;
+  void writeFlush(unsigned shard);
+  void writeFlushAll(unsigned shard, ZmFn<> fn);
+  void committed(
+    unsigned shard, ZmRef<const IOBuf> buf, CommitResult result,
+    const WriteBatch *batch);
+
   // outbound recovery / replication
+  struct RecBatch;
+  struct RecState;
   void recSend(ZmRef<Cxn> cxn, unsigned shard, UN un, UN endUN);
-  void recSend_(ZmRef<Cxn> cxn, unsigned shard, UN un, UN endUN, ZmRef<const IOBuf> buf);
-  void recNext(ZmRef<Cxn> cxn, unsigned shard, UN un, UN endUN);
+  void recFetch(ZmRef<RecState> state);
+  void recFetched(ZmRef<RecState> state, UN seqNo, ZmRef<RecBatch> batch);
+  void recSend_(RecState *state, RecBatch *batch);
   ZmRef<const IOBuf> mkBuf(unsigned shard, UN un);
   void commitSend(unsigned shard, UN un);
 
   // inbound replication
   void repRecordRcvd(unsigned shard, ZmRef<const IOBuf> buf);
+  void repBatchRcvd(unsigned shard, ZtArray<ZmRef<const IOBuf>> bufs);
   void repCommitRcvd(unsigned shard, UN un);
 
   // recovery - DB thread
@@ -740,6 +787,9 @@ private:
   using BufCacheUNArray = ZtArray<ZmRef<BufCacheUN>>;
   BufCacheUNArray	m_bufCacheUN;
 
+  // write queue (sharded)
+  ZtArray<WriteQueue>	m_writeQueue;
+
   // I/O buffer allocation
   IOBufAllocFn		m_bufAllocFn;
 };
@@ -887,6 +937,50 @@ struct SplitKey {
   using IsGroupKey = ZuBool<GroupFields::N>;
 };
 
+// --- in-memory ordered key indices
+
+// key with the number of significant leading fields - a group key
+// prefix (see SplitKey) is significant only up to the end of the group
+template <typename O, unsigned KeyID_>
+struct MemKey {
+  enum { KeyID = KeyID_ };
+  using Key = ZuFieldKeyT<O, KeyID>;
+  using Fields = ZuFields<Key>;
+  enum { N = Fields::N };
+
+  Key		key;
+  unsigned	n = N;
+};
+// comparator for ascending/descending keys, consistent with RDBMS
+// B-Tree indices and the in-memory data store; a prefix sorts before
+// all keys sharing that prefix
+template <typename MemKey_> struct MemKeyCmp {
+  using Fields = typename MemKey_::Fields;
+  template <typename Field>
+  using Descend = ZuTypeIn<
+    ZuUnsigned<MemKey_::KeyID>,
+    ZuSeqTL<ZuFieldProp::GetDescend<typename Field::Props>>>;
+
+  // compare the leading n fields
+  static int cmp(const MemKey_ &l, const MemKey_ &r, unsigned n) {
+    int i = 0;
+    ZuUnroll::all<MemKey_::N>([&l, &r, n, &i](auto I) {
+      if (i || I >= n) return;
+      using Field = ZuType<I, Fields>;
+      i = ZuCmp<typename Field::T>::cmp(Field::get(l.key), Field::get(r.key));
+      if constexpr (Descend<Field>{}) i = -i;
+    });
+    return i;
+  }
+  static int cmp(const MemKey_ &l, const MemKey_ &r) {
+    if (int i = cmp(l, r, l.n < r.n ? l.n : r.n)) return i;
+    return ZuCmp<unsigned>::cmp(l.n, r.n);
+  }
+  static bool equals(const MemKey_ &l, const MemKey_ &r) {
+    return !cmp(l, r);
+  }
+};
+
 // --- typed table
 
 template <typename T>
@@ -921,6 +1015,17 @@ public:
   Table(DB *db, TableCf *cf) : AnyTable{db, cf, Table::allocBuf} {
     m_cache.length(cf->nShards);
     m_bufCache.length(cf->nShards);
+    m_writeIndex.length(cf->nShards);
+    if (cf->memIndex) {
+      m_memIndices.length(cf->nShards);
+      m_memCounts.length(cf->nShards);
+      m_memPending.length(cf->nShards);
+      for (unsigned i = 0; i < cf->nShards; i++) {
+	m_memIndices[i] = new MemIndices{};
+	m_memCounts[i] = new MemCounts{};
+	m_memPending[i] = new MemPending{};
+      }
+    }
   }
   ~Table() = default;
 
@@ -1045,6 +1150,60 @@ private:
     m_cache[shard].stats(stats);
   }
 
+  // write queue index
+  int writeIndex(unsigned shard, const IOBuf *buf, unsigned i) {
+    auto record = record_(msg_(buf->hdr()));
+    auto fbo = ZfbField::verify<T>(Zfb::Load::bytes(record->data()));
+    if (ZuUnlikely(!fbo)) return -1;
+    Key<0> key = ZuFieldKey<0>(*fbo);
+    auto &index = m_writeIndex[shard];
+    int j = -1;
+    if (auto kv = index.find(key)) {
+      j = kv->template p<1>();
+      index.del(key);
+    }
+    index.add(ZuMv(key), i);
+    return j;
+  }
+  void writeIndexClean(unsigned shard) { m_writeIndex[shard].clean(); }
+
+  // in-memory indices
+  void objIndex(const IOBuf *buf);
+  void objIndexLoad(ZmFn<void(bool)> fn);
+  void memIndexApply(const IOBuf *buf);
+  void memIndexLoad(unsigned shard, ZmFn<void(bool)> fn);
+  void memIndexLoaded(unsigned shard);
+  template <typename Ctx, typename L, typename Done>
+  void memIndexAll(unsigned shard, Ctx ctx, L l, Done done);
+  template <unsigned KeyID>
+  static auto memGroupKey(const GroupKey<KeyID> &groupKey) {
+    MemKey<T, KeyID> key;
+    key.n = SplitKey<T, KeyID>::GroupFields::N;
+    ZuUnroll::all<SplitKey<T, KeyID>::GroupFields::N>(
+      [&key, &groupKey](auto I) {
+	key.key.template p<I>() = groupKey.template p<I>();
+      });
+    return key;
+  }
+  template <unsigned KeyID>
+  static auto memCountKey(const T &data) {
+    MemKey<T, KeyID> key{ZuFieldKey<KeyID>(data)};
+    key.n = SplitKey<T, KeyID>::GroupFields::N;
+    return key;
+  }
+  template <unsigned KeyID, typename MemCounts>
+  static void memCountAdj(MemCounts *counts, const T &data, bool inc);
+  template <unsigned KeyID, typename L>
+  void memCount(GroupKey<KeyID> groupKey, L l);
+  template <
+    unsigned KeyID,
+    typename SelectKey,
+    typename Tuple_,
+    bool SelectRow,
+    bool SelectNext,
+    typename L>
+  void memSelect(SelectKey selectKey, bool inclusive, unsigned limit, L l);
+
   // ameliorate cold start
   void warmup(unsigned shard) {
     // warmup heaps
@@ -1434,6 +1593,47 @@ private:
   // pending replications
   using BufCacheArray = ZtArray<BufCache<T>>;
   BufCacheArray			m_bufCache;
+
+  // write queue index - primary key -> queue position
+  using WriteIndex = ZmLHashKV<Key<0>, unsigned, ZmLHashLocal<>>;
+  using WriteIndexArray = ZtArray<WriteIndex>;
+  WriteIndexArray		m_writeIndex;
+
+  // in-memory ordered key indices (optional, see TableCf::memIndex)
+  // - each shard indexes a copy of each of its rows by every key
+  // - loaded on open, maintained from committed/replicated records
+  // - count() and select() queries are served from these indices
+  //   instead of the backing data store
+  struct MemRow : public ZmObject {
+    T		data;
+    UN		un;
+
+    MemRow(T data_, UN un_) : data{ZuMv(data_)}, un{un_} { }
+  };
+  template <typename KeyID>
+  using MemIndex =
+    ZmRBTreeKV<MemKey<T, KeyID{}>, ZmRef<MemRow>,
+      ZmRBTreeCmp<MemKeyCmp,
+	ZmRBTreeUnique<true>>>;
+  using MemIndices =
+    ZuTypeApply<ZuTuple, ZuTypeMap<MemIndex, ZuSeqTL<KeyIDs>>>;
+  using MemIndexArray = ZtArray<ZuPtr<MemIndices>>;
+  MemIndexArray			m_memIndices;
+  // row counts by group key, maintained with the indices
+  template <typename KeyID>
+  using MemCount =
+    ZmRBTreeKV<MemKey<T, KeyID{}>, uint64_t,
+      ZmRBTreeCmp<MemKeyCmp,
+	ZmRBTreeUnique<true>>>;
+  using MemCounts =
+    ZuTypeApply<ZuTuple, ZuTypeMap<MemCount, ZuSeqTL<KeyIDs>>>;
+  using MemCountArray = ZtArray<ZuPtr<MemCounts>>;
+  MemCountArray			m_memCounts;
+  // records committed/replicated while a shard is loading, replayed
+  // in UN order once the load completes
+  using MemPending = ZtArray<ZmRef<const IOBuf>>;
+  using MemPendingArray = ZtArray<ZuPtr<MemPending>>;
+  MemPendingArray		m_memPending;	// null once loaded
 };
 
 template <typename T>
@@ -1613,6 +1813,9 @@ struct DBCf {
   unsigned		heartbeatTimeout = 0;
   unsigned		reconnectFreq = 0;
   unsigned		electionTimeout = 0;
+  unsigned		recBatch = 0;	// records per recovery batch
+  unsigned		recBatchSize = 0; // max. bytes per recovery message
+  unsigned		recWindow = 0;	// recovery batches in flight
   ZmHashParams		cxnHash;
 #if Zdb_DEBUG
   bool			debug = 0;
@@ -1636,6 +1839,9 @@ struct DBCf {
     heartbeatTimeout = cf->getInt("heartbeatTimeout", 1, 14400, 4);
     reconnectFreq = cf->getInt("reconnectFreq", 1, 3600, 1);
     electionTimeout = cf->getInt("electionTimeout", 1, 3600, 8);
+    recBatch = cf->getInt("recBatch", 1, 1<<16, 64);
+    recBatchSize = cf->getInt("recBatchSize", 1<<10, 1<<28, 1<<20);
+    recWindow = cf->getInt("recWindow", 1, 1<<10, 4);
 #if Zdb_DEBUG
     debug = cf->getBool("debug");
 #endif
@@ -1772,6 +1978,11 @@ public:
     return m_tables.findVal(id);
   }
 
+  // outbound recovery statistics
+  unsigned recovering() const { return m_recovering; }
+  uint64_t recovered() const { return m_recovered.load_(); }
+  uint64_t recoveryRate() const;	// records/sec
+
   using AllFn = ZmFn<void(AnyTable *, ZmFn<void(bool)>)>;
   using AllDoneFn = ZmFn<void(DB *, bool)>;
 
@@ -1854,6 +2065,7 @@ private:
   void repStart();
   void repStop();
   void recEnd();
+  void recovered(unsigned n) { m_recovered += n; }
 
   bool replicate(ZmRef<const IOBuf> buf);
 
@@ -1901,6 +2113,10 @@ private:
   unsigned		m_recovering = 0;	// recovering next-ranked host
   DBState		m_recover{4};		// recovery state
   DBState		m_recoverEnd{4};	// recovery end
+  ZuTime		m_recStart;		// recovery start time
+  uint64_t		m_recBase = 0;		// m_recovered at start
+  uint64_t		m_recRate = 0;		// records/sec of last recovery
+  ZmAtomic<uint64_t>	m_recovered = 0;	// records sent in recovery
   int			m_nPeers = 0;	// # up to date peers
 					// # votes received (Electing)
 					// # pending disconnects (Stopping)
@@ -1948,6 +2164,11 @@ inline void Table<T>::count(GroupKey<KeyID> key, L l)
 
   ZmAssert(invoked());
 
+  if (config().memIndex) {
+    memCount<KeyID>(ZuMv(key), ZuMv(l));
+    return;
+  }
+
   auto context = ZmMkRef(new Context{ZuMv(l)});
 
   using Key = GroupKey<KeyID>;
@@ -1983,6 +2204,12 @@ inline void Table<T>::select_(
 {
   using Context = Select<Tuple_>;
 
+  if (config().memIndex) {
+    memSelect<KeyID, SelectKey, Tuple_, SelectRow, SelectNext>(
+      ZuMv(selectKey), inclusive, limit, ZuMv(l));
+    return;
+  }
+
   auto context = ZmMkRef(new Context{ZuMv(l)});
 
   Zfb::IOBuilder fbb{allocBuf()};
@@ -2013,6 +2240,227 @@ inline void Table<T>::select_(
     KeyID, ZuMv(keyBuf).constRef(), limit, ZuMv(tupleFn));
 }
 
+// in-memory indices - apply committed/replicated record, deferring it
+// if the shard is still loading
+template <typename T>
+inline void Table<T>::objIndex(const IOBuf *buf)
+{
+  unsigned shard = record_(msg_(buf->hdr()))->shard();
+  if (auto pending = m_memPending[shard].ptr()) {
+    new (pending->push()) ZmRef<const IOBuf>{buf};
+    return;
+  }
+  memIndexApply(buf);
+}
+
+// in-memory indices - apply record
+template <typename T>
+inline void Table<T>::memIndexApply(const IOBuf *buf)
+{
+  auto msg = msg_(buf->hdr());
+  auto record = record_(msg);
+  unsigned shard = record->shard();
+  MemIndices *indices = m_memIndices[shard].ptr();
+  MemCounts *counts = m_memCounts[shard].ptr();
+  auto fbo = ZfbField::verify<T>(Zfb::Load::bytes(record->data()));
+  if (ZuUnlikely(!fbo)) return;
+  auto add = [indices, counts](ZmRef<MemRow> row) {
+    ZuUnroll::all<KeyIDs>([indices, counts, &row](auto KeyID) {
+      indices->template p<KeyID>().add(
+	MemKey<T, KeyID>{ZuFieldKey<KeyID>(row->data)}, row);
+      memCountAdj<KeyID>(counts, row->data, true);
+    });
+  };
+  auto del = [indices, counts](const MemRow *row) {
+    ZuUnroll::all<KeyIDs>([indices, counts, row](auto KeyID) {
+      if (indices->template p<KeyID>().del(
+	    MemKey<T, KeyID>{ZuFieldKey<KeyID>(row->data)}))
+	memCountAdj<KeyID>(counts, row->data, false);
+    });
+  };
+  ZmRef<MemRow> row =
+    indices->template p<0>().findVal(MemKey<T, 0>{ZuFieldKey<0>(*fbo)});
+  // the newest wins - loaded rows may be newer than deferred records
+  if (row && row->un >= record->un()) return;
+  auto vn = record->vn();
+  if (vn < 0) { // delete
+    if (row) del(row);
+    return;
+  }
+  if (!vn || msg->body_type() == fbs::Body::Recovery) { // complete row
+    if (row) del(row);
+    add(new MemRow{ZfbField::ctor<T>(fbo), record->un()});
+    return;
+  }
+  // update - mutable fields only, re-index by updated keys
+  if (ZuUnlikely(!row)) return;
+  del(row);
+  ZfbField::update(row->data, fbo);
+  row->un = record->un();
+  add(ZuMv(row));
+}
+
+// in-memory indices - load each shard in turn from the backing data store
+template <typename T>
+inline void Table<T>::objIndexLoad(ZmFn<void(bool)> fn)
+{
+  memIndexLoad(0, ZuMv(fn));
+}
+template <typename T>
+inline void Table<T>::memIndexLoad(unsigned shard, ZmFn<void(bool)> fn)
+{
+  invoke(shard, [this, shard, fn = ZuMv(fn)]() mutable {
+    m_memIndices[shard] = new MemIndices{};
+    m_memCounts[shard] = new MemCounts{};
+    if (!m_memPending[shard]) m_memPending[shard] = new MemPending{};
+    storeTbl()->recoverN(shard, 0, nextUN(shard), [
+      this, shard, fn = ZuMv(fn)
+    ](RowResult result) mutable {
+      if (ZuLikely(result.is<RowData>())) {
+	invoke(shard, [this, buf = ZuMv(result).p<RowData>().buf]() {
+	  memIndexApply(buf.ptr());
+	});
+	return;
+      }
+      if (ZuUnlikely(result.is<Event>())) {
+	ZeLogEvent(ZuMv(result).p<Event>());
+	ZeLOG(Error, ([id = this->id(), shard](auto &s) {
+	  s << "Zdb in-memory index load of " << id << '/' << shard
+	    << " failed";
+	}));
+	fn(false);
+	return;
+      }
+      invoke(shard, [this, shard, fn = ZuMv(fn)]() mutable {
+	memIndexLoaded(shard);
+	if (shard + 1 < config().nShards)
+	  memIndexLoad(shard + 1, ZuMv(fn));
+	else
+	  fn(true);
+      });
+    });
+  });
+}
+
+// in-memory indices - shard loaded, replay deferred records in UN order
+template <typename T>
+inline void Table<T>::memIndexLoaded(unsigned shard)
+{
+  ZuPtr<MemPending> pending = ZuMv(m_memPending[shard]);
+  unsigned n = pending->length();
+  if (!n) return;
+  auto un = [](const ZmRef<const IOBuf> &buf) {
+    return record_(msg_(buf->hdr()))->un();
+  };
+  if (n > 1)
+    ZuSort(&(*pending)[0], n, [&un](
+	const ZmRef<const IOBuf> &a, const ZmRef<const IOBuf> &b) {
+      return ZuCmp<UN>::cmp(un(a), un(b));
+    });
+  for (unsigned i = 0; i < n; i++) memIndexApply((*pending)[i].ptr());
+}
+
+// in-memory indices - run l(shard, ctx) in each shard in turn, then
+// done(ctx)
+template <typename T>
+template <typename Ctx, typename L, typename Done>
+inline void Table<T>::memIndexAll(unsigned shard, Ctx ctx, L l, Done done)
+{
+  invoke(shard, [
+    this, shard, ctx = ZuMv(ctx), l = ZuMv(l), done = ZuMv(done)
+  ]() mutable {
+    l(shard, ctx);
+    if (shard + 1 < config().nShards)
+      memIndexAll(shard + 1, ZuMv(ctx), ZuMv(l), ZuMv(done));
+    else
+      done(ZuMv(ctx));
+  });
+}
+
+// in-memory indices - increment/decrement the row count of a group
+template <typename T>
+template <unsigned KeyID, typename MemCounts>
+inline void Table<T>::memCountAdj(MemCounts *counts, const T &data, bool inc)
+{
+  auto &count = counts->template p<KeyID>();
+  auto key = memCountKey<KeyID>(data);
+  if (auto node = count.findPtr(key)) {
+    if (inc)
+      ++node->val();
+    else if (!--node->val())
+      count.delNode(node);
+  } else if (inc)
+    count.add(ZuMv(key), uint64_t(1));
+}
+
+template <typename T>
+template <unsigned KeyID, typename L>
+inline void Table<T>::memCount(GroupKey<KeyID> groupKey, L l)
+{
+  auto key = memGroupKey<KeyID>(groupKey);
+  memIndexAll(0, uint64_t(0), [this, key](unsigned shard, uint64_t &count) {
+    const auto &counts = m_memCounts[shard]->template p<KeyID>();
+    if (auto node = counts.findPtr(key)) count += node->val();
+  }, [l = ZuMv(l)](uint64_t count) mutable {
+    l(typename Count::Result{count});
+  });
+}
+
+// each shard yields up to limit results, which are then merged
+template <typename T>
+template <
+  unsigned KeyID,
+  typename SelectKey,
+  typename Tuple_,
+  bool SelectRow,
+  bool SelectNext,
+  typename L>
+inline void Table<T>::memSelect(
+  SelectKey selectKey, bool inclusive, unsigned limit, L l)
+{
+  using MemKey = Zdb_::MemKey<T, KeyID>;
+  using Cmp = MemKeyCmp<MemKey>;
+  using Result = ZuTuple<MemKey, Tuple_>;
+  using Results = ZtArray<Result>;
+  enum { Group = SplitKey<T, KeyID>::GroupFields::N };
+
+  MemKey key;
+  if constexpr (SelectNext)
+    key.key = ZuMv(selectKey);
+  else
+    key = memGroupKey<KeyID>(selectKey);
+  memIndexAll(0, Results{}, [
+    this, key, inclusive, limit
+  ](unsigned shard, Results &results) {
+    const auto &index = m_memIndices[shard]->template p<KeyID>();
+    auto node = inclusive ?
+      index.template findPtr<ZmRBTreeGreaterEqual>(key) :
+      index.template findPtr<ZmRBTreeGreater>(key);
+    for (unsigned i = 0;
+	i < limit && node && !Cmp::cmp(node->key(), key, Group); i++) {
+      const T &data = node->val()->data;
+      if constexpr (SelectRow)
+	new (results.push()) Result{
+	  node->key(), Tuple_{ZuFieldKey<ZuFieldKeyID::All>(data)}};
+      else
+	new (results.push()) Result{
+	  node->key(), Tuple_{ZuFieldKey<KeyID>(data)}};
+      node = index.next(node);
+    }
+  }, [limit, l = ZuMv(l)](Results results) mutable {
+    using SelectResult = typename Select<Tuple_>::Result;
+    unsigned n = results.length();
+    if (n > 1)
+      ZuSort(&results[0], n, [](const Result &a, const Result &b) {
+	return Cmp::cmp(a.template p<0>(), b.template p<0>());
+      });
+    if (n > limit) n = limit;
+    for (unsigned i = 0; i < n; i++)
+      l(SelectResult{ZuMv(results[i]).template p<1>()}, i + 1);
+    l(SelectResult{}, 0);
+  });
+}
+
 template <typename T>
 template <
   unsigned KeyID, bool UpdateLRU, bool Evict, typename L, typename Ctor>
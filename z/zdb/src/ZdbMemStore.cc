@@ -118,31 +118,69 @@ void StoreTbl::recover(unsigned shard, UN un, RowFn rowFn)
   });
 }
 
+void StoreTbl::recoverN(unsigned shard, UN un, UN endUN, RecoverFn fn)
+{
+  m_store->run([this, shard, un, endUN, fn = ZuMv(fn)]() mutable {
+    auto row = m_indexUN.find<ZmRBTreeGreaterEqual>(
+      ZuTuple<unsigned, ZdbUN>{shard, un});
+    while (row && row->shard == shard && row->un < endUN) {
+      RowData data{.buf = saveRow<true>(row).constRef()};
+      fn(RowResult{ZuMv(data)});
+      row = m_indexUN.next(row);
+    }
+    fn(RowResult{});
+  });
+}
+
 void StoreTbl::write(ZmRef<const IOBuf> buf, CommitFn commitFn)
 {
   m_store->run([this, buf = ZuMv(buf), commitFn = ZuMv(commitFn)]() mutable {
-    // idempotence check
-    auto record = record_(msg_(buf->hdr()));
-    auto shard = record->shard();
-    auto un = record->un();
-    auto &maxUN = m_maxUN[shard];
-    if (maxUN != ZdbNullUN() && un <= maxUN) {
-      commitFn(ZuMv(buf), CommitResult{});
-      return;
-    }
-    // load row, perform insert/update/delete
-    ZmRef<MemRow> row = loadRow(buf).mutableRef();
-    if (!row->vn)
-      insert(ZuMv(row), ZuMv(buf), ZuMv(commitFn));
-    else if (row->vn > 0)
-      update(ZuMv(row), ZuMv(buf), ZuMv(commitFn));
-    else
-      del(ZuMv(row), ZuMv(buf), ZuMv(commitFn));
+    write_(ZuMv(buf), commitFn);
   });
 }
 
-void StoreTbl::insert(
-  ZmRef<MemRow> row, ZmRef<const IOBuf> buf, CommitFn commitFn)
+void StoreTbl::writeN(ZtArray<ZmRef<const IOBuf>> bufs, CommitFn commitFn)
+{
+  m_store->run([
+    this, bufs = ZuMv(bufs), commitFn = ZuMv(commitFn)
+  ]() mutable {
+    for (unsigned i = 0, n = bufs.length(); i < n; i++)
+      write_(ZuMv(bufs[i]), commitFn);
+  });
+}
+
+void StoreTbl::write_(ZmRef<const IOBuf> buf, const CommitFn &commitFn)
+{
+  // idempotence check
+  if (applied(record_(msg_(buf->hdr())))) {
+    commitFn(ZuMv(buf), CommitResult{});
+    return;
+  }
+  // load row, perform insert/update/delete
+  auto result = apply(loadRow(buf));
+  commitFn(ZuMv(buf), ZuMv(result));
+}
+
+void StoreTbl::upsert(ZmRef<MemRow> row)
+{
+  unsigned n = m_keyFields.length();
+  {
+    auto key = extractKey(m_fields, m_keyFields, 0, row->data);
+    if (ZmRef<MemRow> old = m_indices[0].delVal(key).mutableRef()) {
+      m_indexUN.delNode(old);
+      for (unsigned i = 1; i < n; i++)
+	m_indices[i].del(extractKey(m_fields, m_keyFields, i, old->data));
+    }
+  }
+  for (unsigned i = 0; i < n; i++) {
+    auto key = extractKey(m_fields, m_keyFields, i, row->data);
+    ZmAssert(key.length() == m_keyFields[i].length());
+    m_indices[i].add(key, row.constRef());
+  }
+  m_indexUN.addNode(ZuMv(row));
+}
+
+CommitResult StoreTbl::insert(ZmRef<MemRow> row)
 {
   ZeLOG(Debug, ([](auto &s) { }));
   m_maxUN[row->shard] = row->un, m_maxSN = row->sn;
@@ -150,87 +188,81 @@ void StoreTbl::insert(
   for (unsigned i = 0; i < n; i++) {
     auto key = extractKey(m_fields, m_keyFields, i, row->data);
     ZmAssert(key.length() == m_keyFields[i].length());
-    if (!i && m_indices[i].findVal(key)) {
-      commitFn(ZuMv(buf), CommitResult{ZeVEVENT(Error,
+    if (!i && m_indices[i].findVal(key))
+      return CommitResult{ZeVEVENT(Error,
 	  ([id = this->id(), key = ZuMv(key)](auto &s, const auto &) {
 	    s << id << " insert(" << ZtJoin(key, ", ")
 	      << ") failed - record exists";
-	  }))});
-      return;
-    }
+	  }))};
     m_indices[i].add(key, row.constRef());
   }
   m_indexUN.addNode(ZuMv(row));
-  commitFn(ZuMv(buf), CommitResult{});
+  return CommitResult{};
 }
 
-void StoreTbl::update(
-  ZmRef<MemRow> updRow, ZmRef<const IOBuf> buf, CommitFn commitFn)
+CommitResult StoreTbl::update(ZmRef<MemRow> updRow)
 {
   auto key = extractKey(m_fields, m_keyFields, 0, updRow->data);
   ZmRef<MemRow> row = m_indices[0].findVal(key).mutableRef();
-  if (row) {
-    m_maxUN[updRow->shard] = updRow->un, m_maxSN = updRow->sn;
-
-    // remember original secondary index key values
-    unsigned n = m_keyFields.length();
-    auto origKeys = ZmAlloc(Tuple, n - 1);
-    for (unsigned i = 1; i < n; i++) {
-      auto key = extractKey(m_fields, m_keyFields, i, row->data);
-      ZmAssert(key.length() == m_keyFields[i].length());
-      new (&origKeys[i - 1]) Tuple(ZuMv(key)); // not Tuple{}
-    }
-    // remove from UN index
-    m_indexUN.delNode(row);
-
-    row->un = updRow->un;
-    row->sn = updRow->sn;
-    row->vn = updRow->vn;
-    updTuple(m_fields, row->data, ZuMv(updRow->data));
-
-    // add back to UN index
-    m_indexUN.addNode(row);
-    // update secondary indices if corresponding key changed
-    for (unsigned i = 1; i < n; i++) {
-      auto key = extractKey(m_fields, m_keyFields, i, row->data);
-      if (key != origKeys[i - 1]) {
-	m_indices[i].del(origKeys[i - 1]);
-	m_indices[i].add(key, row.constRef());
-      }
-    }
-
-    commitFn(ZuMv(buf), CommitResult{});
-  } else {
-    commitFn(ZuMv(buf), CommitResult{
+  if (!row)
+    return CommitResult{
 	ZeVEVENT(Error, ([id = this->id(), key](auto &s, const auto &) {
 	  s << id << " update(" << ZtJoin(key, ", ")
 	    << ") failed - record missing";
-	}))});
+	}))};
+
+  m_maxUN[updRow->shard] = updRow->un, m_maxSN = updRow->sn;
+
+  // remember original secondary index key values
+  unsigned n = m_keyFields.length();
+  auto origKeys = ZmAlloc(Tuple, n - 1);
+  for (unsigned i = 1; i < n; i++) {
+    auto key = extractKey(m_fields, m_keyFields, i, row->data);
+    ZmAssert(key.length() == m_keyFields[i].length());
+    new (&origKeys[i - 1]) Tuple(ZuMv(key)); // not Tuple{}
   }
+  // remove from UN index
+  m_indexUN.delNode(row);
+
+  row->un = updRow->un;
+  row->sn = updRow->sn;
+  row->vn = updRow->vn;
+  updTuple(m_fields, row->data, ZuMv(updRow->data));
+
+  // add back to UN index
+  m_indexUN.addNode(row);
+  // update secondary indices if corresponding key changed
+  for (unsigned i = 1; i < n; i++) {
+    auto key = extractKey(m_fields, m_keyFields, i, row->data);
+    if (key != origKeys[i - 1]) {
+      m_indices[i].del(origKeys[i - 1]);
+      m_indices[i].add(key, row.constRef());
+    }
+  }
+
+  return CommitResult{};
 }
 
-void StoreTbl::del(
-  ZmRef<MemRow> delRow, ZmRef<const IOBuf> buf, CommitFn commitFn)
+CommitResult StoreTbl::del(ZmRef<MemRow> delRow)
 {
   auto key = extractKey(m_fields, m_keyFields, 0, delRow->data);
   ZmRef<MemRow> row = m_indices[0].delVal(key).mutableRef();
-  if (row) {
-    m_maxUN[delRow->shard] = delRow->un, m_maxSN = delRow->sn;
-    m_indexUN.delNode(row);
-    unsigned n = m_keyFields.length();
-    for (unsigned i = 1; i < n; i++) {
-      auto key = extractKey(m_fields, m_keyFields, i, row->data);
-      ZmAssert(key.length() == m_keyFields[i].length());
-      m_indices[i].del(key);
-    }
-    commitFn(ZuMv(buf), CommitResult{});
-  } else {
-    commitFn(ZuMv(buf), CommitResult{
+  if (!row)
+    return CommitResult{
 	ZeVEVENT(Error, ([id = this->id(), key](auto &s, const auto &) {
 	  s << id << " del(" << ZtJoin(key, ", ")
 	    << ") failed - record missing";
-	}))});
+	}))};
+
+  m_maxUN[delRow->shard] = delRow->un, m_maxSN = delRow->sn;
+  m_indexUN.delNode(row);
+  unsigned n = m_keyFields.length();
+  for (unsigned i = 1; i < n; i++) {
+    auto key = extractKey(m_fields, m_keyFields, i, row->data);
+    ZmAssert(key.length() == m_keyFields[i].length());
+    m_indices[i].del(key);
   }
+  return CommitResult{};
 }
 
 } // ZdbMem
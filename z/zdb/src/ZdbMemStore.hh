@@ -1242,15 +1242,15 @@ public:
 protected:
   ~StoreTbl() = default;
 
-private:
-  // load a row from a buffer containing a replication/recovery message
-  ZmRef<const MemRow> loadRow(const ZmRef<const IOBuf> &buf) {
-    auto record = record_(msg_(buf->hdr()));
+  // load a row from a replication/recovery message; a complete row
+  // (as saved by saveRow()) is loaded in full regardless of its version
+  ZmRef<MemRow> loadRow(const Hdr *hdr, bool complete = false) {
+    auto record = record_(msg_(hdr));
     auto sn = Zfb::Load::uint128(record->sn());
     auto data = Zfb::Load::bytes(record->data());
     auto fbo = Zfb::GetAnyRoot(data.data());
     Tuple tuple;
-    if (!record->vn())
+    if (complete || !record->vn())
       tuple = loadTuple(m_fields, m_xFields, fbo);
     else if (record->vn() > 0)
       tuple = loadUpdTuple(m_fields, m_xFields, fbo);
@@ -1259,6 +1259,10 @@ private:
     return new MemRow{
       record->shard(), record->un(), sn, record->vn(), ZuMv(tuple)};
   }
+  ZmRef<MemRow> loadRow(
+      const ZmRef<const IOBuf> &buf, bool complete = false) {
+    return loadRow(buf->hdr(), complete);
+  }
 
   // save a row to a buffer as a replication/recovery message
   template <bool Recovery>
@@ -1295,15 +1299,38 @@ public:
   void find(unsigned keyID, ZmRef<const IOBuf>, RowFn);
 
   void recover(unsigned shard, UN, RowFn);
+  void recoverN(unsigned shard, UN un, UN endUN, RecoverFn);
 
   void write(ZmRef<const IOBuf>, CommitFn);
+  void writeN(ZtArray<ZmRef<const IOBuf>>, CommitFn);
 
-private:
-  void insert(ZmRef<MemRow>, ZmRef<const IOBuf>, CommitFn);
-  void update(ZmRef<MemRow>, ZmRef<const IOBuf>, CommitFn);
-  void del(ZmRef<MemRow>, ZmRef<const IOBuf>, CommitFn);
+protected:
+  // write, running on store thread
+  void write_(ZmRef<const IOBuf>, const CommitFn &);
+
+  // idempotence check - true if UN has already been applied
+  bool applied(const fbs::Record *record) const {
+    auto maxUN = m_maxUN[record->shard()];
+    return maxUN != ZdbNullUN() && record->un() <= maxUN;
+  }
+
+  // perform insert/update/delete - must be called on the store thread
+  CommitResult apply(ZmRef<MemRow> row) {
+    if (!row->vn) return insert(ZuMv(row));
+    if (row->vn > 0) return update(ZuMv(row));
+    return del(ZuMv(row));
+  }
+
+  // insert or replace a complete row, keyed on the primary key, without
+  // advancing the last UN / SN - used to load snapshots of the table
+  void upsert(ZmRef<MemRow>);
 
 private:
+  CommitResult insert(ZmRef<MemRow>);
+  CommitResult update(ZmRef<MemRow>);
+  CommitResult del(ZmRef<MemRow>);
+
+protected:
   Store			*m_store;
   ZuID			m_id;
   ZtVFieldArray		m_fields;
@@ -126,6 +126,18 @@ inline const fbs::Record *record(const fbs::Msg *msg) {
       return record_(msg);
   }
 }
+inline const fbs::RecordBatch *batch_(const fbs::Msg *msg) {
+  return static_cast<const fbs::RecordBatch *>(msg->body());
+}
+inline const fbs::RecordBatch *batch(const fbs::Msg *msg) {
+  if (ZuUnlikely(!msg)) return nullptr;
+  switch (msg->body_type()) {
+    default:
+      return nullptr;
+    case fbs::Body::RecoveryBatch:
+      return batch_(msg);
+  }
+}
 template <typename T>
 inline const T *data(const fbs::Record *record) {
   if (ZuUnlikely(!record)) return nullptr;
@@ -142,6 +154,20 @@ inline const T *data_(const fbs::Record *record) {
   if (ZuUnlikely(!data)) return nullptr;
   return Zfb::GetRoot<T>(data.data());
 }
+// copy a record into a builder
+template <typename Builder>
+inline Zfb::Offset<fbs::Record> copyRecord(
+    Builder &fbb, const fbs::Record *record) {
+  auto data_ = Zfb::Load::bytes(record->data());
+  Zfb::Offset<Zfb::Vector<uint8_t>> data;
+  if (data_) {
+    uint8_t *ptr;
+    data = Zfb::Save::pvector_(fbb, data_.length(), ptr);
+    if (!data.IsNull() && ptr) memcpy(ptr, data_.data(), data_.length());
+  }
+  return fbs::CreateRecord(fbb, record->table(), record->un(),
+      record->sn(), record->vn(), record->shard(), data);
+}
 inline const fbs::Commit *commit_(const fbs::Msg *msg) {
   return static_cast<const fbs::Commit *>(msg->body());
 }
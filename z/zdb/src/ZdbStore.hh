@@ -17,6 +17,7 @@
 
 #include <zlib/ZuUnion.hh>
 
+#include <zlib/ZmAtomic.hh>
 #include <zlib/ZmPolymorph.hh>
 
 #include <zlib/ZtField.hh>
@@ -124,6 +125,11 @@ using RowResult = ZuUnion<
 // row callback
 using RowFn = ZmFn<void(RowResult)>;
 
+// range recovery callback
+// - called for each row found, in UN order, then once with RowResult{}
+//   (void) to indicate the end of results; an error also ends the results
+using RecoverFn = RowFn;
+
 // commit result
 using CommitResult = ZuUnion<void, Event>;
 // commit callback
@@ -149,8 +155,62 @@ public:
 
   virtual void recover(unsigned shard, UN, RowFn) = 0;
 
+  // range recovery of all rows in shard with UNs in [un, endUN)
+  // - default implementation falls back to recover() for each UN
+  virtual void recoverN(unsigned shard, UN un, UN endUN, RecoverFn fn) {
+    recoverN_(new RecoverN{shard, un, endUN, ZuMv(fn)});
+  }
+
   // buf contains replication message, UN is idempotency key
   virtual void write(ZmRef<const IOBuf>, CommitFn) = 0;	// idempotent
+
+  // batch write - bufs are in UN order within each shard, commitFn is
+  // called for each buf, permitting a store to apply the batch as a
+  // single transaction or pipeline
+  // - default implementation falls back to write() for each buf
+  virtual void writeN(ZtArray<ZmRef<const IOBuf>> bufs, CommitFn fn) {
+    for (unsigned i = 0, n = bufs.length(); i < n; i++)
+      write(ZuMv(bufs[i]), fn);
+  }
+
+private:
+  // default recoverN() state
+  struct RecoverN : public ZmObject {
+    enum { Idle = 0, Pending, Returned };
+
+    unsigned		shard;
+    UN			un;		// next UN to recover
+    UN			endUN;
+    RecoverFn		fn;
+    bool		failed = false;
+    ZmAtomic<int>	state = Idle;
+
+    RecoverN(unsigned shard_, UN un_, UN endUN_, RecoverFn fn_) :
+	shard{shard_}, un{un_}, endUN{endUN_}, fn{ZuMv(fn_)} { }
+  };
+
+  // iterates over the range, rather than recursing, while recover()
+  // calls back synchronously; whichever of recover() returning and the
+  // callback happens last continues the iteration
+  void recoverN_(ZmRef<RecoverN> ctx) {
+    while (!ctx->failed && ctx->un < ctx->endUN) {
+      ctx->state = RecoverN::Pending;
+      recover(ctx->shard, ctx->un, [this, ctx](RowResult result) mutable {
+	if (ZuUnlikely(result.is<Event>())) {
+	  ctx->failed = true;
+	  ctx->fn(ZuMv(result));
+	} else if (result.is<RowData>())
+	  ctx->fn(ZuMv(result));
+	++ctx->un;
+	if (ctx->state.cmpXch(RecoverN::Idle, RecoverN::Pending) ==
+	    RecoverN::Pending) return; // recover() has yet to return
+	recoverN_(ZuMv(ctx));
+      });
+      if (ctx->state.cmpXch(RecoverN::Returned, RecoverN::Pending) ==
+	  RecoverN::Pending) return; // callback will continue
+    }
+    if (!ctx->failed) ctx->fn(RowResult{});
+  }
 };
 
 // backing data store interface
@@ -44,8 +44,10 @@ public:
   void find(unsigned keyID, ZmRef<const IOBuf>, RowFn);
 
   void recover(unsigned shard, UN, RowFn);
+  void recoverN(unsigned shard, UN un, UN endUN, RecoverFn);
 
   void write(ZmRef<const IOBuf>, CommitFn);
+  void writeN(ZtArray<ZmRef<const IOBuf>>, CommitFn);
 };
 
 // --- mock data store
@@ -77,6 +79,7 @@ public:
     while (auto fn = m_work.shift()) fn();
     sync();
   }
+  unsigned pendingWork() const { return m_work.count_(); }
 
   bool deferCallbacks() const { return m_deferCallbacks; }
   void deferCallbacks(bool v) { m_deferCallbacks = v; }
@@ -94,6 +97,11 @@ public:
     sync();
   }
 
+  // writes - batches and records handed to writeN()
+  void written(unsigned n) { ++m_writeBatches; m_writeRecords += n; }
+  unsigned writeBatches() const { return m_writeBatches; }
+  unsigned writeRecords() const { return m_writeRecords; }
+
 private:
   using Ring = ZmXRing<ZmFn<>, ZmXRingLock<ZmPLock>>;
 
@@ -101,6 +109,8 @@ private:
   bool		m_deferCallbacks = false;
   Ring		m_work;
   Ring		m_callbacks;
+  ZmAtomic<unsigned>	m_writeBatches = 0;
+  ZmAtomic<unsigned>	m_writeRecords = 0;
 };
 
 inline zdbtest::Store *StoreTbl::store() const
@@ -192,6 +202,30 @@ inline void StoreTbl::recover(unsigned shard, UN un, RowFn rowFn) {
   store()->addWork(ZuMv(work_));
 }
 
+inline void StoreTbl::recoverN(
+  unsigned shard, UN un, UN endUN, RecoverFn recoverFn)
+{
+  // ZeLOG(Debug, "recoverN() work enqueue");
+  auto work_ = [
+    this, shard, un, endUN, recoverFn = ZuMv(recoverFn)
+  ]() mutable {
+    // ZeLOG(Debug, "recoverN() work dequeue");
+    ZdbMem::StoreTbl::recoverN(shard, un, endUN, [
+      this, recoverFn = ZuMv(recoverFn)
+    ](RowResult result) mutable {
+      // ZeLOG(Debug, "recoverN() callback enqueue");
+      auto callback = [
+	recoverFn, result = ZuMv(result) // recoverFn is called repeatedly
+      ]() mutable {
+	// ZeLOG(Debug, "recoverN() callback dequeue");
+	recoverFn(ZuMv(result));
+      };
+      store()->addCallback(ZuMv(callback));
+    });
+  };
+  store()->addWork(ZuMv(work_));
+}
+
 inline void StoreTbl::write(ZmRef<const IOBuf> buf, CommitFn commitFn) {
   // ZeLOG(Debug, "write() work enqueue");
   auto work_ = [
@@ -214,6 +248,31 @@ inline void StoreTbl::write(ZmRef<const IOBuf> buf, CommitFn commitFn) {
   store()->addWork(ZuMv(work_));
 }
 
+inline void StoreTbl::writeN(
+  ZtArray<ZmRef<const IOBuf>> bufs, CommitFn commitFn)
+{
+  store()->written(bufs.length());
+  // ZeLOG(Debug, "writeN() work enqueue");
+  auto work_ = [
+    this, bufs = ZuMv(bufs), commitFn = ZuMv(commitFn)
+  ]() mutable {
+    // ZeLOG(Debug, "writeN() work dequeue");
+    ZdbMem::StoreTbl::writeN(ZuMv(bufs), [
+      this, commitFn = ZuMv(commitFn)
+    ](ZmRef<const IOBuf> buf, CommitResult result) mutable {
+      // ZeLOG(Debug, "writeN() callback enqueue");
+      auto callback = [
+	commitFn, buf = ZuMv(buf), result = ZuMv(result) // called repeatedly
+      ]() mutable {
+	// ZeLOG(Debug, "writeN() callback dequeue");
+	commitFn(ZuMv(buf), ZuMv(result));
+      };
+      store()->addCallback(ZuMv(callback));
+    });
+  };
+  store()->addWork(ZuMv(work_));
+}
+
 } // zdbtest
 
 #endif /* ZdbMockStore_HH */
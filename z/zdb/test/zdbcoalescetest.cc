@@ -0,0 +1,256 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// write coalescing test - writes queued to the backing data store within
+// a single shard task are handed to the store in one batch, and a queued
+// update is superseded by a later update or delete of the same object
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+
+#include <zlib/ZmTrap.hh>
+
+#include <zlib/ZeLog.hh>
+
+#include <zlib/ZvCf.hh>
+#include <zlib/ZvMxParams.hh>
+
+#include <zlib/Zdb.hh>
+
+#include "ZdbMockStore.hh"
+#include "zdbtest.hh"
+
+using namespace zdbtest;
+
+// mock data store
+ZmRef<zdbtest::Store> store;
+
+// database
+ZmRef<Zdb> db;
+
+// table
+ZmRef<ZdbTable<Order>> orders;
+
+// app scheduler, Zdb multiplexer
+ZmScheduler *appMx = nullptr;
+ZiMultiplex *dbMx = nullptr;
+
+ZmSemaphore done;
+
+ZmRef<ZvCf> inlineCf(ZuString s)
+{
+  ZmRef<ZvCf> cf = new ZvCf{};
+  cf->fromString(s);
+  return cf;
+}
+
+void gtfo()
+{
+  if (dbMx) dbMx->stop();
+  if (appMx) appMx->stop();
+  ZeLog::stop();
+  Zm::exit(1);
+}
+
+#define check(x) check_(x, __LINE__, #x)
+void check_(bool ok, unsigned line, const char *exp)
+{
+  printf("%s %6d %s\n", ok ? " OK " : "NOK ", line, exp);
+  fflush(stdout);
+  if (!ok) gtfo();
+}
+
+void start(ZvCf *cf)
+{
+  db->init(ZdbCf(cf), dbMx, ZdbHandler{
+      .upFn = [](Zdb *, ZdbHost *) { done.post(); },
+      .downFn = [](Zdb *, bool) { }
+  }, store);
+
+  orders = db->initTable<Order>("order"); // might throw
+
+  db->start();
+  done.wait(); // ensure active
+}
+
+ZmRef<ZdbObject<Order>> insert(uint64_t orderID)
+{
+  ZmRef<ZdbObject<Order>> order;
+  orders->insert(0, [orderID, &order](ZdbObject<Order> *o) {
+    if (ZuUnlikely(!o)) return;
+    new (o->ptr()) Order{
+      "IBM", orderID, "FIX0", ZuStringN<32>{} << "order" << orderID,
+      orderID, Side::Buy, {100}, {100}};
+    o->commit();
+    order = o;
+  });
+  return order;
+}
+
+void update(ZmRef<ZdbObject<Order>> order, int qty)
+{
+  orders->update(ZuMv(order), [qty](ZdbObject<Order> *o) {
+    if (ZuUnlikely(!o)) return;
+    o->data().qtys[0] = qty;
+    o->commit();
+  });
+}
+
+void del(ZmRef<ZdbObject<Order>> order)
+{
+  orders->del(ZuMv(order), [](ZdbObject<Order> *o) {
+    if (ZuUnlikely(!o)) return;
+    o->commit();
+  });
+}
+
+// find order by primary key, returning its quantity, -1 if not found
+int find(uint64_t orderID)
+{
+  int qty = -1;
+  orders->run(0, [orderID, &qty]() {
+    orders->find<0>(0, ZuFwdTuple("IBM", orderID),
+      [&qty](ZmRef<ZdbObject<Order>> o) {
+	if (o) qty = o->data().qtys[0];
+	done.post();
+      });
+  });
+  done.wait();
+  return qty;
+}
+
+int main()
+{
+  ZmRef<ZvCf> cf;
+
+  try {
+    cf = inlineCf(
+      "thread zdb\n"
+      "store { thread zdb_mem }\n"
+      "hostID 0\n"
+      "hosts {\n"
+      "  0 { standalone 1 }\n"
+      "}\n"
+      "tables {\n"
+      "  order { }\n"
+      "}\n"
+      "dbMx {\n"
+      "  nThreads 4\n"
+      "  threads {\n"
+      "    1 { name rx isolated true }\n"
+      "    2 { name tx isolated true }\n"
+      "    3 { name zdb isolated true }\n"
+      "    4 { name zdb_mem isolated true }\n"
+      "  }\n"
+      "  rxThread rx\n"
+      "  txThread tx\n"
+      "}\n"
+    );
+
+  } catch (const ZvError &e) {
+    std::cerr << e << '\n' << std::flush;
+    Zm::exit(1);
+  } catch (const ZeError &e) {
+    std::cerr << e << '\n' << std::flush;
+    Zm::exit(1);
+  } catch (...) {
+    Zm::exit(1);
+  }
+
+  ZeLog::init("zdbcoalescetest");
+  ZeLog::level(0);
+  ZeLog::sink(ZeLog::fileSink(ZeSinkOptions{}.path("&2"))); // log to stderr
+  ZeLog::start();
+
+  ZmTrap::trap();
+
+  try {
+    appMx = new ZmScheduler{ZmSchedParams().nThreads(1)};
+    dbMx = new ZiMultiplex{ZvMxParams{"dbMx", cf->getCf<true>("dbMx")}};
+
+    appMx->start();
+    if (!dbMx->start()) throw ZeEVENT(Fatal, "multiplexer start failed");
+
+    store = new zdbtest::Store();
+    db = new Zdb();
+
+    start(cf);
+
+    unsigned batches = store->writeBatches();
+    unsigned records = store->writeRecords();
+    bool ok = false;
+
+    // all writes are queued within one shard task, ahead of the flush
+    orders->run(0, [&ok]() {
+      // insert, then update twice - the first update is superseded
+      auto order1 = insert(1);
+      if (!order1) { done.post(); return; }
+      update(order1, 200);
+      update(order1, 300);
+      // insert, update, then delete - the update is superseded
+      auto order2 = insert(2);
+      if (!order2) { done.post(); return; }
+      update(order2, 200);
+      del(ZuMv(order2));
+      ok = true;
+      done.post();
+    });
+    done.wait();
+    check(ok);
+
+    // the flush was enqueued behind the above task
+    orders->run(0, []() { done.post(); });
+    done.wait();
+
+    check(store->writeBatches() - batches == 1);
+    // 6 writes: 2 inserts, 1 update and 1 delete reach the store
+    check(store->writeRecords() - records == 4);
+
+    db->stop(); // flushes and closes all tables
+
+    // restart from the data store, bypassing the object cache
+    store->preserve();
+    orders = {};
+    db->final();
+
+    start(cf);
+
+    check(orders->count() == 1);
+    check(find(1) == 300);
+    check(find(2) < 0);
+
+    db->stop();
+
+    appMx->stop();
+    dbMx->stop();
+
+    orders = {};
+    db->final(); // calls Store::final()
+    db = {};
+    store = {};
+
+  } catch (const ZvError &e) {
+    ZeLOG(Fatal, ZtString{e});
+    gtfo();
+  } catch (const ZeError &e) {
+    ZeLOG(Fatal, ZtString{e});
+    gtfo();
+  } catch (const ZeAnyEvent &e) {
+    ZeLogEvent(ZeVEvent{e});
+    gtfo();
+  } catch (...) {
+    ZeLOG(Fatal, "unknown exception");
+    gtfo();
+  }
+
+  if (appMx) delete appMx;
+  if (dbMx) delete dbMx;
+
+  ZeLog::stop();
+
+  return 0;
+}
@@ -0,0 +1,277 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// in-memory index test - count() and select() served from in-memory
+// ordered indices (memIndex), both as maintained by committed writes
+// and as loaded from the backing data store on open
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+
+#include <zlib/ZtString.hh>
+
+#include <zlib/ZmTrap.hh>
+
+#include <zlib/ZeLog.hh>
+
+#include <zlib/ZvCf.hh>
+#include <zlib/ZvMxParams.hh>
+
+#include <zlib/Zdb.hh>
+
+#include "ZdbMockStore.hh"
+#include "zdbtest.hh"
+
+using namespace zdbtest;
+
+// mock data store
+ZmRef<zdbtest::Store> store;
+
+// database
+ZmRef<Zdb> db;
+
+// table
+ZmRef<ZdbTable<Order>> orders;
+
+// app scheduler, Zdb multiplexer
+ZmScheduler *appMx = nullptr;
+ZiMultiplex *dbMx = nullptr;
+
+ZmSemaphore done;
+
+ZmRef<ZvCf> inlineCf(ZuString s)
+{
+  ZmRef<ZvCf> cf = new ZvCf{};
+  cf->fromString(s);
+  return cf;
+}
+
+void gtfo()
+{
+  if (dbMx) dbMx->stop();
+  if (appMx) appMx->stop();
+  ZeLog::stop();
+  Zm::exit(1);
+}
+
+#define check(x) check_(x, __LINE__, #x)
+void check_(bool ok, unsigned line, const char *exp)
+{
+  printf("%s %6d %s\n", ok ? " OK " : "NOK ", line, exp);
+  fflush(stdout);
+  if (!ok) gtfo();
+}
+
+void start(ZvCf *cf)
+{
+  db->init(ZdbCf(cf), dbMx, ZdbHandler{
+      .upFn = [](Zdb *, ZdbHost *) { done.post(); },
+      .downFn = [](Zdb *, bool) { }
+  }, store);
+
+  orders = db->initTable<Order>("order"); // might throw
+
+  db->start();
+  done.wait(); // ensure active
+}
+
+void insert(uint64_t orderID, const char *link, uint64_t seqNo)
+{
+  orders->insert(0, [orderID, link, seqNo](ZdbObject<Order> *o) {
+    if (ZuUnlikely(!o)) return;
+    new (o->ptr()) Order{
+      "IBM", orderID, link, ZuStringN<32>{} << "order" << orderID,
+      seqNo, Side::Buy, {100}, {100}};
+    o->commit();
+  });
+}
+
+void del(uint64_t orderID)
+{
+  orders->findDel<0>(0, ZuFwdTuple("IBM", orderID),
+    [](ZdbObject<Order> *o) {
+      if (ZuUnlikely(!o)) return;
+      o->commit();
+    });
+}
+
+uint64_t count(const char *link)
+{
+  uint64_t n = ~uint64_t(0);
+  orders->run(0, [link, &n]() {
+    orders->count<2>(ZuFwdTuple(link), [&n](auto result) {
+      if (result.template is<uint64_t>()) n = result.template p<uint64_t>();
+      done.post();
+    });
+  });
+  done.wait();
+  return n;
+}
+
+// space-separated seqNos of (link, seqNo) keys returned by a query
+template <typename Query>
+ZtString keys(Query query)
+{
+  ZtString s;
+  orders->run(0, [&query, &s]() {
+    query([&s](auto result, unsigned) {
+      using Key = ZuFieldKeyT<Order, 2>;
+      if (result.template is<Key>()) {
+	if (!!s) s << ' ';
+	s << result.template p<Key>().template p<1>();
+	return;
+      }
+      done.post();
+    });
+  });
+  done.wait();
+  return s;
+}
+
+ZtString select(const char *link, unsigned limit)
+{
+  return keys([link, limit](auto l) {
+    orders->selectKeys<2>(ZuFwdTuple(link), limit, ZuMv(l));
+  });
+}
+
+ZtString next(const char *link, uint64_t seqNo, unsigned limit)
+{
+  return keys([link, seqNo, limit](auto l) {
+    orders->nextKeys<2>(ZuFwdTuple(link, seqNo), false, limit, ZuMv(l));
+  });
+}
+
+void verify()
+{
+  check(count("FIX0") == 4);
+  check(count("FIX1") == 3);
+  check(count("FIX2") == 0);
+  // link and seqNo are both descending
+  check(select("FIX0", 10) == "4 2 1 0");
+  check(select("FIX1", 2) == "2 1");
+  check(next("FIX0", 2, 10) == "1 0");
+  check(select("FIX2", 10) == "");
+}
+
+int main()
+{
+  ZmRef<ZvCf> cf;
+
+  try {
+    cf = inlineCf(
+      "thread zdb\n"
+      "store { thread zdb_mem }\n"
+      "hostID 0\n"
+      "hosts {\n"
+      "  0 { standalone 1 }\n"
+      "}\n"
+      "tables {\n"
+      "  order { memIndex 1 }\n"
+      "}\n"
+      "dbMx {\n"
+      "  nThreads 4\n"
+      "  threads {\n"
+      "    1 { name rx isolated true }\n"
+      "    2 { name tx isolated true }\n"
+      "    3 { name zdb isolated true }\n"
+      "    4 { name zdb_mem isolated true }\n"
+      "  }\n"
+      "  rxThread rx\n"
+      "  txThread tx\n"
+      "}\n"
+    );
+
+  } catch (const ZvError &e) {
+    std::cerr << e << '\n' << std::flush;
+    Zm::exit(1);
+  } catch (const ZeError &e) {
+    std::cerr << e << '\n' << std::flush;
+    Zm::exit(1);
+  } catch (...) {
+    Zm::exit(1);
+  }
+
+  ZeLog::init("zdbmemindextest");
+  ZeLog::level(0);
+  ZeLog::sink(ZeLog::fileSink(ZeSinkOptions{}.path("&2"))); // log to stderr
+  ZeLog::start();
+
+  ZmTrap::trap();
+
+  try {
+    appMx = new ZmScheduler{ZmSchedParams().nThreads(1)};
+    dbMx = new ZiMultiplex{ZvMxParams{"dbMx", cf->getCf<true>("dbMx")}};
+
+    appMx->start();
+    if (!dbMx->start()) throw ZeEVENT(Fatal, "multiplexer start failed");
+
+    store = new zdbtest::Store();
+    db = new Zdb();
+
+    start(cf);
+
+    orders->run(0, []() {
+      for (unsigned i = 0; i < 5; i++) insert(i, "FIX0", i);
+      for (unsigned i = 0; i < 3; i++) insert(10 + i, "FIX1", i);
+      done.post();
+    });
+    done.wait();
+    orders->run(0, []() { del(3); });
+
+    verify();
+
+    db->stop(); // flushes and closes all tables
+
+    // restart from the data store, bypassing the object cache
+    store->preserve();
+    orders = {};
+    db->final();
+
+    start(cf);
+
+    // indices are loaded from the data store
+    check(orders->count() == 7);
+    verify();
+
+    // and maintained by subsequent writes
+    orders->run(0, []() { insert(13, "FIX1", 3); done.post(); });
+    done.wait();
+    check(count("FIX1") == 4);
+    check(select("FIX1", 2) == "3 2");
+
+    db->stop();
+
+    appMx->stop();
+    dbMx->stop();
+
+    orders = {};
+    db->final(); // calls Store::final()
+    db = {};
+    store = {};
+
+  } catch (const ZvError &e) {
+    ZeLOG(Fatal, ZtString{e});
+    gtfo();
+  } catch (const ZeError &e) {
+    ZeLOG(Fatal, ZtString{e});
+    gtfo();
+  } catch (const ZeAnyEvent &e) {
+    ZeLogEvent(ZeVEvent{e});
+    gtfo();
+  } catch (...) {
+    ZeLOG(Fatal, "unknown exception");
+    gtfo();
+  }
+
+  if (appMx) delete appMx;
+  if (dbMx) delete dbMx;
+
+  ZeLog::stop();
+
+  return 0;
+}
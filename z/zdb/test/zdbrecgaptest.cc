@@ -0,0 +1,258 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// recovery gap test - records that are cached when a recovery batch is
+// fetched, but are committed to the data store and evicted from the
+// cache before the batch is sent, must still be recovered
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+
+#include <zlib/ZmTrap.hh>
+
+#include <zlib/ZeLog.hh>
+
+#include <zlib/ZvCf.hh>
+#include <zlib/ZvMxParams.hh>
+
+#include <zlib/Zdb.hh>
+
+#include "ZdbMockStore.hh"
+#include "zdbtest.hh"
+
+using namespace zdbtest;
+
+// mock data stores
+ZmRef<zdbtest::Store> store[2];
+
+// databases
+ZmRef<Zdb> db[2];
+
+// tables
+ZmRef<ZdbTable<Order>> orders[2];
+
+// app scheduler, Zdb multiplexer
+ZmScheduler *appMx = nullptr;
+ZiMultiplex *dbMx = nullptr;
+
+ZmSemaphore done;
+
+ZmRef<ZvCf> inlineCf(ZuString s)
+{
+  ZmRef<ZvCf> cf = new ZvCf{};
+  cf->fromString(s);
+  return cf;
+}
+
+void gtfo()
+{
+  if (dbMx) dbMx->stop();
+  if (appMx) appMx->stop();
+  ZeLog::stop();
+  Zm::exit(1);
+}
+
+#define check(x) check_(x, __LINE__, #x)
+void check_(bool ok, unsigned line, const char *exp)
+{
+  printf("%s %6d %s\n", ok ? " OK " : "NOK ", line, exp);
+  fflush(stdout);
+  if (!ok) gtfo();
+}
+
+// wait for all tasks already queued to the shard thread
+void barrier(unsigned i)
+{
+  ZmBlock<>{}([i](auto wake) {
+    orders[i]->run(0, [wake = ZuMv(wake)]() mutable { wake(); });
+  });
+}
+
+void insert(uint64_t orderID)
+{
+  orders[0]->insert(0, [orderID](ZdbObject<Order> *o) {
+    if (ZuUnlikely(!o)) return;
+    new (o->ptr()) Order{
+      "IBM", orderID, "FIX0", ZuStringN<32>{} << "order" << orderID,
+      orderID, Side::Buy, {100}, {100}};
+    o->commit();
+  });
+}
+
+bool found(uint64_t orderID)
+{
+  bool found = false;
+  orders[1]->run(0, [orderID, &found]() {
+    orders[1]->find<0>(0, ZuFwdTuple("IBM", orderID),
+      [&found](ZmRef<ZdbObject<Order>> o) {
+	found = !!o;
+	done.post();
+      });
+  });
+  done.wait();
+  return found;
+}
+
+int main()
+{
+  ZmRef<ZvCf> cf;
+
+  try {
+    cf = inlineCf(
+      "thread zdb\n"
+      "store { thread zdb_mem }\n"
+      "hostID 0\n"
+      "hosts {\n"
+      "  0 { priority 100 ip 127.0.0.1 port 9945 }\n"
+      "  1 { priority  80 ip 127.0.0.1 port 9946 }\n"
+      "}\n"
+      "tables {\n"
+      "  order { }\n"
+      "}\n"
+      "recBatch 1\n"
+      "recWindow 8\n"
+      "dbMx {\n"
+      "  nThreads 4\n"
+      "  threads {\n"
+      "    1 { name rx isolated true }\n"
+      "    2 { name tx isolated true }\n"
+      "    3 { name zdb isolated true }\n"
+      "    4 { name zdb_mem isolated true }\n"
+      "  }\n"
+      "  rxThread rx\n"
+      "  txThread tx\n"
+      "}\n"
+    );
+
+  } catch (const ZvError &e) {
+    std::cerr << e << '\n' << std::flush;
+    Zm::exit(1);
+  } catch (const ZeError &e) {
+    std::cerr << e << '\n' << std::flush;
+    Zm::exit(1);
+  } catch (...) {
+    Zm::exit(1);
+  }
+
+  ZeLog::init("zdbrecgaptest");
+  ZeLog::level(0);
+  ZeLog::sink(ZeLog::fileSink(ZeSinkOptions{}.path("&2"))); // log to stderr
+  ZeLog::start();
+
+  ZmTrap::trap();
+
+  try {
+    appMx = new ZmScheduler{ZmSchedParams().nThreads(1)};
+    dbMx = new ZiMultiplex{ZvMxParams{"dbMx", cf->getCf<true>("dbMx")}};
+
+    appMx->start();
+    if (!dbMx->start()) throw ZeEVENT(Fatal, "multiplexer start failed");
+
+    ZmAtomic<unsigned> ok = 0;
+
+    for (unsigned i = 0; i < 2; i++) {
+      store[i] = new zdbtest::Store();
+      db[i] = new Zdb();
+
+      ZdbCf dbCf{cf};
+
+      dbCf.hostID = (ZuStringN<16>{} << i);
+
+      db[i]->init(ZuMv(dbCf), dbMx, ZdbHandler{
+	.upFn = [](Zdb *, ZdbHost *) { },
+	.downFn = [](Zdb *, bool) { }
+      }, store[i]);
+
+      orders[i] = db[i]->initTable<Order>("order"); // might throw
+    }
+
+    auto started = [&ok](bool ok_) { if (ok_) ++ok; done.post(); };
+
+    db[0]->start(started);
+    done.wait();
+    check(ok == 1);
+    check(db[0]->active());
+
+    // recovered records can only be found in the replication buffer
+    // cache, not in the object cache
+    orders[0]->writeCache(false);
+
+    // UN 0 is committed to the data store and evicted from the cache
+    orders[0]->run(0, []() { insert(0); });
+    barrier(0);
+    store[0]->sync();
+    barrier(0);
+
+    // UNs 1-3 remain cached, their writes are deferred
+    store[0]->deferWork(true);
+    store[0]->deferCallbacks(true);
+    orders[0]->run(0, []() { for (unsigned i = 1; i < 4; i++) insert(i); });
+    barrier(0);
+
+    // host 1 recovers UN 0 from the data store (deferred); batches for
+    // UNs 1-3 are entirely cached, but are sent after UN 0
+    db[1]->start(started);
+    {
+      unsigned i;
+      for (i = 0; i < 500 && store[0]->pendingWork() < 2; i++)
+	Zm::sleep(.01);
+      check(i < 500);
+    }
+
+    // commit UNs 1-3, evicting them from the cache, then complete
+    // recovery of UN 0, which sends all four batches
+    store[0]->performWork();
+    store[0]->deferWork(false);
+    store[0]->performCallbacks();
+    store[0]->deferCallbacks(false);
+
+    done.wait();
+    check(ok == 2);
+
+    {
+      unsigned i;
+      for (i = 0; i < 500 &&
+	  orders[1]->nextUN(0) < orders[0]->nextUN(0); i++)
+	Zm::sleep(.01);
+      check(orders[1]->nextUN(0) == 4);
+    }
+    for (unsigned i = 0; i < 4; i++) check(found(i));
+
+    for (unsigned i = 0; i < 2; i++)
+      db[i]->stop();
+
+    appMx->stop();
+    dbMx->stop();
+
+    for (unsigned i = 0; i < 2; i++) {
+      orders[i] = {};
+      db[i]->final(); // calls Store::final()
+      db[i] = {};
+      store[i] = {};
+    }
+
+  } catch (const ZvError &e) {
+    ZeLOG(Fatal, ZtString{e});
+    gtfo();
+  } catch (const ZeError &e) {
+    ZeLOG(Fatal, ZtString{e});
+    gtfo();
+  } catch (const ZeAnyEvent &e) {
+    ZeLogEvent(ZeVEvent{e});
+    gtfo();
+  } catch (...) {
+    ZeLOG(Fatal, "unknown exception");
+    gtfo();
+  }
+
+  if (appMx) delete appMx;
+  if (dbMx) delete dbMx;
+
+  ZeLog::stop();
+
+  return 0;
+}
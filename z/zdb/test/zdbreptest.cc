@@ -6,6 +6,8 @@
 
 #include <zlib/ZuLib.hh>
 
+#include <stdlib.h>
+
 #include <zlib/ZmTrap.hh>
 
 #include <zlib/ZeLog.hh>
@@ -56,10 +58,23 @@ void gtfo()
   Zm::exit(1);
 }
 
-int main()
+void usage()
+{
+  std::cerr <<
+    "usage: zdbreptest [N]\n"
+    "  N\tload N orders into host 0 before host 1 starts, "
+    "then measure recovery\n" << std::flush;
+  Zm::exit(1);
+}
+
+int main(int argc, char **argv)
 {
   ZmRef<ZvCf> cf;
   ZuString hashOut;
+  unsigned nRecover = 0;
+
+  if (argc > 2) usage();
+  if (argc > 1 && !(nRecover = atoi(argv[1]))) usage();
 
   try {
     cf = inlineCf(
@@ -134,11 +149,45 @@ int main()
       }, store[i]);
 
       orders[i] = db[i]->initTable<Order>("order"); // might throw
+    }
+
+    auto started = [&ok](bool ok_) { if (ok_) ++ok; done.post(); };
 
-      db[i]->start([&ok](bool ok_) { if (ok_) ++ok; done.post(); });
+    db[0]->start(started);
+
+    // load host 0 while host 1 is down, so that it is recovered
+    if (nRecover) {
+      done.wait();
+      if (ok) {
+	orders[0]->run(0, [nRecover]{
+	  for (unsigned i = 0; i < nRecover; i++)
+	    orders[0]->insert(0, [i, nRecover](ZdbObject<Order> *o) {
+	      bool last = i == nRecover - 1;
+	      if (ZuUnlikely(!o)) { if (last) done.post(); return; }
+	      new (o->ptr()) Order{
+		"IBM", 3 + i, "FIX1", ZuStringN<32>{} << "rec" << i, i,
+		Side::Buy, {100}, {100}};
+	      o->commit();
+	      if (last) done.post();
+	    });
+	});
+	done.wait();
+      }
     }
 
-    for (unsigned i = 0; i < 2; i++) done.wait();
+    ZuTime begin = Zm::now();
+
+    db[1]->start(started);
+
+    for (unsigned i = !!nRecover; i < 2; i++) done.wait();
+
+    if (nRecover && ok >= 2) {
+      while (orders[1]->nextUN(0) < orders[0]->nextUN(0)) Zm::sleep(.01);
+      double elapsed = (Zm::now() - begin).as_fp();
+      std::cout << "recovered " << db[0]->recovered() << " records in "
+	<< ZuBoxed(elapsed).fmt<ZuFmt::FP<3>>() << "s ("
+	<< db[0]->recoveryRate() << " records/sec)\n" << std::flush;
+    }
 
     if (ok >= 2) {
       ZmAssert(db[0]->active());
@@ -0,0 +1,647 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// Zdb log-structured file data store
+
+#include <zlib/ZdbFile.hh>
+
+#include <zlib/ZuSort.hh>
+
+#include <zlib/ZiDir.hh>
+
+Zdb_::Store *ZdbStore()
+{
+  return new ZdbFile::Store{};
+}
+
+namespace ZdbFile {
+
+// --- file data store table
+
+StoreTbl::StoreTbl(
+  Store *store, ZuID id, unsigned nShards,
+  ZtVFieldArray fields, ZtVKeyFieldArray keyFields,
+  const reflection::Schema *schema, IOBufAllocFn bufAllocFn
+) :
+  Base{
+    store, id, nShards,
+    ZuMv(fields), ZuMv(keyFields), schema, ZuMv(bufAllocFn)}
+{
+  m_segUN.length(nShards);
+  for (unsigned i = 0; i < nShards; i++) m_segUN[i] = ZdbNullUN();
+}
+
+ZiFile::Path StoreTbl::segName(unsigned index, bool tmp) const
+{
+  ZuStringN<32> name;
+  name << id() << '_'
+    << ZuBox<unsigned>{index}.hex<false, ZuFmt::Right<8>>()
+    << (tmp ? ".tmp" : ".zdb");
+  return ZiFile::append(store()->dir(), ZiFile::Path{name});
+}
+
+void StoreTbl::open(OpenFn openFn)
+{
+  store()->run([this, openFn = ZuMv(openFn)]() mutable {
+    if (!m_recovered) {
+      auto result = recover();
+      if (result.is<Event>()) {
+	openFn(OpenResult{ZuMv(result).p<Event>()});
+	return;
+      }
+      m_recovered = true;
+    }
+    // start a new segment, snapshotting the last UN / SN
+    m_segUN = maxUN();
+    m_segSN = maxSN();
+    ZeError e;
+    if (openSeg(m_file, m_segIndex, 0, false, m_offset, &e) != Zi::OK) {
+      openFn(OpenResult{ZeVEVENT(Error,
+	([path = segName(m_segIndex), e](auto &s, const auto &) {
+	  s << "open(\"" << path << "\") failed: " << e;
+	}))});
+      return;
+    }
+    Base::open();
+    openFn(OpenResult{OpenData{
+      .storeTbl = this,
+      .count = count(),
+      .un = maxUN(),
+      .sn = maxSN()
+    }});
+    if (m_segIndex - m_minIndex >= store()->compactSegs()) compact();
+  });
+}
+
+void StoreTbl::close(CloseFn closeFn)
+{
+  store()->run([this, closeFn = ZuMv(closeFn)]() mutable {
+    if (!opened()) { closeFn(); return; }
+    flush();
+    if (m_compaction) {
+      auto path = segName(m_compaction->index, true);
+      m_compaction->file.close();
+      ZiFile::remove(path);
+      m_compaction = nullptr;
+    }
+    m_file.close();
+    ++m_segIndex; // current segment is now sealed
+    Base::close(ZuMv(closeFn));
+  });
+}
+
+// --- recovery
+
+StoreTbl::RecoverResult StoreTbl::recover()
+{
+  // enumerate segments, removing any incomplete compactions
+  ZtArray<unsigned> indices;
+  {
+    const auto &path = store()->dir();
+    ZiDir dir;
+    ZeError e;
+    if (dir.open(path, &e) != Zi::OK)
+      return {ZeVEVENT(Error, ([path, e](auto &s, const auto &) {
+	s << "ZiDir::open(\"" << path << "\") failed: " << e;
+      }))};
+    ZuStringN<16> prefix;
+    prefix << id() << '_';
+    ZtArray<unsigned> tmpIndices;
+    ZiDir::Path fileName;
+    while (dir.read(fileName) == Zi::OK) {
+#ifdef _WIN32
+      ZtString fileName_{fileName};
+#else
+      auto &fileName_ = fileName;
+#endif
+      unsigned n = prefix.length();
+      if (fileName_.length() != n + 12 ||
+	  memcmp(fileName_.data(), prefix.data(), n)) continue;
+      const char *suffix = fileName_.data() + n + 8;
+      bool tmp = !memcmp(suffix, ".tmp", 4);
+      if (!tmp && memcmp(suffix, ".zdb", 4)) continue;
+      ZuBox<unsigned> index{
+	ZuFmt::Hex<>{}, ZuString{fileName_.data() + n, 8}};
+      if (tmp)
+	tmpIndices.push(index);
+      else
+	indices.push(index);
+    }
+    dir.close();
+    tmpIndices.all([this](unsigned index) {
+      ZiFile::remove(segName(index, true));
+    });
+  }
+  unsigned n = indices.length();
+  if (!n) return {};
+  ZuSort(indices.data(), n);
+
+  // skip everything preceding the most recent compacted segment
+  unsigned first = 0;
+  {
+    ZtArray<uint8_t> hdr;
+    for (unsigned i = n; i-- > 0; ) {
+      ZiFile file;
+      if (file.open(segName(indices[i]), ZiFile::ReadOnly | ZiFile::GC) !=
+	  Zi::OK) continue;
+      if (loadSegHdr(file, hdr, nullptr) != Zi::OK) continue;
+      if (reinterpret_cast<const SegHdr *>(hdr.data())->flags &
+	  SegHdr::Compacted) {
+	first = i;
+	break;
+      }
+    }
+  }
+  for (unsigned i = 0; i < first; i++) ZiFile::remove(segName(indices[i]));
+
+  // replay segments in order
+  ZtArray<uint8_t> hdr;
+  for (unsigned i = first; i < n; i++) {
+    bool last = i == n - 1;
+    auto path = segName(indices[i]);
+    ZiFile file;
+    ZeError e;
+    if (file.open(path, ZiFile::GC, 0666, &e) != Zi::OK)
+      return {ZeVEVENT(Error, ([path, e](auto &s, const auto &) {
+	s << "open(\"" << path << "\") failed: " << e;
+      }))};
+    int r = loadSegHdr(file, hdr, &e);
+    if (r == Zi::IOError)
+      return {ZeVEVENT(Error, ([path, e](auto &s, const auto &) {
+	s << "pread(\"" << path << "\") failed: " << e;
+      }))};
+    if (r != Zi::OK) {
+      if (last) { // segment created immediately prior to failure
+	file.close();
+	ZiFile::remove(path);
+	break;
+      }
+      return {ZeVEVENT(Error, ([path](auto &s, const auto &) {
+	s << '"' << path << "\": invalid segment header";
+      }))};
+    }
+    auto segHdr = reinterpret_cast<const SegHdr *>(hdr.data());
+    if (segHdr->nShards != nShards())
+      return {ZeVEVENT(Error,
+	([path, n = unsigned(segHdr->nShards)](auto &s, const auto &) {
+	  s << '"' << path << "\": inconsistent nShards " << n;
+	}))};
+    ZiFile::Offset offset = segHdr->size();
+    if (replay(file, segHdr, offset, &e) != Zi::OK)
+      return {ZeVEVENT(Error, ([path, e](auto &s, const auto &) {
+	s << "pread(\"" << path << "\") failed: " << e;
+      }))};
+    if (offset < file.size()) {
+      if (!last)
+	return {ZeVEVENT(Error,
+	  ([path, offset = uint64_t(offset)](auto &s, const auto &) {
+	    s << '"' << path << "\": corrupt at offset " << offset;
+	  }))};
+      // torn write - discard the incomplete tail
+      ZeLOG(Warning,
+	([path, offset = uint64_t(offset)](auto &s) {
+	  s << '"' << path << "\": truncated at offset " << offset;
+	}));
+      if (file.truncate(offset, &e) != Zi::OK)
+	return {ZeVEVENT(Error, ([path, e](auto &s, const auto &) {
+	  s << "truncate(\"" << path << "\") failed: " << e;
+	}))};
+    }
+  }
+  m_minIndex = indices[first];
+  m_segIndex = indices[n - 1] + 1;
+  return {};
+}
+
+// returns Zi::OK, Zi::EndOfFile if truncated/invalid, or Zi::IOError
+int StoreTbl::loadSegHdr(ZiFile &file, ZtArray<uint8_t> &hdr, ZeError *e)
+{
+  hdr.length(sizeof(SegHdr));
+  int r = file.pread(0, hdr.data(), sizeof(SegHdr), e);
+  if (r < 0 && r != Zi::EndOfFile) return Zi::IOError;
+  if (r < int(sizeof(SegHdr))) return Zi::EndOfFile;
+  auto segHdr = reinterpret_cast<const SegHdr *>(hdr.data());
+  if (segHdr->magic != SegHdr::Magic || segHdr->nShards > 64)
+    return Zi::EndOfFile;
+  unsigned size = segHdr->size();
+  hdr.length(size);
+  r = file.pread(sizeof(SegHdr),
+    hdr.data() + sizeof(SegHdr), size - sizeof(SegHdr), e);
+  if (r < 0 && r != Zi::EndOfFile) return Zi::IOError;
+  if (r < int(size - sizeof(SegHdr))) return Zi::EndOfFile;
+  return Zi::OK;
+}
+
+// replay messages from offset, updating offset to the end of the
+// last whole valid message
+int StoreTbl::replay(
+  ZiFile &file, const SegHdr *segHdr, ZiFile::Offset &offset, ZeError *e)
+{
+  bool compacted = segHdr->flags & SegHdr::Compacted;
+  unsigned nShards = this->nShards();
+
+  // a compacted segment is a snapshot of the live rows as of its header,
+  // possibly including some rows copied after later updates; subsequent
+  // segments are replayed in full from the UNs in its header
+  if (compacted) {
+    for (unsigned i = 0; i < nShards; i++) m_maxUN[i] = segHdr->un(i);
+    m_maxSN = segHdr->sn;
+  } else {
+    for (unsigned i = 0; i < nShards; i++) {
+      UN un = segHdr->un(i);
+      if (un != ZdbNullUN() &&
+	  (m_maxUN[i] == ZdbNullUN() || un > m_maxUN[i])) m_maxUN[i] = un;
+    }
+    SN sn = segHdr->sn;
+    if (sn != ZdbNullSN() &&
+	(m_maxSN == ZdbNullSN() || sn > m_maxSN)) m_maxSN = sn;
+  }
+
+  enum { ScanSize = 1<<20 };
+  ZtArray<uint8_t> buf;
+  buf.length(ScanSize);
+  ZiFile::Offset pos = offset;	// file offset of buf[0]
+  unsigned length = 0;		// bytes read into buf
+  bool corrupt = false;
+  while (!corrupt) {
+    int r = file.pread(pos + length, buf.data() + length,
+      buf.length() - length, e);
+    if (r == Zi::EndOfFile) break;
+    if (r < 0) return Zi::IOError;
+    length += r;
+    unsigned i = 0;
+    while (length - i >= sizeof(Hdr)) {
+      auto hdr = reinterpret_cast<const Hdr *>(buf.data() + i);
+      if (hdr->length >= (1U<<30)) {
+	corrupt = true;
+	break;
+      }
+      unsigned n = sizeof(Hdr) + hdr->length;
+      if (length - i < n) break;
+      auto record = Zdb_::record(msg(hdr));
+      if (!record || record->shard() >= nShards) {
+	corrupt = true;
+	break;
+      }
+      // rows in a compacted segment are complete and are upserted by
+      // primary key, irrespective of version; errors are expected when
+      // replaying subsequent segments, since the compacted segment may
+      // already include their effects
+      if (compacted)
+	upsert(loadRow(hdr, true));
+      else if (!applied(record))
+	apply(loadRow(hdr));
+      i += n;
+    }
+    if (i) {
+      if (i < length) memmove(buf.data(), buf.data() + i, length - i);
+      pos += i;
+      length -= i;
+    }
+    if (!corrupt && length >= sizeof(Hdr)) {
+      unsigned n = sizeof(Hdr) +
+	reinterpret_cast<const Hdr *>(buf.data())->length;
+      if (n > buf.length()) buf.length(n);
+    }
+  }
+  offset = pos;
+  return Zi::OK;
+}
+
+// --- segment I/O
+
+int StoreTbl::openSeg(
+  ZiFile &file, unsigned index, uint32_t flags, bool tmp,
+  ZiFile::Offset &offset, ZeError *e)
+{
+  int r;
+  if ((r = file.open(segName(index, tmp),
+	  ZiFile::Create | ZiFile::Truncate | ZiFile::GC, 0666, e)) != Zi::OK)
+    return r;
+  unsigned nShards = m_segUN.length();
+  unsigned size = sizeof(SegHdr) + nShards * sizeof(uint64_t);
+  auto hdr_ = ZmAlloc(uint8_t, size);
+  new (&hdr_[0]) SegHdr{
+    .magic = SegHdr::Magic,
+    .flags = flags,
+    .nShards = nShards,
+    .pad_ = 0,
+    .sn = m_segSN
+  };
+  auto un = reinterpret_cast<ZuLittleEndian<uint64_t> *>(
+    &hdr_[0] + sizeof(SegHdr));
+  for (unsigned i = 0; i < nShards; i++)
+    new (&un[i]) ZuLittleEndian<uint64_t>{m_segUN[i]};
+  if ((r = file.write(&hdr_[0], size, e)) != Zi::OK) {
+    file.close();
+    return r;
+  }
+  offset = size;
+  return Zi::OK;
+}
+
+// l(unsigned i) returns the i'th buffer
+template <typename L>
+int StoreTbl::writev(
+  ZiFile &file, unsigned n, L l, ZiFile::Offset &offset, ZeError *e)
+{
+  for (unsigned i = 0; i < n; ) {
+    unsigned m = n - i;
+    if (m > Zi::NVecMax) m = Zi::NVecMax;
+    m_vecs.length(m);
+    unsigned size = 0;
+    for (unsigned j = 0; j < m; j++) {
+      const IOBuf *buf = l(i + j);
+      ZiVec_init(m_vecs[j], const_cast<uint8_t *>(buf->data()), buf->length);
+      size += buf->length;
+    }
+    int r;
+    if ((r = file.writev(m_vecs.data(), m, e)) != Zi::OK) return r;
+    offset += size;
+    i += m;
+  }
+  return Zi::OK;
+}
+
+// seal the current segment and start the next one
+void StoreTbl::roll()
+{
+  m_file.close();
+  ++m_segIndex;
+  m_segUN = maxUN();
+  m_segSN = maxSN();
+  ZeError e;
+  if (openSeg(m_file, m_segIndex, 0, false, m_offset, &e) != Zi::OK) {
+    store()->fail(ZeVEVENT(Error,
+      ([path = segName(m_segIndex), e](auto &s, const auto &) {
+	s << "open(\"" << path << "\") failed: " << e;
+      })));
+    return;
+  }
+  if (m_segIndex - m_minIndex >= store()->compactSegs()) compact();
+}
+
+// --- group commit
+
+void StoreTbl::write(ZmRef<const IOBuf> buf, CommitFn commitFn)
+{
+  store()->run([this, buf = ZuMv(buf), commitFn = ZuMv(commitFn)]() mutable {
+    write_(ZuMv(buf), commitFn);
+  });
+}
+
+// the batch is appended and committed by a single flush()
+void StoreTbl::writeN(ZtArray<ZmRef<const IOBuf>> bufs, CommitFn commitFn)
+{
+  store()->run([
+    this, bufs = ZuMv(bufs), commitFn = ZuMv(commitFn)
+  ]() mutable {
+    for (unsigned i = 0, n = bufs.length(); i < n; i++)
+      write_(ZuMv(bufs[i]), commitFn);
+  });
+}
+
+void StoreTbl::write_(ZmRef<const IOBuf> buf, const CommitFn &commitFn)
+{
+  // idempotence check
+  if (applied(record_(msg_(buf->hdr())))) {
+    commitFn(ZuMv(buf), CommitResult{});
+    return;
+  }
+  // load row, perform insert/update/delete
+  auto result = apply(loadRow(buf));
+  if (result.is<Event>()) {
+    commitFn(ZuMv(buf), ZuMv(result));
+    return;
+  }
+  // defer commit until flushed - flush() is enqueued behind any
+  // writes already queued to the store thread, batching them
+  new (m_pending.push()) Pending{ZuMv(buf), commitFn};
+  if (!m_flushing) {
+    m_flushing = true;
+    store()->run([this]() { flush(); });
+  }
+}
+
+void StoreTbl::flush()
+{
+  m_flushing = false;
+  unsigned n = m_pending.length();
+  if (!n) return;
+  ZeError e;
+  if (writev(m_file, n, [this](unsigned i) {
+    return m_pending[i].buf.ptr();
+  }, m_offset, &e) != Zi::OK) {
+    Event event = ZeVEVENT(Error,
+      ([path = segName(m_segIndex), e](auto &s, const auto &) {
+	s << "writev(\"" << path << "\") failed: " << e;
+      }));
+    commit(CommitResult{event});
+    store()->fail(ZuMv(event));
+    return;
+  }
+  if (store()->sync() && m_file.datasync(&e) != Zi::OK) {
+    Event event = ZeVEVENT(Error,
+      ([path = segName(m_segIndex), e](auto &s, const auto &) {
+	s << "fdatasync(\"" << path << "\") failed: " << e;
+      }));
+    commit(CommitResult{event});
+    store()->fail(ZuMv(event));
+    return;
+  }
+  commit(CommitResult{});
+  if (m_offset >= store()->segSize()) roll();
+}
+
+void StoreTbl::commit(const CommitResult &result)
+{
+  auto pending = ZuMv(m_pending);
+  m_pending = ZtArray<Pending>{};
+  pending.all<true>([&result](Pending &p) {
+    p.commitFn(ZuMv(p.buf), CommitResult{result});
+  });
+}
+
+// --- compaction
+
+void StoreTbl::compact()
+{
+  if (m_compaction || m_segIndex <= m_minIndex) return;
+  ZuPtr<Compaction> compaction = new Compaction{};
+  compaction->index = m_segIndex - 1;
+  // the compacted segment header is the current segment header, which
+  // was snapshotted when the last sealed segment was sealed
+  ZeError e;
+  if (openSeg(compaction->file, compaction->index,
+	SegHdr::Compacted, true, compaction->offset, &e) != Zi::OK) {
+    ZeLOG(Error,
+      ([path = segName(compaction->index, true), e](auto &s) {
+	s << "open(\"" << path << "\") failed: " << e;
+      }));
+    return;
+  }
+  m_compaction = ZuMv(compaction);
+  store()->run([this]() { compactChunk(); });
+}
+
+// copy the next chunk of live rows, yielding to writes in between chunks;
+// rows updated after compaction started may be copied more than once
+void StoreTbl::compactChunk()
+{
+  auto compaction = m_compaction.ptr();
+  if (!compaction) return; // aborted by close()
+  auto row = compaction->started ?
+    m_indexUN.find<ZmRBTreeGreater>(compaction->key) :
+    m_indexUN.find<ZmRBTreeGreaterEqual>(ZuTuple<unsigned, UN>{0, 0});
+  unsigned n = store()->compactChunk();
+  ZtArray<ZmRef<IOBuf>> bufs;
+  bufs.size(n);
+  while (row && bufs.length() < n) {
+    bufs.push(saveRow<false>(row));
+    compaction->key = ZuTuple<unsigned, UN>{row->shard, row->un};
+    row = m_indexUN.next(row);
+  }
+  compaction->started = true;
+  ZeError e;
+  if (writev(compaction->file, bufs.length(), [&bufs](unsigned i) {
+    return bufs[i].ptr();
+  }, compaction->offset, &e) != Zi::OK) {
+    compactAbort(ZeVEVENT(Error,
+      ([path = segName(compaction->index, true), e](auto &s, const auto &) {
+	s << "writev(\"" << path << "\") failed: " << e;
+      })));
+    return;
+  }
+  compaction->count += bufs.length();
+  if (row)
+    store()->run([this]() { compactChunk(); });
+  else
+    compacted();
+}
+
+// atomically replace the sealed segments with the compacted segment
+void StoreTbl::compacted()
+{
+  auto compaction = m_compaction.ptr();
+  auto tmpPath = segName(compaction->index, true);
+  auto path = segName(compaction->index);
+  ZeError e;
+  if (compaction->file.datasync(&e) != Zi::OK) {
+    compactAbort(ZeVEVENT(Error, ([tmpPath, e](auto &s, const auto &) {
+      s << "fdatasync(\"" << tmpPath << "\") failed: " << e;
+    })));
+    return;
+  }
+  compaction->file.close();
+  if (ZiFile::rename(tmpPath, path, &e) != Zi::OK) {
+    compactAbort(ZeVEVENT(Error, ([tmpPath, path, e](auto &s, const auto &) {
+      s << "rename(\"" << tmpPath << "\", \"" << path << "\") failed: " << e;
+    })));
+    return;
+  }
+  for (unsigned i = m_minIndex; i < compaction->index; i++)
+    ZiFile::remove(segName(i));
+  ZeLOG(Info, ([
+    id = this->id(), n = compaction->index - m_minIndex + 1,
+    count = compaction->count
+  ](auto &s) {
+    s << id << " compacted " << n << " segments, " << count << " rows";
+  }));
+  m_minIndex = compaction->index;
+  m_compaction = nullptr;
+}
+
+void StoreTbl::compactAbort(Event e)
+{
+  auto compaction = m_compaction.ptr();
+  compaction->file.close();
+  ZiFile::remove(segName(compaction->index, true));
+  m_compaction = nullptr;
+  ZeLogEvent(ZuMv(e));
+}
+
+// --- file data store
+
+InitResult Store::init(ZvCf *cf, ZiMultiplex *mx, unsigned, FailFn failFn)
+{
+  if (!m_storeTbls) m_storeTbls = new StoreTbls{};
+  m_failFn = ZuMv(failFn);
+  try {
+    const ZtString &tid = cf->get<true>("thread");
+    auto sid = mx->sid(tid);
+    if (!sid ||
+	sid > mx->params().nThreads() ||
+	sid == mx->rxThread() ||
+	sid == mx->txThread())
+      return {ZeVEVENT(Fatal, ([tid = ZtString{tid}](auto &s, const auto &) {
+	s << "Store::init() failed: invalid thread configuration \""
+	  << tid << '"';
+      }))};
+    Store__::init(mx, sid);
+    m_dir = cf->get<true>("dir");
+    m_segSize = cf->getInt("segSize", 1<<16, 1<<30, 64<<20);
+    m_compactSegs = cf->getInt("compactSegs", 2, 1<<10, 4);
+    m_compactChunk = cf->getInt("compactChunk", 1, 1<<20, 1000);
+    m_sync = cf->getBool("sync", true);
+  } catch (const ZvError &e_) {
+    ZtString e;
+    e << e_;
+    return {ZeVEVENT(Fatal, ([e = ZuMv(e)](auto &s, const auto &) {
+      s << "Store::init() failed: invalid configuration: " << e;
+    }))};
+  }
+  if (!ZiFile::isdir(m_dir)) {
+    ZeError e;
+    if (ZiFile::mkdir(m_dir, &e) != Zi::OK)
+      return {ZeVEVENT(Fatal, ([dir = m_dir, e](auto &s, const auto &) {
+	s << "Store::init() failed: mkdir(\"" << dir << "\") failed: " << e;
+      }))};
+  }
+  return {InitData{.replicated = false}};
+}
+
+void Store::final()
+{
+  m_failFn = FailFn{};
+  if (m_storeTbls) {
+    m_storeTbls->clean();
+    m_storeTbls = nullptr;
+  }
+}
+
+void Store::open(
+  ZuID id,
+  unsigned nShards,
+  ZtVFieldArray fields,
+  ZtVKeyFieldArray keyFields,
+  const reflection::Schema *schema,
+  IOBufAllocFn bufAllocFn,
+  OpenFn openFn)
+{
+  StoreTblNode *storeTbl = m_storeTbls->find(id);
+  if (storeTbl && storeTbl->opened()) {
+    openFn(OpenResult{ZeVEVENT(Error, ([id](auto &s, const auto &) {
+      s << "open(" << id << ") failed - already open";
+    }))});
+    return;
+  }
+  if (storeTbl) {
+    if (nShards != storeTbl->nShards()) {
+      openFn(OpenResult{ZeVEVENT(Error, ([id](auto &s, const auto &) {
+	s << "open(" << id << ") failed - inconsistent nShards";
+      }))});
+      return;
+    }
+  } else {
+    storeTbl = new StoreTblNode{
+      this, id, nShards,
+      ZuMv(fields), ZuMv(keyFields), schema, ZuMv(bufAllocFn)};
+    m_storeTbls->addNode(storeTbl);
+  }
+  storeTbl->open(ZuMv(openFn));
+}
+
+} // ZdbFile
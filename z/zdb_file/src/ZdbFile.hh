@@ -0,0 +1,209 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// Zdb log-structured file data store
+//
+// each table is persisted as a sequence of append-only segment files,
+// DIR/TABLE_NNNNNNNN.zdb, each comprising a segment header followed by
+// replication messages in the same format used on the network; every
+// row is also kept in memory - ZdbFile::StoreTbl derives from
+// ZdbMem::StoreTbl, which holds a full copy of the table and serves all
+// reads - and this copy is rebuilt on open by replaying the segments
+// in order, so the table must fit in memory
+//
+// - writes are applied in memory, appended to the current segment and
+//   committed following the next fdatasync(), which is deferred until
+//   the store thread has drained its queue so that concurrent writes
+//   are batched into a single sync (group commit)
+// - the current segment is sealed once it exceeds segSize; when
+//   compactSegs sealed segments have accumulated, the live rows are
+//   incrementally copied (compactChunk rows at a time) into a single
+//   compacted segment which then atomically replaces them
+// - each segment header snapshots the last UN of each shard and the
+//   last SN, so trailing deletions are recovered without an MRD table
+
+#ifndef ZdbFile_HH
+#define ZdbFile_HH
+
+#ifndef ZdbFileLib_HH
+#include <zlib/ZdbFileLib.hh>
+#endif
+
+#include <zlib/ZuByteSwap.hh>
+#include <zlib/ZuPtr.hh>
+
+#include <zlib/ZtArray.hh>
+
+#include <zlib/ZiFile.hh>
+
+#include <zlib/ZdbMemStore.hh>
+
+namespace ZdbFile {
+
+using namespace Zdb_;
+
+// --- segment file format
+
+#pragma pack(push, 4)
+struct SegHdr {
+  enum { Magic = 0x4c62645a };	// "ZdbL"
+  enum { Compacted = 1 };	// flags
+
+  ZuLittleEndian<uint32_t>	magic;
+  ZuLittleEndian<uint32_t>	flags;
+  ZuLittleEndian<uint32_t>	nShards;
+  ZuLittleEndian<uint32_t>	pad_;
+  ZuLittleEndian<uint128_t>	sn;	// last SN as of segment creation
+  // followed by nShards little-endian uint64_t UNs, the last UN
+  // of each shard as of segment creation
+
+  unsigned size() const {
+    return sizeof(SegHdr) + nShards * sizeof(uint64_t);
+  }
+  UN un(unsigned shard) const {
+    using UN_ = ZuLittleEndian<uint64_t>;
+    return reinterpret_cast<const UN_ *>(this + 1)[shard];
+  }
+};
+#pragma pack(pop)
+
+// --- file data store table
+
+class Store;
+
+class ZdbFileAPI StoreTbl : public ZdbMem::StoreTbl {
+  using Base = ZdbMem::StoreTbl;
+
+public:
+  using Store = ZdbFile::Store;
+
+  StoreTbl(
+    Store *store, ZuID id, unsigned nShards,
+    ZtVFieldArray fields, ZtVKeyFieldArray keyFields,
+    const reflection::Schema *schema, IOBufAllocFn bufAllocFn);
+
+  Store *store() const;
+
+  // recover (if not already recovered), then start a new segment
+  void open(OpenFn);
+  void close(CloseFn);
+
+  void write(ZmRef<const IOBuf>, CommitFn);
+  void writeN(ZtArray<ZmRef<const IOBuf>>, CommitFn);
+
+  // compact all sealed segments (no-op if compaction is in progress)
+  void compact();
+
+private:
+  ZiFile::Path segName(unsigned index, bool tmp = false) const;
+
+  // recovery
+  using RecoverResult = ZuUnion<void, Event>;
+  RecoverResult recover();
+  int loadSegHdr(ZiFile &file, ZtArray<uint8_t> &hdr, ZeError *e);
+  int replay(
+    ZiFile &file, const SegHdr *segHdr, ZiFile::Offset &offset, ZeError *e);
+
+  // segment I/O
+  int openSeg(
+    ZiFile &file, unsigned index, uint32_t flags, bool tmp,
+    ZiFile::Offset &offset, ZeError *e);
+  template <typename L>
+  int writev(
+    ZiFile &file, unsigned n, L l, ZiFile::Offset &offset, ZeError *e);
+  void roll();
+
+  // group commit
+  void write_(ZmRef<const IOBuf>, const CommitFn &);
+  void flush();
+  void commit(const CommitResult &);
+
+  // compaction
+  void compactChunk();
+  void compacted();
+  void compactAbort(Event);
+
+private:
+  struct Pending {
+    ZmRef<const IOBuf>	buf;
+    CommitFn		commitFn;
+  };
+
+  struct Compaction {
+    ZiFile			file;
+    ZiFile::Offset		offset = 0;
+    unsigned			index = 0;	// last segment being replaced
+    ZuTuple<unsigned, UN>	key;		// UN index position
+    bool			started = false;
+    uint64_t			count = 0;	// rows written
+  };
+
+  bool			m_recovered = false;
+
+  // segments [m_minIndex, m_segIndex) are sealed, m_segIndex is current
+  unsigned		m_minIndex = 0;
+  unsigned		m_segIndex = 0;
+  ZiFile		m_file;			// current segment
+  ZiFile::Offset	m_offset = 0;		// current segment length
+  ZtArray<UN>		m_segUN;		// current segment header UNs
+  SN			m_segSN = ZdbNullSN();	// current segment header SN
+
+  ZtArray<Pending>	m_pending;
+  ZtArray<ZiVec>	m_vecs;
+  bool			m_flushing = false;
+
+  ZuPtr<Compaction>	m_compaction;
+};
+
+// --- file data store
+
+class ZdbFileAPI Store : public Zdb_::Store, public ZdbMem::Store__ {
+  using StoreTbls = ZdbMem::StoreTbls_<StoreTbl>;
+  using StoreTblNode = typename StoreTbls::Node;
+
+public:
+  InitResult init(ZvCf *cf, ZiMultiplex *mx, unsigned, FailFn failFn);
+  void final();
+
+  void open(
+      ZuID id,
+      unsigned nShards,
+      ZtVFieldArray fields,
+      ZtVKeyFieldArray keyFields,
+      const reflection::Schema *schema,
+      IOBufAllocFn bufAllocFn,
+      OpenFn openFn);
+
+  const ZiFile::Path &dir() const { return m_dir; }
+  unsigned segSize() const { return m_segSize; }
+  unsigned compactSegs() const { return m_compactSegs; }
+  unsigned compactChunk() const { return m_compactChunk; }
+  bool sync() const { return m_sync; }
+
+  void fail(Event e) { m_failFn(ZuMv(e)); }
+
+private:
+  ZmRef<StoreTbls>	m_storeTbls;
+  FailFn		m_failFn;
+  ZiFile::Path		m_dir;
+  unsigned		m_segSize = 0;		// segment size threshold
+  unsigned		m_compactSegs = 0;	// sealed segments before compact
+  unsigned		m_compactChunk = 0;	// rows per compaction chunk
+  bool			m_sync = true;		// fdatasync() on commit
+};
+
+inline ZdbFile::Store *StoreTbl::store() const {
+  return static_cast<Store *>(Base::store());
+}
+
+} // ZdbFile
+
+// main data store driver entry point
+extern "C" {
+  ZdbFileExtern Zdb_::Store *ZdbStore();
+}
+
+#endif /* ZdbFile_HH */
@@ -0,0 +1,13 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// Zdb file library
+
+#include <zlib/ZdbFileLib.hh>
+
+#include "../../version.h"
+
+ZdbFileExtern const char ZdbFileLib[] = "@(#) Zdb File Library v" Z_VERNAME;
@@ -0,0 +1,33 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// Zdb file library main header
+
+#ifndef ZdbFileLib_HH
+#define ZdbFileLib_HH
+
+#include <zlib/ZuLib.hh>
+
+#ifdef _WIN32
+
+#ifdef ZDB_FILE_EXPORTS
+#define ZdbFileAPI ZuExport_API
+#define ZdbFileExplicit ZuExport_Explicit
+#else
+#define ZdbFileAPI ZuImport_API
+#define ZdbFileExplicit ZuImport_Explicit
+#endif
+#define ZdbFileExtern extern ZdbFileAPI
+
+#else
+
+#define ZdbFileAPI
+#define ZdbFileExplicit
+#define ZdbFileExtern extern
+
+#endif
+
+#endif /* ZdbFileLib_HH */
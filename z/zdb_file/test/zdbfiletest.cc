@@ -0,0 +1,462 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// log-structured file data store test - the store directory is cleared,
+// then rows are inserted, updated and deleted with segSize at its minimum
+// and compactSegs 2, so that segments are rolled and compacted; the
+// table is reopened repeatedly and its contents checked, including
+// after compaction and after truncation of the final record
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+
+#include <zlib/ZmTrap.hh>
+
+#include <zlib/ZeLog.hh>
+
+#include <zlib/ZiDir.hh>
+#include <zlib/ZiFile.hh>
+
+#include <zlib/ZvCf.hh>
+#include <zlib/ZvMxParams.hh>
+
+#include <zlib/Zdb.hh>
+
+#include "zdbtest.hh"
+
+using namespace zdbtest;
+
+// database
+ZmRef<Zdb> db;
+
+// table
+ZmRef<ZdbTable<Order>> orders;
+
+// app scheduler, Zdb multiplexer
+ZmScheduler *appMx = nullptr;
+ZiMultiplex *dbMx = nullptr;
+
+// data store directory
+ZiFile::Path dir;
+
+ZmSemaphore done;
+
+enum { N = 2000 };	// number of orders initially inserted
+
+ZmRef<ZvCf> inlineCf(ZuString s)
+{
+  ZmRef<ZvCf> cf = new ZvCf{};
+  cf->fromString(s);
+  return cf;
+}
+
+void usage()
+{
+  static const char *help =
+    "Usage: zdbfiletest [OPTION]...\n\n"
+    "Options:\n"
+    "      --help\t\tthis help\n"
+    "  -m, --module=MODULE\tspecify data store module (default: $ZDB_MODULE)\n"
+    "  -D, --dir=DIR\t\t"
+      "specify data store directory (default: $ZDB_DIR)\n"
+    "\nthe order table is removed from the data store directory\n"
+    ;
+
+  std::cerr << help << std::flush;
+  Zm::exit(1);
+}
+
+void gtfo()
+{
+  if (dbMx) dbMx->stop();
+  if (appMx) appMx->stop();
+  ZeLog::stop();
+  Zm::exit(1);
+}
+
+#define check(x) check_(x, __LINE__, #x)
+void check_(bool ok, unsigned line, const char *exp)
+{
+  printf("%s %6d %s\n", ok ? " OK " : "NOK ", line, exp);
+  fflush(stdout);
+  if (!ok) gtfo();
+}
+
+// --- segment files
+
+ZiFile::Path segName(unsigned index)
+{
+  ZuStringN<32> name;
+  name << "order_"
+    << ZuBox<unsigned>{index}.hex<false, ZuFmt::Right<8>>() << ".zdb";
+  return ZiFile::append(dir, ZiFile::Path{name});
+}
+
+// segments of the order table, optionally removing them
+struct Segs {
+  unsigned	n = 0;		// number of segments
+  unsigned	tmp = 0;	// number of compactions in progress
+  unsigned	min = 0;	// lowest segment index
+  unsigned	max = 0;	// highest segment index
+};
+Segs segs(bool remove = false)
+{
+  Segs segs;
+  ZiDir dir_;
+  if (dir_.open(dir) != Zi::OK) return segs;
+  ZiDir::Path fileName;
+  while (dir_.read(fileName) == Zi::OK) {
+#ifdef _WIN32
+    ZtString fileName_{fileName};
+#else
+    auto &fileName_ = fileName;
+#endif
+    if (fileName_.length() != 18 || memcmp(fileName_.data(), "order_", 6))
+      continue;
+    const char *suffix = fileName_.data() + 14;
+    bool tmp = !memcmp(suffix, ".tmp", 4);
+    if (!tmp && memcmp(suffix, ".zdb", 4)) continue;
+    if (remove) {
+      ZiFile::remove(ZiFile::append(dir, fileName));
+      continue;
+    }
+    if (tmp) { ++segs.tmp; continue; }
+    ZuBox<unsigned> index{
+      ZuFmt::Hex<>{}, ZuString{fileName_.data() + 6, 8}};
+    if (!segs.n || index < segs.min) segs.min = index;
+    if (!segs.n || index > segs.max) segs.max = index;
+    ++segs.n;
+  }
+  dir_.close();
+  return segs;
+}
+
+// wait for any compaction to complete, leaving the compacted segment
+// and the current segment
+bool compacted()
+{
+  for (unsigned i = 0; i < 1000; i++) {
+    auto segs = ::segs();
+    if (!segs.tmp && segs.n <= 2 && segs.min > 0) return true;
+    Zm::sleep(.01);
+  }
+  return false;
+}
+
+// truncate the last segment, tearing its final record
+bool truncate()
+{
+  ZiFile file;
+  if (file.open(segName(segs().max), ZiFile::GC) != Zi::OK) return false;
+  auto size = file.size();
+  return size > 1 && file.truncate(size - 1) == Zi::OK;
+}
+
+// --- database operations
+
+void start(ZvCf *cf)
+{
+  db->init(ZdbCf(cf), dbMx, ZdbHandler{
+      .upFn = [](Zdb *, ZdbHost *) { done.post(); },
+      .downFn = [](Zdb *, bool) { }
+  });
+
+  orders = db->initTable<Order>("order"); // might throw
+
+  if (!db->start()) throw ZeEVENT(Fatal, "Zdb start failed");
+  done.wait(); // ensure active
+}
+
+void stop()
+{
+  db->stop(); // flushes and closes all tables
+  orders = {};
+  db->final(); // calls Store::final()
+}
+
+bool insert(uint64_t orderID)
+{
+  bool ok = false;
+  orders->run(0, [orderID, &ok]() {
+    orders->insert(0, [orderID, &ok](ZdbObject<Order> *o) {
+      if (ZuUnlikely(!o)) { done.post(); return; }
+      new (o->ptr()) Order{
+	"IBM", orderID, "FIX0", ZuStringN<32>{} << "order" << orderID,
+	orderID, Side::Buy, {100}, {100}};
+      o->commit();
+      ok = true;
+      done.post();
+    });
+  });
+  done.wait();
+  return ok;
+}
+
+bool update(uint64_t orderID, int qty)
+{
+  bool ok = false;
+  orders->run(0, [orderID, qty, &ok]() {
+    orders->findUpd<0>(0, ZuFwdTuple("IBM", orderID),
+      [qty, &ok](ZmRef<ZdbObject<Order>> o) {
+	if (o) {
+	  o->data().qtys[0] = qty;
+	  o->commit();
+	  ok = true;
+	}
+	done.post();
+      });
+  });
+  done.wait();
+  return ok;
+}
+
+bool del(uint64_t orderID)
+{
+  bool ok = false;
+  orders->run(0, [orderID, &ok]() {
+    orders->findDel<0>(0, ZuFwdTuple("IBM", orderID),
+      [&ok](ZmRef<ZdbObject<Order>> o) {
+	if (o) {
+	  o->commit();
+	  ok = true;
+	}
+	done.post();
+      });
+  });
+  done.wait();
+  return ok;
+}
+
+// find order by primary key, returning its quantity, -1 if not found
+int find(uint64_t orderID)
+{
+  int qty = -1;
+  orders->run(0, [orderID, &qty]() {
+    orders->find<0>(0, ZuFwdTuple("IBM", orderID),
+      [&qty](ZmRef<ZdbObject<Order>> o) {
+	if (o) qty = o->data().qtys[0];
+	done.post();
+      });
+  });
+  done.wait();
+  return qty;
+}
+
+// --- expected contents
+
+// orders 1..N are inserted with quantity 100, odd orders are updated
+// to 200, every tenth order is deleted; then following compaction
+// order 2 is updated to 300 and order 3 is deleted
+bool phase2 = false;
+
+int expected(uint64_t orderID)
+{
+  if (!(orderID % 10)) return -1;
+  if (phase2) {
+    if (orderID == 2) return 300;
+    if (orderID == 3) return -1;
+  }
+  return (orderID & 1) ? 200 : 100;
+}
+
+unsigned expectedCount()
+{
+  return N - N / 10 - phase2;
+}
+
+// check the contents of orders 1..N
+bool verify()
+{
+  for (uint64_t i = 1; i <= N; i++) {
+    int qty = find(i);
+    if (qty != expected(i)) {
+      ZeLOG(Error, ([i, qty](auto &s) {
+	s << "order " << i << ": unexpected quantity " << qty;
+      }));
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  ZmRef<ZvCf> cf;
+
+  try {
+    ZmRef<ZvCf> options = inlineCf(
+      "module m m { param store.module }\n"
+      "dir D D { param store.dir }\n"
+      "help { flag help }\n");
+
+      // "  module ../src/.libs/libZdbFile.so\n"
+      // "  dir /tmp/zdbfiletest\n"
+
+    cf = inlineCf(
+      "thread zdb\n"
+      "hostID 0\n"
+      "hosts {\n"
+      "  0 { standalone 1 }\n"
+      "}\n"
+      "store {\n"
+      "  module ${ZDB_MODULE}\n"
+      "  dir ${ZDB_DIR}\n"
+      "  thread zdb_file\n"
+      "  segSize 65536\n"
+      "  compactSegs 2\n"
+      "  compactChunk 100\n"
+      "}\n"
+      "tables {\n"
+      "  order { }\n"
+      "}\n"
+      "dbMx {\n"
+      "  nThreads 4\n"
+      "  threads {\n"
+      "    1 { name rx isolated true }\n"
+      "    2 { name tx isolated true }\n"
+      "    3 { name zdb isolated true }\n"
+      "    4 { name zdb_file isolated true }\n"
+      "  }\n"
+      "  rxThread rx\n"
+      "  txThread tx\n"
+      "}\n");
+
+    // command line overrides environment
+    if (cf->fromArgs(options, ZvCf::args(argc, argv)) != 1) usage();
+
+    if (cf->getBool("help")) usage();
+
+    if (!cf->get("store.module")) {
+      std::cerr << "set ZDB_MODULE or use --module=MODULE\n" << std::flush;
+      Zm::exit(1);
+    }
+    if (!cf->get("store.dir")) {
+      std::cerr << "set ZDB_DIR or use --dir=DIR\n" << std::flush;
+      Zm::exit(1);
+    }
+    dir = cf->get("store.dir");
+  } catch (const ZvError &e) {
+    std::cerr << e << '\n' << std::flush;
+    usage();
+  } catch (const ZeError &e) {
+    std::cerr << e << '\n' << std::flush;
+    usage();
+  } catch (...) {
+    usage();
+  }
+
+  ZeLog::init("zdbfiletest");
+  ZeLog::level(0);
+  ZeLog::sink(ZeLog::fileSink(ZeSinkOptions{}.path("&2"))); // log to stderr
+  ZeLog::start();
+
+  ZmTrap::trap();
+
+  try {
+    appMx = new ZmScheduler{ZmSchedParams().nThreads(1)};
+    dbMx = new ZiMultiplex{ZvMxParams{"dbMx", cf->getCf<true>("dbMx")}};
+
+    appMx->start();
+    if (!dbMx->start()) throw ZeEVENT(Fatal, "multiplexer start failed");
+
+    db = new Zdb();
+
+    // start from an empty table
+    segs(true);
+
+    start(cf);
+    check(orders->count() == 0);
+
+    {
+      bool ok = true;
+      for (uint64_t i = 1; ok && i <= N; i++) ok = insert(i);
+      check(ok);
+      for (uint64_t i = 1; ok && i <= N; i += 2) ok = update(i, 200);
+      check(ok);
+      for (uint64_t i = 10; ok && i <= N; i += 10) ok = del(i);
+      check(ok);
+    }
+
+    stop();
+
+    // segments were rolled at segSize
+    check(segs().max >= 2);
+
+    // reopen after writes
+    start(cf);
+    check(orders->count() == expectedCount());
+    check(verify());
+
+    // compaction with compactSegs 2
+    check(compacted());
+
+    // update and delete rows in the compacted segment
+    check(update(2, 300));
+    check(del(3));
+    phase2 = true;
+
+    stop();
+
+    // reopen after compaction
+    start(cf);
+    check(orders->count() == expectedCount());
+    check(verify());
+
+    // allow any compaction triggered by reopening to complete
+    check(compacted());
+
+    check(insert(N + 1));
+    check(find(N + 1) == 100);
+
+    stop();
+
+    // tear the final record, as if by a crash during the write
+    check(truncate());
+
+    // reopen after truncation - the torn record is discarded
+    start(cf);
+    check(orders->count() == expectedCount());
+    check(verify());
+    check(find(N + 1) < 0);
+
+    // writes continue following recovery from the torn record
+    check(insert(N + 2));
+
+    stop();
+
+    start(cf);
+    check(orders->count() == expectedCount() + 1);
+    check(find(N + 2) == 100);
+
+    stop();
+
+    appMx->stop();
+    dbMx->stop();
+
+    db = {};
+
+  } catch (const ZvError &e) {
+    ZeLOG(Fatal, ZtString{e});
+    gtfo();
+  } catch (const ZeError &e) {
+    ZeLOG(Fatal, ZtString{e});
+    gtfo();
+  } catch (const ZeAnyEvent &e) {
+    ZeLogEvent(ZeVEvent{e});
+    gtfo();
+  } catch (...) {
+    ZeLOG(Fatal, "unknown exception");
+    gtfo();
+  }
+
+  if (appMx) delete appMx;
+  if (dbMx) delete dbMx;
+
+  ZeLog::stop();
+
+  return 0;
+}
@@ -596,6 +596,9 @@ void Store::rcvd(Work::Queue::Node *work, PGresult *res)
 	case Query::Index<Recover>{}:
 	  tblTask.tbl->recover_rcvd(tblTask.query.p<Recover>(), res);
 	  break;
+	case Query::Index<RecoverN>{}:
+	  tblTask.tbl->recoverN_rcvd(tblTask.query.p<RecoverN>(), res);
+	  break;
 	case Query::Index<Write>{}:
 	  tblTask.tbl->write_rcvd(tblTask.query.p<Write>(), res);
 	  break;
@@ -632,6 +635,9 @@ void Store::failed(Work::Queue::Node *work, ZeVEvent e)
 	case Query::Index<Recover>{}:
 	  tblTask.tbl->recover_failed(tblTask.query.p<Recover>(), ZuMv(e));
 	  break;
+	case Query::Index<RecoverN>{}:
+	  tblTask.tbl->recoverN_failed(tblTask.query.p<RecoverN>(), ZuMv(e));
+	  break;
 	case Query::Index<Write>{}:
 	  tblTask.tbl->write_failed(tblTask.query.p<Write>(), ZuMv(e));
 	  break;
@@ -682,6 +688,9 @@ void Store::send()
 	  case Query::Index<Recover>{}:
 	    sendState = tblTask.tbl->recover_send(tblTask.query.p<Recover>());
 	    break;
+	  case Query::Index<RecoverN>{}:
+	    sendState = tblTask.tbl->recoverN_send(tblTask.query.p<RecoverN>());
+	    break;
 	  case Query::Index<Write>{}:
 	    sendState = tblTask.tbl->write_send(tblTask.query.p<Write>());
 	    break;
@@ -1307,6 +1316,7 @@ int StoreTbl::open_send()
     case OpenState::PrepSelectRNX:
     case OpenState::PrepSelectRNI: return prepSelect_send();
     case OpenState::PrepFind:	return prepFind_send();
+    case OpenState::PrepRecoverN: return prepRecoverN_send();
     case OpenState::PrepInsert:	return prepInsert_send();
     case OpenState::PrepUpdate:	return prepUpdate_send();
     case OpenState::PrepDelete:	return prepDelete_send();
@@ -1332,6 +1342,7 @@ void StoreTbl::open_rcvd(PGresult *res)
     case OpenState::PrepSelectRNX:
     case OpenState::PrepSelectRNI: prepSelect_rcvd(res); break;
     case OpenState::PrepFind:	prepFind_rcvd(res); break;
+    case OpenState::PrepRecoverN: prepRecoverN_rcvd(res); break;
     case OpenState::PrepInsert:	prepInsert_rcvd(res); break;
     case OpenState::PrepUpdate:	prepUpdate_rcvd(res); break;
     case OpenState::PrepDelete:	prepDelete_rcvd(res); break;
@@ -1886,12 +1897,45 @@ void StoreTbl::prepFind_rcvd(PGresult *res)
   if (!res) {
     m_openState.incKey();
     if (m_openState.keyID() > m_keyFields.length()) // not >=
-      prepInsert();
+      prepRecoverN();
     else
       open_enqueue(true, false);
   }
 }
 
+void StoreTbl::prepRecoverN()
+{
+  m_openState.phase(OpenState::PrepRecoverN);
+  open_enqueue(true, false);
+}
+int StoreTbl::prepRecoverN_send()
+{
+  // ZeLOG(Debug, ([v = m_openState.v](auto &s) { s << ZuBoxed(v).hex(); }));
+
+  ZtString id(m_id_.length() + 10);
+  id << m_id_ << "_recoverN";
+
+  ZtString query;
+  query << "SELECT \"_shard\", \"_un\", \"_sn\", \"_vn\"";
+  unsigned n = m_xFields.length();
+  for (unsigned i = 0; i < n; i++) {
+    query << ", \"" << m_xFields[i].id_ << '"';
+  }
+  query << " FROM \"" << m_id_ << "\" WHERE \"_shard\"=$1::uint2"
+    " AND \"_un\">=$2::uint8 AND \"_un\"<$3::uint8 ORDER BY \"_un\"";
+  ZtArray<Oid> oids(3);
+  oids.push(m_store->oids().oid(Value::Index<UInt16>{}));
+  oids.push(m_store->oids().oid(Value::Index<UInt64>{}));
+  oids.push(m_store->oids().oid(Value::Index<UInt64>{}));
+  return m_store->sendPrepare(id, query, oids);
+}
+void StoreTbl::prepRecoverN_rcvd(PGresult *res)
+{
+  // ZeLOG(Debug, ([v = m_openState.v](auto &s) { s << ZuBoxed(v).hex(); }));
+
+  if (!res) prepInsert();
+}
+
 void StoreTbl::prepInsert()
 {
   m_openState.phase(OpenState::PrepInsert);
@@ -2657,6 +2701,96 @@ void StoreTbl::recover_failed(Work::Recover &recover, ZeVEvent e)
   find_failed_(ZuMv(recover.rowFn), ZuMv(e));
 }
 
+void StoreTbl::recoverN(unsigned shard, UN un, UN endUN, RecoverFn recoverFn)
+{
+  using namespace Work;
+
+  m_store->run([
+    this, shard, un, endUN, recoverFn = ZuMv(recoverFn)
+  ]() mutable {
+    if (m_store->stopping()) {
+      store()->zdbRun([id = m_id, recoverFn = ZuMv(recoverFn)]() mutable {
+	recoverFn(RowResult{ZeVEVENT(Error, ([id](auto &s, const auto &) {
+	  s << "recoverN(" << id << ") failed - DB shutdown in progress";
+	}))});
+      });
+      return;
+    }
+    m_store->enqueue(TblQuery{this,
+      Query{RecoverN{shard, un, endUN, ZuMv(recoverFn)}}, false, true});
+  });
+}
+int StoreTbl::recoverN_send(Work::RecoverN &recover)
+{
+  Tuple params = {
+    Value{UInt16{recover.shard}},
+    Value{UInt64{recover.un}},
+    Value{UInt64{recover.endUN}}
+  };
+  ZtString id(m_id_.length() + 10);
+  id << m_id_ << "_recoverN";
+  return m_store->sendPrepared<SendState::Flush>(id, params);
+}
+void StoreTbl::recoverN_rcvd(Work::RecoverN &recover, PGresult *res)
+{
+  if (!recover.recoverFn) return; // recoverN failed
+
+  if (!res) {
+    m_store->zdbRun([recoverFn = ZuMv(recover.recoverFn)]() mutable {
+      recoverFn(RowResult{});
+    });
+    return;
+  }
+
+  unsigned nr = PQntuples(res);
+  if (!nr) return;
+
+  unsigned nc = m_xFields.length() + 4;
+
+  // tuple is POD, no need to run destructors when going out of scope
+  auto tuple = ZmAlloc(Value, nc);
+
+  if (PQnfields(res) != nc) goto inconsistent;
+  for (unsigned i = 0; i < nr; i++) {
+    for (unsigned j = 0; j < nc; j++) {
+      unsigned type;
+      switch (int(j)) {
+	case 0: type = Value::Index<UInt16>{}; break;	// shard
+	case 1: type = Value::Index<UInt64>{}; break;	// UN
+	case 2: type = Value::Index<UInt128>{}; break;	// SN
+	case 3: type = Value::Index<Int64>{}; break;	// VN
+	default: type = m_xFields[j - 4].type; break;
+      }
+      if (!ZuSwitch::dispatch<Value::N>(type,
+	  [&tuple, res, i, j](auto Type) {
+	    return tuple[j].load<Type>(
+	      PQgetvalue(res, i, j), PQgetlength(res, i, j));
+	  }))
+	goto inconsistent;
+    }
+    auto buf = find_save<true>(ZuArray<const Value>(&tuple[0], nc)).constRef();
+    // res can go out of scope now - everything is saved in buf
+    RowResult result{RowData{.buf = ZuMv(buf)}};
+    m_store->zdbRun([
+      recoverFn = recover.recoverFn, result = ZuMv(result)
+    ]() mutable {
+      recoverFn(ZuMv(result));
+    });
+  }
+  return;
+
+inconsistent:
+  find_failed_(ZuMv(recover.recoverFn),
+    ZeVEVENT(Error, ([id = m_id_](auto &s, const auto &) {
+      s << "inconsistent recoverN() result for table " << id;
+    })));
+}
+void StoreTbl::recoverN_failed(Work::RecoverN &recover, ZeVEvent e)
+{
+  if (!recover.recoverFn) return;
+  find_failed_(ZuMv(recover.recoverFn), ZuMv(e));
+}
+
 void StoreTbl::write(ZmRef<const IOBuf> buf, CommitFn commitFn)
 {
   /* ZeLOG(Debug, ([buf = buf.ptr()](auto &s) {
@@ -2683,6 +2817,33 @@ void StoreTbl::write(ZmRef<const IOBuf> buf, CommitFn commitFn)
       Query{Write{ZuMv(buf), ZuMv(commitFn)}}, true, false});
   });
 }
+// batch is enqueued in a single pass, pipelining the writes
+void StoreTbl::writeN(ZtArray<ZmRef<const IOBuf>> bufs, CommitFn commitFn)
+{
+  using namespace Work;
+
+  m_store->run([
+    this, bufs = ZuMv(bufs), commitFn = ZuMv(commitFn)
+  ]() mutable {
+    if (m_store->stopping()) {
+      store()->zdbRun([
+	id = m_id,
+	bufs = ZuMv(bufs),
+	commitFn = ZuMv(commitFn)
+      ]() mutable {
+	for (unsigned i = 0, n = bufs.length(); i < n; i++)
+	  commitFn(ZuMv(bufs[i]), CommitResult{
+	    ZeVEVENT(Error, ([id](auto &s, const auto &) {
+	      s << "write(" << id << ") failed - DB shutdown in progress";
+	    }))});
+      });
+      return;
+    }
+    for (unsigned i = 0, n = bufs.length(); i < n; i++)
+      m_store->enqueue(TblQuery{this,
+	Query{Write{ZuMv(bufs[i]), commitFn}}, true, false});
+  });
+}
 int StoreTbl::write_send(Work::Write &write)
 {
   /* ZeLOG(Debug, ([buf = write.buf.ptr()](auto &s) {
@@ -1571,13 +1571,20 @@ struct Recover {
   bool			found = false;
 };
 
+struct RecoverN {
+  unsigned		shard;
+  UN			un;
+  UN			endUN;
+  RecoverFn		recoverFn;
+};
+
 struct Write {
   ZmRef<const IOBuf>	buf;
   CommitFn		commitFn;
   bool			mrd = false;	// used by delete only
 };
 
-using Query = ZuUnion<Open, Count, Select, Find, Recover, Write>;
+using Query = ZuUnion<Open, Count, Select, Find, Recover, RecoverN, Write>;
 
 struct Start { };			// start data store
 
@@ -1670,6 +1677,7 @@ public:
     PrepSelectRNX, // Row, Next,    eXclusive - ''
     PrepSelectRNI, // Row, Next,    Inclusive - ''
     PrepFind,	// prepare recover and find for all keys
+    PrepRecoverN, // prepare range recover
     PrepInsert,	// prepare insert query
     PrepUpdate,	// prepare update query
     PrepDelete,	// prepare delete query
@@ -1759,8 +1767,10 @@ public:
   void find(unsigned keyID, ZmRef<const IOBuf>, RowFn);
 
   void recover(unsigned shard, UN, RowFn);
+  void recoverN(unsigned shard, UN un, UN endUN, RecoverFn);
 
   void write(ZmRef<const IOBuf>, CommitFn);
+  void writeN(ZtArray<ZmRef<const IOBuf>>, CommitFn);
 
 private:
   // open orchestration
@@ -1791,6 +1801,10 @@ private:
   int prepFind_send();
   void prepFind_rcvd(PGresult *);
 
+  void prepRecoverN();
+  int prepRecoverN_send();
+  void prepRecoverN_rcvd(PGresult *);
+
   void prepInsert();
   int prepInsert_send();
   void prepInsert_rcvd(PGresult *);
@@ -1846,6 +1860,10 @@ private:
   void recover_rcvd(Work::Recover &, PGresult *);
   void recover_failed(Work::Recover &, ZeVEvent);
 
+  int recoverN_send(Work::RecoverN &);
+  void recoverN_rcvd(Work::RecoverN &, PGresult *);
+  void recoverN_failed(Work::RecoverN &, ZeVEvent);
+
   int write_send(Work::Write &);
   void write_rcvd(Work::Write &, PGresult *);
   void write_failed(Work::Write &, ZeVEvent);
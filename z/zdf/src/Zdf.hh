@@ -23,6 +23,16 @@
 // index.read(nsecs);
 // ZuTime then = df.time(nsecs);
 // reader.read(value);
+// ...
+// ZuFixed values[1024];
+// unsigned n = reader.readN(values, 1024);	// batch read
+// ...
+// df.seek(reader, N);
+// reader.scanFwd(ScanOp::GT, price);	// first value > price
+// uint64_t offset = reader.offset();
+// ...
+// ZuFixed min, max;
+// df.minMax(N, begin, end, min, max);	// using block zone maps
 
 #ifndef Zdf_HH
 #define Zdf_HH
@@ -122,10 +132,19 @@ public:
   }
 
   bool read(ZuFixed &v) { return m_readFn(this, v); }
+  unsigned readN(int64_t *out, unsigned n, unsigned &ndp) {
+    return m_readNFn(this, out, n, ndp);
+  }
+  unsigned readN(ZuFixed *out, unsigned n) {
+    return m_readNFixedFn(this, out, n);
+  }
   void seekFwd(uint64_t offset) { m_seekFwdFn(this, offset); }
   void seekRev(uint64_t offset) { m_seekRevFn(this, offset); }
   void findFwd(const ZuFixed &value) { m_findFwdFn(this, value); }
   void findRev(const ZuFixed &value) { m_findRevFn(this, value); }
+  bool scanFwd(int op, const ZuFixed &value) {
+    return m_scanFwdFn(this, op, value);
+  }
   uint64_t offset() { return m_offsetFn(this); }
 
   void purge() { dispatch([](auto, auto &&v) { v.purge(); }); }
@@ -152,6 +171,12 @@ private:
     m_readFn = [](AnyReader *this_, ZuFixed &v) {
       return this_->ptr_<Index<Reader>{}>()->read(v);
     };
+    m_readNFn = [](AnyReader *this_, int64_t *out, unsigned n, unsigned &ndp) {
+      return this_->ptr_<Index<Reader>{}>()->readN(out, n, ndp);
+    };
+    m_readNFixedFn = [](AnyReader *this_, ZuFixed *out, unsigned n) {
+      return this_->ptr_<Index<Reader>{}>()->readN(out, n);
+    };
     m_seekFwdFn = [](AnyReader *this_, uint64_t offset) {
       this_->ptr_<Index<Reader>{}>()->seekFwd(offset);
     };
@@ -164,22 +189,31 @@ private:
     m_findRevFn = [](AnyReader *this_, const ZuFixed &value) {
       this_->ptr_<Index<Reader>{}>()->findRev(value);
     };
+    m_scanFwdFn = [](AnyReader *this_, int op, const ZuFixed &value) {
+      return this_->ptr_<Index<Reader>{}>()->scanFwd(op, value);
+    };
     m_offsetFn = [](const AnyReader *this_) {
       return this_->ptr_<Index<Reader>{}>()->offset();
     };
   }
 
   typedef bool (*ReadFn)(AnyReader *, ZuFixed &);
+  typedef unsigned (*ReadNFn)(AnyReader *, int64_t *, unsigned, unsigned &);
+  typedef unsigned (*ReadNFixedFn)(AnyReader *, ZuFixed *, unsigned);
   typedef void (*SeekFn)(AnyReader *, uint64_t); 
   typedef void (*FindFn)(AnyReader *, const ZuFixed &); 
+  typedef bool (*ScanFn)(AnyReader *, int, const ZuFixed &);
   typedef uint64_t (*OffsetFn)(const AnyReader *);
 
 private:
   ReadFn	m_readFn = nullptr;
+  ReadNFn	m_readNFn = nullptr;
+  ReadNFixedFn	m_readNFixedFn = nullptr;
   SeekFn	m_seekFwdFn = nullptr;
   SeekFn	m_seekRevFn = nullptr;
   FindFn	m_findFwdFn = nullptr;
   FindFn	m_findRevFn = nullptr;
+  ScanFn	m_scanFwdFn = nullptr;
   OffsetFn	m_offsetFn = nullptr;
 };
 
@@ -389,6 +423,19 @@ public:
     unsigned props = field ? field->props : ZtVFieldProp::Delta;
     r.find(m_series[i], props, value);
   }
+  // minimum and maximum of series i in the offset range [begin, end),
+  // aggregated from block zone maps where possible (see Series::minMax)
+  bool minMax(
+      unsigned i, uint64_t begin, uint64_t end, ZuFixed &min, ZuFixed &max) {
+    auto field = m_fields[i];
+    unsigned props = field ? field->props : ZtVFieldProp::Delta;
+    const Series *s = m_series[i];
+    if (props & ZtVFieldProp::Delta)
+      return s->minMax<DeltaDecoder>(begin, end, min, max);
+    if (props & ZtVFieldProp::Delta2)
+      return s->minMax<Delta2Decoder>(begin, end, min, max);
+    return s->minMax<AbsDecoder>(begin, end, min, max);
+  }
 
   unsigned nSeries() const { return m_series.length(); }
   const Series *series(unsigned i) const { return m_series[i]; }
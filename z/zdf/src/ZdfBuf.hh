@@ -24,14 +24,24 @@
 
 namespace Zdf {
 
+// buffer header, including a zone map (first/minimum/maximum value) that
+// permits blocks to be skipped or aggregated without decoding them;
+// legacy headers written prior to zone maps omit the trailing zone map
+// fields, are flagged accordingly and are otherwise read as before
 #pragma pack(push, 1)
 struct Hdr {
   using UInt64 = ZuLittleEndian<uint64_t>;
   using Int64 = ZuLittleEndian<int64_t>;
 
   UInt64	offset_ = 0;
-  UInt64	cle_ = 0;	// count/length/ndp
+  UInt64	cle_ = 0;	// count/length/ndp/zone map flag
   Int64		last = 0;	// last value in buffer
+  // zone map
+  Int64		first = 0;	// first value in buffer
+  Int64		min = 0;	// minimum value in buffer
+  Int64		max = 0;	// maximum value in buffer
+
+  enum { LegacySize = 24 };	// header size without zone map
 
 private:
   static constexpr uint64_t countMask() { return 0xfffffffULL; }
@@ -42,6 +52,7 @@ public:
 private:
   static constexpr uint64_t ndpMask() { return 0x1fULL; }
   static constexpr unsigned ndpShift() { return 56U; }
+  static constexpr uint64_t zoneMapFlag() { return 1ULL<<63; }
 
   uint64_t cle() const { return cle_; }
 
@@ -53,14 +64,20 @@ public:
   // length of this buffer in bytes
   unsigned length() const { return (cle()>>lengthShift()) & lengthMask(); }
   // ndp of values in this buffer
-  unsigned ndp() const { return cle()>>ndpShift(); }
+  unsigned ndp() const { return (cle()>>ndpShift()) & ndpMask(); }
+  // true if this header has a zone map
+  bool zoneMap() const { return cle() & zoneMapFlag(); }
+  // size of this header in bytes, i.e. offset of the compressed data
+  unsigned size() const { return zoneMap() ? sizeof(Hdr) : LegacySize; }
 
   void offset(uint64_t v) { offset_ = v; }
   void cle(uint64_t count, uint64_t length, uint64_t ndp) {
-    cle_ = count | (length<<lengthShift()) | (ndp<<ndpShift());
+    cle_ =
+      count | (length<<lengthShift()) | (ndp<<ndpShift()) | zoneMapFlag();
   }
 };
 #pragma pack(pop)
+static_assert(offsetof(Hdr, first) == Hdr::LegacySize);
 
 struct BufLRUNode_ {
   BufLRUNode_() = delete;
@@ -143,8 +160,9 @@ public:
 
   template <typename Reader>
   Reader reader() {
-    auto start = data() + sizeof(Hdr);
-    return Reader{start, start + hdr()->length()};
+    auto hdr = this->hdr();
+    auto start = data() + hdr->size();
+    return Reader{start, start + hdr->length()};
   }
 
   template <typename Writer>
@@ -154,15 +172,21 @@ public:
     return Writer{start, end};
   }
   template <typename Writer>
-  void sync(const Writer &writer, unsigned ndp, int64_t last) {
+  void sync(
+      const Writer &writer, unsigned ndp, int64_t last,
+      int64_t first, int64_t min, int64_t max) {
     auto hdr = this->hdr();
     auto start = data() + sizeof(Hdr);
     hdr->cle(writer.count(), writer.pos() - start, ndp);
     hdr->last = last;
+    hdr->first = first;
+    hdr->min = min;
+    hdr->max = max;
   }
 
   unsigned space() const {
-    auto start = data() + sizeof(Hdr) + hdr()->length();
+    auto hdr = this->hdr();
+    auto start = data() + hdr->size() + hdr->length();
     auto end = data() + Size;
     if (start >= end) return 0;
     return end - start;
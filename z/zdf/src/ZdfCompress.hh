@@ -11,6 +11,7 @@
 // * single-byte RLE
 // * efficient random-access (seeking) and interpolation searching
 // * absolute, delta (first derivative), and delta-of-delta (second derivative)
+// * batch decoding of contiguous values (readN)
 
 #ifndef ZdfCompress_HH
 #define ZdfCompress_HH
@@ -152,7 +153,48 @@ public:
     return false;
   }
 
+  // read up to n values into out, returns number read
+  // - RLE runs are expanded by (vectorized) filling
+  unsigned readN(int64_t *out, unsigned n) {
+    return readN(out, n, [](int64_t *out, int64_t value, unsigned count) {
+      for (unsigned i = 0; i < count; i++) out[i] = value;
+    });
+  }
+  // read up to n values into out, returns number read
+  // - l(int64_t *out, int64_t value, unsigned count) writes count values
+  //   to out, count > 1 for RLE runs of identical values
+  template <typename L>
+  unsigned readN(int64_t *out, unsigned n, L l) {
+    // decode using a local copy, since out could alias m_prev and inhibit
+    // the compiler from keeping the decoder state in registers
+    Decoder decoder{*this};
+    n = decoder.readN_(out, n, l);
+    *this = decoder;
+    return n;
+  }
+
 private:
+  template <typename L>
+  unsigned readN_(int64_t *out, unsigned n, L &l) {
+    unsigned i = 0;
+    int64_t value;
+    while (i < n) {
+      if (m_rle) {
+	unsigned j = n - i;
+	if (j > m_rle) j = m_rle;
+	l(out + i, m_prev, j);
+	m_rle -= j;
+	i += j;
+	continue;
+      }
+      if (ZuUnlikely(!read_(&value))) break;
+      l(out + i, value, 1);
+      ++i;
+    }
+    m_count += i;
+    return i;
+  }
+
   bool read_(int64_t *value_) {
     if (ZuUnlikely(m_pos >= m_end)) return false;
     unsigned byte = *m_pos;
@@ -344,6 +386,25 @@ private:
   unsigned	m_count = 0;
 };
 
+// in-place inclusive prefix sum of n values onto base, returns the total
+// - blocks of 4 are summed pairwise, leaving a single serially dependent
+//   add per block, which compilers can vectorize
+inline int64_t prefixSum(int64_t *data, unsigned n, int64_t base) {
+  unsigned i = 0;
+  for (; i + 4 <= n; i += 4) {
+    int64_t *d = data + i;
+    int64_t d0 = d[0], d1 = d[1], d2 = d[2], d3 = d[3];
+    d1 += d0; d3 += d2;
+    d2 += d1; d3 += d1;
+    d[0] = base + d0;
+    d[1] = base + d1;
+    d[2] = base + d2;
+    d[3] = (base += d3);
+  }
+  for (; i < n; i++) data[i] = (base += data[i]);
+  return base;
+}
+
 template <typename Base = Decoder>
 class DeltaDecoder : public Base {
 public:
@@ -406,7 +467,41 @@ public:
     return true;
   }
 
-private:
+  // read up to n values into out, returns number read
+  // - deltas and deltas of deltas are summed as they are decoded, with
+  //   RLE runs of deltas expanded in closed form; any higher order deltas
+  //   are then prefix summed
+  unsigned readN(int64_t *out, unsigned n) {
+    if constexpr (ZuIsExact<Base, Decoder>{}) {
+      int64_t base = m_base;
+      n = Base::readN(out, n,
+	  [&base](int64_t *out, int64_t skip, unsigned count) {
+	    if (ZuLikely(count == 1)) {
+	      *out = (base += skip);
+	      return;
+	    }
+	    for (unsigned i = 0; i < count; i++)
+	      out[i] = base + skip * static_cast<int64_t>(i + 1);
+	    base += skip * static_cast<int64_t>(count);
+	  });
+      m_base = base;
+    } else if constexpr (ZuIsExact<Base, DeltaDecoder<Decoder>>{}) {
+      int64_t base = m_base, delta = Base::m_base;
+      n = this->Decoder::readN(out, n,
+	  [&base, &delta](int64_t *out, int64_t skip, unsigned count) {
+	    for (unsigned i = 0; i < count; i++)
+	      out[i] = (base += (delta += skip));
+	  });
+      m_base = base;
+      Base::m_base = delta;
+    } else {
+      n = Base::readN(out, n);
+      m_base = prefixSum(out, n, m_base);
+    }
+    return n;
+  }
+
+protected:
   int64_t		m_base = 0;
 };
 
@@ -8,6 +8,7 @@
 // * chunked into blocks
 // * compressed (see ZdfCompress)
 // * indexable (if monotonically increasing, e.g. time series)
+// * per-block zone maps (first/min/max) for range scans and aggregation
 // * support archiving of old data with purge()
 // * in-memory or file-backed (see ZdfMem / ZdfFile)
 
@@ -112,6 +113,22 @@ public:
     m_ndp = m_buf->hdr()->ndp();
   }
 
+  // seek forward to the first value v such that v op value (see ScanOp),
+  // skipping blocks whose zone maps exclude it; returns false if none
+  bool scanFwd(int op, const ZuFixed &value) {
+    if (ZuUnlikely(!*this)) return false;
+    for (;;) {
+      if (m_decoder.search(
+	  [op, &value, ndp = m_ndp](int64_t v, unsigned count) -> unsigned {
+	    return Series::scanMatch(ZuFixed{v, ndp}, op, value) ? 0 : count;
+	  }))
+	return true;
+      m_decoder = m_series->template scanDecoder<Decoder>(m_buf, op, value);
+      if (ZuUnlikely(!m_decoder)) return false;
+      m_ndp = m_buf->hdr()->ndp();
+    }
+  }
+
   // read single value
   bool read(ZuFixed &value) {
     if (ZuUnlikely(!*this)) return false;
@@ -126,6 +143,39 @@ public:
     return true;
   }
 
+  // read up to n mantissas, returns number read (0 at end of series)
+  // - all values read by a single call share the same ndp; reading stops
+  //   early at a block boundary where the ndp changes
+  unsigned readN(int64_t *out, unsigned n, unsigned &ndp) {
+    if (ZuUnlikely(!*this)) return 0;
+    unsigned i = m_decoder.readN(out, n);
+    ndp = m_ndp;
+    while (i < n) {
+      m_decoder = m_series->template nextDecoder<Decoder>(m_buf);
+      if (ZuUnlikely(!m_decoder)) break;
+      m_ndp = m_buf->hdr()->ndp();
+      if (i && m_ndp != ndp) break;
+      ndp = m_ndp;
+      i += m_decoder.readN(out + i, n - i);
+    }
+    return i;
+  }
+
+  // read up to n values, returns number read (0 at end of series)
+  unsigned readN(ZuFixed *out, unsigned n) {
+    enum { Batch = 256 };
+    int64_t mantissa[Batch];
+    unsigned i = 0;
+    while (i < n) {
+      unsigned ndp;
+      unsigned j = readN(mantissa, n - i < Batch ? n - i : Batch, ndp);
+      if (!j) break;
+      for (unsigned k = 0; k < j; k++) out[i + k] = ZuFixed{mantissa[k], ndp};
+      i += j;
+    }
+    return i;
+  }
+
   void purge() {
     if (ZuUnlikely(!*this)) return;
     const_cast<Series *>(m_series)->purge_(m_buf->blkIndex);
@@ -161,6 +211,9 @@ public:
       m_series(w.m_series),
       m_buf(ZuMv(w.m_buf)),
       m_ndp(w.m_ndp),
+      m_first(w.m_first),
+      m_min(w.m_min),
+      m_max(w.m_max),
       m_encoder(ZuMv(w.m_encoder)) {
     w.m_series = nullptr;
     w.m_buf = nullptr;
@@ -179,7 +232,9 @@ public:
   }
 
   void sync() {
-    if (ZuLikely(m_buf)) m_buf->sync(m_encoder, m_ndp, m_encoder.last());
+    if (ZuLikely(m_buf))
+      m_buf->sync(
+	m_encoder, m_ndp, m_encoder.last(), m_first, m_min, m_max);
   }
 
   void save() {
@@ -187,25 +242,30 @@ public:
   }
 
   bool write(const ZuFixed &value) {
+    int64_t mantissa = value.mantissa();
     bool eob;
     if (ZuUnlikely(!m_buf)) {
       m_encoder = m_series->template encoder<Encoder>(m_buf);
       if (ZuUnlikely(!m_buf)) return false;
       m_buf->pin();
       m_ndp = value.ndp();
+      m_first = m_min = m_max = mantissa;
       eob = false;
     } else {
       eob = value.ndp() != m_ndp;
     }
-    if (eob || !m_encoder.write(value.mantissa())) {
+    if (eob || !m_encoder.write(mantissa)) {
       sync();
       save();
       m_encoder = m_series->template nextEncoder<Encoder>(m_buf);
       if (ZuUnlikely(!m_buf)) return false;
       m_buf->pin();
       m_ndp = value.ndp();
-      if (ZuUnlikely(!m_encoder.write(value.mantissa()))) return false;
+      m_first = m_min = m_max = mantissa;
+      return m_encoder.write(mantissa);
     }
+    if (mantissa < m_min) m_min = mantissa;
+    if (mantissa > m_max) m_max = mantissa;
     return true;
   }
 
@@ -213,6 +273,9 @@ private:
   Series	*m_series = nullptr;
   ZmRef<Buf>	m_buf;
   unsigned	m_ndp = 0;
+  int64_t	m_first = 0;	// zone map
+  int64_t	m_min = 0;
+  int64_t	m_max = 0;
   Encoder	m_encoder;
 };
 
@@ -244,7 +307,7 @@ protected:
     m_blkOffset = blkOffset;
     Hdr hdr;
     for (unsigned i = 0; loadHdr(i + blkOffset, hdr); i++)
-      new (Blk::new_<Hdr>(m_blks.push())) Hdr{hdr};
+      new (Blk::new_<Hdr, true>(m_blks.push())) Hdr{hdr};
     openFn(OpenResult{});
   }
 
@@ -295,6 +358,76 @@ public:
   template <typename Encoder>
   auto writer() { return Writer<Series, Encoder>{this}; }
 
+  // minimum and maximum of values in the offset range [begin, end);
+  // blocks wholly within the range are aggregated from their zone maps,
+  // only partially covered (or legacy) blocks are decoded; returns
+  // false if the range is empty
+  template <typename Decoder>
+  bool minMax(uint64_t begin, uint64_t end, ZuFixed &min, ZuFixed &max) const {
+    min.null();
+    max.null();
+    unsigned n = m_blks.length();
+    if (ZuUnlikely(!n || begin >= end)) return false;
+    auto update = [&min, &max](const ZuFixed &lo, const ZuFixed &hi) {
+      if (!*min || lo.cmp(min) < 0) min = lo;
+      if (!*max || hi.cmp(max) > 0) max = hi;
+    };
+    unsigned blkIndex =
+      ZuSearchPos(ZuInterSearch(&m_blks[0], n, seekFn(begin)));
+    for (; blkIndex < n; blkIndex++) {
+      const Hdr *hdr = this->hdr(m_blks[blkIndex]);
+      uint64_t offset = hdr->offset();
+      if (offset >= end) break;
+      unsigned count = hdr->count();
+      if (!count) continue;
+      unsigned ndp = hdr->ndp();
+      if (hdr->zoneMap() && offset >= begin && offset + count <= end) {
+	update(
+	  ZuFixed{int64_t(hdr->min), ndp}, ZuFixed{int64_t(hdr->max), ndp});
+	continue;
+      }
+      // partially covered or legacy block - decode (invalidates hdr)
+      auto buf = loadBuf(blkIndex);
+      if (ZuUnlikely(!buf)) break;
+      auto decoder = buf->template reader<Decoder>();
+      if (offset < begin) {
+	if (!decoder.seek(begin - offset)) continue;
+	offset = begin;
+      }
+      int64_t v;
+      while (offset++ < end && decoder.read(v))
+	update(ZuFixed{v, ndp}, ZuFixed{v, ndp});
+    }
+    return *min;
+  }
+
+  // true if v op value (see ScanOp)
+  static bool scanMatch(const ZuFixed &v, int op, const ZuFixed &value) {
+    int i = v.cmp(value);
+    switch (op) {
+      case ScanOp::LT: return i < 0;
+      case ScanOp::LE: return i <= 0;
+      case ScanOp::GT: return i > 0;
+      case ScanOp::GE: return i >= 0;
+    }
+    return false;
+  }
+  // false if the zone map of a block excludes all values v op value
+  static bool scanMatch(const Hdr *hdr, int op, const ZuFixed &value) {
+    if (ZuUnlikely(!hdr->count())) return false;
+    if (ZuUnlikely(!hdr->zoneMap())) return true;
+    unsigned ndp = hdr->ndp();
+    switch (op) {
+      case ScanOp::LT:
+      case ScanOp::LE:
+	return scanMatch(ZuFixed{int64_t(hdr->min), ndp}, op, value);
+      case ScanOp::GT:
+      case ScanOp::GE:
+	return scanMatch(ZuFixed{int64_t(hdr->max), ndp}, op, value);
+    }
+    return false;
+  }
+
 private:
   using Blk = ZuUnion<Hdr, ZmRef<Buf>>; // FIXME
 					// always ZdbObjRef<BlkHdr>
@@ -470,6 +603,21 @@ private:
     return Decoder{};
   }
 
+  // first block following buf that may contain values v op value
+  template <typename Decoder>
+  Decoder scanDecoder(ZmRef<Buf> &buf, int op, const ZuFixed &value) const {
+    unsigned blkIndex = buf->blkIndex + 1;
+    unsigned n = m_blks.length();
+    while (blkIndex < n && !scanMatch(hdr(m_blks[blkIndex]), op, value))
+      ++blkIndex;
+    if (blkIndex >= n) goto null;
+    if (!(buf = loadBuf(blkIndex))) goto null;
+    return buf->reader<Decoder>();
+  null:
+    buf = nullptr;
+    return Decoder{};
+  }
+
   template <typename Encoder>
   Encoder encoder(ZmRef<Buf> &buf) {
     return nextEncoder<Encoder>(buf);
@@ -488,8 +636,9 @@ private:
     }
     m_store->shift(); // might call unloadBuf()
     buf = new Buf{m_store, m_seriesID, blkIndex};
-    new (Blk::new_<ZmRef<Buf>>(m_blks.push())) ZmRef<Buf>{buf};
+    new (Blk::new_<ZmRef<Buf>, true>(m_blks.push())) ZmRef<Buf>{buf};
     new (buf->hdr()) Hdr{offset, 0};
+    buf->hdr()->cle(0, 0, 0); // empty, with zone map
     m_store->push(buf);
     {
       blkIndex = buf->blkIndex;
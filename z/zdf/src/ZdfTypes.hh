@@ -28,6 +28,11 @@ using OpenFn = ZmFn<void(OpenResult)>;		// open callback
 using CloseResult = ZuUnion<void, Event>;	// close result
 using CloseFn = ZmFn<void(CloseResult)>;	// close callback
 
+// comparison operator for zone map scans (see Reader::scanFwd)
+namespace ScanOp {
+  enum { LT = 0, LE, GT, GE };
+}
+
 } // namespace Zdf
 
 #endif /* ZdfTypes_HH */
@@ -8,6 +8,8 @@
 
 #include <zlib/ZuStringN.hh>
 
+#include <zlib/ZmTime.hh>
+
 #include <zlib/ZdfCompress.hh>
 #include <zlib/ZdfSeries.hh>
 #include <zlib/ZdfMockStore.hh>
@@ -25,6 +27,49 @@ void fail(const char *s, int64_t i) { print(s, i); }
 #define CHECK(x) ((x) ? ok("OK  " #x) : fail("NOK " #x))
 #define CHECK2(x, y) ((x == y) ? ok("OK  " #x, x) : fail("NOK " #x, x))
 
+// mock store retaining saved blocks, optionally rewriting them with
+// legacy headers (without zone maps) as written by earlier versions
+class BlkStore : public Zdf::MockStore {
+public:
+  BlkStore(bool legacy) : m_legacy{legacy} { }
+
+  bool loadHdr(unsigned, unsigned blkIndex, Zdf::Hdr &hdr) {
+    if (blkIndex >= m_blks.length()) return false;
+    memcpy(static_cast<void *>(&hdr), m_blks[blkIndex].data(), sizeof(hdr));
+    return true;
+  }
+  bool load(unsigned, unsigned blkIndex, void *buf) {
+    if (blkIndex >= m_blks.length()) return false;
+    memcpy(buf, m_blks[blkIndex].data(), Zdf::Buf::Size);
+    return true;
+  }
+  void save(ZmRef<Zdf::Buf> buf) {
+    unsigned blkIndex = buf->blkIndex;
+    while (m_blks.length() <= blkIndex)
+      new (m_blks.push()) ZtArray<uint8_t>{};
+    auto &blk = m_blks[blkIndex];
+    blk.length(Zdf::Buf::Size);
+    memcpy(blk.data(), buf->data(), Zdf::Buf::Size);
+    if (m_legacy) {
+      auto hdr = reinterpret_cast<Zdf::Hdr *>(blk.data());
+      unsigned length = hdr->length();
+      memmove(blk.data() + Zdf::Hdr::LegacySize,
+	blk.data() + sizeof(Zdf::Hdr), length);
+      hdr->cle_ = uint64_t(hdr->cle_) & ~(1ULL<<63); // clear zone map flag
+    }
+    MockStore::save(ZuMv(buf));
+  }
+
+  bool legacy(unsigned blkIndex) const {
+    return blkIndex < m_blks.length() &&
+      !reinterpret_cast<const Zdf::Hdr *>(m_blks[blkIndex].data())->zoneMap();
+  }
+
+private:
+  bool				m_legacy;
+  ZtArray<ZtArray<uint8_t>>	m_blks;
+};
+
 int main()
 {
   using namespace Zdf;
@@ -105,9 +150,217 @@ int main()
     }
     CHECK(!r.read(v));
   }
+  {
+    auto r = s.seek<DeltaDecoder<>>(200);
+    ZuFixed v[64];
+    unsigned n = r.readN(v, 64);
+    CHECK2(n, 64);
+    CHECK(v[0].mantissa() == 430700 && v[0].ndp() == 4);
+    CHECK(v[63].mantissa() == 430700 && v[63].ndp() == 4);
+    CHECK(r.offset() == 264);
+    n = r.readN(v, 64);
+    CHECK2(n, 44);
+    CHECK(v[43].mantissa() == 430700 && v[43].ndp() == 4);
+    CHECK(!r.readN(v, 64));
+  }
   ZmBlock<>{}([&s](auto wake) {
     s.close([wake = ZuMv(wake)](CloseResult) mutable { wake(); });
   });
+  // zone maps
+  {
+    enum { N = 10000 };
+    Series p;
+    p.init(&store);
+    ZmBlock<>{}([&p](auto wake) {
+      p.open("test", "price", [wake = ZuMv(wake)](OpenResult) mutable {
+	wake();
+      });
+    });
+    {
+      auto w = p.writer<Encoder>();
+      for (unsigned i = 0; i < N; i++) // sawtooth, peaking at 4999
+	w.write(ZuFixed{int64_t(i < N / 2 ? i : N - i), 2});
+    }
+    CHECK(p.blkCount() > 2);
+    {
+      auto r = p.seek<Decoder>();
+      CHECK(r.scanFwd(ScanOp::GT, ZuFixed{4990, 2}));
+      CHECK(r.offset() == 4991);
+      CHECK(r.scanFwd(ScanOp::LE, ZuFixed{5, 1})); // 0.5 == 50 at ndp 2
+      CHECK(r.offset() == 9950);
+      CHECK(!r.scanFwd(ScanOp::GT, ZuFixed{5000, 2}));
+    }
+    {
+      ZuFixed min, max;
+      CHECK(p.minMax<Decoder>(100, 9000, min, max));
+      CHECK(min.mantissa() == 100 && max.mantissa() == 5000);
+      CHECK(p.minMax<Decoder>(9990, N, min, max));
+      CHECK(min.mantissa() == 1 && max.mantissa() == 10);
+      CHECK(!p.minMax<Decoder>(N, N + 1, min, max));
+    }
+    ZmBlock<>{}([&p](auto wake) {
+      p.close([wake = ZuMv(wake)](CloseResult) mutable { wake(); });
+    });
+  }
+  // legacy headers - blocks without zone maps read as before
+  {
+    enum { N = 10000 };
+    BlkStore stores[2]{false, true};
+    for (unsigned i = 0; i < 2; i++) {
+      stores[i].init(nullptr, nullptr);
+      Series w;
+      w.init(&stores[i]);
+      ZmBlock<>{}([&w](auto wake) {
+	w.open("test", "legacy", [wake = ZuMv(wake)](OpenResult) mutable {
+	  wake();
+	});
+      });
+      {
+	auto w_ = w.writer<Encoder>();
+	for (unsigned j = 0; j < N; j++) // sawtooth, peaking at 4999
+	  w_.write(ZuFixed{int64_t(j < N / 2 ? j : N - j), 2});
+      }
+      ZmBlock<>{}([&w](auto wake) {
+	w.close([wake = ZuMv(wake)](CloseResult) mutable { wake(); });
+      });
+    }
+    CHECK(!stores[0].legacy(0));
+    CHECK(stores[1].legacy(0));
+    // reload both series from their stores
+    Series l[2];
+    for (unsigned i = 0; i < 2; i++) {
+      l[i].init(&stores[i]);
+      ZmBlock<>{}([&l, i](auto wake) {
+	l[i].open("test", "legacy", [wake = ZuMv(wake)](OpenResult) mutable {
+	  wake();
+	});
+      });
+    }
+    CHECK(l[0].blkCount() > 2);
+    CHECK(l[1].blkCount() == l[0].blkCount());
+    CHECK(l[1].count() == N);
+    {
+      auto r0 = l[0].seek<Decoder>();
+      auto r1 = l[1].seek<Decoder>();
+      ZuFixed v0, v1;
+      unsigned n = 0;
+      bool match = true;
+      while (r0.read(v0)) {
+	if (!r1.read(v1) || v0.mantissa() != v1.mantissa() ||
+	    v0.ndp() != v1.ndp()) { match = false; break; }
+	++n;
+      }
+      CHECK(match);
+      CHECK2(n, N);
+      CHECK(!r1.read(v1));
+    }
+    {
+      auto r0 = l[0].seek<Decoder>(100);
+      auto r1 = l[1].seek<Decoder>(100);
+      ZuFixed v0[64], v1[64];
+      unsigned n0, n1, n = 0;
+      bool match = true;
+      while ((n0 = r0.readN(v0, 64))) {
+	n1 = r1.readN(v1, 64);
+	if (n1 != n0) { match = false; break; }
+	for (unsigned i = 0; i < n0; i++)
+	  if (v0[i].mantissa() != v1[i].mantissa() ||
+	      v0[i].ndp() != v1[i].ndp()) match = false;
+	n += n0;
+      }
+      CHECK(match);
+      CHECK2(n, N - 100);
+      CHECK(!r1.readN(v1, 64));
+    }
+    {
+      auto r = l[1].seek<Decoder>();
+      CHECK(r.scanFwd(ScanOp::GT, ZuFixed{4990, 2}));
+      CHECK(r.offset() == 4991);
+      CHECK(r.scanFwd(ScanOp::LE, ZuFixed{5, 1})); // 0.5 == 50 at ndp 2
+      CHECK(r.offset() == 9950);
+      CHECK(!r.scanFwd(ScanOp::GT, ZuFixed{5000, 2}));
+    }
+    {
+      static const uint64_t ranges[][2] = {
+	{ 0, N }, { 100, 9000 }, { 9990, N }, { 4000, 6000 }, { 1, 2 }
+      };
+      bool match = true;
+      for (const auto &range : ranges) {
+	ZuFixed min0, max0, min1, max1;
+	bool ok0 = l[0].minMax<Decoder>(range[0], range[1], min0, max0);
+	bool ok1 = l[1].minMax<Decoder>(range[0], range[1], min1, max1);
+	if (!ok0 || !ok1 ||
+	    min0.mantissa() != min1.mantissa() ||
+	    max0.mantissa() != max1.mantissa()) match = false;
+      }
+      CHECK(match);
+      ZuFixed min, max;
+      CHECK(l[1].minMax<Decoder>(100, 9000, min, max));
+      CHECK(min.mantissa() == 100 && max.mantissa() == 5000);
+      CHECK(!l[1].minMax<Decoder>(N, N + 1, min, max));
+    }
+    for (unsigned i = 0; i < 2; i++)
+      ZmBlock<>{}([&l, i](auto wake) {
+	l[i].close([wake = ZuMv(wake)](CloseResult) mutable { wake(); });
+      });
+  }
+  // read() / readN() throughput
+  {
+    enum { N = 1000000 };
+    Series b;
+    b.init(&store);
+    ZmBlock<>{}([&b](auto wake) {
+      b.open("test", "bench", [wake = ZuMv(wake)](OpenResult) mutable {
+	wake();
+      });
+    });
+    {
+      auto w = b.writer<DeltaEncoder<DeltaEncoder<>>>();
+      int64_t v = 1000000000;
+      for (unsigned i = 0; i < N; i++) {
+	w.write(ZuFixed{v, 9});
+	v += 1000 + ((i % 100) ? 0 : (i & 0xff)); // mostly regular, some jitter
+      }
+    }
+    ZtArray<ZuFixed> v1, v2;
+    v1.length(N);
+    v2.length(N);
+    unsigned n1 = 0, n2 = 0;
+    ZuTime t1, t2;
+    for (unsigned i = 0; i < 5; i++) { // best of 5, first pass warms up
+      ZuTime start = Zm::now();
+      {
+	auto r = b.seek<DeltaDecoder<DeltaDecoder<>>>();
+	n1 = 0;
+	while (n1 < N && r.read(v1[n1])) ++n1;
+      }
+      ZuTime t = Zm::now() - start;
+      if (!i || t < t1) t1 = t;
+      start = Zm::now();
+      {
+	auto r = b.seek<DeltaDecoder<DeltaDecoder<>>>();
+	n2 = r.readN(v2.data(), N);
+      }
+      t = Zm::now() - start;
+      if (!i || t < t2) t2 = t;
+    }
+    CHECK2(n1, N);
+    CHECK2(n2, N);
+    bool match = true;
+    for (unsigned i = 0; i < N; i++)
+      if (v1[i].mantissa() != v2[i].mantissa() || v1[i].ndp() != v2[i].ndp()) {
+	match = false;
+	break;
+      }
+    CHECK(match);
+    std::cout
+      << "read():  " << (double(t1.nanosecs()) / N) << "ns/value\n"
+      << "readN(): " << (double(t2.nanosecs()) / N) << "ns/value\n"
+      << std::flush;
+    ZmBlock<>{}([&b](auto wake) {
+      b.close([wake = ZuMv(wake)](CloseResult) mutable { wake(); });
+    });
+  }
   // s.final();
   // store.final();
 }
@@ -167,6 +167,12 @@ void ZeLog::start_()
 void ZeLog::start__()
 {
   if (m_thread) return;
+  if (m_threadBufSize) {
+    m_running = 1;
+    m_thread = ZmThread{[this]() { threadWork_(); },
+	ZmThreadParams().name("log").priority(ZmThreadPriority::Low)};
+    return;
+  }
   m_ring.init(ZmRingParams{m_bufSize});
   {
     int r;
@@ -194,6 +200,14 @@ void ZeLog::stop_()
     m_thread = {};
   }
   if (!thread) return;
+  if (m_threadBufSize) {
+    m_stopping = 1;
+    m_sem.post();
+    thread.join();		// wait for ring buffers to drain
+    m_stopping = 0;
+    m_running = 0;
+    return;
+  }
   m_ring.eof(true);
   thread.join();		// wait for ring buffer to drain
   m_ring.close();
@@ -210,6 +224,106 @@ void ZeLog::work_()
   }
 }
 
+// per-thread ring buffer, released (and marked EOF) on thread exit
+struct ZeLogThread : public ZmObject {
+  ZmRef<ZeLogThreadBuf>	buf;
+
+  ~ZeLogThread() { if (buf) buf->m_ring.eof(true); }
+};
+
+ZeLogThreadBuf *ZeLog::threadBuf_(ZeLogThread *thread)
+{
+  Guard guard(m_lock);
+  if (!thread->buf) {
+    ZmRef<ZeLogThreadBuf> buf = new ZeLogThreadBuf{};
+    buf->m_ring.init(ZmRingParams{m_threadBufSize});
+    if (buf->m_ring.open(ZeLogThreadBuf::Ring::Read |
+	  ZeLogThreadBuf::Ring::Write) != Zu::OK)
+      return nullptr;
+    auto context = ZmThreadContext::self();
+    buf->m_tid = context->tid();
+    buf->m_name = context->name();
+    if (!buf->m_name) buf->m_name << ZuBoxed(buf->m_tid);
+    m_threadBufs.push(buf);
+    ++m_bufSeqNo;
+    thread->buf = ZuMv(buf);
+  }
+  if (!m_program) init__();
+  try { start__(); } catch (...) {
+    throw ZtString{"ZeLog::start failed!"};
+  }
+  return thread->buf;
+}
+
+ZtArray<ZmRef<ZeLogThreadBuf>> ZeLog::threadBufs_()
+{
+  Guard guard(m_lock);
+  return m_threadBufs;
+}
+
+// the logger thread repeatedly dispatches the earliest event at the
+// head of all the per-thread ring buffers; messages are prefixed by time
+void ZeLog::threadWork_()
+{
+  ZtArray<ZmRef<ZeLogThreadBuf>> bufs;
+  ZtArray<void *> heads;
+  unsigned seqNo = 0;
+  bool refresh = true;
+
+  for (;;) {
+    if (refresh || m_bufSeqNo.load_() != seqNo) {
+      Guard guard(m_lock);
+      unsigned n = m_threadBufs.length();
+      for (unsigned i = 0; i < n; ) { // remove drained buffers of dead threads
+	if (m_threadBufs[i]->m_ring.readStatus() == Zu::EndOfFile) {
+	  m_threadBufs.splice(i, 1);
+	  --n;
+	} else
+	  i++;
+      }
+      bufs = m_threadBufs;
+      seqNo = m_bufSeqNo.load_();
+      heads.null();
+      heads.length(n, true);
+      refresh = false;
+    }
+    unsigned n = bufs.length();
+    int next = -1;
+    ZuTime time;
+    for (unsigned i = 0; i < n; i++) {
+      void *ptr = heads[i];
+      if (!ptr) {
+	if (!(ptr = heads[i] = bufs[i]->m_ring.tryShift())) {
+	  if (bufs[i]->m_ring.readStatus() == Zu::EndOfFile) refresh = true;
+	  continue;
+	}
+      }
+      if (next < 0 || *static_cast<const ZuTime *>(ptr) < time) {
+	next = i;
+	time = *static_cast<const ZuTime *>(ptr);
+      }
+    }
+    if (next >= 0) {
+      auto ptr = static_cast<uint8_t *>(heads[next]);
+      bufs[next]->m_ring.shift2(
+	  sizeof(ZuTime) + Fn::invoke(ptr + sizeof(ZuTime), this));
+      heads[next] = nullptr;
+      continue;
+    }
+    if (refresh) continue;
+    if (m_stopping.load_()) break;
+    // all ring buffers are empty - wait for a writer to wake the logger;
+    // the timeout guards against a wake-up that raced with going idle
+    m_idle = 1;
+    bool empty = true;
+    for (unsigned i = 0; i < n; i++)
+      if (bufs[i]->m_ring.readStatus()) { empty = false; break; }
+    if (empty && !m_stopping.load_() && m_bufSeqNo.load_() == seqNo)
+      m_sem.timedwait(Zm::now() + ZuTime{0, 10000000}); // 10ms
+    m_idle = 0;
+  }
+}
+
 ZmRef<ZeSink> ZeLog::sink_()
 {
   Guard guard(m_lock);
@@ -223,8 +337,22 @@ ZmRef<ZeSink> ZeLog::sink_()
   return m_sink;
 }
 
-void ZeLog::log__(Fn &fn)
+void *ZeLog::push_(unsigned size, ZuTime time)
 {
+  if (m_threadBufSize) {
+    auto thread = ZmSpecific<ZeLogThread>::instance();
+    ZeLogThreadBuf *buf = thread->buf;
+    if (ZuUnlikely(!buf || !m_running.load_()))
+      if (!(buf = threadBuf_(thread))) return nullptr;
+    auto ptr = static_cast<uint8_t *>(
+	buf->m_ring.tryPush(sizeof(ZuTime) + size));
+    if (ZuUnlikely(!ptr)) {
+      buf->m_dropped.store_(buf->m_dropped.load_() + 1);
+      return nullptr;
+    }
+    new (ptr) ZuTime{time};
+    return ptr + sizeof(ZuTime);
+  }
   if (ZuUnlikely(!m_ring.ctrl())) {
     Guard guard(m_lock);
     if (!m_program) init__();
@@ -232,14 +360,106 @@ void ZeLog::log__(Fn &fn)
       throw ZtString{"ZeLog::start failed!"};
     }
   }
+  return m_ring.push(size);
+}
+
+void ZeLog::push2_(void *ptr, unsigned size)
+{
+  if (m_threadBufSize) {
+    auto buf = ZmSpecific<ZeLogThread>::instance()->buf.ptr_();
+    buf->m_ring.push2(sizeof(ZuTime) + size);
+    if (ZuUnlikely(m_idle.load_())) wake_();
+    return;
+  }
+  m_ring.push2(ptr, size);
+}
+
+void ZeLog::log__(Fn &fn, ZuTime time)
+{
   unsigned size = fn.pushSize();
   void *ptr;
-  if (ZuLikely(ptr = m_ring.push(size))) {
+  if (ZuLikely(ptr = push_(size, time))) {
     fn.push(ptr);
-    m_ring.push2(ptr, size);
+    push2_(ptr, size);
   }
 }
 
+uint32_t ZeLog::fmtID(ZeLogFmt &fmt, const int8_t *types, unsigned nArgs)
+{
+  Guard guard(m_lock);
+  if (uint32_t id = fmt.id.load_()) return id;
+  fmt.types = types;
+  fmt.nArgs = nArgs;
+  if (!fmt.function) fmt.function = "";
+  fmt.id = ++m_fmtID; // store/release
+  return m_fmtID;
+}
+
+unsigned ZeLog::binInvoke(void *ptr, ZeLog *this_)
+{
+  auto msg = static_cast<BinMsg *>(ptr);
+  try {
+    this_->sink_()->bin(this_->m_buf, *msg->fmt, &msg->rec);
+  } catch (...) { }
+  return (sizeof(BinMsg) - sizeof(ZeLogRec)) + msg->rec.length;
+}
+
+void ZeLogFmt::print(ZeLogBuf &s, const ZeLogRec *rec) const
+{
+  using namespace ZeLogArgType;
+
+  const uint8_t *data = rec->data();
+  const uint8_t *end = data + rec->dataLen();
+  unsigned i = 0;
+  auto arg = [this, &s, &data, end, &i]() {
+    int type = types[i++];
+    unsigned n = size(type);
+    if (data + n > end) return;
+    switch (type) {
+      case Bool: s << (*data ? "true" : "false"); break;
+      case Char: s << static_cast<char>(*data); break;
+#define ZeLogFmt_print(Type, T) \
+      case Type: { T v; memcpy(&v, data, sizeof(T)); s << ZuBoxed(v); } break
+      ZeLogFmt_print(Int8, int8_t);
+      ZeLogFmt_print(UInt8, uint8_t);
+      ZeLogFmt_print(Int16, int16_t);
+      ZeLogFmt_print(UInt16, uint16_t);
+      ZeLogFmt_print(Int32, int32_t);
+      ZeLogFmt_print(UInt32, uint32_t);
+      ZeLogFmt_print(Int64, int64_t);
+      ZeLogFmt_print(UInt64, uint64_t);
+      ZeLogFmt_print(Float, float);
+      ZeLogFmt_print(Double, double);
+#undef ZeLogFmt_print
+      case String: {
+	uint16_t len;
+	memcpy(&len, data, sizeof(uint16_t));
+	if (data + n + len > end) { data = end; return; }
+	s << ZuString{reinterpret_cast<const char *>(data + n), len};
+	n += len;
+      } break;
+    }
+    data += n;
+  };
+  const char *format = this->format;
+  if (ZuUnlikely(!format)) return;
+  while (const char *p = strstr(format, "{}")) {
+    s << ZuString{format, unsigned(p - format)};
+    format = p + 2;
+    if (i < nArgs) arg(); else s << "{}";
+  }
+  s << format;
+}
+
+void ZeSink::bin(ZeLogBuf &buf, const ZeLogFmt &fmt, const ZeLogRec *rec)
+{
+  ZeEventInfo info = fmt.info(rec);
+  buf.null();
+  pre(buf, info);
+  fmt.print(buf, rec);
+  post(buf, info);
+}
+
 void ZeLog::age_()
 {
   ZmRef<ZeSink> sink;
@@ -17,6 +17,22 @@
 // if no sink is registered at initialization, the default sink is stderr
 // on Unix and the Application event log on Windows
 
+// binary (deferred) logging:
+// ZeBLOG(Info, "order {} filled {}@{}", id, qty, px);
+// - the format is a compile-time descriptor (ZeLogFmt), "{}" is replaced
+//   by the next argument; arguments must be booleans, characters,
+//   integers, floating point values or strings
+// - the caller only copies the raw arguments into the ring buffer;
+//   formatting is deferred to the logger thread, or performed offline
+//   when a binary sink is used (see ZiBinLogSink and zbinlog)
+
+// per-thread ring buffers:
+// ZeLog::threadBufSize(1<<16);	// before start(), 64Kbytes per thread
+// - logging threads never contend with each other, and never block;
+//   events are dropped if the thread's ring buffer is full
+// - the logger thread merges the per-thread ring buffers by event time
+// - see ZeLog::allThreadBufs() for telemetry (drops, overflows)
+
 #ifndef ZeLog_HH
 #define ZeLog_HH
 
@@ -25,10 +41,12 @@
 #endif
 
 #include <stdio.h>
+#include <string.h>
 
 #include <zlib/ZuCmp.hh>
 #include <zlib/ZuString.hh>
 
+#include <zlib/ZmAtomic.hh>
 #include <zlib/ZmBackTrace.hh>
 #include <zlib/ZmCleanup.hh>
 #include <zlib/ZmSemaphore.hh>
@@ -37,6 +55,7 @@
 #include <zlib/ZmRing.hh>
 #include <zlib/ZmRingFn.hh>
 
+#include <zlib/ZtArray.hh>
 #include <zlib/ZtString.hh>
 
 #include <zlib/ZePlatform.hh>
@@ -48,10 +67,150 @@
 
 class ZeLog;
 
+// binary log argument types
+namespace ZeLogArgType {
+  ZtEnumValues(ZeLogArgType, int8_t,
+    Bool, Char, Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64,
+    Float, Double, String);
+
+  // size of a fixed-size argument (strings are length-prefixed)
+  inline constexpr unsigned size(int i) {
+    constexpr uint8_t sizes[] = { 1, 1, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8, 2 };
+    return (i < 0 || i >= N) ? 0 : sizes[i];
+  }
+}
+
+// binary log record header, followed by the raw arguments; records are
+// padded to a multiple of 8 bytes and are stored in native byte order
+struct ZeLogRec {
+  uint32_t	length = 0;	// padded length, including this header
+  uint32_t	fmtID = 0;	// ZeLogFmt::id
+  int64_t	sec = 0;	// time
+  int32_t	nsec = 0;
+  int32_t	severity = 0;
+  uint64_t	tid = 0;
+
+  enum { Align = 8 };
+  static constexpr unsigned align(unsigned n) {
+    return (n + Align - 1) & ~(Align - 1);
+  }
+
+  ZuTime time() const { return ZuTime{sec, nsec}; }
+
+  const uint8_t *data() const {
+    return reinterpret_cast<const uint8_t *>(this + 1);
+  }
+  uint8_t *data() { return reinterpret_cast<uint8_t *>(this + 1); }
+  unsigned dataLen() const { return length - sizeof(ZeLogRec); }
+};
+
+// binary log argument encoding - fixed-size values are copied verbatim,
+// strings are stored as a 16bit length followed by the string data
+template <typename T_> struct ZeLogArg {
+  using T = ZuDecay<T_>;
+  using Traits = ZuTraits<T>;
+
+  static constexpr int type() {
+    using namespace ZeLogArgType;
+    if constexpr (Traits::IsBool) return Bool;
+    else if constexpr (ZuIsExact<T, char>{}) return Char;
+    else if constexpr (Traits::IsIntegral) {
+      constexpr bool s = Traits::IsSigned;
+      if constexpr (sizeof(T) == 1) return s ? Int8 : UInt8;
+      else if constexpr (sizeof(T) == 2) return s ? Int16 : UInt16;
+      else if constexpr (sizeof(T) == 4) return s ? Int32 : UInt32;
+      else return s ? Int64 : UInt64;
+    } else if constexpr (Traits::IsFloatingPoint)
+      return sizeof(T) == 4 ? Float : Double;
+    else if constexpr (Traits::IsString && !Traits::IsWString)
+      return String;
+    else
+      return Invalid;
+  }
+  static_assert(type() >= 0, "unsupported binary log argument type");
+
+  static unsigned len(const T &v) {
+    unsigned n = ZuString{v}.length();
+    return n > ZeLog_BUFSIZ ? ZeLog_BUFSIZ : n;
+  }
+  static unsigned size(const T &v) {
+    if constexpr (type() == ZeLogArgType::String)
+      return sizeof(uint16_t) + len(v);
+    else
+      return ZeLogArgType::size(type());
+  }
+  static uint8_t *write(uint8_t *ptr, const T &v) {
+    using namespace ZeLogArgType;
+    if constexpr (type() == String) {
+      uint16_t n = len(v);
+      memcpy(ptr, &n, sizeof(uint16_t));
+      memcpy(ptr + sizeof(uint16_t), ZuString{v}.data(), n);
+      return ptr + sizeof(uint16_t) + n;
+    } else if constexpr (type() == Double) {
+      double d = v; // long double is narrowed
+      memcpy(ptr, &d, sizeof(double));
+      return ptr + sizeof(double);
+    } else if constexpr (type() == Bool) {
+      *ptr = v;
+      return ptr + 1;
+    } else {
+      memcpy(ptr, &v, sizeof(T));
+      return ptr + sizeof(T);
+    }
+  }
+};
+template <typename ...Args> struct ZeLogArgs {
+  static const int8_t *types() {
+    if constexpr (!sizeof...(Args))
+      return nullptr;
+    else {
+      static constexpr int8_t types_[] = { ZeLogArg<Args>::type()... };
+      return &types_[0];
+    }
+  }
+};
+
+// binary log format descriptor, statically allocated at each call site;
+// the ID and argument types are assigned when it is first used
+struct ZeAPI ZeLogFmt {
+  int			severity = -1;
+  const char		*file = nullptr;
+  int			line = -1;
+  const char		*function = nullptr;
+  const char		*format = nullptr;
+  const int8_t		*types = nullptr;
+  unsigned		nArgs = 0;
+  ZmAtomic<uint32_t>	id = 0;		// 0 - unassigned
+
+  ZeLogFmt() = default;
+  ZeLogFmt(
+      int severity_, const char *file_, int line_,
+      const char *function_, const char *format_) :
+    severity{severity_}, file{file_}, line{line_},
+    function{function_}, format{format_} { }
+
+  ZeLogFmt(const ZeLogFmt &) = default;
+  ZeLogFmt &operator =(const ZeLogFmt &) = default;
+
+  ZeEventInfo info(const ZeLogRec *rec) const {
+    ZeEventInfo info;
+    info.time = rec->time();
+    info.tid = rec->tid;
+    info.severity = rec->severity;
+    info.file = file;
+    info.line = line;
+    info.function = function;
+    return info;
+  }
+
+  // format the raw arguments following rec
+  void print(ZeLogBuf &, const ZeLogRec *rec) const;
+};
+
 namespace ZeSinkType {
-  ZtEnumValues(ZeSinkType, int8_t, File, Debug, System, Lambda);
+  ZtEnumValues(ZeSinkType, int8_t, File, Debug, System, Lambda, Binary);
 }
-struct ZeSink : public ZmPolymorph {
+struct ZeAPI ZeSink : public ZmPolymorph {
   int	type;	// ZeSinkType
 
   ZeSink(int type_) : type(type_) { }
@@ -59,6 +218,9 @@ struct ZeSink : public ZmPolymorph {
   virtual void pre(ZeLogBuf &, const ZeEventInfo &) = 0;
   virtual void post(ZeLogBuf &, const ZeEventInfo &) = 0;
   virtual void age() = 0;
+
+  // binary log record - formats as text by default
+  virtual void bin(ZeLogBuf &, const ZeLogFmt &, const ZeLogRec *);
 };
 
 struct ZeSinkOptions {
@@ -159,6 +321,27 @@ struct ZeLambdaSink : public ZeLambdaSink_ {
   void age() { } // unused
 };
 
+// per-thread single-writer ring buffer (see ZeLog::threadBufSize())
+struct ZeLogThread;
+class ZeAPI ZeLogThreadBuf : public ZmObject {
+friend ZeLog;
+friend ZeLogThread;
+
+public:
+  using Ring = ZmRing<>;
+
+  Zm::ThreadID tid() const { return m_tid; }
+  const ZmThreadName &name() const { return m_name; }
+  const Ring &ring() const { return m_ring; }
+  uint64_t dropped() const { return m_dropped.load_(); } // events dropped
+
+private:
+  Ring			m_ring;
+  Zm::ThreadID		m_tid = 0;
+  ZmThreadName		m_name;
+  ZmAtomic<uint64_t>	m_dropped = 0;	// updated by the writer
+};
+
 class ZeAPI ZeLog {
   ZeLog(const ZeLog &);
   ZeLog &operator =(const ZeLog &);		// prevent mis-use
@@ -209,6 +392,20 @@ public:
     instance()->bufSize_(n);
   }
 
+  // non-zero - each logging thread has its own ring buffer of n bytes,
+  // which the logger thread merges by time; callers never contend or
+  // block - events are dropped (and counted) if the ring buffer is full;
+  // must be called before start()
+  static void threadBufSize(unsigned n) {
+    instance()->threadBufSize_(n);
+  }
+
+  // iterate over per-thread ring buffers (for telemetry)
+  template <typename L>
+  static void allThreadBufs(L l) {
+    for (const auto &buf : instance()->threadBufs_()) l(buf.ptr());
+  }
+
   static ZuString program() { return instance()->program_(); }
 
   static int level() { return instance()->level_(); }
@@ -230,6 +427,7 @@ public:
   template <typename L>
   void log_(ZeEvent<L> e) {
     if (static_cast<int>(e.severity) < m_level) return;
+    ZuTime time = e.time;
     auto fn_ = [e = ZuMv(e)](ZeLog *this_) mutable {
       auto sink = this_->sink_();
       auto &buf = this_->m_buf;
@@ -239,8 +437,45 @@ public:
       sink->post(buf, e);
     };
     Fn fn{fn_};
-    log__(fn);
+    log__(fn, time);
+  }
+
+  // binary logging - the caller copies the arguments into the ring
+  // buffer, formatting is deferred (see ZeBLOG())
+  template <typename ...Args>
+  static void logBin(ZeLogFmt &fmt, const Args &...args) {
+    instance()->logBin_(fmt, args...);
+  }
+  template <typename ...Args>
+  void logBin_(ZeLogFmt &fmt, const Args &...args) {
+    if (fmt.severity < m_level) return;
+    uint32_t id = fmt.id;
+    if (ZuUnlikely(!id))
+      id = fmtID(fmt, ZeLogArgs<Args...>::types(), sizeof...(Args));
+    unsigned length = ZeLogRec::align(
+	sizeof(ZeLogRec) + (0 + ... + ZeLogArg<Args>::size(args)));
+    unsigned size = sizeof(BinInvokeFn) + sizeof(BinMsg) - sizeof(ZeLogRec);
+    size += length;
+    ZuTime now = Zm::now();
+    auto ptr = static_cast<uint8_t *>(push_(size, now));
+    if (ZuUnlikely(!ptr)) return;
+    *reinterpret_cast<BinInvokeFn *>(ptr) = &ZeLog::binInvoke;
+    auto msg = reinterpret_cast<BinMsg *>(ptr + sizeof(BinInvokeFn));
+    msg->fmt = &fmt;
+    auto rec = &msg->rec;
+    rec->length = length;
+    rec->fmtID = id;
+    rec->sec = now.sec();
+    rec->nsec = now.nsec();
+    rec->severity = fmt.severity;
+    rec->tid = Zm::getTID();
+    uint8_t *data = rec->data();
+    ((data = ZeLogArg<Args>::write(data, args)), ...);
+    if (unsigned pad = (reinterpret_cast<uint8_t *>(rec) + length) - data)
+      memset(data, 0, pad);
+    push2_(ptr, size);
   }
+
   static void age() { instance()->age_(); }
 
 private:
@@ -251,6 +486,7 @@ private:
   void init__(const char *program, const char *facility);
 
   void bufSize_(unsigned n) { m_bufSize = n; }
+  void threadBufSize_(unsigned n) { m_threadBufSize = n; }
 
   ZuString program_() const { return m_program; }
   ZuString facility_() const { return m_facility; }
@@ -267,8 +503,28 @@ private:
   void forked_();
 
   void work_();
+  void threadWork_();
+
+  void log__(Fn &fn, ZuTime time);
+
+  // push_() returns null if the event is dropped, time is used to merge
+  // per-thread ring buffers
+  void *push_(unsigned size, ZuTime time);
+  void push2_(void *ptr, unsigned size);
+
+  ZeLogThreadBuf *threadBuf_(ZeLogThread *);
+  ZtArray<ZmRef<ZeLogThreadBuf>> threadBufs_();
+  void wake_() { if (m_idle.xch(0)) m_sem.post(); }
 
-  void log__(Fn &fn);
+  // binary log message in ring buffer - follows the invocation function
+  struct BinMsg {
+    const ZeLogFmt	*fmt;
+    ZeLogRec		rec;	// followed by the arguments
+  };
+  typedef unsigned (*BinInvokeFn)(void *, ZeLog *);
+  static unsigned binInvoke(void *ptr, ZeLog *);
+
+  uint32_t fmtID(ZeLogFmt &fmt, const int8_t *types, unsigned nArgs);
 
   void age_();
 
@@ -277,12 +533,22 @@ private:
   ZtString		m_facility;
   int			m_level;
   unsigned		m_bufSize = (1<<20);	// 1Mbyte
+  unsigned		m_threadBufSize = 0;	// 0 - shared ring buffer
 
   ZmThread		m_thread;
   Ring			m_ring;
 
+  // per-thread ring buffers
+  ZmAtomic<unsigned>	m_running = 0;	// logger thread is running
+  ZmAtomic<unsigned>	m_stopping = 0;
+  ZmAtomic<unsigned>	m_idle = 0;	// logger thread is waiting
+  ZmAtomic<unsigned>	m_bufSeqNo = 0;	// incremented by add/remove
+  ZmSemaphore		m_sem;
+
   Lock			m_lock;
     ZmRef<ZeSink>	  m_sink;
+    uint32_t		  m_fmtID = 0;	// last binary format ID
+    ZtArray<ZmRef<ZeLogThreadBuf>> m_threadBufs;
 
   // thread-specific
   ZeLogBuf		m_buf;
@@ -345,4 +611,24 @@ ZeBackTrace(ZeEvent<L> event_) {
 #define ZeLOG(sev, msg) ZeLOG_(Ze:: sev, msg)
 #define ZeLOGBT(sev, msg) ZeLOGBT_(Ze:: sev, msg)
 
+// binary logging - the format must be a string literal
+#define ZeBLOG__(sev, fmt, ...) \
+  ([&, fn_ = ZuFnName]() { \
+    static ZeLogFmt fmt_{sev, __FILE__, __LINE__, fn_, fmt}; \
+    ZeLog::logBin(fmt_ __VA_OPT__(,) __VA_ARGS__); \
+  }())
+
+#ifndef ZDEBUG
+
+#define ZeBLOG_(sev, fmt, ...) \
+  ((sev > Ze::Debug) ? ZeBLOG__(sev, fmt, __VA_ARGS__) : void())
+
+#else /* !ZDEBUG */
+
+#define ZeBLOG_(sev, fmt, ...) ZeBLOG__(sev, fmt, __VA_ARGS__)
+
+#endif /* !ZDEBUG */
+
+#define ZeBLOG(sev, fmt, ...) ZeBLOG_(Ze:: sev, fmt, __VA_ARGS__)
+
 #endif /* ZeLog_HH */
@@ -0,0 +1,259 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// binary log sink and reader
+
+#include <zlib/ZiBinLog.hh>
+
+using namespace ZiBinLog;
+
+void ZiBinLogSink::init()
+{
+  if (!m_path) m_path << ZeLog::program() << ".zlog";
+
+  Guard guard(m_lock);
+  open_();
+}
+
+ZiBinLogSink::~ZiBinLogSink()
+{
+  Guard guard(m_lock);
+  close_();
+}
+
+bool ZiBinLogSink::open_()
+{
+  ZiFile::age(m_path, m_age);
+  ZeError e;
+  if (m_file.mmap(m_path,
+	ZiFile::Create | ZiFile::Truncate, m_size, true, 0, 0666, &e) !=
+      Zi::OK) {
+    ZtString s;
+    s << '"' << m_path << "\": " << e << '\n';
+    fwrite(s.data(), 1, s.length(), stderr);
+    return false;
+  }
+  new (m_file.addr()) FileHdr{};
+  m_offset = sizeof(FileHdr);
+  m_defined.clear();
+  return true;
+}
+
+void ZiBinLogSink::close_()
+{
+  if (!m_file.addr()) return;
+  m_file.truncate(m_offset);
+  m_file.close();
+  m_offset = 0;
+}
+
+uint8_t *ZiBinLogSink::alloc_(unsigned length)
+{
+  auto ptr = static_cast<uint8_t *>(m_file.addr()) + m_offset;
+  m_offset += length;
+  return ptr;
+}
+
+void ZiBinLogSink::define(const ZeLogFmt &fmt)
+{
+  unsigned fileLen = strlen(fmt.file) + 1;
+  unsigned functionLen = strlen(fmt.function) + 1;
+  unsigned formatLen = strlen(fmt.format) + 1;
+  unsigned length = ZeLogRec::align(
+      sizeof(DefRec) + fmt.nArgs + fileLen + functionLen + formatLen);
+  auto ptr = alloc_(length);
+  memset(ptr, 0, length);
+  auto def = new (ptr) DefRec{};
+  def->length = length;
+  def->id = fmt.id.load_();
+  def->severity = fmt.severity;
+  def->line = fmt.line;
+  def->nArgs = fmt.nArgs;
+  ptr += sizeof(DefRec);
+  if (fmt.nArgs) memcpy(ptr, fmt.types, fmt.nArgs);
+  ptr += fmt.nArgs;
+  memcpy(ptr, fmt.file, fileLen); ptr += fileLen;
+  memcpy(ptr, fmt.function, functionLen); ptr += functionLen;
+  memcpy(ptr, fmt.format, formatLen);
+  m_defined.grow(def->id + 1, true);
+  m_defined[def->id] = true;
+}
+
+void ZiBinLogSink::bin(ZeLogBuf &, const ZeLogFmt &fmt, const ZeLogRec *rec)
+{
+  Guard guard(m_lock);
+
+  if (ZuUnlikely(!m_file.addr())) return;
+
+  uint32_t id = rec->fmtID;
+  auto defined = [this, id]() {
+    return id < m_defined.length() && m_defined[id];
+  };
+  auto defLength = [&fmt]() {
+    return ZeLogRec::align(
+	sizeof(DefRec) + fmt.nArgs +
+	strlen(fmt.file) + strlen(fmt.function) + strlen(fmt.format) + 3);
+  };
+  unsigned length = rec->length;
+  if (!defined()) length += defLength();
+  if (ZuUnlikely(m_offset + length > m_file.mmapLength())) {
+    if (length == rec->length) length += defLength();
+    if (length > m_size - sizeof(FileHdr)) return; // too large
+    close_();
+    if (!open_()) return;
+  }
+  if (!defined()) define(fmt);
+  memcpy(alloc_(rec->length), rec, rec->length);
+}
+
+void ZiBinLogSink::pre(ZeLogBuf &, const ZeEventInfo &)
+{
+  // text events are formatted without a prefix, see post()
+}
+
+void ZiBinLogSink::post(ZeLogBuf &buf, const ZeEventInfo &info)
+{
+  Guard guard(m_lock);
+
+  if (ZuUnlikely(!m_file.addr())) return;
+
+  const char *file = info.file ? info.file : "";
+  const char *function = info.function ? info.function : "";
+  unsigned fileLen = strlen(file) + 1;
+  unsigned functionLen = strlen(function) + 1;
+  if (fileLen > 0xffff) fileLen = 0xffff;
+  if (functionLen > 0xffff) functionLen = 0xffff;
+  unsigned length = ZeLogRec::align(
+      sizeof(ZeLogRec) + sizeof(TextRec) +
+      fileLen + functionLen + buf.length());
+  if (ZuUnlikely(m_offset + length > m_file.mmapLength())) {
+    if (length > m_size - sizeof(FileHdr)) return; // too large
+    close_();
+    if (!open_()) return;
+  }
+  auto ptr = alloc_(length);
+  memset(ptr, 0, length);
+  auto rec = new (ptr) ZeLogRec{};
+  rec->length = length;
+  rec->fmtID = TextID;
+  rec->sec = info.time.sec();
+  rec->nsec = info.time.nsec();
+  rec->severity = info.severity;
+  rec->tid = info.tid;
+  ptr = rec->data();
+  auto text = new (ptr) TextRec{};
+  text->line = info.line;
+  text->fileLen = fileLen;
+  text->functionLen = functionLen;
+  ptr += sizeof(TextRec);
+  memcpy(ptr, file, fileLen - 1); ptr += fileLen;
+  memcpy(ptr, function, functionLen - 1); ptr += functionLen;
+  memcpy(ptr, buf.data(), buf.length());
+}
+
+void ZiBinLogSink::age()
+{
+  Guard guard(m_lock);
+
+  close_();
+  open_();
+}
+
+int ZiBinLogReader::open(const ZiFile::Path &path, ZeError *e)
+{
+  close();
+
+  ZiFile file;
+  int r;
+  if ((r = file.open(path, ZiFile::ReadOnly, 0666, e)) != Zi::OK) return r;
+  ZiFile::Offset size = file.size();
+  m_data.length(size);
+  ZiFile::Offset offset = 0;
+  while (offset < size) {
+    unsigned n = size - offset;
+    if (n > (1U<<30)) n = (1U<<30);
+    if ((r = file.read(m_data.data() + offset, n, e)) <= 0) {
+      close();
+      return r < 0 ? r : Zi::IOError;
+    }
+    offset += r;
+  }
+  file.close();
+
+  auto hdr = reinterpret_cast<const FileHdr *>(m_data.data());
+  if (size < ZiFile::Offset(sizeof(FileHdr)) ||
+      hdr->magic != FileHdr::Magic || hdr->version != FileHdr::Version) {
+    close();
+#ifndef _WIN32
+    if (e) *e = EINVAL;
+#else
+    if (e) *e = ERROR_INVALID_DATA;
+#endif
+    return Zi::IOError;
+  }
+  return Zi::OK;
+}
+
+void ZiBinLogReader::close()
+{
+  m_data.null();
+  m_fmts.null();
+}
+
+unsigned ZiBinLogReader::replay(ZeSink *sink)
+{
+  if (m_data.length() < sizeof(FileHdr)) return 0;
+
+  const uint8_t *ptr = m_data.data() + sizeof(FileHdr);
+  const uint8_t *end = m_data.data() + m_data.length();
+  unsigned n = 0;
+  while (ptr + sizeof(ZeLogRec) <= end) {
+    auto rec = reinterpret_cast<const ZeLogRec *>(ptr);
+    unsigned length = rec->length;
+    if (!length || ptr + length > end) break; // end of file
+    ptr += length;
+    if (rec->fmtID == DefID) {
+      auto def = reinterpret_cast<const DefRec *>(rec);
+      auto types = reinterpret_cast<const int8_t *>(def + 1);
+      auto file = reinterpret_cast<const char *>(types + def->nArgs);
+      auto function = file + strlen(file) + 1;
+      auto format = function + strlen(function) + 1;
+      m_fmts.grow(def->id + 1);
+      auto &fmt = m_fmts[def->id];
+      fmt = ZeLogFmt{def->severity, file, def->line, function, format};
+      fmt.types = types;
+      fmt.nArgs = def->nArgs;
+      fmt.id = def->id;
+      continue;
+    }
+    if (rec->fmtID == TextID) {
+      auto text = reinterpret_cast<const TextRec *>(rec->data());
+      auto file = reinterpret_cast<const char *>(text + 1);
+      auto function = file + text->fileLen;
+      auto message = function + text->functionLen;
+      ZeEventInfo info;
+      info.time = rec->time();
+      info.tid = rec->tid;
+      info.severity = rec->severity;
+      info.file = file;
+      info.line = text->line;
+      info.function = function;
+      m_buf.null();
+      sink->pre(m_buf, info);
+      m_buf << ZuString{message,
+	  unsigned(reinterpret_cast<const char *>(ptr) - message)};
+      while (m_buf.length() && !m_buf[m_buf.length() - 1])
+	m_buf.length(m_buf.length() - 1); // trim padding
+      sink->post(m_buf, info);
+    } else {
+      if (rec->fmtID >= m_fmts.length() || !m_fmts[rec->fmtID].format)
+	continue; // undefined format
+      sink->bin(m_buf, m_fmts[rec->fmtID], rec);
+    }
+    ++n;
+  }
+  return n;
+}
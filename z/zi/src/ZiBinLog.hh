@@ -0,0 +1,138 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// binary log sink and reader
+//
+// ZeLog::sink(ZiBinLogSink::sink(ZeSinkOptions{}.path("app.zlog")));
+// ZeBLOG(Info, "order {} filled {}@{}", id, qty, px);
+//
+// binary log records (see ZeBLOG()) are appended verbatim to a
+// memory-mapped file, preceded by a definition of each format the first
+// time it occurs in the file; conventional events (ZeLOG()) are stored
+// as pre-formatted text; the file is rendered as text offline by zbinlog
+// (ZiBinLogReader), with the same layout as ZeFileSink
+//
+// the file is pre-allocated to size bytes; once full, it is truncated,
+// aged (see ZiFile::age()) and a new file is started - each file is
+// self-contained
+
+#ifndef ZiBinLog_HH
+#define ZiBinLog_HH
+
+#ifndef ZiLib_HH
+#include <zlib/ZiLib.hh>
+#endif
+
+#include <zlib/ZtArray.hh>
+#include <zlib/ZtString.hh>
+
+#include <zlib/ZeLog.hh>
+
+#include <zlib/ZiFile.hh>
+
+namespace ZiBinLog {
+
+// file format - a file header is followed by records, each of which
+// begins with the same 8 bytes as ZeLogRec; a zero length ends the file
+
+struct FileHdr {
+  enum { Magic = 0x424c655a };	// "ZeLB"
+  enum { Version = 1 };
+
+  uint32_t	magic = Magic;
+  uint32_t	version = Version;
+};
+
+// reserved format IDs
+enum {
+  DefID = 0,		// format definition
+  TextID = ~0U		// pre-formatted text event
+};
+
+// format definition, followed by the argument types, then the
+// null-terminated file, function and format strings
+struct DefRec {
+  uint32_t	length = 0;
+  uint32_t	fmtID = DefID;
+  uint32_t	id = 0;		// ZeLogFmt::id
+  int32_t	severity = 0;
+  int32_t	line = 0;
+  uint16_t	nArgs = 0;
+  uint16_t	pad_ = 0;
+};
+
+// text event - ZeLogRec, followed by this, then the null-terminated
+// file and function and the message (not null-terminated)
+struct TextRec {
+  int32_t	line = 0;
+  uint16_t	fileLen = 0;	// including null terminator
+  uint16_t	functionLen = 0;
+};
+
+} // ZiBinLog
+
+class ZiAPI ZiBinLogSink : public ZeSink {
+  using Lock = ZmPLock;
+  using Guard = ZmGuard<Lock>;
+
+public:
+  enum { DefaultSize = 64<<20 };	// 64Mb
+  enum { MinSize = 1<<20 };		// 1Mb
+
+  ZiBinLogSink() : ZeSink{ZeSinkType::Binary} { init(); }
+  ZiBinLogSink(const ZeSinkOptions &options, unsigned size = DefaultSize) :
+      ZeSink{ZeSinkType::Binary}, m_path{options.path()},
+      m_age{options.age()}, m_size{size < MinSize ? MinSize : size} {
+    init();
+  }
+
+  ~ZiBinLogSink();
+
+  template <typename ...Args>
+  static ZmRef<ZeSink> sink(Args &&...args) {
+    return new ZiBinLogSink(ZuFwd<Args>(args)...);
+  }
+
+  void pre(ZeLogBuf &, const ZeEventInfo &);
+  void post(ZeLogBuf &, const ZeEventInfo &);
+  void age();
+
+  void bin(ZeLogBuf &, const ZeLogFmt &, const ZeLogRec *);
+
+private:
+  void init();
+  bool open_();
+  void close_();
+  uint8_t *alloc_(unsigned length);
+
+  void define(const ZeLogFmt &);
+
+  ZtString		m_path;
+  unsigned		m_age = 8;
+  unsigned		m_size = DefaultSize;
+
+  Lock			m_lock;
+    ZiFile		  m_file;
+    unsigned		  m_offset = 0;
+    ZtArray<bool>	  m_defined;	// indexed by format ID
+};
+
+// reads a binary log file and replays it to a (text) sink
+class ZiAPI ZiBinLogReader {
+public:
+  int open(const ZiFile::Path &path, ZeError *e = nullptr);
+  void close();
+
+  // returns the number of events replayed
+  unsigned replay(ZeSink *sink);
+
+private:
+  ZtArray<uint8_t>	m_data;
+  ZtArray<ZeLogFmt>	m_fmts;		// indexed by format ID
+  ZeLogBuf		m_buf;
+};
+
+#endif /* ZiBinLog_HH */
@@ -304,7 +304,8 @@ int ZiFile::open_(
       blkSize = s.st_blksize;
     }
   }
-  if (length >= 0 && (size() < length || (flags & Truncate))) {
+  if (!(flags & ReadOnly) &&
+      length >= 0 && (size() < length || (flags & Truncate))) {
     if (ftruncate(h, length) < 0) { ::close(h); goto error; }
   }
 #else
@@ -335,7 +336,8 @@ int ZiFile::open_(
     h = CreateFile(
 	name, accessFlags, shareFlags, nullptr, createFlags, fileFlags, NULL);
     if (h == INVALID_HANDLE_VALUE) goto error;
-    if ((length > 0 && size() < length) || (flags & Truncate)) {
+    if (!(flags & ReadOnly) &&
+	((length > 0 && size() < length) || (flags & Truncate))) {
       LONG high = length>>32;
       if ((SetFilePointer(h, length & 0xffffffffU, &high, FILE_BEGIN) ==
 	    INVALID_SET_FILE_POINTER &&
@@ -416,7 +418,8 @@ int ZiFile::mmap(
     if (!m_addr) goto error;
     if (m_addr == MAP_FAILED) { m_addr = nullptr; goto error; }
   }
-  *(static_cast<uint8_t *>(m_addr) + (m_mmapLength - 1)) = 0;
+  if (!(flags & ReadOnly))
+    *(static_cast<uint8_t *>(m_addr) + (m_mmapLength - 1)) = 0;
 #else
   if (flags & Shm)
     m_mmapHandle = m_handle;
@@ -955,6 +958,25 @@ error:
   return Zi::IOError;
 }
 
+int ZiFile::datasync(ZeError *e)
+{
+#ifndef _WIN32
+#ifdef linux
+  if (fdatasync(m_handle) < 0) goto error;
+#else
+  if (fsync(m_handle) < 0) goto error;
+#endif
+#else
+  if (!FlushFileBuffers(m_handle)) goto error;
+#endif
+
+  return Zi::OK;
+
+error:
+  if (e) *e = ZeLastError;
+  return Zi::IOError;
+}
+
 int ZiFile::msync(void *addr, Offset length, ZeError *e)
 {
   if (!m_addr) {
@@ -129,6 +129,7 @@ public:
   void seek(Offset offset) { Guard guard(m_lock); m_offset = offset; }
 
   int sync(ZeError *e = nullptr);
+  int datasync(ZeError *e = nullptr);	// fdatasync() - omits metadata
   int msync(void *addr = 0, Offset length = 0, ZeError *e = nullptr);
 
   int read(void *ptr, unsigned len, ZeError *e = nullptr);
@@ -16,6 +16,8 @@
 
 #include <zlib/ZmAssert.hh>
 #include <zlib/ZmFn.hh>
+#include <zlib/ZmRef.hh>
+#include <zlib/ZmPolymorph.hh>
 
 #include <zlib/ZiIP.hh>
 
@@ -29,6 +31,8 @@ struct ZiIOContext {
   unsigned	offset = 0;	// offset within buffer - set by app
   unsigned	length = 0;	// length - set by ZiMultiplex
   ZiSockAddr	addr;		// set by app (send) / ZiMultiplex (recv)
+  ZmRef<const ZmPolymorph> pin;	// owner of buffer - set by app (send),
+				// retained until zero-copy send completes
 
   static constexpr uintptr_t invalid_ptr() { return uintptr_t(-1); }
 
@@ -37,7 +41,9 @@ friend ZiConnection;
   // initialize (called from within send/recv)
   template <typename Fn>
   void init_(Fn &&fn_) {
-    fn = ZuFwd<Fn>(fn_); ptr = nullptr; size = offset = length = 0; (*this)();
+    fn = ZuFwd<Fn>(fn_); ptr = nullptr; size = offset = length = 0;
+    pin = nullptr;
+    (*this)();
   }
 
 public:
@@ -48,6 +54,7 @@ public:
     fn = ZuFwd<Fn>(fn_);
     ptr = static_cast<uint8_t *>(const_cast<void *>(ptr_));
     size = size_; offset = offset_; length = 0;
+    pin = nullptr;
   }
   // UDP send
   template <typename Fn, typename Addr>
@@ -57,6 +64,7 @@ public:
     fn = ZuFwd<Fn>(fn_);
     ptr = static_cast<uint8_t *>(const_cast<void *>(ptr_));
     size = size_; offset = offset_; length = 0;
+    pin = nullptr;
     addr = ZuFwd<Addr>(addr_);
   }
   // initially, ptr will be null and app must set it via init()
@@ -66,6 +74,7 @@ public:
   void complete() {
     fn = {};
     ptr = nullptr;
+    pin = nullptr;
   }
   bool completed() const { return !fn; }
 
@@ -73,6 +82,7 @@ public:
   void disconnect() {
     fn = {};
     ptr = reinterpret_cast<uint8_t *>(invalid_ptr());
+    pin = nullptr;
   }
   bool disconnected() const {
     return reinterpret_cast<uintptr_t>(ptr) == invalid_ptr();
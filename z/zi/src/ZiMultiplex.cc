@@ -188,11 +188,23 @@ ZiMultiplex_WSExt::~ZiMultiplex_WSExt()
 #include <sys/syscall.h>
 #include <linux/unistd.h>
 #include <linux/sockios.h>
+#include <linux/errqueue.h>
+#include <fcntl.h>
 
 #ifndef EPOLLRDHUP
 #define EPOLLRDHUP 0
 #endif
 
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+
 #if 0
 #ifndef __NR_eventfd
 #if defined(__x86_64__)
@@ -207,6 +219,16 @@ ZiMultiplex_WSExt::~ZiMultiplex_WSExt()
 
 #endif /* ZiMultiplex_EPoll */
 
+#ifdef ZiMultiplex_IOURing
+#include <sys/mman.h>
+#include <poll.h>
+#include <linux/io_uring.h>
+
+#include <zlib/ZtArray.hh>
+
+#include <zlib/ZiIOBuf.hh>
+#endif
+
 using ErrorStr = ZuStringN<120>;
 
 #define Log(severity, op, result, error) \
@@ -226,6 +248,462 @@ ZiConnection::ZiConnection(ZiMultiplex *mx, const ZiCxnInfo &info) :
   m_rxContext.cxn = m_txContext.cxn = this;
 }
 
+#ifdef ZiMultiplex_EPoll
+// batched UDP receive - the first datagram of each recvmmsg() is received
+// directly into the application's buffer; the remainder are staged and
+// copied out one at a time as the application re-arms its receive context
+struct ZiConnection::RxBatch {
+  unsigned	size;			// max. datagrams per recvmmsg()
+  unsigned	slotSize = 0;		// staging slot size
+  unsigned	next = 0;		// next staged datagram to deliver
+  unsigned	count = 0;		// datagrams returned by recvmmsg()
+  uint8_t	*slots = nullptr;	// staging slots [1, size)
+  mmsghdr	*msgs;
+  iovec		*iovs;
+  ZiSockAddr	*addrs;
+
+  RxBatch(unsigned n) :
+    size{n}, msgs{new mmsghdr[n]}, iovs{new iovec[n]},
+    addrs{new ZiSockAddr[n]} { }
+  ~RxBatch() {
+    delete [] slots;
+    delete [] msgs;
+    delete [] iovs;
+    delete [] addrs;
+  }
+
+  uint8_t *slot(unsigned i) { return slots + (i - 1) * slotSize; }
+
+  // only called when no staged datagrams are pending
+  void reserve(unsigned n) {
+    if (ZuLikely(n <= slotSize)) return;
+    delete [] slots;
+    slots = new uint8_t[(size - 1) * n];
+    slotSize = n;
+  }
+};
+
+// batched UDP send - datagrams are copied into staging slots as the
+// application sends them, completing each send immediately; the slots
+// are flushed by sendmmsg() when full, and otherwise once the work
+// already queued on the Tx thread has been processed
+struct ZiConnection::TxBatch {
+  unsigned	size;			// max. datagrams per sendmmsg()
+  unsigned	slotSize = 0;		// staging slot size
+  unsigned	sent = 0;		// datagrams sent from staging
+  unsigned	count = 0;		// datagrams staged
+  bool		queued = false;		// flush queued on Tx thread
+  bool		blocked = false;	// flush returned EAGAIN
+  uint8_t	*slots = nullptr;	// staging slots [0, size)
+  mmsghdr	*msgs;
+  iovec		*iovs;
+  ZiSockAddr	*addrs;
+
+  TxBatch(unsigned n) :
+    size{n}, msgs{new mmsghdr[n]}, iovs{new iovec[n]},
+    addrs{new ZiSockAddr[n]} { }
+  ~TxBatch() {
+    delete [] slots;
+    delete [] msgs;
+    delete [] iovs;
+    delete [] addrs;
+  }
+
+  uint8_t *slot(unsigned i) { return slots + i * slotSize; }
+
+  // only called when no staged datagrams are pending
+  void reserve(unsigned n) {
+    if (ZuLikely(n <= slotSize)) return;
+    delete [] slots;
+    slots = new uint8_t[size * n];
+    slotSize = n;
+  }
+};
+
+// zero-copy send - the kernel numbers each successful MSG_ZEROCOPY send
+// sequentially, notifying completion of ranges of sends via the socket
+// error queue; the buffer pinned by each send is retained until then;
+// Tx thread exclusive (completions are forwarded by the Rx thread)
+struct ZiConnection::ZeroCopy {
+  using Pin = ZmRef<const ZmPolymorph>;
+
+  Pin		*pins = nullptr;	// ring of pins [head, tail)
+  unsigned	size = 0;		// ring size (power of 2)
+  uint32_t	head = 0;		// oldest unreleased send
+  uint32_t	tail = 0;		// next send
+  bool		off = false;		// SO_ZEROCOPY unsupported - copy
+
+  ~ZeroCopy() { delete [] pins; }
+
+  unsigned count() const { return tail - head; }
+
+  void push(Pin pin) {
+    if (ZuUnlikely(count() >= size)) grow();
+    pins[tail++ & (size - 1)] = ZuMv(pin);
+  }
+  void grow() {
+    unsigned n = size ? (size<<1) : 64;
+    auto pins_ = new Pin[n];
+    for (uint32_t i = head; i != tail; i++)
+      pins_[i & (n - 1)] = ZuMv(pins[i & (size - 1)]);
+    delete [] pins;
+    pins = pins_;
+    size = n;
+  }
+
+  // release sends [lo, hi] - ranges may be notified out of order
+  void release(uint32_t lo, uint32_t hi) {
+    for (uint32_t i = lo; ; i++) {
+      if (i - head < count()) pins[i & (size - 1)] = nullptr;
+      if (i == hi) break;
+    }
+    while (head != tail && !pins[head & (size - 1)]) head++;
+  }
+};
+
+// splice() relay - data is moved from the socket into a pipe, and from
+// the pipe into the peer's socket; Rx thread exclusive
+struct ZiConnection::Splice {
+  enum { Size = 65536 };	// max. bytes per splice()
+
+  ZmRef<ZiConnection>	peer;
+  int			pipe[2] = { -1, -1 };
+  unsigned		pending = 0;	// bytes in pipe
+
+  Splice(ZmRef<ZiConnection> peer_) : peer{ZuMv(peer_)} { }
+  ~Splice() {
+    if (pipe[0] >= 0) ::close(pipe[0]);
+    if (pipe[1] >= 0) ::close(pipe[1]);
+  }
+};
+#endif
+
+#ifdef ZiMultiplex_IOURing
+inline constexpr const char *ZiMultiplex_URingBuf_HeapID() {
+  return "ZiMultiplex.URingBuf";
+}
+
+// io_uring submission and completion queues, and the ring of provided
+// buffers consumed by multishot recv; Rx thread exclusive once started
+//
+// SQEs are queued and submitted together with the next wait for
+// completions, or as soon as epollQuantum SQEs are pending; up to
+// epollQuantum completions are processed per wait
+struct ZiMultiplex::URing {
+  // user_data tags (low 3 bits) - ZiConnection, Listener, Connect
+  // and Readable are all at least 8-byte aligned
+  enum {
+    Recv = 0,		// ZiConnection - multishot recv
+    Accept,		// Listener - multishot accept
+    Connect,		// Connect - POLLOUT (connection completion)
+    Wake,		// wake pipe - multishot POLLIN
+    PollIn,		// ZiConnection - multishot POLLIN (UDP, netlink)
+    PollOut,		// ZiConnection - POLLOUT (Tx blocked)
+    Readable,		// Readable - multishot POLLIN
+    Ignore = 7,		// cancelation
+    Mask = 7
+  };
+
+  using Buf = ZiIOBufAlloc<16384, ZiMultiplex_URingBuf_HeapID>;
+
+  int			fd = -1;
+  unsigned		quantum = 0;
+  unsigned		pending = 0;	// SQEs queued but not yet submitted
+  unsigned		inFlight = 0;	// requests awaiting their final CQE
+
+  void			*ringMap = nullptr;
+  size_t		ringSize = 0;
+  io_uring_sqe		*sqes = nullptr;
+  unsigned		sqEntries = 0;
+  unsigned		*sqHead = nullptr;
+  unsigned		*sqTail = nullptr;
+  unsigned		sqMask = 0;
+  unsigned		sqTail_ = 0;	// local tail, published by push()
+  unsigned		*cqHead = nullptr;
+  unsigned		*cqTail = nullptr;
+  unsigned		cqMask = 0;
+  io_uring_cqe		*cqes = nullptr;
+
+  // CQEs reaped by sqe() to relieve a full CQ, returned first by cqe()
+  ZtArray<io_uring_cqe>	overflow;
+  unsigned		overflowHead = 0;
+
+  io_uring_buf		*bufRing = nullptr; // tail overlays bufRing[0].resv
+  unsigned		nBufs = 0;
+  uint16_t		bufTail = 0;
+  ZmRef<ZiIOBuf>	*bufs = nullptr;
+
+  ~URing() { close(); }
+
+  static int setup(unsigned entries, io_uring_params *p) {
+    return syscall(__NR_io_uring_setup, entries, p);
+  }
+  int enter(unsigned submit, unsigned wait, bool reap) {
+    return syscall(__NR_io_uring_enter, fd, submit, wait,
+	reap ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+  }
+  int register_(unsigned op, void *arg, unsigned n) {
+    return syscall(__NR_io_uring_register, fd, op, arg, n);
+  }
+
+  bool init(unsigned depth, unsigned nBufs_, unsigned quantum_) {
+    io_uring_params p;
+    memset(&p, 0, sizeof(io_uring_params));
+    p.flags = IORING_SETUP_CQSIZE | IORING_SETUP_COOP_TASKRUN;
+    p.cq_entries = depth<<2; // multishot requests post many completions
+    if ((fd = setup(depth, &p)) < 0) {
+      Warning("io_uring_setup", Zi::IOError, ZeLastError);
+      return false;
+    }
+    if (!(p.features & IORING_FEAT_SINGLE_MMAP) ||
+	!(p.features & IORING_FEAT_NODROP)) {
+      Warning("io_uring_setup", Zi::IOError, ZeError{EOPNOTSUPP});
+      return false;
+    }
+    quantum = quantum_;
+    ringSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    {
+      size_t cqSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+      if (ringSize < cqSize) ringSize = cqSize;
+    }
+    ringMap = mmap(0, ringSize, PROT_READ | PROT_WRITE,
+	MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ringMap == MAP_FAILED) {
+      ringMap = nullptr;
+      Warning("mmap(IORING_OFF_SQ_RING)", Zi::IOError, ZeLastError);
+      return false;
+    }
+    sqEntries = p.sq_entries;
+    sqes = static_cast<io_uring_sqe *>(mmap(0,
+	  sqEntries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+	  MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+    if (sqes == MAP_FAILED) {
+      sqes = nullptr;
+      Warning("mmap(IORING_OFF_SQES)", Zi::IOError, ZeLastError);
+      return false;
+    }
+    auto ring = static_cast<uint8_t *>(ringMap);
+    sqHead = reinterpret_cast<unsigned *>(ring + p.sq_off.head);
+    sqTail = reinterpret_cast<unsigned *>(ring + p.sq_off.tail);
+    sqMask = *reinterpret_cast<unsigned *>(ring + p.sq_off.ring_mask);
+    sqTail_ = *sqTail;
+    {
+      auto array = reinterpret_cast<unsigned *>(ring + p.sq_off.array);
+      for (unsigned i = 0; i < sqEntries; i++) array[i] = i;
+    }
+    cqHead = reinterpret_cast<unsigned *>(ring + p.cq_off.head);
+    cqTail = reinterpret_cast<unsigned *>(ring + p.cq_off.tail);
+    cqMask = *reinterpret_cast<unsigned *>(ring + p.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(ring + p.cq_off.cqes);
+
+    // provided buffers - a power of 2, drawn from ZiIOBufAlloc
+    nBufs = 1;
+    while (nBufs < nBufs_ && nBufs < 32768) nBufs <<= 1;
+    {
+      void *ptr = mmap(0, nBufs * sizeof(io_uring_buf),
+	  PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (ptr == MAP_FAILED) {
+	Warning("mmap", Zi::IOError, ZeLastError);
+	return false;
+      }
+      bufRing = static_cast<io_uring_buf *>(ptr);
+    }
+    {
+      io_uring_buf_reg reg;
+      memset(&reg, 0, sizeof(io_uring_buf_reg));
+      reg.ring_addr = reinterpret_cast<uintptr_t>(bufRing);
+      reg.ring_entries = nBufs;
+      reg.bgid = 0;
+      if (register_(IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+	Warning("io_uring_register(IORING_REGISTER_PBUF_RING)",
+	    Zi::IOError, ZeLastError);
+	return false;
+      }
+    }
+    bufs = new ZmRef<ZiIOBuf>[nBufs];
+    for (unsigned i = 0; i < nBufs; i++) {
+      bufs[i] = new Buf{};
+      recycle(i);
+    }
+    return true;
+  }
+
+  void close() {
+    if (fd >= 0) { ::close(fd); fd = -1; }
+    if (sqes) {
+      munmap(sqes, sqEntries * sizeof(io_uring_sqe));
+      sqes = nullptr;
+    }
+    if (ringMap) { munmap(ringMap, ringSize); ringMap = nullptr; }
+    if (bufRing) {
+      munmap(bufRing, nBufs * sizeof(io_uring_buf));
+      bufRing = nullptr;
+    }
+    delete [] bufs;
+    bufs = nullptr;
+  }
+
+  // obtain a cleared SQE - push() must follow; if the SQ is full, the
+  // kernel may be unable to consume it (EAGAIN / EBUSY) until CQEs are
+  // reaped, in which case they are stashed for cqe()
+  io_uring_sqe *sqe() {
+    for (;;) {
+      unsigned head = ZmAtomic_load(sqHead);
+      ZmAtomic_acquire();
+      if (ZuLikely(sqTail_ - head < sqEntries)) break;
+      int r = submit_(false, false);
+      if (ZuUnlikely(r < 0)) break; // reported by submit_()
+      if (r) continue;
+      io_uring_cqe cqe;
+      bool reaped = false;
+      while (cqe_(cqe)) {
+	new (overflow.push()) io_uring_cqe{cqe};
+	reaped = true;
+      }
+      if (!reaped) enter(0, 1, true);
+    }
+    io_uring_sqe *sqe = &sqes[sqTail_ & sqMask];
+    memset(sqe, 0, sizeof(io_uring_sqe));
+    return sqe;
+  }
+  void push() {
+    ++sqTail_;
+    ZmAtomic_release();
+    ZmAtomic_store(sqTail, sqTail_);
+    if (++pending >= quantum) submit();
+  }
+
+  // submit pending SQEs, optionally waiting for a completion (unless
+  // stashed CQEs are ready); reap without waiting runs deferred task
+  // work to post ready completions
+  bool submit(bool wait = false, bool reap = false) {
+    if (overflowHead < overflow.length()) wait = false;
+    return submit_(wait, reap) >= 0;
+  }
+  // returns 1 if submitted, 0 if the kernel is busy (EAGAIN / EBUSY),
+  // -1 on error
+  int submit_(bool wait, bool reap) {
+    for (;;) {
+      int r = enter(pending, wait, wait || reap);
+      if (ZuLikely(r >= 0)) {
+	pending = unsigned(r) >= pending ? 0U : pending - r;
+	return 1;
+      }
+      ZeError e{errno};
+      if (e.errNo() == EINTR) continue;
+      if (e.errNo() == EAGAIN || e.errNo() == EBUSY) return 0;
+      Error("io_uring_enter", Zi::IOError, e);
+      return -1;
+    }
+  }
+
+  bool cqe(io_uring_cqe &cqe) {
+    if (ZuUnlikely(overflowHead < overflow.length())) {
+      cqe = overflow[overflowHead++];
+      if (overflowHead == overflow.length()) {
+	overflow.length(0);
+	overflowHead = 0;
+      }
+      return true;
+    }
+    return cqe_(cqe);
+  }
+  bool cqe_(io_uring_cqe &cqe) {
+    unsigned head = *cqHead;
+    unsigned tail = ZmAtomic_load(cqTail);
+    ZmAtomic_acquire();
+    if (head == tail) return false;
+    cqe = cqes[head & cqMask];
+    ZmAtomic_release();
+    ZmAtomic_store(cqHead, head + 1);
+    if ((cqe.user_data & Mask) != Ignore && !(cqe.flags & IORING_CQE_F_MORE))
+      --inFlight;
+    return true;
+  }
+
+  // return a provided buffer to the kernel
+  void recycle(unsigned bid) {
+    // io_uring_buf_ring::bufs is mis-declared for C++ (the empty
+    // struct preceding the flexible array has non-zero size)
+    io_uring_buf &buf = bufRing[bufTail & (nBufs - 1)];
+    buf.addr = reinterpret_cast<uintptr_t>(bufs[bid]->data());
+    buf.len = bufs[bid]->size;
+    buf.bid = bid;
+    ZmAtomic_release();
+    ZmAtomic_store(&bufRing[0].resv, ++bufTail);
+  }
+  const uint8_t *buf(unsigned bid) const { return bufs[bid]->data(); }
+
+  void recv(int s, uintptr_t data) {
+    io_uring_sqe *sqe = this->sqe();
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = s;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    sqe->user_data = data;
+    push();
+    ++inFlight;
+  }
+  void accept(int s, uintptr_t data) {
+    io_uring_sqe *sqe = this->sqe();
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = s;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK;
+    sqe->user_data = data;
+    push();
+    ++inFlight;
+  }
+  void poll(int s, uintptr_t data, unsigned events, bool multishot) {
+    io_uring_sqe *sqe = this->sqe();
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = s;
+    sqe->poll32_events = events;
+    if (multishot) sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->user_data = data;
+    push();
+    ++inFlight;
+  }
+  // cancel a single request
+  void cancel(uintptr_t data) {
+    io_uring_sqe *sqe = this->sqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = data;
+    sqe->user_data = Ignore;
+    push();
+  }
+  // cancel all requests on a socket - submitted immediately, before close()
+  void cancelFD(int s) {
+    io_uring_sqe *sqe = this->sqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = s;
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+    sqe->user_data = Ignore;
+    push();
+    submit();
+  }
+  void cancelAll() {
+    io_uring_sqe *sqe = this->sqe();
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY | IORING_ASYNC_CANCEL_ALL;
+    sqe->user_data = Ignore;
+    push();
+    submit();
+  }
+};
+
+// multishot recv state - data that arrived after the application
+// completed its receive context is stashed until it is re-armed
+struct ZiConnection::URingRx {
+  ZtArray<uint8_t>	stash;
+  bool			armed = false;	// multishot recv outstanding
+  bool			canceled = false;
+};
+#endif
+
 ZiConnection::~ZiConnection()
 {
   // precautionary code to ensure no leaking of sockets
@@ -234,6 +712,16 @@ ZiConnection::~ZiConnection()
     ZeLOG(Warning, "~ZiConnection() called with socket still open");
     Zi::closeSocket(m_info.socket);
   }
+
+#ifdef ZiMultiplex_EPoll
+  delete m_rxBatch;
+  delete m_txBatch;
+  delete m_zeroCopy;
+  delete m_splice;
+#endif
+#ifdef ZiMultiplex_IOURing
+  delete m_uringRx;
+#endif
 }
 
 void ZiMultiplex::udp(ZiConnectFn fn, ZiFailFn failFn,
@@ -366,6 +854,7 @@ void ZiMultiplex::udp_(ZiConnectFn fn, ZiFailFn failFn,
     failFn(false);
     return;
   }
+  initBusyPoll(s);
 #endif
 
 #else /* !_WIN32 */
@@ -675,7 +1164,12 @@ retry:
     ZiSockAddr remote(ci.remoteIP, ci.remotePort);
     if (::connect(s, remote.sa(), remote.len()) < 0) {
       ZeError e{errno};
-      if (e.errNo() == EAGAIN || e.errNo() == EINPROGRESS) return;
+      if (e.errNo() == EAGAIN || e.errNo() == EINPROGRESS) {
+#ifdef ZiMultiplex_IOURing
+	if (m_uring) uringConnect(request);
+#endif
+	return;
+      }
       if (e.errNo() == EINTR) goto retry;
       connectDel(s);
       ::close(s);
@@ -981,6 +1475,85 @@ found:
   m_nAccepts -= nAccepts;
 }
 
+#ifdef ZiMultiplex_EPoll
+void ZiMultiplex::addReadable(int fd, ZmFn<> fn)
+{
+  if (ZuUnlikely(!running())) {
+    Error("addReadable", Zi::NotReady, ZeOK);
+    return;
+  }
+
+  rxInvoke([this, fd, fn = ZuMv(fn)]() mutable {
+    addReadable_(fd, ZuMv(fn));
+  });
+}
+
+void ZiMultiplex::addReadable_(int fd, ZmFn<> fn)
+{
+  if (m_readables->find(fd)) {
+    Error("addReadable", Zi::IOError, ZeError{EEXIST});
+    return;
+  }
+
+  ZmRef<Readable> readable = new Readable(fd, ZuMv(fn));
+  m_readables->addNode(readable);
+
+#ifdef ZiMultiplex_IOURing
+  if (m_uring) {
+    ZmREF(readable);
+    m_uring->poll(fd,
+	reinterpret_cast<uintptr_t>(readable.ptr()) | URing::Readable,
+	POLLIN, true);
+  } else
+#endif
+  {
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(struct epoll_event));
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.u64 = reinterpret_cast<uintptr_t>(readable.ptr()) | 3;
+    if (epoll_ctl(m_epollFD, EPOLL_CTL_ADD, fd, &ev) < 0) {
+      ZeError e{errno};
+      m_readables->del(fd);
+      Error("epoll_ctl(EPOLL_CTL_ADD)", Zi::IOError, e);
+      return;
+    }
+    ZmREF(readable); // released by delReadable_() / stop
+  }
+
+  // fd may have become readable before it was registered
+  readable->m_fn();
+}
+
+void ZiMultiplex::delReadable(int fd, ZmFn<> fn)
+{
+  if (ZuUnlikely(!running())) { fn(); return; }
+
+  rxInvoke([this, fd, fn = ZuMv(fn)]() mutable {
+    delReadable_(fd, ZuMv(fn));
+  });
+}
+
+void ZiMultiplex::delReadable_(int fd, ZmFn<> fn)
+{
+  if (ZmRef<Readable> readable = m_readables->del(fd)) {
+    readable->m_up = false;
+#ifdef ZiMultiplex_IOURing
+    if (m_uring)
+      m_uring->cancelFD(fd);
+    else
+#endif
+    {
+      epoll_ctl(m_epollFD, EPOLL_CTL_DEL, fd, 0);
+      // events for fd may remain in the current epoll batch, and this
+      // may be called from within readable->m_fn() - release epoll's
+      // reference only once the current batch has been processed
+      rxRun([this, readable = ZuMv(readable)]() { ZmDEREF(readable); });
+    }
+  }
+  fn();
+}
+#endif
+
 void ZiMultiplex::accept(Listener *listener)
 {
 #ifdef ZiMultiplex_IOCP
@@ -1026,9 +1599,19 @@ retry:
     return;
   }
 
+  accepted(listener, s, remote);
+
+  goto retry;
+#endif
+}
+
+#ifdef ZiMultiplex_EPoll
+void ZiMultiplex::accepted(
+    Listener *listener, Socket s, const ZiSockAddr &remote)
+{
   if (!initSocket(s, listener->info().options)) {
     ::close(s);
-    goto retry;
+    return;
   }
 
   ZiDEBUG(this, ZtSprintf("FD: % 3d ACCEPTING from %s:%u", s,
@@ -1038,10 +1621,40 @@ retry:
       ZiCxnType::TCPIn, s, listener->info().options,
       listener->info().ip, listener->info().port,
       remote.ip(), remote.port() });
+}
 
-  goto retry;
-#endif
+void ZiMultiplex::acceptError(Listener *listener)
+{
+  int n;
+  int s = listener->info().socket;
+  if (ioctl(s, FIONREAD, &n) < 0) {
+    ZeError e{errno};
+    listenerDel(s);
+    ::close(s);
+    Error("listen", Zi::IOError, e);
+  }
+}
+
+void ZiMultiplex::connectError(Connect *request)
+{
+  int n;
+  int s = request->info().socket;
+  ZeError e;
+  if (ioctl(s, FIONREAD, &n) < 0)
+    e = errno;
+  else {
+    int errNo = EIO;
+    socklen_t l = sizeof(int);
+    if (getsockopt(s, SOL_SOCKET, SO_ERROR, &errNo, &l) < 0)
+      errNo = EIO;
+    e = errNo;
+  }
+  connectDel(s);
+  ::close(s);
+  // Warning("connect", Zi::IOError, e);
+  request->fail(true);
 }
+#endif
 
 #ifdef ZiMultiplex_IOCP
 void ZiMultiplex::overlappedAccept(Accept *request,
@@ -1100,6 +1713,12 @@ void ZiConnection::connected()
 #endif
 
 #ifdef ZiMultiplex_EPoll
+#ifdef ZiMultiplex_IOURing
+  if (m_mx->m_uring) {
+    if (ZuLikely(!m_rxContext.completed())) uringRecv();
+    return;
+  }
+#endif
   if (ZuUnlikely(m_rxContext.completed()))
     m_mx->epollRecv(this, m_info.socket, 0);
 #endif
@@ -1123,6 +1742,9 @@ void ZiConnection::recv_(ZiIOFn fn)
 
 #ifdef ZiMultiplex_EPoll
   if (ZuLikely(!m_rxContext.completed())) {
+#ifdef ZiMultiplex_IOURing
+    if (m_mx->m_uring) { uringRecv(); return; }
+#endif
     if (!m_mx->epollRecv(this, m_info.socket, EPOLLIN | EPOLLRDHUP))
       m_rxContext.complete();
     else
@@ -1140,6 +1762,11 @@ void ZiConnection::recv_(ZiIOFn fn)
 #ifdef ZiMultiplex_EPoll
 bool ZiMultiplex::epollRecv(ZiConnection *cxn, int s, uint32_t events)
 {
+#ifdef ZiMultiplex_IOURing
+  // io_uring readiness is multishot - recv() ignores it while completed
+  if (m_uring) return true;
+#endif
+
   struct epoll_event ev;
   memset(&ev, 0, sizeof(struct epoll_event));
   ev.events = events | EPOLLOUT | EPOLLET;
@@ -1171,6 +1798,10 @@ void ZiConnection::recv()
 #endif
   }
 
+#ifdef ZiMultiplex_EPoll
+  if (ZuUnlikely(m_splice)) return spliceRecv();
+#endif
+
   if (ZuUnlikely(m_rxContext.completed()))
 #ifdef ZiMultiplex_EPoll
     return true;
@@ -1242,6 +1873,9 @@ void ZiConnection::recv()
     return true;
   }
 
+  if (m_info.options.udp() && m_info.options.batch() && m_mx->rxBatch() > 1)
+    return recvBatch();
+
   unsigned len = m_rxContext.size - m_rxContext.offset;
   auto buf = m_rxContext.ptr + m_rxContext.offset;
 
@@ -1324,6 +1958,199 @@ retry:
 #endif
 }
 
+#ifdef ZiMultiplex_EPoll
+bool ZiConnection::recvBatch()
+{
+  RxBatch *batch = m_rxBatch;
+  if (ZuUnlikely(!batch)) batch = m_rxBatch = new RxBatch{m_mx->rxBatch()};
+
+  // returns 0 to continue, 1 if the context completed, -1 if disconnected
+  auto rearmed = [this]() -> int {
+    if (ZuUnlikely(m_rxContext.completed())) {
+      if (m_rxContext.disconnected()) {
+	disconnect();
+	return -1;
+      }
+      m_mx->epollRecv(this, m_info.socket, 0);
+      return 1;
+    }
+    if (ZuUnlikely(m_rxContext.offset >= m_rxContext.size)) {
+      m_rxContext.complete();
+      m_mx->epollRecv(this, m_info.socket, 0);
+      return 1;
+    }
+    return 0;
+  };
+
+  ZeError e;
+  int r;
+  bool drained = false;
+
+  for (;;) {
+    // deliver datagrams staged by a previous recvmmsg()
+    while (batch->next < batch->count) {
+      unsigned i = batch->next++;
+      unsigned n = batch->msgs[i].msg_len;
+      if (ZuUnlikely(!n)) continue;
+      unsigned len = m_rxContext.size - m_rxContext.offset;
+      if (ZuUnlikely(n > len)) n = len; // truncate, as recvfrom() would
+      memcpy(m_rxContext.ptr + m_rxContext.offset, batch->slot(i), n);
+      m_rxContext.addr = batch->addrs[i];
+      executedRecv(n);
+      if (int j = rearmed()) return j > 0;
+    }
+
+    // a short batch drained the socket - edge-triggered epoll will
+    // notify again on the next arrival
+    if (drained) return true;
+
+    unsigned len = m_rxContext.size - m_rxContext.offset;
+    unsigned n = batch->size;
+    batch->reserve(len);
+    for (unsigned i = 0; i < n; i++) {
+      iovec &iov = batch->iovs[i];
+      msghdr &hdr = batch->msgs[i].msg_hdr;
+      iov.iov_base = i ? batch->slot(i) : m_rxContext.ptr + m_rxContext.offset;
+      iov.iov_len = len;
+      memset(&hdr, 0, sizeof(msghdr));
+      hdr.msg_name = batch->addrs[i].sa();
+      hdr.msg_namelen = batch->addrs[i].len();
+      hdr.msg_iov = &iov;
+      hdr.msg_iovlen = 1;
+    }
+
+  retry:
+    r = ::recvmmsg(m_info.socket, batch->msgs, n, 0, nullptr);
+    if (ZuUnlikely(r < 0)) e = errno;
+
+    ZiDEBUG(m_mx, ZtSprintf(
+	  "FD: % 3d recvmmsg(%u): %d errno: %d (EAGAIN=%d EINTR=%d)",
+	  int(m_info.socket), n, r, int(e.errNo()), int(EAGAIN), int(EINTR)));
+
+    if (ZuUnlikely(r < 0)) {
+      if (e.errNo() == EAGAIN) {
+#ifdef ZiMultiplex_DEBUG
+	if (m_mx->yield()) Zm::yield();
+#endif
+	return true;
+      }
+      if (e.errNo() == EINTR) goto retry;
+      errorRecv(Zi::IOError, e);
+      return false;
+    }
+    if (ZuUnlikely(!r)) return true;
+
+    ZiMultiplex::batched(m_mx->m_rxBatchHist, r);
+    drained = unsigned(r) < n;
+    batch->next = 1;
+    batch->count = r;
+
+    if (unsigned len0 = batch->msgs[0].msg_len) {
+      m_rxContext.addr = batch->addrs[0];
+      executedRecv(len0);
+      if (int j = rearmed()) return j > 0;
+    }
+  }
+}
+#endif
+
+#ifdef ZiMultiplex_IOURing
+bool ZiConnection::uringStream() const
+{
+  return !m_info.options.udp()
+#ifdef ZiMultiplex_Netlink
+    && !m_info.options.netlink()
+#endif
+    ;
+}
+
+// deliver any stashed data, then arm multishot recv (or, for UDP and
+// netlink, pump-prime recv() as for epoll)
+void ZiConnection::uringRecv()
+{
+  if (!uringStream()) { recv(); return; }
+
+  URingRx *rx = m_uringRx;
+  if (ZuUnlikely(!rx)) rx = m_uringRx = new URingRx{};
+
+  if (unsigned n = rx->stash.length()) {
+    ZtArray<uint8_t> stash = ZuMv(rx->stash);
+    uringRecvd(stash.data(), n);
+    if (m_rxContext.completed()) return;
+  }
+
+  if (!rx->armed && m_rxUp.load_()) {
+    rx->armed = true;
+    rx->canceled = false;
+    m_mx->uringRecv(this);
+  }
+}
+
+// data received by multishot recv - copy it into the application's
+// receive context; once the context completes, stash the remainder and
+// cancel the recv until the application calls recv_() again
+void ZiConnection::uringRecvd(const uint8_t *data, unsigned len)
+{
+  URingRx *rx = m_uringRx;
+
+  while (len) {
+    if (ZuUnlikely(!m_rxUp.load_())) { m_rxContext.complete(); return; }
+
+    if (ZuUnlikely(m_rxContext.completed())) {
+      rx->stash.append(data, len);
+      break;
+    }
+
+    unsigned n = m_rxContext.size - m_rxContext.offset;
+    if (n > len) n = len;
+    memcpy(m_rxContext.ptr + m_rxContext.offset, data, n);
+
+    ZiDEBUG(m_mx, ZtHexDump(ZtSprintf(
+	    "FD: % 3d recv(): %u", int(m_info.socket), n),
+	  m_rxContext.ptr + m_rxContext.offset, n));
+
+    data += n, len -= n;
+
+    executedRecv(n);
+
+    if (ZuUnlikely(m_rxContext.completed())) {
+      if (m_rxContext.disconnected()) {
+	disconnect();
+	return;
+      }
+    } else if (ZuUnlikely(m_rxContext.offset >= m_rxContext.size))
+      m_rxContext.complete();
+  }
+
+  if (ZuUnlikely(m_rxContext.completed()) && rx->armed && !rx->canceled) {
+    rx->canceled = true;
+    m_mx->m_uring->cancel(
+	reinterpret_cast<uintptr_t>(this) | ZiMultiplex::URing::Recv);
+  }
+}
+
+// multishot recv terminated - res is the final result
+void ZiConnection::uringRecvEnd(int res)
+{
+  m_uringRx->armed = false;
+
+  if (ZuUnlikely(!m_rxUp.load_())) return;
+
+  if (!res) { // EOF
+    disconnect();
+    return;
+  }
+
+  if (res < 0 && res != -ECANCELED && res != -ENOBUFS) {
+    errorRecv(Zi::IOError, ZeError{-res});
+    return;
+  }
+
+  // canceled, or provided buffers were exhausted - re-arm if receiving
+  if (!m_rxContext.completed()) uringRecv();
+}
+#endif
+
 #ifdef ZiMultiplex_IOCP
 void ZiConnection::overlappedRecv(int status, unsigned n, ZeError e)
 {
@@ -1405,6 +2232,12 @@ void ZiConnection::send()
 
   if (ZuUnlikely(!m_txUp.load_())) { m_txContext.complete(); return; }
 
+#ifdef ZiMultiplex_EPoll
+  // flush any datagrams left staged by a previous EAGAIN
+  if (ZuUnlikely(m_txBatch && m_txBatch->blocked) &&
+      flushBatch() != Zi::OK) return;
+#endif
+
   if (ZuLikely(m_txContext.completed())) return;
 
 #ifdef ZiMultiplex_IOCP
@@ -1453,14 +2286,22 @@ retry:
 	int(m_info.socket), len, m_txContext.size, m_txContext.offset),
 	buf, len));
 
-  if (m_info.options.udp())
-    n = ::sendto(
-	m_info.socket, buf, len, 0,
-	m_txContext.addr.sa(), m_txContext.addr.len());
+  if (m_info.options.udp()) {
+    if (m_info.options.batch() && m_mx->txBatch() > 1) {
+      // blocked (sendBlocked() called), or error (already reported)
+      if (ZuUnlikely((n = sendBatch(buf, len)) < 0)) return;
+    } else
+      n = ::sendto(
+	  m_info.socket, buf, len, 0,
+	  m_txContext.addr.sa(), m_txContext.addr.len());
+  }
 #ifdef ZiMultiplex_Netlink
   else if (m_info.options.netlink())
     n = ZiNetlink::send(m_info.socket, m_ci.familyID, m_ci.portID, buf, len);
 #endif
+  else if (m_info.options.zeroCopy() && m_txContext.pin &&
+      len >= m_mx->zeroCopyMin())
+    n = sendZC(buf, len);
   else
     n = ::send(m_info.socket, buf, len, 0);
   if (ZuUnlikely(n < 0)) e = errno;
@@ -1471,6 +2312,7 @@ retry:
 
   if (ZuUnlikely(n < 0)) {
     if (e.errNo() == EAGAIN) {
+      sendBlocked();
 #ifdef ZiMultiplex_DEBUG
       if (m_mx->yield()) Zm::yield();
 #endif
@@ -1539,6 +2381,270 @@ void ZiConnection::executedSend(unsigned n)
   while (!m_txContext());
 }
 
+#ifdef ZiMultiplex_EPoll
+// stage a datagram for sendmmsg(); returns len, or the result of a
+// failed flushBatch() (Zi::NotReady or Zi::IOError)
+int ZiConnection::sendBatch(const uint8_t *buf, unsigned len)
+{
+  TxBatch *batch = m_txBatch;
+  if (ZuUnlikely(!batch)) batch = m_txBatch = new TxBatch{m_mx->txBatch()};
+
+  int r;
+  if (ZuUnlikely(batch->count &&
+	(batch->count >= batch->size || len > batch->slotSize)) &&
+      (r = flushBatch()) != Zi::OK)
+    return r;
+
+  batch->reserve(len);
+  unsigned i = batch->count++;
+  iovec &iov = batch->iovs[i];
+  msghdr &hdr = batch->msgs[i].msg_hdr;
+  memcpy(batch->slot(i), buf, len);
+  iov.iov_base = batch->slot(i);
+  iov.iov_len = len;
+  memset(&hdr, 0, sizeof(msghdr));
+  if (!!m_txContext.addr) {
+    batch->addrs[i] = m_txContext.addr;
+    hdr.msg_name = batch->addrs[i].sa();
+    hdr.msg_namelen = batch->addrs[i].len();
+  }
+  hdr.msg_iov = &iov;
+  hdr.msg_iovlen = 1;
+
+  if (!batch->queued) {
+    batch->queued = true;
+    m_mx->push(m_mx->txThread(),
+	[cxn = ZmMkRef(this)]() { cxn->flushBatch_(); });
+  }
+
+  return len;
+}
+
+// returns Zi::OK, Zi::NotReady on EAGAIN (staged datagrams are retained,
+// sendBlocked() has been called), or Zi::IOError (errorSend() has been
+// called)
+int ZiConnection::flushBatch()
+{
+  TxBatch *batch = m_txBatch;
+  ZeError e;
+
+  while (batch->sent < batch->count) {
+    unsigned n = batch->count - batch->sent;
+    int r = ::sendmmsg(m_info.socket, &batch->msgs[batch->sent], n, 0);
+    if (ZuUnlikely(r < 0)) e = errno;
+
+    ZiDEBUG(m_mx, ZtSprintf(
+	  "FD: % 3d sendmmsg(%u): %d errno: %d (EAGAIN=%d EINTR=%d)",
+	  int(m_info.socket), n, r, int(e.errNo()), int(EAGAIN), int(EINTR)));
+
+    if (ZuUnlikely(r < 0)) {
+      if (e.errNo() == EINTR) continue;
+      if (e.errNo() == EAGAIN) {
+	batch->blocked = true;
+	sendBlocked();
+	return Zi::NotReady;
+      }
+      batch->sent = batch->count = 0;
+      batch->blocked = false;
+      errorSend(Zi::IOError, e);
+      return Zi::IOError;
+    }
+    ZiMultiplex::batched(m_mx->m_txBatchHist, r);
+    batch->sent += r;
+  }
+  batch->sent = batch->count = 0;
+  batch->blocked = false;
+  return Zi::OK;
+}
+
+// flush queued behind a burst of sends
+void ZiConnection::flushBatch_()
+{
+  m_txBatch->queued = false;
+  if (ZuUnlikely(!m_txUp.load_())) return;
+  if (m_txBatch->count) flushBatch();
+}
+
+// send() returned EAGAIN - epoll reports EPOLLOUT for every connection,
+// whereas io_uring POLLOUT is only requested while Tx is blocked
+void ZiConnection::sendBlocked()
+{
+#ifdef ZiMultiplex_IOURing
+  if (m_mx->m_uring)
+    m_mx->rxRun([cxn = ZmMkRef(this)]() { cxn->m_mx->uringPollOut(cxn); });
+#endif
+}
+
+// MSG_ZEROCOPY send, pinning m_txContext.pin until completion; copies
+// if the kernel cannot pin further pages (ENOBUFS), or if SO_ZEROCOPY
+// is not enabled on the socket, in which case the kernel would silently
+// copy without ever notifying completion; returns bytes sent, or -1
+// with errno set
+int ZiConnection::sendZC(const uint8_t *buf, unsigned len)
+{
+  ZeroCopy *zc = m_zeroCopy;
+  if (ZuUnlikely(!zc)) {
+    zc = m_zeroCopy = new ZeroCopy{};
+    int b = 0;
+    socklen_t l = sizeof(int);
+    if (getsockopt(m_info.socket, SOL_SOCKET, SO_ZEROCOPY, &b, &l) < 0 || !b)
+      zc->off = true;
+  }
+  if (ZuUnlikely(zc->off)) return ::send(m_info.socket, buf, len, 0);
+  int n = ::send(m_info.socket, buf, len, MSG_ZEROCOPY);
+  if (ZuUnlikely(n < 0)) {
+    if (errno == ENOBUFS) return ::send(m_info.socket, buf, len, 0);
+    return -1;
+  }
+  zc->push(m_txContext.pin);
+  return n;
+}
+
+// drain zero-copy completions from the socket error queue (Rx thread),
+// forwarding them to the Tx thread to release the pinned buffers
+void ZiConnection::recvZC()
+{
+  uint64_t control[16];	// cmsghdr + sock_extended_err + sockaddr_in6
+  msghdr msg;
+
+  for (;;) {
+    memset(&msg, 0, sizeof(msghdr));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (::recvmsg(m_info.socket, &msg, MSG_ERRQUEUE) < 0) {
+      if (errno == EINTR) continue;
+      return; // EAGAIN - drained
+    }
+    for (cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+      if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+	    (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR)))
+	continue;
+      auto ee = reinterpret_cast<const sock_extended_err *>(CMSG_DATA(cm));
+      if (ee->ee_origin != SO_EE_ORIGIN_ZEROCOPY || ee->ee_errno) continue;
+      m_mx->txRun([cxn = ZmMkRef(this), lo = ee->ee_info, hi = ee->ee_data]() {
+	if (cxn->m_zeroCopy) cxn->m_zeroCopy->release(lo, hi);
+      });
+    }
+  }
+}
+
+void ZiConnection::splice(ZiConnection *peer)
+{
+  m_mx->rxInvoke(this, [this, peer = ZmMkRef(peer)]() mutable {
+    splice_(ZuMv(peer));
+    return this;
+  });
+}
+
+void ZiConnection::splice_(ZmRef<ZiConnection> peer)
+{
+  if (ZuUnlikely(!m_rxUp.load_())) return;
+  if (ZuUnlikely(!peer->m_rxUp.load_())) { close(); return; }
+
+  if (m_info.options.udp() || m_info.options.netlink() ||
+      m_splice || peer->m_spliceIn
+#ifdef ZiMultiplex_IOURing
+      || m_mx->m_uring
+#endif
+      ) {
+    spliceError(ZeError{EINVAL});
+    return;
+  }
+
+  auto splice = new Splice{ZuMv(peer)};
+  if (pipe2(splice->pipe, O_NONBLOCK) < 0) {
+    ZeError e{errno};
+    delete splice;
+    close();
+    Error("pipe2", Zi::IOError, e);
+    return;
+  }
+
+  // the receive context is bypassed
+  m_rxContext.complete();
+  if (!m_mx->epollRecv(this, m_info.socket, EPOLLIN | EPOLLRDHUP)) {
+    delete splice;
+    close();
+    return;
+  }
+  m_splice = splice;
+  m_splice->peer->m_spliceIn = this;
+
+  spliceRecv();
+}
+
+// relay socket -> pipe -> peer until either would block; resumed by
+// readiness of this socket (EPOLLIN) or of the peer's (EPOLLOUT)
+bool ZiConnection::spliceRecv()
+{
+  Splice *splice = m_splice;
+  Socket peer = splice->peer->m_info.socket;
+  ZeError e;
+  ssize_t n;
+
+  for (;;) {
+    while (splice->pending) {
+      n = ::splice(splice->pipe[0], nullptr, peer, nullptr,
+	  splice->pending, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+      if (ZuUnlikely(n < 0)) {
+	e = errno;
+	if (e.errNo() == EINTR) continue;
+	if (e.errNo() == EAGAIN) return true;
+	spliceError(e);
+	return false;
+      }
+      splice->pending -= n;
+    }
+
+    n = ::splice(m_info.socket, nullptr, splice->pipe[1], nullptr,
+	Splice::Size, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+
+    ZiDEBUG(m_mx, ZtSprintf(
+	  "FD: % 3d splice(%d): %d errno: %d",
+	  int(m_info.socket), int(peer), int(n), n < 0 ? errno : 0));
+
+    if (ZuUnlikely(n < 0)) {
+      e = errno;
+      if (e.errNo() == EINTR) continue;
+      if (e.errNo() == EAGAIN) return true;
+      spliceError(e);
+      return false;
+    }
+    if (ZuUnlikely(!n)) {
+      disconnect();
+      return false;
+    }
+    m_rxRequests++, m_rxBytes += n;
+    splice->pending = n;
+  }
+}
+
+void ZiConnection::spliceError(ZeError e)
+{
+  if (m_rxUp.load_()) close();
+  if (e.errNo() == ZiENOTCONN || e.errNo() == ZiECONNRESET ||
+      e.errNo() == EPIPE) return;
+  Error("splice", Zi::IOError, e);
+}
+
+// disconnecting (Rx thread) - stop relaying to peer, and close any
+// connection relaying to this one, before the socket is closed
+void ZiConnection::spliceClose()
+{
+  if (m_splice) {
+    m_splice->peer->m_spliceIn = nullptr;
+    delete m_splice;
+    m_splice = nullptr;
+  }
+  if (ZiConnection *src = m_spliceIn) {
+    m_spliceIn = nullptr;
+    delete src->m_splice;
+    src->m_splice = nullptr;
+    if (src->m_rxUp.load_()) src->close();
+  }
+}
+#endif
+
 bool ZiMultiplex::initSocket(Socket s, const ZiCxnOptions &options)
 {
 #ifndef _WIN32
@@ -1576,6 +2682,18 @@ bool ZiMultiplex::initSocket(Socket s, const ZiCxnOptions &options)
       Error("setsockopt(TCP_NODELAY)", Zi::IOError, ZeLastSockError);
       return false;
     }
+#ifdef ZiMultiplex_EPoll
+    // kernels without SO_ZEROCOPY (pre-4.14) fall back to copying sends;
+    // so does io_uring, which does not drain completions from the socket
+    // error queue
+    if (options.zeroCopy() && !options.udp() && !options.netlink() &&
+#ifdef ZiMultiplex_IOURing
+	!m_uring &&
+#endif
+	setsockopt(s, SOL_SOCKET, SO_ZEROCOPY,
+	  (const char *)&b, sizeof(int)) < 0)
+      Warning("setsockopt(SO_ZEROCOPY)", Zi::IOError, ZeLastSockError);
+#endif
   }
 
 #ifdef ZiMultiplex_EPoll
@@ -1583,6 +2701,7 @@ bool ZiMultiplex::initSocket(Socket s, const ZiCxnOptions &options)
     Error("fcntl(O_NONBLOCK)", Zi::IOError, ZeLastError);
     return false;
   }
+  initBusyPoll(s);
 #endif
 
 #else /* !_WIN32 */
@@ -1634,10 +2753,46 @@ bool ZiMultiplex::initSocket(Socket s, const ZiCxnOptions &options)
   return true;
 }
 
+#ifdef ZiMultiplex_EPoll
+// kernel busy-polling of the device queue on blocking reads / polls -
+// requires CAP_NET_ADMIN to exceed net.core.busy_read, failure is not fatal
+void ZiMultiplex::initBusyPoll(Socket s)
+{
+  if (!m_busyPoll) return;
+#ifdef SO_BUSY_POLL
+  if (setsockopt(s, SOL_SOCKET, SO_BUSY_POLL,
+	(const char *)&m_busyPoll, sizeof(unsigned)) < 0) {
+    Warning("setsockopt(SO_BUSY_POLL)", Zi::IOError, ZeLastSockError);
+    return;
+  }
+#endif
+#ifdef SO_PREFER_BUSY_POLL
+  {
+    int b = 1;
+    if (setsockopt(s, SOL_SOCKET, SO_PREFER_BUSY_POLL,
+	  (const char *)&b, sizeof(int)) < 0)
+      Warning("setsockopt(SO_PREFER_BUSY_POLL)",
+	  Zi::IOError, ZeLastSockError);
+  }
+#endif
+}
+#endif
+
 bool ZiMultiplex::cxnAdd(ZiConnection *cxn, Socket s)
 {
   m_cxns->add(cxn);
 
+#ifdef ZiMultiplex_IOURing
+  if (m_uring) {
+    if (!cxn->uringStream()) {
+      ZmREF(cxn);
+      m_uring->poll(s, reinterpret_cast<uintptr_t>(cxn) | URing::PollIn,
+	  POLLIN | POLLRDHUP, true);
+    }
+    return true;
+  }
+#endif
+
 #ifdef ZiMultiplex_EPoll
   {
     struct epoll_event ev;
@@ -1659,6 +2814,11 @@ bool ZiMultiplex::cxnAdd(ZiConnection *cxn, Socket s)
 
 void ZiMultiplex::cxnDel(Socket s)
 {
+#ifdef ZiMultiplex_IOURing
+  if (m_uring)
+    m_uring->cancelFD(s);
+  else
+#endif
 #ifdef ZiMultiplex_EPoll
   epoll_ctl(m_epollFD, EPOLL_CTL_DEL, s, 0);
 #endif
@@ -1670,6 +2830,14 @@ bool ZiMultiplex::listenerAdd(Listener *listener, Socket s)
 {
   m_listeners->addNode(listener);
 
+#ifdef ZiMultiplex_IOURing
+  if (m_uring) {
+    ZmREF(listener);
+    m_uring->accept(s, reinterpret_cast<uintptr_t>(listener) | URing::Accept);
+    return true;
+  }
+#endif
+
 #ifdef ZiMultiplex_EPoll
   {
     struct epoll_event ev;
@@ -1690,6 +2858,11 @@ bool ZiMultiplex::listenerAdd(Listener *listener, Socket s)
 
 void ZiMultiplex::listenerDel(Socket s)
 {
+#ifdef ZiMultiplex_IOURing
+  if (m_uring)
+    m_uring->cancelFD(s);
+  else
+#endif
 #ifdef ZiMultiplex_EPoll
   epoll_ctl(m_epollFD, EPOLL_CTL_DEL, s, 0);
 #endif
@@ -1703,6 +2876,10 @@ bool ZiMultiplex::connectAdd(Connect *request, Socket s)
 {
   m_connects->addNode(request);
 
+#ifdef ZiMultiplex_IOURing
+  if (m_uring) return true; // POLLOUT is requested by connect()
+#endif
+
   {
     struct epoll_event ev;
     memset(&ev, 0, sizeof(struct epoll_event));
@@ -1722,6 +2899,11 @@ bool ZiMultiplex::connectAdd(Connect *request, Socket s)
 
 void ZiMultiplex::connectDel(Socket s)
 {
+#ifdef ZiMultiplex_IOURing
+  if (m_uring)
+    m_uring->cancelFD(s);
+  else
+#endif
 #ifdef ZiMultiplex_EPoll
   epoll_ctl(m_epollFD, EPOLL_CTL_DEL, s, 0);
 #endif
@@ -1785,6 +2967,7 @@ retry:
     if (e.errNo() == EAGAIN) return;
     if (e.errNo() == EINTR) goto retry;
     errorDisconnect(Zi::IOError, e);
+    return;
   }
   executedDisconnect();
 #endif
@@ -1837,6 +3020,10 @@ void ZiMultiplex::disconnected(ZiConnection *cxn)
 
   ZiDEBUG(this, ZtSprintf("FD: % 3d disconnected()", int(s)));
 
+#ifdef ZiMultiplex_EPoll
+  cxn->spliceClose();
+#endif
+
   cxnDel(s);
   
   if (ZuUnlikely(m_stopping && !m_cxns->count_())) stop_2();
@@ -1875,7 +3062,18 @@ ZiMultiplex::ZiMultiplex(ZiMxParams mxParams) :
   m_txBufSize(mxParams.txBufSize())
 #ifdef ZiMultiplex_EPoll
   , m_epollMaxFDs(mxParams.epollMaxFDs()),
-  m_epollQuantum(mxParams.epollQuantum())
+  m_epollQuantum(mxParams.epollQuantum()),
+  m_rxBatch(mxParams.rxBatch()),
+  m_txBatch(mxParams.txBatch()),
+  m_pollSpin(mxParams.pollSpin()),
+  m_pollYield(mxParams.pollYield()),
+  m_busyPoll(mxParams.busyPoll()),
+  m_zeroCopyMin(mxParams.zeroCopyMin())
+#endif
+#ifdef ZiMultiplex_IOURing
+  , m_uringParam(mxParams.uring()),
+  m_uringDepth(mxParams.uringDepth()),
+  m_uringBufs(mxParams.uringBufs())
 #endif
 #ifdef ZiMultiplex_DEBUG
   , m_trace(mxParams.trace()),
@@ -1894,6 +3092,11 @@ ZiMultiplex::ZiMultiplex(ZiMxParams mxParams) :
 #endif
   m_cxns = new CxnHash(ZmHashParams().bits(8).loadFactor(1).cBits(4).
       init(mxParams.cxnHash()));
+#ifdef ZiMultiplex_EPoll
+  m_readables =
+    new ReadableHash(ZmHashParams().bits(2).loadFactor(1).cBits(2).
+	init("ZiMultiplex.ReadableHash"));
+#endif
   if (!params().thread(m_rxThread).name())
     params_().thread(m_rxThread).name("ioRx");
   if (!params().thread(m_txThread).name())
@@ -1939,25 +3142,30 @@ bool ZiMultiplex::start__()
     sigaddset(&s, SIGURG);
     pthread_sigmask(SIG_BLOCK, &s, 0);
   }
-  if ((m_epollFD = epoll_create(m_epollMaxFDs)) < 0) {
-    Error("epoll_create", Zi::IOError, ZeLastError);
-    return false;
-  }
   if (pipe(&m_wakeFD) < 0) {
-    ZeError e{errno};
-    ::close(m_epollFD); m_epollFD = -1;
-    Error("pipe", Zi::IOError, e);
+    Error("pipe", Zi::IOError, ZeLastError);
     return false;
   }
   if (fcntl(m_wakeFD, F_SETFL, O_NONBLOCK) < 0) {
     ZeError e{errno};
-    ::close(m_epollFD); m_epollFD = -1;
     ::close(m_wakeFD); m_wakeFD = -1;
     ::close(m_wakeFD2); m_wakeFD2 = -1;
     Error("fcntl(F_SETFL, O_NONBLOCK)", Zi::IOError, e);
     return false;
   }
+#ifdef ZiMultiplex_IOURing
+  if (m_uringParam && !uringInit())
+    ZeLOG(Warning, "io_uring unavailable - using epoll");
+  if (!m_uring)
+#endif
   {
+    if ((m_epollFD = epoll_create(m_epollMaxFDs)) < 0) {
+      ZeError e{errno};
+      ::close(m_wakeFD); m_wakeFD = -1;
+      ::close(m_wakeFD2); m_wakeFD2 = -1;
+      Error("epoll_create", Zi::IOError, e);
+      return false;
+    }
     struct epoll_event ev;
     memset(&ev, 0, sizeof(struct epoll_event));
     ev.events = EPOLLIN;
@@ -1991,6 +3199,18 @@ bool ZiMultiplex::stop__()
 
   wake();
 
+#ifdef ZiMultiplex_IOURing
+  // the Rx thread reaps the wake from the ring, and must exit before
+  // the wake pipe is closed and the ring is torn down
+  if (m_uring) {
+    bool stopped = ZmScheduler::stop__();
+    stop_3();
+    uringClose();
+    m_stopping = nullptr;
+    return stopped;
+  }
+#endif
+
   stop_3();
 
   m_stopping = nullptr;
@@ -2014,6 +3234,9 @@ void ZiMultiplex::stop_2()
     ConnectHash::Iterator i(*m_connects);
     while (ZmRef<Connect> connect = i.iterate()) {
       i.del();
+#ifdef ZiMultiplex_IOURing
+      if (m_uring) m_uring->cancelFD(connect->info().socket);
+#endif
       ::close(connect->info().socket);
     }
   }
@@ -2024,10 +3247,32 @@ void ZiMultiplex::stop_2()
     while (ZmRef<Listener> listener = i.iterate()) {
       i.del();
       listener->down();
+#ifdef ZiMultiplex_IOURing
+      if (m_uring) m_uring->cancelFD(listener->info().socket);
+#endif
       Zi::closeSocket(listener->info().socket);
     }
   }
 
+#ifdef ZiMultiplex_EPoll
+  {
+    ReadableHash::Iterator i(*m_readables);
+    while (ZmRef<Readable> readable = i.iterate()) {
+      i.del();
+      readable->m_up = false;
+#ifdef ZiMultiplex_IOURing
+      if (m_uring)
+	m_uring->cancelFD(readable->m_fd);
+      else
+#endif
+      {
+	epoll_ctl(m_epollFD, EPOLL_CTL_DEL, readable->m_fd, 0);
+	ZmDEREF(readable);
+      }
+    }
+  }
+#endif
+
   // drain any I/O completions
 #ifdef ZiMultiplex_IOCP
   {
@@ -2099,7 +3344,13 @@ void ZiMultiplex::rx()
 #endif
 
 #ifdef ZiMultiplex_EPoll
+#ifdef ZiMultiplex_IOURing
+  if (m_uring) { uringRx(); return; }
+#endif
+
   bool wake = false;
+  bool polling = m_pollSpin;		// busy-polling vs. blocking
+  unsigned spins = 0, yields = 0;
 
   int r;
   ZeError e;
@@ -2121,7 +3372,7 @@ void ZiMultiplex::rx()
 #endif
 #endif
 
-    r = epoll_wait(m_epollFD, ev, m_epollQuantum, -1);
+    r = epoll_wait(m_epollFD, ev, m_epollQuantum, polling ? 0 : -1);
 
 #if 0
 #ifdef ZiMultiplex_DEBUG
@@ -2140,63 +3391,57 @@ void ZiMultiplex::rx()
     }
 
     if (ZuLikely(r)) {
+      polled(polling);
+      polling = m_pollSpin;
+      spins = yields = 0;
+
       for (unsigned i = 0; i < unsigned(r); i++) {
 	uint32_t events = ev[i].events;
 	uintptr_t v = ev[i].data.u64;
 
 	if (ZuLikely(!(v & 3))) {
 	  ZiConnection *cxn = (ZiConnection *)v;
+	  if (ZuUnlikely(events & EPOLLERR) && cxn->info().options.zeroCopy())
+	    cxn->recvZC();
 	  if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
 	    if (ZuUnlikely(!cxn->recv())) continue;
-	  if (events & EPOLLOUT)
+	  if (events & EPOLLOUT) {
+	    if (ZuUnlikely(cxn->m_spliceIn)) cxn->m_spliceIn->recv();
 	    txRun([cxn = ZmMkRef(cxn)]() { cxn->send(); });
+	  }
 	  continue;
 	}
 
 	if (ZuLikely(v == 3)) { wake = readWake(); continue; }
 
+	if (ZuLikely((v & 3) == 3)) {
+	  // m_fn() may call delReadable_()
+	  ZmRef<Readable> readable =
+	    (Readable *)(v & ~static_cast<uintptr_t>(3));
+	  if (ZuLikely(readable->m_up)) readable->m_fn();
+	  continue;
+	}
+
 	if (ZuLikely((v & 3) == 1)) {
 	  Listener *listener = (Listener *)(v & ~static_cast<uintptr_t>(3));
-	  if (ZuLikely(!(events & EPOLLERR))) {
+	  if (ZuLikely(!(events & EPOLLERR)))
 	    accept(listener);
-	    continue;
-	  }
-	  int n;
-	  int s = listener->info().socket;
-	  if (ioctl(s, FIONREAD, &n) < 0) {
-	    e = errno;
-	    listenerDel(s);
-	    ::close(s);
-	    Error("listen", Zi::IOError, e);
-	  }
+	  else
+	    acceptError(listener);
 	  continue;
 	}
 	  
 	if (ZuLikely((v & 3) == 2)) {
 	  ZmRef<Connect> request = (Connect *)(v & ~static_cast<uintptr_t>(3));
-	  if (ZuLikely(!(events & EPOLLERR))) {
+	  if (ZuLikely(!(events & EPOLLERR)))
 	    connect(request);
-	    continue;
-	  }
-	  int n;
-	  int s = request->info().socket;
-	  if (ioctl(s, FIONREAD, &n) < 0)
-	    e = errno;
-	  else {
-	    int errNo = EIO;
-	    socklen_t l = sizeof(int);
-	    if (getsockopt(s, SOL_SOCKET, SO_ERROR, &errNo, &l) < 0)
-	      errNo = EIO;
-	    e = errNo;
-	  }
-	  connectDel(s);
-	  ::close(s);
-	  // Warning("connect", Zi::IOError, e);
-	  request->fail(true);
+	  else
+	    connectError(request);
 	  continue;
 	}
       }
-    }
+    } else if (polling)
+      polling = pollIdle(spins, yields);
     
     if (wake) break;
   }
@@ -2231,6 +3476,23 @@ bool ZiMultiplex::readWake()
   return ::read(m_wakeFD, &c, 1) >= 1;
 }
 
+// empty busy-poll - returns false once the spin / yield budget is spent
+bool ZiMultiplex::pollIdle(unsigned &spins, unsigned &yields)
+{
+  if (++spins < m_pollSpin) return true;
+  spins = 0;
+  if (m_pollYield && ++yields >= m_pollYield) return false;
+  Zm::yield();
+  return true;
+}
+
+// Rx wakeup, either while busy-polling or after blocking
+void ZiMultiplex::polled(bool polling)
+{
+  auto &count = polling ? m_rxPolled : m_rxWaited;
+  count.store_(count.load_() + 1);
+}
+
 void ZiMultiplex::writeWake()
 {
   ZiDEBUG(this, ZtSprintf("FD: % 3d writeWake", m_wakeFD2));
@@ -2246,6 +3508,218 @@ void ZiMultiplex::writeWake()
 }
 #endif
 
+#ifdef ZiMultiplex_IOURing
+bool ZiMultiplex::uringInit()
+{
+  m_uring = new URing{};
+  if (!m_uring->init(m_uringDepth, m_uringBufs, m_epollQuantum)) {
+    delete m_uring;
+    m_uring = nullptr;
+    return false;
+  }
+  m_uring->poll(m_wakeFD, URing::Wake, POLLIN, true);
+  return true;
+}
+
+// cancel all outstanding requests, then wait for every final completion,
+// releasing the references they hold
+void ZiMultiplex::uringClose()
+{
+  m_uring->cancelAll();
+  io_uring_cqe cqe;
+  for (;;) {
+    while (m_uring->cqe(cqe))
+      if (!(cqe.flags & IORING_CQE_F_MORE)) uringDeref(cqe.user_data);
+    if (!m_uring->inFlight) break;
+    if (!m_uring->submit(true)) break;
+  }
+  delete m_uring;
+  m_uring = nullptr;
+}
+
+void ZiMultiplex::uringRx()
+{
+  bool wake = false;
+  bool polling = m_pollSpin;		// busy-polling vs. blocking
+  unsigned spins = 0, yields = 0;
+  io_uring_cqe cqe;
+
+  for (;;) {
+    ZiDEBUG(this, ZtSprintf(
+	  "wait() nThreads: % 2d nConnections: % 4d uringFD: % 3d "
+	  "wakeFD: % 3d wakeFD2: % 3d nListeners: % 3d",
+	  params().nThreads(), m_cxns->count_(),
+	  m_uring->fd, m_wakeFD, m_wakeFD2,
+	  m_listeners->count_()));
+
+    // submit any queued requests and wait for (or reap) completions
+    if (!m_uring->submit(!polling, polling)) break;
+
+    unsigned i;
+    for (i = 0; i < m_epollQuantum && m_uring->cqe(cqe); i++)
+      if (uringCompleted(cqe.user_data, cqe.res, cqe.flags)) wake = true;
+
+    if (ZuLikely(i)) {
+      polled(polling);
+      polling = m_pollSpin;
+      spins = yields = 0;
+    } else if (polling)
+      polling = pollIdle(spins, yields);
+
+    if (wake) break;
+  }
+}
+
+// process a completion - returns true if woken
+bool ZiMultiplex::uringCompleted(uintptr_t data, int res, unsigned flags)
+{
+  bool more = flags & IORING_CQE_F_MORE;
+  unsigned tag = data & URing::Mask;
+  data &= ~static_cast<uintptr_t>(URing::Mask);
+
+  switch (tag) {
+    case URing::Recv: {
+      auto cxn = reinterpret_cast<ZiConnection *>(data);
+      if (flags & IORING_CQE_F_BUFFER) {
+	unsigned bid = flags>>IORING_CQE_BUFFER_SHIFT;
+	if (res > 0) cxn->uringRecvd(m_uring->buf(bid), res);
+	m_uring->recycle(bid);
+      }
+      if (!more) {
+	cxn->uringRecvEnd(res);
+	ZmDEREF(cxn);
+      }
+    } break;
+
+    case URing::Accept: {
+      auto listener = reinterpret_cast<Listener *>(data);
+      if (res >= 0) {
+	ZiSockAddr remote;
+	socklen_t len = remote.len();
+	if (ZuUnlikely(!listener->up()))
+	  ::close(res);
+	else if (getpeername(res, remote.sa(), &len) < 0) {
+	  ZeError e{errno};
+	  ::close(res);
+	  Error("getpeername", Zi::IOError, e);
+	} else
+	  accepted(listener, res, remote);
+      } else if (res != -ECANCELED && listener->up()) {
+	Error("accept", Zi::IOError, ZeError{-res});
+	acceptError(listener);
+      }
+      if (!more) {
+	if (res >= 0 && listener->up())
+	  m_uring->accept(listener->info().socket, data | URing::Accept);
+	else
+	  ZmDEREF(listener);
+      }
+    } break;
+
+    case URing::Connect: {
+      auto request = reinterpret_cast<Connect *>(data);
+      if (res != -ECANCELED) {
+	if (ZuLikely(res >= 0 && !(res & POLLERR)))
+	  connect(request);
+	else
+	  connectError(request);
+      }
+      ZmDEREF(request);
+    } break;
+
+    case URing::Wake: {
+      bool wake = res > 0 && readWake();
+      if (!more && res != -ECANCELED)
+	m_uring->poll(m_wakeFD, URing::Wake, POLLIN, true);
+      return wake;
+    }
+
+    case URing::PollIn: {
+      auto cxn = reinterpret_cast<ZiConnection *>(data);
+      if (res > 0) cxn->recv();
+      if (!more) {
+	if (res >= 0 && cxn->m_rxUp.load_())
+	  m_uring->poll(cxn->info().socket, data | URing::PollIn,
+	      POLLIN | POLLRDHUP, true);
+	else
+	  ZmDEREF(cxn);
+      }
+    } break;
+
+    case URing::PollOut: {
+      auto cxn = reinterpret_cast<ZiConnection *>(data);
+      cxn->m_uringPollOut = false;
+      if (res != -ECANCELED)
+	txRun([cxn = ZmMkRef(cxn)]() { cxn->send(); });
+      ZmDEREF(cxn);
+    } break;
+
+    case URing::Readable: {
+      auto readable = reinterpret_cast<Readable *>(data);
+      if (res > 0 && readable->m_up) readable->m_fn();
+      if (!more) {
+	if (res >= 0 && readable->m_up) {
+	  m_uring->poll(readable->m_fd, data | URing::Readable, POLLIN, true);
+	  readable->m_fn(); // fd may have become readable before re-arming
+	} else
+	  ZmDEREF(readable);
+      }
+    } break;
+  }
+
+  return false;
+}
+
+// release the reference held by an outstanding request
+void ZiMultiplex::uringDeref(uintptr_t data)
+{
+  unsigned tag = data & URing::Mask;
+  data &= ~static_cast<uintptr_t>(URing::Mask);
+
+  switch (tag) {
+    case URing::Recv:
+    case URing::PollIn:
+    case URing::PollOut:
+      ZmDEREF(reinterpret_cast<ZiConnection *>(data));
+      break;
+    case URing::Accept:
+      ZmDEREF(reinterpret_cast<Listener *>(data));
+      break;
+    case URing::Connect:
+      ZmDEREF(reinterpret_cast<Connect *>(data));
+      break;
+    case URing::Readable:
+      ZmDEREF(reinterpret_cast<Readable *>(data));
+      break;
+  }
+}
+
+// each outstanding request holds a reference to its target
+void ZiMultiplex::uringRecv(ZiConnection *cxn)
+{
+  ZmREF(cxn);
+  m_uring->recv(cxn->info().socket,
+      reinterpret_cast<uintptr_t>(cxn) | URing::Recv);
+}
+
+void ZiMultiplex::uringConnect(Connect *request)
+{
+  ZmREF(request);
+  m_uring->poll(request->info().socket,
+      reinterpret_cast<uintptr_t>(request) | URing::Connect, POLLOUT, false);
+}
+
+void ZiMultiplex::uringPollOut(ZiConnection *cxn)
+{
+  if (cxn->m_uringPollOut ||
+      !cxn->m_rxUp.load_() || !cxn->m_txUp.load_()) return;
+  cxn->m_uringPollOut = true;
+  ZmREF(cxn);
+  m_uring->poll(cxn->info().socket,
+      reinterpret_cast<uintptr_t>(cxn) | URing::PollOut, POLLOUT, false);
+}
+#endif
+
 void ZiMultiplex::telemetry(ZiMxTelemetry &data) const
 {
   data.id = params().id();
@@ -2262,6 +3736,18 @@ void ZiMultiplex::telemetry(ZiMxTelemetry &data) const
   data.ll = params().ll();
   data.priority = params().priority();
   data.nThreads = params().nThreads();
+#ifdef ZiMultiplex_EPoll
+  data.rxBatch1 = m_rxBatchHist[0].load_();
+  data.rxBatch4 = m_rxBatchHist[1].load_();
+  data.rxBatch16 = m_rxBatchHist[2].load_();
+  data.rxBatch64 = m_rxBatchHist[3].load_();
+  data.txBatch1 = m_txBatchHist[0].load_();
+  data.txBatch4 = m_txBatchHist[1].load_();
+  data.txBatch16 = m_txBatchHist[2].load_();
+  data.txBatch64 = m_txBatchHist[3].load_();
+  data.rxPolled = m_rxPolled.load_();
+  data.rxWaited = m_rxWaited.load_();
+#endif
 }
 
 ZiMxMgr *ZiMxMgr::instance()
@@ -52,6 +52,9 @@
 
 #ifdef linux
 #define ZiMultiplex_EPoll	// Linux epoll
+#if __has_include(<linux/io_uring.h>)
+#define ZiMultiplex_IOURing	// Linux io_uring (selected at run-time)
+#endif
 #endif
 
 #ifdef NETLINK
@@ -167,11 +170,13 @@ namespace ZiCxnFlags {
     LoopBack,		// L - combine with M and U for multicast loopback
     KeepAlive,		// K - set SO_KEEPALIVE socket option
     Nagle,		// D - enable Nagle algorithm (no TCP_NODELAY)
-    NetLink		// N - NetLink socket
+    NetLink,		// N - NetLink socket
+    Batch,		// B - combine with U for batched recvmmsg/sendmmsg
+    ZeroCopy		// Z - MSG_ZEROCOPY for large TCP sends
   );
   ZtEnumFlagsMap(ZiCxnFlags, Map,
       "U", UDP_, "M", Multicast_, "L", LoopBack_, "L", KeepAlive_,
-      "D", Nagle_, "N", NetLink_);
+      "D", Nagle_, "N", NetLink_, "B", Batch_, "Z", ZeroCopy_);
 }
 class ZiCxnOptions {
   using MReqs = ZuArrayN<ZiMReq, ZiCxnOptions_NMReq>;
@@ -271,6 +276,31 @@ public:
     b ? (m_flags |= Nagle()) : (m_flags &= ~Nagle());
     return *this;
   }
+  // batched UDP I/O (Linux only) - up to ZiMxParams::rxBatch() datagrams
+  // are received per recvmmsg(), and consecutive sends are coalesced
+  // into sendmmsg() calls of up to ZiMxParams::txBatch() datagrams
+  bool batch() const {
+    using namespace ZiCxnFlags;
+    return m_flags & Batch();
+  }
+  ZiCxnOptions &batch(bool b) {
+    using namespace ZiCxnFlags;
+    b ? (m_flags |= Batch()) : (m_flags &= ~Batch());
+    return *this;
+  }
+  // zero-copy TCP send (Linux only) - sends of at least
+  // ZiMxParams::zeroCopyMin() bytes whose ZiIOContext::pin is set use
+  // MSG_ZEROCOPY; the pinned buffer is retained until the kernel releases it;
+  // sends are copied if the kernel does not support SO_ZEROCOPY
+  bool zeroCopy() const {
+    using namespace ZiCxnFlags;
+    return m_flags & ZeroCopy();
+  }
+  ZiCxnOptions &zeroCopy(bool b) {
+    using namespace ZiCxnFlags;
+    b ? (m_flags |= ZeroCopy()) : (m_flags &= ~ZeroCopy());
+    return *this;
+  }
 
   bool equals(const ZiCxnOptions &o) const {
     using namespace ZiCxnFlags;
@@ -477,6 +507,14 @@ public:
   void send(ZiIOFn fn);
   void send_(ZiIOFn fn);	// direct call from within tx thread
 
+#ifdef ZiMultiplex_EPoll
+  // relay all subsequently received data to peer using splice(), without
+  // copying through userspace (Linux epoll only); the receive context is
+  // completed, and the application must not otherwise send to peer;
+  // if peer disconnects, this connection is closed
+  void splice(ZiConnection *peer);
+#endif
+
   // graceful disconnect (socket shutdown); then socket close
   void disconnect();
 
@@ -513,6 +551,44 @@ private:
   void errorSend(int status, ZeError e);
   void executedSend(unsigned n);
 
+#ifdef ZiMultiplex_EPoll
+  // batched UDP I/O
+  struct RxBatch;
+  struct TxBatch;
+
+  bool recvBatch();
+  int sendBatch(const uint8_t *buf, unsigned len);
+  int flushBatch();
+  void flushBatch_();
+
+  void sendBlocked();
+
+  // zero-copy send
+  struct ZeroCopy;
+
+  int sendZC(const uint8_t *buf, unsigned len);
+  void recvZC();
+
+  // splice() relay
+  struct Splice;
+
+  void splice_(ZmRef<ZiConnection> peer);
+  bool spliceRecv();
+  void spliceError(ZeError e);
+  void spliceClose();
+#endif
+
+#ifdef ZiMultiplex_IOURing
+  // io_uring - TCP is received by multishot recv, other sockets
+  // (UDP, netlink) by multishot poll driving recv()
+  struct URingRx;
+
+  bool uringStream() const;
+  void uringRecv();
+  void uringRecvd(const uint8_t *data, unsigned len);
+  void uringRecvEnd(int res);
+#endif
+
   void disconnect_1();
   void disconnect_2();
   void close_1();
@@ -539,12 +615,25 @@ private:
   Zi_Overlapped		m_rxOverlapped;
   DWORD			m_rxFlags;		// flags for WSARecv()
 #endif
+#ifdef ZiMultiplex_EPoll
+  RxBatch		*m_rxBatch = nullptr;
+  Splice		*m_splice = nullptr;	// relaying to peer
+  ZiConnection		*m_spliceIn = nullptr;	// peer relaying to this
+#endif
+#ifdef ZiMultiplex_IOURing
+  URingRx		*m_uringRx = nullptr;
+  bool			m_uringPollOut = false;	// POLLOUT armed for Tx
+#endif
 
   // Tx thread exclusive
   ZmAtomic<unsigned>	m_txUp;
   uint64_t		m_txRequests;
   uint64_t		m_txBytes;
   ZiIOContext		m_txContext;
+#ifdef ZiMultiplex_EPoll
+  TxBatch		*m_txBatch = nullptr;
+  ZeroCopy		*m_zeroCopy = nullptr;
+#endif
 };
 
 // named parameter list for configuring ZiMultiplex
@@ -571,6 +660,26 @@ struct ZiMxParams {
     { m_epollMaxFDs = n; return ZuMv(*this); }
   ZiMxParams &&epollQuantum(unsigned n)
     { m_epollQuantum = n; return ZuMv(*this); }
+  ZiMxParams &&rxBatch(unsigned n)
+    { m_rxBatch = n; return ZuMv(*this); }
+  ZiMxParams &&txBatch(unsigned n)
+    { m_txBatch = n; return ZuMv(*this); }
+  ZiMxParams &&pollSpin(unsigned n)
+    { m_pollSpin = n; return ZuMv(*this); }
+  ZiMxParams &&pollYield(unsigned n)
+    { m_pollYield = n; return ZuMv(*this); }
+  ZiMxParams &&busyPoll(unsigned usecs)
+    { m_busyPoll = usecs; return ZuMv(*this); }
+  ZiMxParams &&zeroCopyMin(unsigned n)
+    { m_zeroCopyMin = n; return ZuMv(*this); }
+#endif
+#ifdef ZiMultiplex_IOURing
+  ZiMxParams &&uring(bool b)
+    { m_uring = b; return ZuMv(*this); }
+  ZiMxParams &&uringDepth(unsigned n)
+    { m_uringDepth = n; return ZuMv(*this); }
+  ZiMxParams &&uringBufs(unsigned n)
+    { m_uringBufs = n; return ZuMv(*this); }
 #endif
   ZiMxParams &&rxBufSize(unsigned v)
     { m_rxBufSize = v; return ZuMv(*this); }
@@ -599,6 +708,17 @@ struct ZiMxParams {
 #ifdef ZiMultiplex_EPoll
   unsigned epollMaxFDs() const { return m_epollMaxFDs; }
   unsigned epollQuantum() const { return m_epollQuantum; }
+  unsigned rxBatch() const { return m_rxBatch; }
+  unsigned txBatch() const { return m_txBatch; }
+  unsigned pollSpin() const { return m_pollSpin; }
+  unsigned pollYield() const { return m_pollYield; }
+  unsigned busyPoll() const { return m_busyPoll; }
+  unsigned zeroCopyMin() const { return m_zeroCopyMin; }
+#endif
+#ifdef ZiMultiplex_IOURing
+  bool uring() const { return m_uring; }
+  unsigned uringDepth() const { return m_uringDepth; }
+  unsigned uringBufs() const { return m_uringBufs; }
 #endif
   unsigned rxBufSize() const { return m_rxBufSize; }
   unsigned txBufSize() const { return m_txBufSize; }
@@ -619,6 +739,19 @@ private:
 #ifdef ZiMultiplex_EPoll
   unsigned		m_epollMaxFDs = 256;
   unsigned		m_epollQuantum = 8;
+  unsigned		m_rxBatch = 32;	// datagrams per recvmmsg()
+  unsigned		m_txBatch = 32;	// datagrams per sendmmsg()
+  // Rx busy-polling - pollSpin non-blocking polls between each yield,
+  // pollYield yields before blocking (0 - never block); 0 pollSpin disables
+  unsigned		m_pollSpin = 0;
+  unsigned		m_pollYield = 0;
+  unsigned		m_busyPoll = 0;	// SO_BUSY_POLL (usecs)
+  unsigned		m_zeroCopyMin = 16384; // min. MSG_ZEROCOPY send
+#endif
+#ifdef ZiMultiplex_IOURing
+  bool			m_uring = false;	// io_uring instead of epoll
+  unsigned		m_uringDepth = 256;	// submission queue size
+  unsigned		m_uringBufs = 256;	// multishot recv buffers
 #endif
   unsigned		m_rxBufSize = 0;
   unsigned		m_txBufSize = 0;
@@ -633,11 +766,21 @@ private:
 #endif
 };
 
+// batched UDP I/O histogram buckets - number of recvmmsg() / sendmmsg()
+// calls that transferred 1, 2-4, 5-16 and 17+ datagrams
+enum { ZiMxBatchBuckets = 4 };
+inline unsigned ZiMxBatchBucket(unsigned n) {
+  return n <= 1 ? 0 : n <= 4 ? 1 : n <= 16 ? 2 : 3;
+}
+
 // display sequence:
 //   id, state, nThreads, rxThread, txThread,
 //   priority, stackSize, partition, rxBufSize, txBufSize,
-//   queueSize, ll, spin, timeout
-struct ZiMxTelemetry { // not graphable
+//   queueSize, ll, spin, timeout,
+//   rxBatch1, rxBatch4, rxBatch16, rxBatch64,
+//   txBatch1, txBatch4, txBatch16, txBatch64,
+//   rxPolled, rxWaited
+struct ZiMxTelemetry { // not graphable, except for batch histograms, etc.
   ZuID		id;		// primary key
   uint32_t	stackSize = 0;
   uint32_t	queueSize = 0;
@@ -652,6 +795,16 @@ struct ZiMxTelemetry { // not graphable
   uint8_t	ll = 0;
   uint8_t	priority = 0;
   uint8_t	nThreads = 0;
+  uint64_t	rxBatch1 = 0;	// graphable (*)
+  uint64_t	rxBatch4 = 0;	// graphable (*)
+  uint64_t	rxBatch16 = 0;	// graphable (*)
+  uint64_t	rxBatch64 = 0;	// graphable (*)
+  uint64_t	txBatch1 = 0;	// graphable (*)
+  uint64_t	txBatch4 = 0;	// graphable (*)
+  uint64_t	txBatch16 = 0;	// graphable (*)
+  uint64_t	txBatch64 = 0;	// graphable (*)
+  uint64_t	rxPolled = 0;	// graphable (*) - Rx wakeups while spinning
+  uint64_t	rxWaited = 0;	// graphable (*) - Rx wakeups after blocking
 };
 
 class ZiAPI ZiMultiplex : public ZmScheduler {
@@ -816,6 +969,31 @@ template <typename> friend class Connect_;
   using Connect = Connect_<ConnectHeap>;
 #endif
 
+#ifdef ZiMultiplex_EPoll
+  // readable source, e.g. a ZmRing/ZiRing notifyFD()
+  class Readable_ : public ZuObject {
+  friend ZiMultiplex;
+
+  public:
+    static int FDAxor(const Readable_ &r) { return r.m_fd; }
+    static const char *HeapID() { return "ZiMultiplex.Readable"; }
+
+  protected:
+    Readable_(int fd, ZmFn<> fn) : m_fd{fd}, m_fn{ZuMv(fn)} { }
+
+  private:
+    int			m_fd;
+    ZmFn<>		m_fn;
+    bool		m_up = true;
+  };
+  using ReadableHash =
+    ZmHash<Readable_,
+      ZmHashNode<Readable_,
+	ZmHashKey<Readable_::FDAxor,
+	  ZmHashHeapID<Readable_::HeapID>>>>;
+  using Readable = ReadableHash::Node;
+#endif
+
   using CxnHash =
     ZmHash<ZmRef<ZiConnection>,
       ZmHashKey<ZiConnection::SocketAxor,
@@ -863,6 +1041,17 @@ public:
       ZiIP remoteIP, uint16_t remotePort,
       ZiCxnOptions options = ZiCxnOptions());
 
+#ifdef ZiMultiplex_EPoll
+  // add a readable source - fn is called from the Rx thread whenever
+  // fd becomes readable (edge-triggered), and once upon registration;
+  // fd is not closed by ZiMultiplex and must remain open until
+  // delReadable() calls fn (from the Rx thread)
+  void addReadable(int fd, ZmFn<> fn);
+  void addReadable_(int fd, ZmFn<> fn);				// Rx thread
+  void delReadable(int fd, ZmFn<> fn = ZmFn<>());
+  void delReadable_(int fd, ZmFn<> fn = ZmFn<>());		// Rx thread
+#endif
+
   unsigned rxThread() const { return m_rxThread; }
   unsigned txThread() const { return m_txThread; }
 
@@ -893,6 +1082,15 @@ public:
 #ifdef ZiMultiplex_EPoll
   unsigned epollMaxFDs() const { return m_epollMaxFDs; }
   unsigned epollQuantum() const { return m_epollQuantum; }
+  unsigned rxBatch() const { return m_rxBatch; }
+  unsigned txBatch() const { return m_txBatch; }
+  unsigned pollSpin() const { return m_pollSpin; }
+  unsigned pollYield() const { return m_pollYield; }
+  unsigned busyPoll() const { return m_busyPoll; }
+  unsigned zeroCopyMin() const { return m_zeroCopyMin; }
+#endif
+#ifdef ZiMultiplex_IOURing
+  bool uring() const { return m_uring; }	// false if epoll fallback
 #endif
   unsigned rxBufSize() const { return m_rxBufSize; }
   unsigned txBufSize() const { return m_txBufSize; }
@@ -931,10 +1129,33 @@ private:
   void disconnected(ZiConnection *cxn);
 
 #ifdef ZiMultiplex_EPoll
+  void accepted(Listener *, Socket, const ZiSockAddr &remote);
+  void acceptError(Listener *);
+  void connectError(Connect *);
+
   bool epollRecv(ZiConnection *, int s, uint32_t events);
+
+  bool pollIdle(unsigned &spins, unsigned &yields);
+  void polled(bool polling);
+#endif
+
+#ifdef ZiMultiplex_IOURing
+  struct URing;
+
+  bool uringInit();
+  void uringClose();
+  void uringRx();
+  bool uringCompleted(uintptr_t data, int res, unsigned flags);
+  void uringDeref(uintptr_t data);
+  void uringRecv(ZiConnection *);
+  void uringConnect(Connect *);
+  void uringPollOut(ZiConnection *);
 #endif
 
   bool initSocket(Socket, const ZiCxnOptions &);
+#ifdef ZiMultiplex_EPoll
+  void initBusyPoll(Socket);
+#endif
 
   bool cxnAdd(ZiConnection *, Socket);
   void cxnDel(Socket);
@@ -960,6 +1181,9 @@ private:
     ZmRef<ConnectHash>	  m_connects;
 #endif
     ZmRef<CxnHash>	  m_cxns;	// connections
+#ifdef ZiMultiplex_EPoll
+    ZmRef<ReadableHash>	  m_readables;
+#endif
 
   unsigned		m_txThread = 0;
 
@@ -975,6 +1199,33 @@ private:
   unsigned		m_epollQuantum = 0;
   int			m_epollFD = -1;
   int			m_wakeFD = -1, m_wakeFD2 = -1;	// wake pipe
+
+  unsigned		m_rxBatch = 0;
+  unsigned		m_txBatch = 0;
+
+  unsigned		m_pollSpin = 0;
+  unsigned		m_pollYield = 0;
+  unsigned		m_busyPoll = 0;
+  unsigned		m_zeroCopyMin = 0;
+
+#ifdef ZiMultiplex_IOURing
+  bool			m_uringParam = false;
+  unsigned		m_uringDepth = 0;
+  unsigned		m_uringBufs = 0;
+  URing			*m_uring = nullptr;	// Rx exclusive once started
+#endif
+
+  // batch size histograms, updated by the Rx and Tx threads respectively
+  ZmAtomic<uint64_t>	m_rxBatchHist[ZiMxBatchBuckets];
+  ZmAtomic<uint64_t>	m_txBatchHist[ZiMxBatchBuckets];
+  static void batched(ZmAtomic<uint64_t> *hist, unsigned n) {
+    auto &count = hist[ZiMxBatchBucket(n)];
+    count.store_(count.load_() + 1);
+  }
+
+  // Rx wakeups while busy-polling vs. after blocking, updated by Rx thread
+  ZmAtomic<uint64_t>	m_rxPolled;
+  ZmAtomic<uint64_t>	m_rxWaited;
 #endif
 
 #ifdef ZiMultiplex_DEBUG
@@ -8,6 +8,8 @@
 
 #include <zlib/ZiRing.hh>
 
+#include <zlib/ZuIntrin.hh>
+
 #include <zlib/ZmTime.hh>
 
 #include <zlib/ZeLog.hh>
@@ -15,6 +17,8 @@
 #ifdef linux
 
 #include <sys/syscall.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <linux/futex.h>
 
 #endif
@@ -24,11 +28,106 @@ namespace ZiRing_ {
 #ifdef linux
 
 Blocker::Blocker() { }
-Blocker::Blocker(const Blocker &blocker) { }
-Blocker::~Blocker() { }
+Blocker::Blocker(const Blocker &blocker) :
+    m_mask{blocker.m_mask}, m_name{blocker.m_name},
+    m_notify{blocker.m_notify} { }
+Blocker::~Blocker() { close(); }
+
+bool Blocker::open(bool head, const Params &params)
+{
+  if (head) {
+    m_name = params.name;
+    m_notify = params.notify;
+  }
+  return true;
+}
+void Blocker::close()
+{
+  unsubscribe();
+  int fd = m_sendFD.xch(-1);
+  if (fd >= 0) ::close(fd);
+}
+
+// abstract namespace socket address of reader id
+static bool notifyAddr(
+    const Zi::Path &name, unsigned id, sockaddr_un &addr, socklen_t &len)
+{
+  ZuStringN<sizeof(addr.sun_path) - 1> path;
+  if (name.length() + 16 > path.size()) return false;
+  path << name << ".notify." << ZuBox<unsigned>(id);
+  memset(&addr, 0, sizeof(sockaddr_un));
+  addr.sun_family = AF_UNIX;
+  memcpy(&addr.sun_path[1], path.data(), path.length());
+  len = offsetof(sockaddr_un, sun_path) + 1 + path.length();
+  return true;
+}
+
+int Blocker::subscribe(unsigned id)
+{
+  if (!m_notify || !m_mask || id >= MaxRdrs) return -1;
+  if (m_fd >= 0) {
+    if (unsigned(m_id) == id) return m_fd;
+    unsubscribe();
+  }
+  sockaddr_un addr;
+  socklen_t len;
+  if (!notifyAddr(m_name, id, addr, len)) return -1;
+  int fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr *>(&addr), len) < 0) {
+    ZeError e{errno};
+    if (fd >= 0) ::close(fd);
+    ZeLOG(Error, ([name = m_name, id, e](auto &s) {
+      s << "ZiRing::Blocker::subscribe() bind(" << name
+	<< ".notify." << id << ") failed: " << e;
+    }));
+    return -1;
+  }
+  m_fd = fd;
+  m_id = id;
+  *m_mask |= (1ULL<<id);
+  return fd;
+}
+
+void Blocker::unsubscribe()
+{
+  if (m_fd < 0) return;
+  if (m_mask) *m_mask &= ~(1ULL<<m_id);
+  ::close(m_fd);
+  m_fd = -1;
+  m_id = -1;
+}
 
-bool Blocker::open(bool, const Params &) { return true; }
-void Blocker::close() { }
+void Blocker::notified()
+{
+  if (m_fd < 0) return;
+  char buf[64];
+  while (::recv(m_fd, buf, sizeof(buf), MSG_DONTWAIT) > 0);
+}
+
+// failures are intentionally ignored - EAGAIN indicates that the reader
+// already has pending notifications, ECONNREFUSED a dead reader that
+// will be removed from the mask by gc(); the send socket is created on
+// first use, and concurrent writers (MW) race to publish it
+void Blocker::notify(uint64_t mask)
+{
+  int fd = m_sendFD;
+  if (ZuUnlikely(fd < 0)) {
+    fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return;
+    int prev = m_sendFD.cmpXch(fd, -1);
+    if (prev >= 0) { ::close(fd); fd = prev; }
+  }
+  sockaddr_un addr;
+  socklen_t len;
+  char c = 0;
+  while (mask) {
+    unsigned id = ZuIntrin::ctz(mask);
+    mask &= mask - 1;
+    if (notifyAddr(m_name, id, addr, len))
+      ::sendto(fd, &c, 1, MSG_DONTWAIT | MSG_NOSIGNAL,
+	  reinterpret_cast<const sockaddr *>(&addr), len);
+  }
+}
 
 int Blocker::wait(
     ZmAtomic<uint32_t> &addr, uint32_t val,
@@ -36,6 +135,7 @@ int Blocker::wait(
 {
   if (addr.cmpXch(val | Waiting32(), val) != val) return Zu::OK;
   val |= Waiting32();
+  if (m_notify) return Zu::NotReady; // Waiting is set, wake() will notify
   if (ZuUnlikely(params.timeout)) {
     ZuTime out = Zm::now(params.timeout);
     unsigned i = 0;
@@ -67,6 +167,8 @@ int Blocker::wait(
 
 void Blocker::wake(ZmAtomic<uint32_t> &addr)
 {
+  // readers in other processes may be blocked rather than notified
+  if (m_mask) if (uint64_t mask = *m_mask) notify(mask);
   syscall(SYS_futex, reinterpret_cast<volatile int *>(&addr),
       FUTEX_WAKE, INT_MAX, 0, 0, 0);
 }
@@ -148,6 +250,10 @@ void Blocker::wake(ZmAtomic<uint32_t> &addr)
   while (ReleaseSemaphore(m_sem, 1, &prev) && prev > 1);
 }
 
+int Blocker::subscribe(unsigned) { return -1; }	// unsupported
+void Blocker::unsubscribe() { }
+void Blocker::notified() { }
+
 #endif /* _WIN32 */
 
 bool CtrlMem::open(unsigned size, const Params &params)
@@ -122,7 +122,32 @@ public:
   // wake up waiters on addr
   void wake(ZmAtomic<uint32_t> &addr);
 
+  // notification (Params::notify, Linux) - wait() returns NotReady
+  // instead of blocking, and wake() sends a datagram to each subscribed
+  // reader's socket (abstract namespace "<name>.notify.<id>"), since
+  // unlike futexes, eventfds cannot be shared by name between processes;
+  // subscribe() returns the socket, -1 on error
+  int subscribe(unsigned id);
+  void unsubscribe();
+  void notified();	// consume pending notifications
+
+  // bound by RingExt to the subscribed readers mask in shared memory
+  void notifyMask(ZmAtomic<uint64_t> *mask) { m_mask = mask; }
+
+private:
+#ifdef linux
+  void notify(uint64_t mask);
+#endif
+
 protected:
+  ZmAtomic<uint64_t>	*m_mask = nullptr;	// Ctrl::notifyMask
+#ifdef linux
+  Zi::Path		m_name;
+  int			m_fd = -1;	// reader - bound socket
+  int			m_id = -1;	// reader - subscribed ID
+  ZmAtomic<int>		m_sendFD = -1;	// writer - unbound socket
+  bool			m_notify = false;
+#endif
 #ifdef _WIN32
   HANDLE		m_sem;
 #endif
@@ -152,6 +177,7 @@ struct Ctrl<true> : public ZmRing_::Ctrl<true> {
   uint32_t			pad_6;
   uint32_t			rdrPID[MaxRdrs];
   ZuTime			rdrTime[MaxRdrs];
+  ZmAtomic<uint64_t>		notifyMask; // readers subscribed to notify
 };
 template <>
 struct Ctrl<false> : public Ctrl<true> {
@@ -184,6 +210,7 @@ protected:
   ZuInline const uint32_t *rdrPID() const { return ctrl()->rdrPID; }
   ZuInline ZuTime *rdrTime() { return ctrl()->rdrTime; }
   ZuInline const ZuTime *rdrTime() const { return ctrl()->rdrTime; }
+  ZuInline ZmAtomic<uint64_t> &notifyMask() { return ctrl()->notifyMask; }
 
   ZuInline ZmAtomic<uint32_t> &writerPID();		// unused
   ZuInline const ZmAtomic<uint32_t> &writerPID() const;	// ''
@@ -341,6 +368,8 @@ inline bool RingExt<Ring, MW, MR>::open_()
       ring()->writerTime() = start;
     }
 
+  ring()->headBlocker().notifyMask(&ring()->notifyMask());
+
   return true;
 }
 
@@ -354,6 +383,11 @@ inline void RingExt<Ring, MW, MR>::close_()
     }
 
   Base::close_();
+
+  // SR and undetached readers must clear their bit in the shared mask
+  // before it is unbound
+  ring()->headBlocker().unsubscribe();
+  ring()->headBlocker().notifyMask(nullptr);
 }
 
 template <typename Ring, bool MW, bool MR>
@@ -477,6 +511,7 @@ inline void RingExt<Ring, MW, MR>::attached(unsigned id)
 template <typename Ring, bool MW, bool MR>
 inline void RingExt<Ring, MW, MR>::detached(unsigned id)
 {
+  ring()->notifyMask() &= ~(1ULL<<id);
   (ring()->rdrPID())[id] = 0;
   (ring()->rdrTime())[id] = ZuTime{};
 }
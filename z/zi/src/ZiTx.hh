@@ -44,6 +44,7 @@ public:
 	    impl_->sent(ZuMv(buf_));
 	    return true;
 	  }}, buf->data(), buf->length, 0);
+	if (impl(buf)->info().options.zeroCopy()) io.pin = buf;
 	return true;
       }});
   }
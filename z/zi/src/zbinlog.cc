@@ -0,0 +1,69 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// binary log decoder - renders ZiBinLogSink files as text
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <zlib/ZeLog.hh>
+
+#include <zlib/ZiBinLog.hh>
+
+void usage()
+{
+  fputs(
+    "Usage: zbinlog [OPTION]... FILE...\n\n"
+    "Options:\n"
+    "  -z N\t- timezone offset N seconds (default: 0)\n", stderr);
+  Zm::exit(1);
+}
+
+int main(int argc, char **argv)
+{
+  int tzOffset = 0;
+  int i;
+
+  for (i = 1; i < argc; i++) {
+    if (argv[i][0] != '-') break;
+    if (!argv[i][1] || argv[i][2]) usage();
+    switch (argv[i][1]) {
+      case 'z':
+	if (++i >= argc) usage();
+	tzOffset = atoi(argv[i]);
+	break;
+      default:
+	usage();
+	break;
+    }
+  }
+  if (i >= argc) usage();
+
+  // same layout as ZeFileSink
+  ZmRef<ZeSink> sink = new ZeLambdaSink{
+    [](ZeLogBuf &buf, const ZeEventInfo &) {
+      buf << '\n';
+      unsigned len = buf.length();
+      if (buf[len - 1] != '\n') buf[len - 1] = '\n';
+      fwrite(buf.data(), 1, len, stdout);
+    }, tzOffset};
+
+  int r = 0;
+  for (; i < argc; i++) {
+    ZiBinLogReader reader;
+    ZeError e;
+    if (reader.open(argv[i], &e) != Zi::OK) {
+      fprintf(stderr, "%s: %s\n", argv[i], e.message());
+      r = 1;
+      continue;
+    }
+    reader.replay(sink);
+  }
+  fflush(stdout);
+  return r;
+}
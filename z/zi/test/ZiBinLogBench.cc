@@ -0,0 +1,145 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// logging benchmark - ZeFileSink (text) vs. ZiBinLogSink (binary)
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <zlib/ZuBox.hh>
+#include <zlib/ZuTime.hh>
+
+#include <zlib/ZeLog.hh>
+
+#include <zlib/ZiBinLog.hh>
+
+void usage()
+{
+  fputs(
+    "Usage: ZiBinLogBench [OPTION]...\n\n"
+    "Options:\n"
+    "  -n N\t- log N events (default: 1000000)\n"
+    "  -t\t- text (ZeFileSink) only\n"
+    "  -b\t- binary (ZiBinLogSink) only\n"
+    "  -T N\t- per-thread ring buffer of N bytes (default: shared)\n",
+    stderr);
+  Zm::exit(1);
+}
+
+uint64_t dropped()
+{
+  uint64_t n = 0;
+  ZeLog::allThreadBufs([&n](const ZeLogThreadBuf *buf) {
+    n += buf->dropped();
+  });
+  return n;
+}
+
+void report(
+    const char *name, unsigned n, ZuTime logged, ZuTime drained,
+    unsigned dropped)
+{
+  printf("%-8s %u events: %.1fns/event caller, %.1fns/event drained "
+      "(%.0f events/sec), %u dropped\n", name, n,
+      double(logged.nanosecs()) / double(n),
+      double(drained.nanosecs()) / double(n),
+      double(n) * 1000000000 / double(drained.nanosecs()), dropped);
+}
+
+void text(unsigned n)
+{
+  ZeLog::sink(ZeLog::fileSink(ZeSinkOptions{}.path("ZiBinLogBench.log")));
+  ZeLog::start();
+  uint64_t dropped_ = dropped();
+  ZuTime begin = Zm::now();
+  for (unsigned i = 0; i < n; i++) {
+    unsigned qty = 100 + (i & 0xff);
+    double px = 100.0 + double(i & 0xfff) / 64;
+    ZeLOG(Info, ([i, qty, px](auto &s) {
+      s << "order " << ZuBoxed(i) << " filled " << ZuBoxed(qty) << '@' <<
+	ZuBoxed(px);
+    }));
+  }
+  ZuTime logged = Zm::now() - begin;
+  ZeLog::stop();
+  ZuTime drained = Zm::now() - begin;
+  report("text", n, logged, drained, dropped() - dropped_);
+}
+
+void binary(unsigned n)
+{
+  ZeLog::sink(ZiBinLogSink::sink(ZeSinkOptions{}.path("ZiBinLogBench.zlog")));
+  ZeLog::start();
+  uint64_t dropped_ = dropped();
+  ZuTime begin = Zm::now();
+  for (unsigned i = 0; i < n; i++) {
+    unsigned qty = 100 + (i & 0xff);
+    double px = 100.0 + double(i & 0xfff) / 64;
+    ZeBLOG(Info, "order {} filled {}@{}", i, qty, px);
+  }
+  ZuTime logged = Zm::now() - begin;
+  ZeLog::stop();
+  ZeLog::sink(ZeLog::fileSink(ZeSinkOptions{}.path("&2")));
+  ZuTime drained = Zm::now() - begin;
+  dropped_ = dropped() - dropped_;
+  report("binary", n, logged, drained, dropped_);
+  unsigned expected = n - dropped_;
+
+  // decode offline, discarding the output
+  ZiBinLogReader reader;
+  ZeError e;
+  if (reader.open("ZiBinLogBench.zlog", &e) != Zi::OK) {
+    fprintf(stderr, "ZiBinLogBench.zlog: %s\n", e.message());
+    return;
+  }
+  unsigned m = 0;
+  auto sink = ZeLog::lambdaSink([&m](ZeLogBuf &, const ZeEventInfo &) {
+    ++m;
+  });
+  begin = Zm::now();
+  unsigned o = reader.replay(sink);
+  ZuTime decoded = Zm::now() - begin;
+  printf("%-8s %u events: %.1fns/event decoded%s\n", "zbinlog", o,
+      double(decoded.nanosecs()) / double(o ? o : 1),
+      (m == expected && o == expected) ? "" : " - MISMATCH");
+}
+
+int main(int argc, char **argv)
+{
+  unsigned n = 1000000;
+  unsigned threadBufSize = 0;
+  bool text_ = true, binary_ = true;
+
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] != '-' || !argv[i][1] || argv[i][2]) usage();
+    switch (argv[i][1]) {
+      case 'n':
+	if (++i >= argc || !(n = atoi(argv[i]))) usage();
+	break;
+      case 't':
+	binary_ = false;
+	break;
+      case 'b':
+	text_ = false;
+	break;
+      case 'T':
+	if (++i >= argc || !(threadBufSize = atoi(argv[i]))) usage();
+	break;
+      default:
+	usage();
+	break;
+    }
+  }
+
+  ZeLog::init("ZiBinLogBench");
+  ZeLog::level(0);
+  ZeLog::threadBufSize(threadBufSize);
+
+  if (text_) text(n);
+  if (binary_) binary(n);
+}
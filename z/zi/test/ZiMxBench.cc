@@ -0,0 +1,273 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// loopback TCP ping-pong benchmark - epoll vs. io_uring
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <zlib/ZuTime.hh>
+
+#include <zlib/ZmSemaphore.hh>
+
+#include <zlib/ZtArray.hh>
+
+#include <zlib/ZeLog.hh>
+
+#include <zlib/ZiMultiplex.hh>
+
+class Mx;
+
+// the client sends a message, the server echoes it back
+class Connection : public ZiConnection {
+public:
+  Connection(Mx *mx, const ZiCxnInfo &ci, bool client, unsigned size);
+
+  Mx *mx() { return reinterpret_cast<Mx *>(ZiConnection::mx()); }
+
+  void connected(ZiIOContext &io) {
+    io.init(ZiIOFn::Member<&Connection::recvd>::fn(this),
+	m_rxBuf.data(), m_rxBuf.length(), 0);
+    if (m_client) ping();
+  }
+  void disconnected();
+
+  void ping() {
+    m_sent = Zm::now();
+    send(ZiIOFn::Member<&Connection::send_>::fn(this));
+  }
+
+  bool recvd(ZiIOContext &io);
+
+  bool send_(ZiIOContext &io) {
+    io.init(ZiIOFn::Member<&Connection::sent>::fn(this),
+	m_txBuf.data(), m_txBuf.length(), 0);
+    return true;
+  }
+  bool sent(ZiIOContext &io) {
+    if ((io.offset += io.length) < io.size) return true;
+    io.complete();
+    return true;
+  }
+
+private:
+  bool			m_client;
+  ZtArray<uint8_t>	m_rxBuf;
+  ZtArray<uint8_t>	m_txBuf;
+  ZuTime		m_sent;
+};
+
+class Mx : public ZiMultiplex {
+public:
+  Mx(ZiMxParams params, unsigned port, unsigned size, unsigned count) :
+    ZiMultiplex{ZuMv(params)},
+    m_port{port}, m_size{size}, m_count{count} { }
+
+  void listen() {
+    ZiMultiplex::listen(
+	ZiListenFn::Member<&Mx::listening>::fn(this),
+	ZiFailFn::Member<&Mx::failed>::fn(this),
+	ZiConnectFn::Member<&Mx::accepted>::fn(this),
+	ZiIP{"127.0.0.1"}, m_port, 1);
+  }
+  void listening(const ZiListenInfo &) {
+    connect(
+	ZiConnectFn::Member<&Mx::connected>::fn(this),
+	ZiFailFn::Member<&Mx::failed>::fn(this),
+	ZiIP{}, 0, ZiIP{"127.0.0.1"}, m_port);
+  }
+  void failed(bool) {
+    fprintf(stderr, "listen / connect failed\n");
+    m_done.post();
+  }
+  ZiConnection *accepted(const ZiCxnInfo &ci) {
+    return new Connection(this, ci, false, m_size);
+  }
+  ZiConnection *connected(const ZiCxnInfo &ci) {
+    return new Connection(this, ci, true, m_size);
+  }
+
+  // returns true when complete
+  bool rtt(ZuTime t) {
+    uint64_t ns = t.nanosecs();
+    m_total += ns;
+    if (!m_min || ns < m_min) m_min = ns;
+    if (ns > m_max) m_max = ns;
+    if (++m_n < m_count) return false;
+    m_done.post();
+    return true;
+  }
+
+  void wait() { m_done.wait(); }
+
+  unsigned n() const { return m_n; }
+  uint64_t total() const { return m_total; }	// nanosecs
+  uint64_t min() const { return m_min; }
+  uint64_t max() const { return m_max; }
+
+private:
+  unsigned	m_port;
+  unsigned	m_size;
+  unsigned	m_count;
+  unsigned	m_n = 0;
+  uint64_t	m_total = 0;
+  uint64_t	m_min = 0;
+  uint64_t	m_max = 0;
+  ZmSemaphore	m_done;
+};
+
+Connection::Connection(
+    Mx *mx, const ZiCxnInfo &ci, bool client, unsigned size) :
+  ZiConnection{mx, ci}, m_client{client}
+{
+  m_rxBuf.length(size);
+  m_txBuf.length(size);
+  memset(m_txBuf.data(), 'x', size);
+}
+
+bool Connection::recvd(ZiIOContext &io)
+{
+  if ((io.offset += io.length) < io.size) return true;
+  io.offset = 0;
+  if (!m_client) {
+    memcpy(m_txBuf.data(), m_rxBuf.data(), m_rxBuf.length());
+    send(ZiIOFn::Member<&Connection::send_>::fn(this));
+    return true;
+  }
+  if (mx()->rtt(Zm::now() - m_sent)) {
+    io.disconnect();
+    return true;
+  }
+  ping();
+  return true;
+}
+
+void Connection::disconnected() { }
+
+void usage()
+{
+  fputs(
+    "Usage: ZiMxBench [OPTION]...\n\n"
+    "Options:\n"
+    "  -n N\t- N round trips (default: 100000)\n"
+    "  -s N\t- message size N bytes (default: 64)\n"
+    "  -p N\t- loopback port (default: 27413)\n"
+    "  -q N\t- epoll / io_uring quantum (default: 8)\n"
+    "  -b N\t- busy-poll N times between yields (default: 0 - block)\n"
+    "  -e\t- epoll only\n"
+    "  -u\t- io_uring only\n", stderr);
+  Zm::exit(1);
+}
+
+void run(const char *name, bool uring,
+    unsigned port, unsigned size, unsigned count, unsigned quantum,
+    unsigned spin)
+{
+  ZiMxParams params;
+  params.scheduler([name](auto &s) { s.id(name); });
+#ifdef ZiMultiplex_EPoll
+  params.epollQuantum(quantum);
+  params.pollSpin(spin);
+#endif
+#ifdef ZiMultiplex_IOURing
+  params.uring(uring);
+#else
+  if (uring) {
+    fprintf(stderr, "%s: unsupported\n", name);
+    return;
+  }
+#endif
+
+  Mx mx{ZuMv(params), port, size, count};
+
+  if (!mx.start()) Zm::exit(1);
+#ifdef ZiMultiplex_IOURing
+  if (uring && !mx.uring()) {
+    fprintf(stderr, "%s: unavailable\n", name);
+    mx.stop();
+    return;
+  }
+#endif
+
+  ZuTime begin = Zm::now();
+  mx.listen();
+  mx.wait();
+  ZuTime elapsed = Zm::now() - begin;
+
+  mx.stop();
+
+#ifdef ZiMultiplex_EPoll
+  ZiMxTelemetry data;
+  mx.telemetry(data);
+#endif
+
+  if (unsigned n = mx.n())
+    printf("%-8s %u x %u bytes: rtt mean %.1fus min %.1fus max %.1fus "
+	"(%.0f msgs/sec)\n", name, n, size,
+	double(mx.total()) / (double(n) * 1000),
+	double(mx.min()) / 1000,
+	double(mx.max()) / 1000,
+	double(n) * 1000000000 / double(elapsed.nanosecs()));
+#ifdef ZiMultiplex_EPoll
+  if (spin)
+    printf("%-8s wakeups: %llu polled %llu waited\n", name,
+	static_cast<unsigned long long>(data.rxPolled),
+	static_cast<unsigned long long>(data.rxWaited));
+#endif
+}
+
+int main(int argc, char **argv)
+{
+  unsigned count = 100000;
+  unsigned size = 64;
+  unsigned port = 27413;
+  unsigned quantum = 8;
+  unsigned spin = 0;
+  bool epoll = true, uring = true;
+
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0] != '-' || !argv[i][1] || argv[i][2]) usage();
+    switch (argv[i][1]) {
+      case 'n':
+	if (++i >= argc || !(count = atoi(argv[i]))) usage();
+	break;
+      case 's':
+	if (++i >= argc || !(size = atoi(argv[i]))) usage();
+	break;
+      case 'p':
+	if (++i >= argc || !(port = atoi(argv[i]))) usage();
+	break;
+      case 'q':
+	if (++i >= argc || !(quantum = atoi(argv[i]))) usage();
+	break;
+      case 'b':
+	if (++i >= argc) usage();
+	spin = atoi(argv[i]);
+	break;
+      case 'e':
+	uring = false;
+	break;
+      case 'u':
+	epoll = false;
+	break;
+      default:
+	usage();
+	break;
+    }
+  }
+
+  ZeLog::init("ZiMxBench");
+  ZeLog::level(0);
+  ZeLog::sink(ZeLog::debugSink());
+  ZeLog::start();
+
+  if (epoll) run("epoll", false, port, size, count, quantum, spin);
+  if (uring) run("io_uring", true, port, size, count, quantum, spin);
+
+  ZeLog::stop();
+}
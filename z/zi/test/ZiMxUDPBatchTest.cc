@@ -0,0 +1,271 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// batched UDP round-trip test - bursts of variable-length datagrams are
+// sent with sendmmsg() and echoed back, with burst sizes that are not
+// multiples of the Rx / Tx batch size, so that recvmmsg() and sendmmsg()
+// both transfer full and partial batches
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <zlib/ZmSemaphore.hh>
+
+#include <zlib/ZtArray.hh>
+
+#include <zlib/ZeLog.hh>
+
+#include <zlib/ZiMultiplex.hh>
+
+void fail()
+{
+  Zm::exit(1);
+}
+#define check(x) check_(x, __LINE__, #x)
+void check_(bool ok, unsigned line, const char *exp)
+{
+  printf("%s %6d %s\n", ok ? " OK " : "NOK ", line, exp);
+  fflush(stdout);
+  if (!ok) fail();
+}
+
+enum { Batch = 8 };		// rxBatch / txBatch
+enum { MaxSize = 512 };		// max. datagram size
+
+// bursts straddle the batch size
+static const unsigned bursts[] = { 1, 7, 8, 9, 13, 16, 20, 3 };
+enum { NBursts = sizeof(bursts) / sizeof(bursts[0]) };
+enum { N = 77 };		// total datagrams
+
+// datagram length and content are derived from the seqNo
+unsigned msgSize(unsigned seqNo) { return 8 + (seqNo * 37) % 300; }
+void msgFill(uint8_t *ptr, unsigned seqNo) {
+  unsigned n = msgSize(seqNo);
+  memcpy(ptr, &seqNo, 4);
+  for (unsigned i = 4; i < n; i++) ptr[i] = (seqNo + i) & 0xff;
+}
+bool msgVerify(const uint8_t *ptr, unsigned n, unsigned seqNo) {
+  if (n != msgSize(seqNo)) return false;
+  unsigned seqNo_;
+  memcpy(&seqNo_, ptr, 4);
+  if (seqNo_ != seqNo) return false;
+  for (unsigned i = 4; i < n; i++)
+    if (ptr[i] != ((seqNo + i) & 0xff)) return false;
+  return true;
+}
+
+class Mx;
+
+// the client sends bursts of datagrams, the server echoes each datagram
+// to its source address; the server's socket is unconnected
+class Connection : public ZiConnection {
+public:
+  Connection(Mx *mx, const ZiCxnInfo &ci, bool client);
+
+  Mx *mx() { return reinterpret_cast<Mx *>(ZiConnection::mx()); }
+
+  void connected(ZiIOContext &io);
+  void disconnected();
+
+  bool recvd(ZiIOContext &io);
+
+  // Tx thread - stage datagrams [seqNo, seqNo + n)
+  void burst(unsigned seqNo, unsigned n) {
+    for (unsigned i = 0; i < n; i++) {
+      msgFill(m_txBufs[seqNo + i].data(), seqNo + i);
+      m_txLens[seqNo + i] = msgSize(seqNo + i);
+      send_(ZiIOFn::Member<&Connection::send__>::fn(this));
+    }
+  }
+
+  bool send__(ZiIOContext &io) {
+    unsigned i = m_txNext++;
+    if (m_client)
+      io.init(ZiIOFn::Member<&Connection::sent>::fn(this),
+	  m_txBufs[i].data(), m_txLens[i], 0);
+    else
+      io.init(ZiIOFn::Member<&Connection::sent>::fn(this),
+	  m_txBufs[i].data(), m_txLens[i], 0, m_txAddrs[i]);
+    return true;
+  }
+  bool sent(ZiIOContext &io) {
+    io.complete();
+    return true;
+  }
+
+  unsigned received() const { return m_rxCount; }
+  bool ok() const { return m_ok; }
+
+private:
+  bool			m_client;
+  bool			m_ok = true;
+  unsigned		m_rxCount = 0;	// Rx thread
+  unsigned		m_txNext = 0;	// Tx thread
+  ZtArray<uint8_t>	m_rxBuf;
+  ZtArray<uint8_t>	m_txBufs[N];
+  unsigned		m_txLens[N];
+  ZiSockAddr		m_txAddrs[N];
+};
+
+class Mx : public ZiMultiplex {
+public:
+  Mx(ZiMxParams params) : ZiMultiplex{ZuMv(params)} { }
+
+  void udp(bool client, unsigned localPort, unsigned remotePort) {
+    ZiMultiplex::udp(
+	client ?
+	  ZiConnectFn::Member<&Mx::connectedClient>::fn(this) :
+	  ZiConnectFn::Member<&Mx::connectedServer>::fn(this),
+	ZiFailFn::Member<&Mx::failed>::fn(this),
+	ZiIP{"127.0.0.1"}, localPort,
+	client ? ZiIP{"127.0.0.1"} : ZiIP{}, remotePort,
+	ZiCxnOptions{}.udp(true).batch(true));
+  }
+  ZiConnection *connectedClient(const ZiCxnInfo &ci) {
+    return m_client = new Connection(this, ci, true);
+  }
+  ZiConnection *connectedServer(const ZiCxnInfo &ci) {
+    return m_server = new Connection(this, ci, false);
+  }
+  void failed(bool) {
+    fprintf(stderr, "udp failed\n");
+    fail();
+  }
+
+  ZmRef<Connection>	m_client;
+  ZmRef<Connection>	m_server;
+  ZmSemaphore		m_connected;
+  ZmSemaphore		m_disconnected;
+  ZmSemaphore		m_echoed;	// client received all of a burst
+  unsigned		m_expected = 0;	// client datagrams expected
+};
+
+Connection::Connection(Mx *mx, const ZiCxnInfo &ci, bool client) :
+  ZiConnection{mx, ci}, m_client{client}
+{
+  m_rxBuf.length(MaxSize);
+  for (unsigned i = 0; i < N; i++) m_txBufs[i].length(MaxSize);
+}
+
+void Connection::connected(ZiIOContext &io)
+{
+  io.init(ZiIOFn::Member<&Connection::recvd>::fn(this),
+      m_rxBuf.data(), m_rxBuf.length(), 0);
+  mx()->m_connected.post();
+}
+
+void Connection::disconnected()
+{
+  mx()->m_disconnected.post();
+}
+
+bool Connection::recvd(ZiIOContext &io)
+{
+  unsigned seqNo = m_rxCount++;
+  if (seqNo >= N || !msgVerify(m_rxBuf.data(), io.length, seqNo)) {
+    m_ok = false;
+    if (m_client) mx()->m_echoed.post();
+    return true;
+  }
+  if (!m_client) {
+    memcpy(m_txBufs[seqNo].data(), m_rxBuf.data(), io.length);
+    m_txLens[seqNo] = io.length;
+    m_txAddrs[seqNo] = io.addr;
+    send(ZiIOFn::Member<&Connection::send__>::fn(this));
+  } else if (m_rxCount == mx()->m_expected)
+    mx()->m_echoed.post();
+  return true;
+}
+
+int main()
+{
+  ZeLog::init("ZiMxUDPBatchTest");
+  ZeLog::level(0);
+  ZeLog::sink(ZeLog::fileSink(ZeSinkOptions{}.path("&2")));
+  ZeLog::start();
+
+  ZiMxParams params;
+  params.scheduler([](auto &s) { s.id("mx"); });
+  params.rxBatch(Batch).txBatch(Batch);
+  Mx mx{ZuMv(params)};
+  check(mx.start());
+
+  mx.udp(false, 27421, 0);
+  mx.m_connected.wait();
+  mx.udp(true, 27422, 27421);
+  mx.m_connected.wait();
+  check(!!mx.m_client && !!mx.m_server);
+
+  ZiMxTelemetry before;
+  mx.telemetry(before);
+
+  unsigned seqNo = 0;
+  for (unsigned i = 0; i < NBursts; i++) {
+    unsigned n = bursts[i];
+    mx.m_expected = seqNo + n;
+
+    // stall the Rx thread while the burst is sent and flushed, so that
+    // the server receives it with as few recvmmsg() calls as possible
+    ZmSemaphore stalled, resume;
+    mx.rxRun([&stalled, &resume]() { stalled.post(); resume.wait(); });
+    stalled.wait();
+    {
+      ZmSemaphore flushed;
+      mx.txRun([client = mx.m_client, seqNo, n]() {
+	client->burst(seqNo, n);
+      });
+      mx.txRun([&flushed]() { flushed.post(); }); // behind the flush
+      flushed.wait();
+    }
+    resume.post();
+
+    mx.m_echoed.wait();
+    check(mx.m_server->ok() && mx.m_client->ok());
+    check(mx.m_server->received() == seqNo + n);
+    check(mx.m_client->received() == seqNo + n);
+    seqNo += n;
+  }
+  check(seqNo == N);
+
+  ZiMxTelemetry after;
+  mx.telemetry(after);
+
+  // all datagrams were sent and received in batches of up to Batch,
+  // and partial batches followed full batches
+  auto count = [](const ZiMxTelemetry &t, bool tx) {
+    return tx ?
+      (t.txBatch1 + t.txBatch4 + t.txBatch16 + t.txBatch64) :
+      (t.rxBatch1 + t.rxBatch4 + t.rxBatch16 + t.rxBatch64);
+  };
+  printf("rx: %u %u %u %u tx: %u %u %u %u\n",
+      unsigned(after.rxBatch1 - before.rxBatch1),
+      unsigned(after.rxBatch4 - before.rxBatch4),
+      unsigned(after.rxBatch16 - before.rxBatch16),
+      unsigned(after.rxBatch64 - before.rxBatch64),
+      unsigned(after.txBatch1 - before.txBatch1),
+      unsigned(after.txBatch4 - before.txBatch4),
+      unsigned(after.txBatch16 - before.txBatch16),
+      unsigned(after.txBatch64 - before.txBatch64));
+  check(after.txBatch16 > before.txBatch16);	// full client batches
+  check(after.rxBatch16 > before.rxBatch16);	// full server batches
+  check(after.txBatch64 == before.txBatch64);
+  check(after.rxBatch64 == before.rxBatch64);
+  check(count(after, true) - count(before, true) < 2 * N);
+  check(count(after, false) - count(before, false) < 2 * N);
+
+  mx.m_client->close();
+  mx.m_server->close();
+  mx.m_disconnected.wait();
+  mx.m_disconnected.wait();
+  mx.m_client = nullptr;
+  mx.m_server = nullptr;
+
+  mx.stop();
+
+  ZeLog::stop();
+}
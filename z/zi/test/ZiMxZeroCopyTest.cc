@@ -0,0 +1,327 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// zero-copy send and splice() relay test (Linux epoll)
+// - MSG_ZEROCOPY - pinned buffers outlive their sends, and are released
+//   once the kernel's completions are drained from the socket error queue
+// - fallback - without SO_ZEROCOPY (as on kernels lacking support), sends
+//   are copied and pinned buffers are released as soon as they are sent
+// - splice() - a zero-copy sender relayed through a pair of connections
+// - io_uring - zero-copy connections fall back to copying sends
+
+#include <zlib/ZuLib.hh>
+
+#include <stdio.h>
+
+#include <zlib/ZmAtomic.hh>
+#include <zlib/ZmPolymorph.hh>
+#include <zlib/ZmSemaphore.hh>
+
+#include <zlib/ZtArray.hh>
+
+#include <zlib/ZeLog.hh>
+
+#include <zlib/ZiMultiplex.hh>
+
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+
+void fail()
+{
+  Zm::exit(1);
+}
+#define check(x) check_(x, __LINE__, #x)
+void check_(bool ok, unsigned line, const char *exp)
+{
+  printf("%s %6d %s\n", ok ? " OK " : "NOK ", line, exp);
+  fflush(stdout);
+  if (!ok) fail();
+}
+
+enum { Port = 27431 };
+enum { K = 8 };			// buffers per run
+enum { Size = 65536 };		// buffer size (>= zeroCopyMin)
+
+// byte at stream offset o
+uint8_t pattern(uint64_t o) { return o % 251; }
+
+// released buffers - Tx thread
+bool freed[K];
+ZmAtomic<unsigned> released;
+
+// buffer pinned by each send
+struct Buf : public ZmPolymorph {
+  unsigned		k;
+  ZtArray<uint8_t>	data;
+
+  Buf(unsigned k_, uint64_t offset) : k{k_} {
+    data.length(Size);
+    for (unsigned i = 0; i < Size; i++) data[i] = pattern(offset + i);
+  }
+  ~Buf() { freed[k] = true; ++released; }
+};
+
+class Mx;
+
+class Connection : public ZiConnection {
+public:
+  Connection(Mx *mx, const ZiCxnInfo &ci);
+
+  Mx *mx() { return reinterpret_cast<Mx *>(ZiConnection::mx()); }
+
+  void connected(ZiIOContext &io);
+  void disconnected() { }
+
+  bool recvd(ZiIOContext &io);
+
+  // send K buffers, each pinned until it is released
+  void sendAll() {
+    m_txNext = m_sent = m_retained = 0;
+    for (unsigned k = 0; k < K; k++) {
+      freed[k] = false;
+      m_bufs[k] = new Buf{k, m_txBytes};
+      m_txBytes += Size;
+    }
+    for (unsigned k = 0; k < K; k++)
+      send(ZiIOFn::Member<&Connection::sendBuf>::fn(this));
+  }
+  bool sendBuf(ZiIOContext &io) {
+    auto buf = ZuMv(m_bufs[m_txNext++]);
+    io.init(ZiIOFn::Member<&Connection::sentBuf>::fn(this),
+	buf->data.data(), buf->data.length(), 0);
+    io.pin = ZuMv(buf);
+    return true;
+  }
+  bool sentBuf(ZiIOContext &io);
+
+  uint64_t received() const { return m_rxBytes; }
+  bool ok() const { return m_ok; }
+  unsigned retained() const { return m_retained; }
+
+private:
+  ZtArray<uint8_t>	m_rxBuf;
+  uint64_t		m_rxBytes = 0;	// Rx thread
+  bool			m_ok = true;	// Rx thread
+  ZmRef<const Buf>	m_bufs[K];
+  uint64_t		m_txBytes = 0;	// Tx thread
+  unsigned		m_txNext = 0;	// Tx thread
+  unsigned		m_sent = 0;	// Tx thread
+  unsigned		m_retained = 0;	// Tx thread
+};
+
+class Mx : public ZiMultiplex {
+public:
+  Mx(ZiMxParams params, unsigned port) :
+    ZiMultiplex{ZuMv(params)}, m_port{port} { }
+
+  void listen() {
+    ZiMultiplex::listen(
+	ZiListenFn::Member<&Mx::listening>::fn(this),
+	ZiFailFn::Member<&Mx::failed>::fn(this),
+	ZiConnectFn::Member<&Mx::accepted>::fn(this),
+	ZiIP{"127.0.0.1"}, m_port, 8);
+    m_up.wait();
+  }
+  void listening(const ZiListenInfo &) { m_up.post(); }
+
+  // connect, returning once both ends are up
+  void connect(ZiCxnOptions options) {
+    ZiMultiplex::connect(
+	ZiConnectFn::Member<&Mx::connected>::fn(this),
+	ZiFailFn::Member<&Mx::failed>::fn(this),
+	ZiIP{}, 0, ZiIP{"127.0.0.1"}, m_port, ZuMv(options));
+    m_up.wait();
+    m_up.wait();
+  }
+  ZiConnection *accepted(const ZiCxnInfo &ci) {
+    return m_server = new Connection(this, ci);
+  }
+  ZiConnection *connected(const ZiCxnInfo &ci) {
+    return m_client = new Connection(this, ci);
+  }
+  void failed(bool) {
+    fprintf(stderr, "listen / connect failed\n");
+    fail();
+  }
+
+  // wait for a condition, polling for up to 5 seconds
+  template <typename Cond> static bool poll(Cond cond) {
+    for (unsigned i = 0; i < 500; i++) {
+      if (cond()) return true;
+      Zm::sleep(.01);
+    }
+    return cond();
+  }
+
+  unsigned		m_port;
+  ZmRef<Connection>	m_client;
+  ZmRef<Connection>	m_server;
+  ZmSemaphore		m_up;
+  ZmSemaphore		m_sent;		// all buffers sent
+};
+
+Connection::Connection(Mx *mx, const ZiCxnInfo &ci) :
+  ZiConnection{mx, ci}
+{
+  m_rxBuf.length(Size);
+}
+
+void Connection::connected(ZiIOContext &io)
+{
+  io.init(ZiIOFn::Member<&Connection::recvd>::fn(this),
+      m_rxBuf.data(), m_rxBuf.length(), 0);
+  mx()->m_up.post();
+}
+
+bool Connection::recvd(ZiIOContext &io)
+{
+  for (unsigned i = 0; i < io.length; i++)
+    if (m_rxBuf[i] != pattern(m_rxBytes + i)) m_ok = false;
+  m_rxBytes += io.length;
+  return true;
+}
+
+bool Connection::sentBuf(ZiIOContext &io)
+{
+  if ((io.offset += io.length) < io.size) return true;
+  unsigned k = static_cast<const Buf *>(io.pin.ptr())->k;
+  io.complete();
+  // a zero-copy completion is forwarded to the Tx thread, so cannot be
+  // processed before the send itself completes
+  if (!freed[k]) ++m_retained;
+  if (++m_sent == K) mx()->m_sent.post();
+  return true;
+}
+
+// send K buffers from client to sink, returning the number retained
+// after they were sent
+unsigned run(Mx &mx, Connection *client, Connection *sink)
+{
+  uint64_t base = sink->received();
+  released = 0;
+  mx.txRun([client = ZmMkRef(client)]() { client->sendAll(); });
+  mx.m_sent.wait();
+  unsigned retained = 0;
+  {
+    ZmSemaphore sem;
+    mx.txRun([client = ZmMkRef(client), &retained, &sem]() {
+      retained = client->retained();
+      sem.post();
+    });
+    sem.wait();
+  }
+  check(Mx::poll([sink, base]() {
+    return sink->received() - base >= uint64_t(K) * Size;
+  }));
+  check(sink->received() - base == uint64_t(K) * Size);
+  check(sink->ok());
+  check(Mx::poll([]() { return released == K; }));
+  return retained;
+}
+
+int main()
+{
+  ZeLog::init("ZiMxZeroCopyTest");
+  ZeLog::level(0);
+  ZeLog::sink(ZeLog::fileSink(ZeSinkOptions{}.path("&2")));
+  ZeLog::start();
+
+  ZiMxParams params;
+  params.scheduler([](auto &s) { s.id("mx"); });
+  params.zeroCopyMin(Size);
+#ifdef ZiMultiplex_IOURing
+  params.uring(false);
+#endif
+  Mx mx{ZuMv(params), Port};
+  check(mx.start());
+
+  mx.listen();
+
+  // zero-copy - every buffer is retained until its completion is drained
+  // from the error queue
+  {
+    mx.connect(ZiCxnOptions{}.zeroCopy(true));
+    ZmRef<Connection> client = ZuMv(mx.m_client);
+    ZmRef<Connection> server = ZuMv(mx.m_server);
+    unsigned retained = run(mx, client, server);
+    printf("zero-copy: %u/%u retained\n", retained, unsigned(K));
+    check(retained == K);
+    client->close();
+    server->close();
+  }
+
+  // fallback - SO_ZEROCOPY is disabled before the first send, as though
+  // unsupported by the kernel; sends are copied, buffers are not retained
+  {
+    mx.connect(ZiCxnOptions{}.zeroCopy(true));
+    ZmRef<Connection> client = ZuMv(mx.m_client);
+    ZmRef<Connection> server = ZuMv(mx.m_server);
+    int b = 0;
+    check(setsockopt(client->info().socket, SOL_SOCKET, SO_ZEROCOPY,
+	  &b, sizeof(int)) == 0);
+    unsigned retained = run(mx, client, server);
+    printf("fallback: %u/%u retained\n", retained, unsigned(K));
+    check(retained == 0);
+    client->close();
+    server->close();
+  }
+
+  // splice() - source -> relay -> peer -> sink
+  {
+    mx.connect(ZiCxnOptions{}.zeroCopy(true));
+    ZmRef<Connection> source = ZuMv(mx.m_client);
+    ZmRef<Connection> relay = ZuMv(mx.m_server);
+    mx.connect(ZiCxnOptions{});
+    ZmRef<Connection> sink = ZuMv(mx.m_client);
+    ZmRef<Connection> peer = ZuMv(mx.m_server);
+    relay->splice(peer);
+    {
+      ZmSemaphore sem;
+      mx.rxRun([&sem]() { sem.post(); });
+      sem.wait();
+    }
+    run(mx, source, sink);
+    run(mx, source, sink);
+    check(relay->received() == 0); // bypassed the receive context
+    check(peer->received() == 0);
+    source->close();
+    check(Mx::poll([&relay]() { return !relay->up(); }));
+    peer->close();
+    sink->close();
+  }
+
+  mx.stop();
+
+#ifdef ZiMultiplex_IOURing
+  // io_uring - completions are never drained from the error queue, so
+  // zero-copy connections copy their sends, and buffers are not retained
+  {
+    ZiMxParams params;
+    params.scheduler([](auto &s) { s.id("mx_uring"); });
+    params.zeroCopyMin(Size);
+    params.uring(true);
+    Mx mx{ZuMv(params), Port + 1};
+    check(mx.start());
+    if (!mx.uring())
+      printf("io_uring: unavailable, skipped\n");
+    else {
+      mx.listen();
+      mx.connect(ZiCxnOptions{}.zeroCopy(true));
+      ZmRef<Connection> client = ZuMv(mx.m_client);
+      ZmRef<Connection> server = ZuMv(mx.m_server);
+      unsigned retained = run(mx, client, server);
+      printf("io_uring: %u/%u retained\n", retained, unsigned(K));
+      check(retained == 0);
+      client->close();
+      server->close();
+    }
+    mx.stop();
+  }
+#endif
+
+  ZeLog::stop();
+}
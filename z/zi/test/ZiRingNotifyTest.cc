@@ -0,0 +1,191 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// ring buffer notification test - ZmRing and ZiRing readers serviced
+// by the ZiMultiplex Rx thread
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <zlib/ZmRing.hh>
+#include <zlib/ZmSemaphore.hh>
+#include <zlib/ZmThread.hh>
+
+#include <zlib/ZiRing.hh>
+#include <zlib/ZiMultiplex.hh>
+
+void fail()
+{
+  Zm::exit(1);
+}
+#define check(x) check_(x, __LINE__, #x)
+void check_(bool ok, unsigned line, const char *exp)
+{
+  printf("%s %6d %s\n", ok ? " OK " : "NOK ", line, exp);
+  fflush(stdout);
+  if (!ok) fail();
+}
+
+struct Msg {
+  uint64_t	seqNo;
+};
+
+enum { N = 1000000 };
+
+template <typename Ring>
+struct Reader {
+  Ring		ring;
+  unsigned	count = 0;
+  unsigned	wakes = 0;
+  bool		ok = true;
+  bool		eof = false;
+  ZmSemaphore	done;
+
+  Reader(const Ring &ring_) : ring{ring_} { }
+
+  // called from the Rx thread - consume notifications before draining,
+  // the final shift() re-arms the ring
+  void drain() {
+    ++wakes;
+    ring.notified();
+    while (const Msg *msg = ring.shift()) {
+      if (msg->seqNo != count) ok = false;
+      ++count;
+      ring.shift2();
+    }
+    if (!eof && ring.readStatus() == Zu::EndOfFile) {
+      eof = true;
+      done.post();
+    }
+  }
+};
+
+template <typename Ring, typename Params>
+void run(ZiMultiplex &mx, const char *name, Params params)
+{
+  Ring ring{ZuMv(params)};
+  check(ring.open(0) == Zu::OK);
+  ring.reset();
+
+  Reader<Ring> reader{ring};
+  check(reader.ring.open(Ring::Read) == Zu::OK);
+  if constexpr (Ring::MR) check(reader.ring.attach() == Zu::OK);
+  int fd = reader.ring.notifyFD();
+  check(fd >= 0);
+  check(!reader.ring.shift()); // arm
+
+  mx.addReadable(fd, [&reader]() { reader.drain(); });
+
+  ZuTime begin = Zm::now();
+  ZmThread writer{[&ring]() {
+    Ring writer{ring};
+    if (writer.open(Ring::Write) != Zu::OK) return;
+    for (unsigned i = 0; i < N; i++) {
+      void *ptr = writer.push();
+      if (!ptr) break;
+      new (ptr) Msg{i};
+      writer.push2();
+    }
+    writer.eof();
+    writer.close();
+  }};
+  writer.join();
+  reader.done.wait();
+  ZuTime elapsed = Zm::now() - begin;
+
+  {
+    ZmSemaphore sem;
+    mx.delReadable(fd, [&sem]() { sem.post(); });
+    sem.wait();
+  }
+
+  check(reader.count == N);
+  check(reader.ok);
+  printf("%s: %u msgs %u wakes %.2fns/msg\n", name, reader.count,
+      reader.wakes, double(elapsed.nanosecs()) / double(N));
+
+  if constexpr (Ring::MR) reader.ring.detach();
+  reader.ring.close();
+  ring.close();
+}
+
+// delReadable() called from within the callback, with the other
+// readable's event pending in the same batch - its callback must not be
+// called, and neither readable may be freed while still referenced
+void selfDel(ZiMultiplex &mx)
+{
+  int fds[2][2];
+  check(pipe2(fds[0], O_NONBLOCK) == 0);
+  check(pipe2(fds[1], O_NONBLOCK) == 0);
+
+  unsigned calls = 0;
+  bool ok = true;
+  ZmSemaphore sem;
+
+  for (unsigned i = 0; i < 2; i++)
+    mx.addReadable(fds[i][0],
+      [&mx, &fds, &calls, &ok, &sem, fd = fds[i][0], magic = 42U]() {
+	char c;
+	if (read(fd, &c, 1) != 1) return; // called upon registration
+	++calls;
+	mx.delReadable(fds[0][0]);
+	mx.delReadable(fds[1][0]);
+	if (magic != 42U) ok = false; // captures must remain intact
+	sem.post();
+      });
+
+  // write to both pipes from the Rx thread, so that both events are
+  // returned by the same wait
+  mx.rxRun([&fds]() {
+    check(write(fds[0][1], "", 1) == 1);
+    check(write(fds[1][1], "", 1) == 1);
+  });
+  sem.wait();
+
+  // process any remaining events and deferred releases
+  for (unsigned i = 0; i < 2; i++) {
+    mx.rxRun([&sem]() { sem.post(); });
+    sem.wait();
+  }
+
+  check(calls == 1);
+  check(ok);
+
+  for (unsigned i = 0; i < 2; i++) { close(fds[i][0]); close(fds[i][1]); }
+}
+
+int main()
+{
+  using ZmRing_ = ZmRing<ZmRingT<Msg>>;
+  using ZiRing_ = ZiRing<ZmRingT<Msg>>;
+
+  for (unsigned uring = 0; uring < 2; uring++) {
+    ZiMxParams params;
+    params.scheduler([](auto &s) { s.id("mx"); });
+#ifdef ZiMultiplex_IOURing
+    params.uring(uring);
+#else
+    if (uring) break;
+#endif
+    ZiMultiplex mx{ZuMv(params)};
+    check(mx.start());
+#ifdef ZiMultiplex_IOURing
+    if (uring && !mx.uring()) { mx.stop(); break; }
+#endif
+    puts(uring ? "io_uring" : "epoll");
+
+    run<ZmRing_>(mx, "ZmRing",
+	ZmRingParams{}.size(65536).notify(true));
+    run<ZiRing_>(mx, "ZiRing",
+	ZiRingParams{"ZiRingNotifyTest"}.size(65536).notify(true));
+
+    selfDel(mx);
+
+    mx.stop();
+  }
+}
@@ -34,6 +34,7 @@
 #define ZmAtomic_store(ptr, val) __atomic_store_n(ptr, val, __ATOMIC_RELAXED)
 #define ZmAtomic_acquire() __atomic_thread_fence(__ATOMIC_ACQUIRE)
 #define ZmAtomic_release() __atomic_thread_fence(__ATOMIC_RELEASE)
+#define ZmAtomic_fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
 #endif
 
 #ifdef _MSC_VER
@@ -46,6 +47,7 @@
 	val, std::memory_order_relaxed))
 #define ZmAtomic_acquire() std::atomic_thread_fence(std::memory_order_acquire)
 #define ZmAtomic_release() std::atomic_thread_fence(std::memory_order_release)
+#define ZmAtomic_fence() std::atomic_thread_fence(std::memory_order_seq_cst)
 #endif
 
 // Atomic Operations (compare and exchange, etc.)
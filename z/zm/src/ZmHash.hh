@@ -61,6 +61,7 @@ template <typename Lock> class ZmHash_LockMgr {
 protected:
   ZmHash_LockMgr(const ZmHashParams &p) :
       m_bits{p.bits()   < 2 ? 2 : p.bits()  > 28 ? 28 : p.bits()},
+      m_incremental{p.incremental()},
       m_cBits{p.cBits() < 0 ? 0 : p.cBits() > 12 ? 12 : p.cBits()} {
     if (m_cBits > m_bits) m_cBits = m_bits;
     unsigned n = 1U<<m_cBits;
@@ -92,7 +93,11 @@ protected:
   Lock &lockCode(uint32_t code) const {
     return lockSlot(ZmHash_Bits::hashBits(code, m_bits));
   }
+  // incremental resize stripes locks by the low bits of the slot, which
+  // are invariant across resizes - old slot i and new slots i and
+  // i + (1<<oldBits) share a lock
   Lock &lockSlot(unsigned slot) const {
+    if (m_incremental) return lock_(slot & ((1U<<m_cBits) - 1));
     return lock_(slot>>(m_bits - m_cBits));
   }
 
@@ -118,6 +123,7 @@ protected:
 
 protected:
   unsigned	m_bits;
+  bool		m_incremental;
 private:
   unsigned	m_cBits;
   mutable void	*m_locks;
@@ -126,7 +132,8 @@ private:
 template <> class ZmHash_LockMgr<ZmNoLock> {
 protected:
   ZmHash_LockMgr(const ZmHashParams &p) :
-      m_bits{p.bits() < 2 ? 2 : p.bits() > 28 ? 28 : p.bits()} { }
+      m_bits{p.bits() < 2 ? 2 : p.bits() > 28 ? 28 : p.bits()},
+      m_incremental{p.incremental()} { }
   ~ZmHash_LockMgr() { }
 
 public:
@@ -149,6 +156,7 @@ protected:
 
 protected:
   unsigned	m_bits;
+  bool		m_incremental;
 private:
   ZmNoLock	m_noLock;
 };
@@ -305,6 +313,7 @@ private:
   using LockMgr::unlockAll;
 
   using LockMgr::m_bits;
+  using LockMgr::m_incremental;
 
 public:
   unsigned bits() const { return m_bits; }
@@ -512,6 +521,7 @@ private:
     m_table = static_cast<NodePtr *>(
 	Zm::alignedAlloc(sizeof(NodePtr)<<m_bits, Zm::CacheLineSize));
     memset(m_table, 0, sizeof(NodePtr)<<m_bits);
+    if (m_incremental) m_cursors = new unsigned[1U<<cBits()];
     ZmHashMgr::add(this);
   }
 
@@ -533,6 +543,7 @@ public:
     ZmHashMgr::del(this);
     clean();
     Zm::alignedFree(m_table);
+    delete [] m_cursors;
   }
 
   unsigned loadFactor_() const { return m_loadFactor; }
@@ -590,6 +601,8 @@ private:
 
     unsigned slot = ZmHash_Bits::hashBits(code, m_bits);
 
+    if (ZuUnlikely(m_pending.load_())) migrate(slot);
+
     node->NodeExt::next = m_table[slot];
     m_table[slot] = ZuMv(node);
     m_count.store_(count + 1);
@@ -740,6 +753,15 @@ private:
   template <typename Match>
   Node *find_(Match match, uint32_t code) const {
     Node *node;
+
+    if (ZuUnlikely(m_pending.load_())) {
+      node = m_old[ZmHash_Bits::hashBits(code, m_bits - 1)];
+      if (node != Migrated()) {
+	for (; node && !match(node); node = node->NodeExt::next);
+	return node;
+      }
+    }
+
     unsigned slot = ZmHash_Bits::hashBits(code, m_bits);
 
     for (node = m_table[slot];
@@ -776,6 +798,8 @@ private:
     Node *node;
     unsigned slot = ZmHash_Bits::hashBits(code, m_bits);
 
+    if (ZuUnlikely(m_pending.load_())) migrate(slot);
+
     for (node = m_table[slot];
 	 node && !equals(node->Node::key(), KeyAxor(data));
 	 node = node->NodeExt::next);
@@ -858,6 +882,8 @@ private:
     Node *node, *prevNode = nullptr;
     unsigned slot = ZmHash_Bits::hashBits(code, m_bits);
 
+    if (ZuUnlikely(m_pending.load_())) migrate(slot);
+
     for (node = m_table[slot];
 	 node && !match(node);
 	 prevNode = node, node = node->NodeExt::next);
@@ -903,6 +929,7 @@ private:
 
     LockTraits::lock(lockCode(code));
     iterator.m_slot = ZmHash_Bits::hashBits(code, m_bits);
+    if (ZuUnlikely(m_pending.load_())) migrate(iterator.m_slot);
     iterator.m_node = nullptr;
     iterator.m_prev = nullptr;
   }
@@ -916,7 +943,7 @@ private:
 
     if (!node) {
       prevNode = nullptr;
-      node = m_table[slot];
+      node = head(slot);
     } else {
       prevNode = node;
       node = node->NodeExt::next;
@@ -932,12 +959,18 @@ private:
 	}
 	LockTraits::lock(lockSlot(slot));
 	iterator.m_slot = slot;
-      } while (!(node = m_table[slot]));
+      } while (!(node = head(slot)));
     }
 
     iterator.m_prev = prevNode;
     return iterator.m_node = node;
   }
+  // returns the head of a slot's chain during iteration, first migrating
+  // the corresponding old bucket if an incremental resize is in progress
+  Node *head(unsigned slot) {
+    if (ZuUnlikely(m_pending.load_())) migrate(slot);
+    return m_table[slot];
+  }
   template <typename I>
   Node *keyIterate(I &iterator) {
     int slot = iterator.m_slot;
@@ -998,6 +1031,9 @@ public:
   void clean() {
     lockAll();
 
+    // an incremental resize in progress runs to completion first
+    migrateAll();
+
     for (unsigned i = 0, n = (1U<<m_bits); i < n; i++) {
       Node *node, *prevNode;
 
@@ -1038,6 +1074,8 @@ public:
 
 private:
   void resize(unsigned bits) {
+    if (m_incremental) { resizeIncr(bits); return; }
+
     if (!lockAllResize(bits)) return;
 
     m_resized.store_(m_resized.load_() + 1);
@@ -1065,11 +1103,95 @@ private:
     unlockAll();
   }
 
+  // incremental resize - the old table is retained and drained a few
+  // buckets at a time by subsequent updates; lookups search whichever
+  // table holds the key; new slots i and i + (1<<oldBits) are initialized
+  // when old bucket i is migrated, so the new table need not be cleared
+  // up front; only the table swap itself is performed with all locks held
+  //
+  // each update only migrates buckets within the stripe whose lock it
+  // already holds, so no further locks are ever acquired; a stripe's
+  // buckets are claimed in order by its cursor; any buckets remaining
+  // unmigrated when the table is next resized are migrated then
+  enum { MigrateBatch = 4 };	// buckets migrated per update
+
+  // sentinel marking a migrated old bucket
+  static Node *Migrated() {
+    return reinterpret_cast<Node *>(static_cast<uintptr_t>(1));
+  }
+
+  void resizeIncr(unsigned bits) {
+    NodePtr *table = static_cast<NodePtr *>(
+	Zm::alignedAlloc(sizeof(NodePtr)<<bits, Zm::CacheLineSize));
+
+    if (!lockAllResize(bits)) { Zm::alignedFree(table); return; }
+
+    m_resized.store_(m_resized.load_() + 1);
+
+    migrateAll();
+
+    m_old = m_table;
+    m_table = table;
+    m_bits = bits;
+    memset(m_cursors, 0, sizeof(unsigned)<<cBits());
+    m_pending.store_(1U<<(bits - 1));
+
+    unlockAll();
+  }
+
+  // migrate the old bucket corresponding to new slot, followed by
+  // up to MigrateBatch more from the same stripe (slot's lock is held)
+  void migrate(unsigned slot) {
+    unsigned n = 1U<<(m_bits - 1);
+    unsigned stripe = slot & ((1U<<cBits()) - 1);
+    migrateSlot(slot & (n - 1));
+    unsigned &cursor = m_cursors[stripe];
+    for (unsigned k = 0; k < MigrateBatch; ) {
+      unsigned i = (cursor<<cBits()) | stripe;
+      if (i >= n) return;
+      ++cursor;
+      if (migrateSlot(i)) ++k;
+    }
+  }
+
+  // migrate old bucket i to the new table (lock for slot i is held);
+  // returns false if already migrated
+  bool migrateSlot(unsigned i) {
+    Node *node = m_old[i], *nextNode;
+    if (node == Migrated()) return false;
+    m_old[i] = Migrated();
+    m_table[i] = m_table[i + (1U<<(m_bits - 1))] = nullptr;
+    for (; node; node = nextNode) {
+      nextNode = node->NodeExt::next;
+      unsigned j = ZmHash_Bits::hashBits(
+	  HashFn::hash(node->Node::key()), m_bits);
+      node->NodeExt::next = m_table[j];
+      m_table[j] = node;
+    }
+    --m_pending;
+    return true;
+  }
+
+  // complete any incremental resize and release the old table (all
+  // locks are held)
+  void migrateAll() {
+    if (!m_old) return;
+    if (m_pending.load_())
+      for (unsigned i = 0, n = (1U<<(m_bits - 1)); i < n; i++)
+	migrateSlot(i);
+    Zm::alignedFree(m_old);
+    m_old = nullptr;
+  }
+
   Cmp			m_cmp;
   unsigned		m_loadFactor = 0;
   ZmAtomic<unsigned>	m_count = 0;
   ZmAtomic<unsigned>	m_resized = 0;
   NodePtr		*m_table;
+  // incremental resize
+  NodePtr		*m_old = nullptr;	// old table
+  unsigned		*m_cursors = nullptr;	// next old bucket, by stripe
+  ZmAtomic<unsigned>	m_pending = 0;		// old buckets not migrated
 };
 
 template <typename P0, typename P1, typename NTP = ZmHash_Defaults>
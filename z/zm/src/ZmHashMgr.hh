@@ -31,15 +31,20 @@ public:
   ZmHashParams &bits(unsigned v) { m_bits = v; return *this; }
   ZmHashParams &loadFactor(double v) { m_loadFactor = v; return *this; }
   ZmHashParams &cBits(unsigned v) { m_cBits = v; return *this; }
+  // incremental resize - buckets migrate a few at a time instead of
+  // the whole table being rehashed while all locks are held
+  ZmHashParams &incremental(bool v) { m_incremental = v; return *this; }
 
   unsigned bits() const { return m_bits; }
   double loadFactor() const { return m_loadFactor; }
   unsigned cBits() const { return m_cBits; }
+  bool incremental() const { return m_incremental; }
 
 private:
   unsigned	m_bits = 8;
   double	m_loadFactor = 1.0;
   unsigned	m_cBits = 3;
+  bool		m_incremental = false;
 };
 
 // display sequence:
@@ -7,6 +7,7 @@
 // block allocator with affinitized cache (free list) and statistics
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <zlib/ZmHeap.hh>
 
@@ -336,12 +337,18 @@ void ZmHeapCache::final_()
 {
   if (m_lookup)
     m_lookup->del(this);
+  for (ZmHeapMag *mag : { m_full, m_empty })
+    while (mag) {
+      ZmHeapMag *next = mag->next;
+      ::free(mag);
+      mag = next;
+    }
   if (m_begin)
     hwloc_free(ZmTopology::hwloc(),
 	m_begin, m_info.config.cacheSize * m_info.size);
 }
 
-void *ZmHeapCache::alloc(ZmHeapStats &stats)
+void *ZmHeapCache::alloc(ZmHeapStats &stats, ZmHeapMags &mags)
 {
 #ifdef ZmHeap_DEBUG
   {
@@ -349,6 +356,13 @@ void *ZmHeapCache::alloc(ZmHeapStats &stats)
     if (ZuUnlikely(fn = m_traceAllocFn)) (*fn)(m_info.id, m_info.size);
   }
 #endif
+  if (ZuLikely(mags.loaded || (magSize() && magInit(mags))))
+    if (ZuLikely(mags.loaded->count || magLoad(mags))) {
+      ++stats.cacheAllocs;
+      ++stats.magAllocs;
+      ZmHeapMag *mag = mags.loaded;
+      return mag->blocks()[--mag->count];
+    }
   void *p;
   if (ZuLikely(p = alloc_())) {
     ++stats.cacheAllocs;
@@ -360,7 +374,7 @@ void *ZmHeapCache::alloc(ZmHeapStats &stats)
   return p;
 }
 
-void ZmHeapCache::free(ZmHeapStats &stats, void *p)
+void ZmHeapCache::free(ZmHeapStats &stats, ZmHeapMags &mags, void *p)
 {
   if (ZuUnlikely(!p)) return;
 #ifdef ZmHeap_DEBUG
@@ -381,9 +395,21 @@ void ZmHeapCache::free(ZmHeapStats &stats, void *p)
   }
   // check own cache first - optimize for malloc()/free() within same partition
   if (ZuLikely(owned(p))) {
+    if (ZuLikely(mags.loaded || (magSize() && magInit(mags)))) {
+      if (ZuUnlikely(mags.loaded->count >= magSize())) magUnload(mags);
+      ++stats.magFrees;
+      ZmHeapMag *mag = mags.loaded;
+      mag->blocks()[mag->count++] = p;
+      return;
+    }
     free_(p);
     return;
   }
+  free__(p);
+}
+
+void ZmHeapCache::free__(void *p)
+{
   if (auto lookup = this->lookup())
     if (auto other = lookup->find(this, p)) {
       other->free_(p);
@@ -392,6 +418,189 @@ void ZmHeapCache::free(ZmHeapStats &stats, void *p)
   ::free(p);
 }
 
+void ZmHeapCache::allocN(
+    ZmHeapStats &stats, ZmHeapMags &mags, void **blocks, unsigned n)
+{
+#ifdef ZmHeap_DEBUG
+  {
+    TraceFn fn;
+    if (ZuUnlikely(fn = m_traceAllocFn))
+      for (unsigned i = 0; i < n; i++) (*fn)(m_info.id, m_info.size);
+  }
+#endif
+  unsigned i = 0;
+  if (mags.loaded || (magSize() && magInit(mags))) {
+    while (i < n && (mags.loaded->count || magLoad(mags))) {
+      ZmHeapMag *mag = mags.loaded;
+      unsigned j = n - i;
+      if (j > mag->count) j = mag->count;
+      mag->count -= j;
+      memcpy(blocks + i, mag->blocks() + mag->count, j * sizeof(void *));
+      i += j;
+    }
+    stats.magAllocs += i;
+  }
+  if (i < n) i += allocN_(blocks + i, n - i);
+  stats.cacheAllocs += i;
+  for (; i < n; i++) {
+    void *p = ::malloc(m_info.size);
+    if (ZuUnlikely(!p)) {
+      freeN(stats, mags, blocks, i);
+      throw std::bad_alloc{};
+    }
+    ++stats.heapAllocs;
+    blocks[i] = p;
+  }
+}
+
+void ZmHeapCache::freeN(
+    ZmHeapStats &stats, ZmHeapMags &mags, void **blocks, unsigned n)
+{
+#ifdef ZmHeap_DEBUG
+  {
+    TraceFn fn;
+    if (ZuUnlikely(fn = m_traceFreeFn))
+      for (unsigned i = 0; i < n; i++) (*fn)(m_info.id, m_info.size);
+  }
+#endif
+  bool magazine = mags.loaded || (magSize() && magInit(mags));
+  void *head = nullptr, *tail = nullptr; // chain of owned blocks
+  for (unsigned i = 0; i < n; i++) {
+    void *p = blocks[i];
+    if (ZuUnlikely(!p)) continue;
+    ++stats.frees;
+    if (ZuUnlikely(!owned(p))) {
+      if (m_info.sharded)
+	::free(p);
+      else
+	free__(p);
+      continue;
+    }
+    if (magazine) {
+      if (ZuUnlikely(mags.loaded->count >= magSize())) magUnload(mags);
+      ++stats.magFrees;
+      ZmHeapMag *mag = mags.loaded;
+      mag->blocks()[mag->count++] = p;
+      continue;
+    }
+    *reinterpret_cast<uintptr_t *>(p) = reinterpret_cast<uintptr_t>(head);
+    if (!head) tail = p;
+    head = p;
+  }
+  if (head) freeN_(head, tail); // single push of the whole chain
+}
+
+// magazines are allocated on first use by each thread; the depot
+// retains full magazines for other threads to load, and empty magazines
+// for re-use - the number of magazines is bounded by cacheSize / magSize
+
+bool ZmHeapCache::magInit(ZmHeapMags &mags)
+{
+  if (ZuUnlikely(!(mags.loaded = magAlloc()))) return false;
+  if (ZuUnlikely(!(mags.prev = magAlloc()))) {
+    ::free(mags.loaded);
+    mags.loaded = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void ZmHeapCache::magFinal(ZmHeapMags &mags)
+{
+  if (!mags.loaded) return;
+  unsigned size = magSize();
+  ZmHeapMag *mag[2] = { mags.loaded, mags.prev };
+  for (unsigned i = 0; i < 2; i++)
+    if (mag[i]->count < size) magDrain(mag[i]);
+  DepotGuard guard{m_depotLock};
+  for (unsigned i = 0; i < 2; i++)
+    if (mag[i]->count) {
+      mag[i]->next = m_full;
+      m_full = mag[i];
+    } else {
+      mag[i]->next = m_empty;
+      m_empty = mag[i];
+    }
+  mags.loaded = mags.prev = nullptr;
+}
+
+ZmHeapMag *ZmHeapCache::magAlloc()
+{
+  {
+    DepotGuard guard{m_depotLock};
+    if (ZmHeapMag *mag = m_empty) {
+      m_empty = mag->next;
+      mag->next = nullptr;
+      return mag;
+    }
+  }
+  void *p = ::malloc(sizeof(ZmHeapMag) + magSize() * sizeof(void *));
+  if (ZuUnlikely(!p)) return nullptr;
+  return new (p) ZmHeapMag{};
+}
+
+// called when the loaded magazine is empty
+bool ZmHeapCache::magLoad(ZmHeapMags &mags)
+{
+  if (mags.prev->count) { // previous is full - swap
+    ZmHeapMag *mag = mags.prev;
+    mags.prev = mags.loaded;
+    mags.loaded = mag;
+    return true;
+  }
+  {
+    DepotGuard guard{m_depotLock};
+    if (ZmHeapMag *mag = m_full) { // exchange empty previous for full
+      m_full = mag->next;
+      mags.prev->next = m_empty;
+      m_empty = mags.prev;
+      mags.prev = mags.loaded;
+      mags.loaded = mag;
+      mag->next = nullptr;
+      return true;
+    }
+  }
+  // depot is empty - refill from the free list in a single operation
+  ZmHeapMag *mag = mags.loaded;
+  mag->count = allocN_(mag->blocks(), magSize());
+  return mag->count;
+}
+
+// called when the loaded magazine is full
+void ZmHeapCache::magUnload(ZmHeapMags &mags)
+{
+  if (!mags.prev->count) { // previous is empty - swap
+    ZmHeapMag *mag = mags.prev;
+    mags.prev = mags.loaded;
+    mags.loaded = mag;
+    return;
+  }
+  ZmHeapMag *mag = magAlloc();
+  if (ZuUnlikely(!mag)) { // out of memory - return blocks to the free list
+    magDrain(mags.loaded);
+    return;
+  }
+  {
+    DepotGuard guard{m_depotLock};
+    mags.prev->next = m_full; // deposit full previous
+    m_full = mags.prev;
+  }
+  mags.prev = mags.loaded;
+  mags.loaded = mag;
+}
+
+void ZmHeapCache::magDrain(ZmHeapMag *mag)
+{
+  unsigned n = mag->count;
+  if (!n) return;
+  void **blocks = mag->blocks();
+  for (unsigned i = 1; i < n; i++)
+    *reinterpret_cast<uintptr_t *>(blocks[i - 1]) =
+      reinterpret_cast<uintptr_t>(blocks[i]);
+  freeN_(blocks[0], blocks[n - 1]);
+  mag->count = 0;
+}
+
 // stats() iterates over the ZmHeapCacheT instances using
 // ZmSpecific::all, compiling aggregate statistics from the
 // thread-specific instances
@@ -410,6 +619,8 @@ void ZmHeapCache::histStats(const ZmHeapStats &s) const
   m_histStats.heapAllocs += s.heapAllocs;
   m_histStats.cacheAllocs += s.cacheAllocs;
   m_histStats.frees += s.frees;
+  m_histStats.magAllocs += s.magAllocs;
+  m_histStats.magFrees += s.magFrees;
 }
 
 void ZmHeapCache::telemetry(ZmHeapTelemetry &data) const
@@ -421,7 +632,10 @@ void ZmHeapCache::telemetry(ZmHeapTelemetry &data) const
   data.cacheAllocs = m_stats.cacheAllocs;
   data.heapAllocs = m_stats.heapAllocs;
   data.frees = m_stats.frees;
+  data.magAllocs = m_stats.magAllocs;
+  data.magFrees = m_stats.magFrees;
   data.size = m_info.size;
+  data.magSize = magSize();
   data.partition = m_info.partition;
   data.sharded = m_info.sharded;
   data.alignment = m_info.config.alignment;
@@ -10,6 +10,7 @@
 // * optional partitions / sharding
 //   - fast partition lookup
 // * TLS free list
+// * optional per-thread magazines exchanged in bulk with a depot
 // * efficient statistics and telemetry (ZvTelemetry)
 // * globally configured
 //   - supports profile-guided optimization of heap configuration
@@ -48,6 +49,7 @@ struct ZmHeapConfig {
   uint32_t	alignment;
   uint64_t	cacheSize;
   ZmBitmap	cpuset;
+  uint32_t	magSize = 0;	// per-thread magazine size (0 - disabled)
 };
 
 struct ZmHeapInfo {
@@ -62,13 +64,17 @@ struct ZmHeapStats {
   uint64_t	heapAllocs;
   uint64_t	cacheAllocs;
   uint64_t	frees;
+  uint64_t	magAllocs;	// subset of cacheAllocs
+  uint64_t	magFrees;	// subset of frees
 };
 
 // display sequence:
 //   id, size, alignment, partition, sharded,
-//   cacheSize, cpuset, cacheAllocs, heapAllocs, frees, allocated (*)
+//   cacheSize, cpuset, magSize, cacheAllocs, heapAllocs, frees,
+//   magAllocs, magFrees, allocated (*)
 // derived display fields:
 //   allocated = (heapAllocs + cacheAllocs) - frees
+// magazine hit rates are magAllocs / cacheAllocs and magFrees / frees
 struct ZmHeapTelemetry {
   ZmIDString	id;		// primary key
   uint64_t	cacheSize = 0;
@@ -76,12 +82,31 @@ struct ZmHeapTelemetry {
   uint64_t	cacheAllocs = 0;// graphable (*)
   uint64_t	heapAllocs = 0;	// graphable (*)
   uint64_t	frees = 0;	// graphable
+  uint64_t	magAllocs = 0;	// graphable
+  uint64_t	magFrees = 0;	// graphable
   uint32_t	size = 0;
+  uint32_t	magSize = 0;
   uint16_t	partition = 0;
   uint8_t	sharded = 0;
   uint8_t	alignment = 0;
 };
 
+// magazine - fixed-capacity stack of free blocks, followed in memory
+// by magSize block pointers; full and empty magazines are exchanged
+// in bulk between threads via the depot in ZmHeapCache
+struct ZmHeapMag {
+  ZmHeapMag	*next = nullptr;	// depot linkage
+  unsigned	count = 0;
+
+  void **blocks() { return reinterpret_cast<void **>(this + 1); }
+};
+
+// per-thread magazine pair - the previous magazine is always full or empty
+struct ZmHeapMags {
+  ZmHeapMag	*loaded = nullptr;
+  ZmHeapMag	*prev = nullptr;
+};
+
 class ZmHeapLookup;
 
 typedef void (*ZmHeapStatsFn)();
@@ -105,6 +130,8 @@ template <auto, unsigned, bool> friend class ZmHeapCacheT;
     m_stats.heapAllocs += s.heapAllocs;
     m_stats.cacheAllocs += s.cacheAllocs;
     m_stats.frees += s.frees;
+    m_stats.magAllocs += s.magAllocs;
+    m_stats.magFrees += s.magFrees;
   }
 
   static const char *IDAxor(const ZmHeapCache *this_) {
@@ -147,8 +174,24 @@ private:
   void init_(hwloc_topology_t);
   void final_();
 
-  void *alloc(ZmHeapStats &stats);
-  void free(ZmHeapStats &stats, void *p);
+  void *alloc(ZmHeapStats &stats, ZmHeapMags &mags);
+  void free(ZmHeapStats &stats, ZmHeapMags &mags, void *p);
+  void allocN(ZmHeapStats &stats, ZmHeapMags &mags, void **blocks, unsigned n);
+  void freeN(ZmHeapStats &stats, ZmHeapMags &mags, void **blocks, unsigned n);
+
+  void free__(void *p);		// free a block that is not owned
+
+  // magazines - only used for non-sharded heaps with a cache
+
+  unsigned magSize() const {
+    return m_info.sharded || !m_begin ? 0U : m_info.config.magSize;
+  }
+  bool magInit(ZmHeapMags &mags);
+  void magFinal(ZmHeapMags &mags);	// called on thread exit
+  ZmHeapMag *magAlloc();			// new empty magazine
+  bool magLoad(ZmHeapMags &mags);	// ensure loaded is non-empty
+  void magUnload(ZmHeapMags &mags);	// ensure loaded is non-full
+  void magDrain(ZmHeapMag *mag);	// return magazine contents to cache
 
   // lock-free MPMC LIFO slist
 
@@ -179,6 +222,45 @@ private:
     m_head.store_(reinterpret_cast<uintptr_t>(p));
   }
 
+  // bulk pop up to n blocks
+  unsigned allocN_(void **blocks, unsigned n) {
+    uintptr_t p;
+  loop:
+    p = m_head.load_();
+    if (ZuUnlikely(!p)) return 0;
+    unsigned i = 0;
+    if (ZuLikely(m_info.sharded)) { // sharded - no contention
+      do {
+	blocks[i++] = reinterpret_cast<void *>(p);
+	p = *reinterpret_cast<uintptr_t *>(p);
+      } while (i < n && p);
+      m_head.store_(p);
+      return i;
+    }
+    if (ZuUnlikely(p & 1)) { ZmAtomic_acquire(); goto loop; }
+    if (ZuUnlikely(m_head.cmpXch(p | 1, p) != p)) goto loop;
+    do {
+      blocks[i++] = reinterpret_cast<void *>(p);
+      p = reinterpret_cast<ZmAtomic<uintptr_t> *>(p)->load_();
+    } while (i < n && p);
+    m_head = p;
+    return i;
+  }
+  // bulk push a pre-linked chain of blocks from head to tail
+  void freeN_(void *head, void *tail) {
+    uintptr_t n;
+    if (ZuLikely(m_info.sharded)) { // sharded - no contention
+      *reinterpret_cast<uintptr_t *>(tail) = m_head.load_();
+      m_head.store_(reinterpret_cast<uintptr_t>(head));
+      return;
+    }
+  loop:
+    n = m_head.load_();
+    if (n & 1) { ZmAtomic_acquire(); goto loop; }
+    reinterpret_cast<ZmAtomic<uintptr_t> *>(tail)->store_(n);
+    if (m_head.cmpXch(reinterpret_cast<uintptr_t>(head), n) != n) goto loop;
+  }
+
   bool owned(void *p) const {
     return p >= m_begin && p < m_end;
   }
@@ -191,6 +273,15 @@ private:
   ZmAtomic<uintptr_t>	m_head;		// free list (contended atomic)
   char			m__pad[CacheLineSize - sizeof(uintptr_t)];
 
+  using DepotLock = ZmPLock;
+  using DepotGuard = ZmGuard<DepotLock>;
+
+  DepotLock		m_depotLock;
+    ZmHeapMag		  *m_full = nullptr;	// full magazines
+    ZmHeapMag		  *m_empty = nullptr;	// empty magazines
+  char			m__pad2[CacheLineSize -
+			  sizeof(DepotLock) - (sizeof(ZmHeapMag *)<<1)];
+
   ZmHeapInfo		m_info;
   ZmHeapLookup		*m_lookup = nullptr;
   StatsFn		m_statsFn;	// aggregates stats from TLS
@@ -220,8 +311,8 @@ template <auto, unsigned, bool> friend class ZmHeapCacheT;
     CSV_(S &stream) : m_stream(stream) { }
     void print() {
       m_stream <<
-	"ID,size,partition,sharded,alignment,cacheSize,cpuset,"
-	"cacheAllocs,heapAllocs,frees\n";
+	"ID,size,partition,sharded,alignment,cacheSize,cpuset,magSize,"
+	"cacheAllocs,heapAllocs,frees,magAllocs,magFrees\n";
       ZmHeapMgr::all(ZmFn<void(ZmHeapCache *)>::Member<&CSV_::print_>::fn(this));
     }
     void print_(ZmHeapCache *cache) {
@@ -235,9 +326,12 @@ template <auto, unsigned, bool> friend class ZmHeapCacheT;
 	ZuBoxed(data.alignment) << ',' <<
 	ZuBoxed(data.cacheSize) << ',' <<
 	data.cpuset << ',' <<
+	ZuBoxed(data.magSize) << ',' <<
 	ZuBoxed(data.cacheAllocs) << ',' <<
 	ZuBoxed(data.heapAllocs) << ',' <<
-	ZuBoxed(data.frees) << '\n';
+	ZuBoxed(data.frees) << ',' <<
+	ZuBoxed(data.magAllocs) << ',' <<
+	ZuBoxed(data.magFrees) << '\n';
     }
 
   private:
@@ -288,6 +382,7 @@ private:
 
 public:
   ~ZmHeapCacheT() {
+    m_cache->magFinal(m_mags);
     m_cache->histStats(m_stats);
   }
 
@@ -296,16 +391,25 @@ public:
   static ZmHeapCacheT *instance() { return TLS::instance(); }
   static void *alloc() {
     ZmHeapCacheT *this_ = instance();
-    return this_->m_cache->alloc(this_->m_stats);
+    return this_->m_cache->alloc(this_->m_stats, this_->m_mags);
   }
   static void free(void *p) {
     ZmHeapCacheT *this_ = instance();
-    this_->m_cache->free(this_->m_stats, p);
+    this_->m_cache->free(this_->m_stats, this_->m_mags, p);
+  }
+  static void allocN(void **blocks, unsigned n) {
+    ZmHeapCacheT *this_ = instance();
+    this_->m_cache->allocN(this_->m_stats, this_->m_mags, blocks, n);
+  }
+  static void freeN(void **blocks, unsigned n) {
+    ZmHeapCacheT *this_ = instance();
+    this_->m_cache->freeN(this_->m_stats, this_->m_mags, blocks, n);
   }
 
 private:
   ZmHeapCache	*m_cache;
   ZmHeapStats	m_stats;
+  ZmHeapMags	m_mags;
 };
 
 // ZmHeapAllocSize returns a size that is minimum sizeof(uintptr_t),
@@ -357,6 +461,16 @@ public:
     Cache::free(p);
   }
 
+  // bulk allocate / free n uninitialized blocks of AllocSize, for burst
+  // paths; the caller is responsible for construction / destruction,
+  // e.g. new (blocks[i]) T{...} and blocks[i]->~T()
+  static void allocN(void **blocks, unsigned n) {
+    Cache::allocN(blocks, n);
+  }
+  static void freeN(void **blocks, unsigned n) {
+    Cache::freeN(blocks, n);
+  }
+
 private:
   static ZmHeap_Init<ZmHeap__>	m_init;
 };
@@ -0,0 +1,124 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// lock-free latency histogram
+
+#include <zlib/ZmHistogram.hh>
+
+#include <zlib/ZmSingleton.hh>
+#include <zlib/ZmRBTree.hh>
+
+class ZmHistogramMgr_ : public ZmObject {
+friend ZmSingletonCtor<ZmHistogramMgr_>;
+friend ZmHistogramMgr;
+
+  using Lock = ZmPLock;
+  using Guard = ZmGuard<Lock>;
+  using ReadGuard = ZmReadGuard<Lock>;
+
+  using StatsFn = ZmHistogramStatsFn;
+
+  using ID2Histogram =
+    ZmRBTree<ZmRef<ZmHistogram>,
+      ZmRBTreeKey<ZmHistogram::IDAxor,
+	ZmRBTreeUnique<true,
+	  ZmRBTreeHeapID<ZmHeapDisable()>>>>;
+
+  ZmHistogramMgr_() { }
+
+public:
+  ~ZmHistogramMgr_() { m_histograms.clean(); }
+
+  friend ZuUnsigned<ZmCleanup::Library> ZmCleanupLevel(ZmHistogramMgr_ *);
+
+private:
+  static ZmHistogramMgr_ *instance() {
+    return ZmSingleton<ZmHistogramMgr_>::instance();
+  }
+
+  ZmHistogram *histogram(const char *id, StatsFn statsFn) {
+    Guard guard(m_lock);
+    if (auto node = m_histograms.find(id)) return node->val();
+    ZmRef<ZmHistogram> h = new ZmHistogram{id, statsFn};
+    m_histograms.add(h);
+    return h;
+  }
+
+  void all(ZmFn<void(ZmHistogram *)> fn) {
+    ZmRef<ZmHistogram> h;
+    {
+      ReadGuard guard(m_lock);
+      h = m_histograms.minimumVal();
+    }
+    while (h) {
+      fn(h);
+      {
+	ReadGuard guard(m_lock);
+	h = m_histograms.readIterator<ZmRBTreeGreater>(
+	    ZmHistogram::IDAxor(h)).iterateVal();
+      }
+    }
+  }
+
+  Lock		m_lock;
+    ID2Histogram  m_histograms;
+};
+
+void ZmHistogramMgr::all(ZmFn<void(ZmHistogram *)> fn)
+{
+  ZmHistogramMgr_::instance()->all(ZuMv(fn));
+}
+
+ZmHistogram *ZmHistogramMgr::histogram(const char *id, StatsFn statsFn)
+{
+  return ZmHistogramMgr_::instance()->histogram(id, statsFn);
+}
+
+uint64_t ZmHistogramStats::percentile(double p) const
+{
+  if (!count) return 0;
+  uint64_t rank = uint64_t(double(count) * p / 100.0 + 0.5);
+  if (rank < 1) rank = 1;
+  if (rank >= count) return max;
+  uint64_t n = 0;
+  for (unsigned i = 0; i < ZmHistogramBuckets::N; i++) {
+    if ((n += buckets[i]) >= rank) {
+      uint64_t v = ZmHistogramBuckets::value(i);
+      return v < max ? v : max;
+    }
+  }
+  return max;
+}
+
+const ZmHistogramStats &ZmHistogram::stats() const
+{
+  {
+    Guard guard{m_histLock};
+    m_stats = m_histStats;
+  }
+  m_statsFn(); // calls ZmHistogramT::stats() { TLS::all(...) }
+  return m_stats;
+}
+
+void ZmHistogram::histStats(const ZmHistogramStats &s) const
+{
+  Guard guard{m_histLock};
+  m_histStats.add(s);
+}
+
+void ZmHistogram::telemetry(ZmHistogramTelemetry &data) const
+{
+  const auto &stats = this->stats();
+  data.id = m_id;
+  data.count = stats.count;
+  data.min = stats.count ? stats.min : 0;
+  data.max = stats.max;
+  data.mean = stats.count ? stats.total / stats.count : 0;
+  data.p50 = stats.percentile(50.0);
+  data.p90 = stats.percentile(90.0);
+  data.p99 = stats.percentile(99.0);
+  data.p999 = stats.percentile(99.9);
+}
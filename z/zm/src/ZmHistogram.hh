@@ -0,0 +1,201 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// lock-free latency histogram
+// * HDR-style log-linear buckets - relative error < 1%
+// * TLS buckets - recording is a handful of non-atomic instructions
+//   with no cross-thread sharing
+// * statistics are aggregated from all threads on demand
+// * registered by name, efficient telemetry (ZvTelemetry)
+//
+// inline constexpr const char *CommitLatency() { return "zdb.commit"; }
+// ...
+// ZmHistogramT<CommitLatency>::record((Zm::now() - start).nanosecs());
+//
+// ZmHistogramMgr::all([](ZmHistogram *h) { ... h->telemetry(data); ... });
+
+#ifndef ZmHistogram_HH
+#define ZmHistogram_HH
+
+#ifndef ZmLib_HH
+#include <zlib/ZmLib.hh>
+#endif
+
+#include <zlib/ZuIntrin.hh>
+#include <zlib/ZuPrint.hh>
+
+#include <zlib/ZmPlatform.hh>
+#include <zlib/ZmObject.hh>
+#include <zlib/ZmSpecific.hh>
+#include <zlib/ZmPLock.hh>
+#include <zlib/ZmGuard.hh>
+#include <zlib/ZmFn.hh>
+
+class ZmHistogramMgr;
+class ZmHistogramMgr_;
+template <auto ID> class ZmHistogramT;
+
+// bucket layout - values below 2^Bits are recorded exactly; above that,
+// each power of 2 is divided into 2^(Bits - 1) linear sub-buckets;
+// values >= 2^MaxBits (~3 days in nanoseconds) are clamped
+namespace ZmHistogramBuckets {
+  enum { Bits = 7 };
+  enum { MaxBits = 48 };
+  enum { Half = 1<<(Bits - 1) };
+  enum { N = (MaxBits - Bits + 2) * Half };
+
+  constexpr uint64_t MaxValue = (uint64_t(1)<<MaxBits) - 1;
+
+  ZuInline unsigned bucket(uint64_t v) {
+    if (ZuUnlikely(v > MaxValue)) v = MaxValue;
+    if (v < (Half<<1)) return v;
+    unsigned shift = (63 - ZuIntrin::clz(v)) - (Bits - 1);
+    return shift * Half + unsigned(v>>shift);
+  }
+  // highest value recorded in bucket i
+  inline constexpr uint64_t value(unsigned i) {
+    if (i < (Half<<1)) return i;
+    unsigned shift = i / Half - 1;
+    return ((uint64_t(i - shift * Half) + 1)<<shift) - 1;
+  }
+}
+
+struct ZmHistogramStats {
+  uint64_t	count = 0;
+  uint64_t	total = 0;
+  uint64_t	min = ~uint64_t(0);
+  uint64_t	max = 0;
+  uint64_t	buckets[ZmHistogramBuckets::N] = { 0 };
+
+  void record(uint64_t v) {
+    ++buckets[ZmHistogramBuckets::bucket(v)];
+    ++count;
+    total += v;
+    if (v < min) min = v;
+    if (v > max) max = v;
+  }
+
+  void add(const ZmHistogramStats &s) {
+    if (!s.count) return;
+    count += s.count;
+    total += s.total;
+    if (s.min < min) min = s.min;
+    if (s.max > max) max = s.max;
+    for (unsigned i = 0; i < ZmHistogramBuckets::N; i++)
+      buckets[i] += s.buckets[i];
+  }
+
+  void reset() { new (this) ZmHistogramStats{}; }
+
+  // value at percentile p (0 < p <= 100)
+  uint64_t percentile(double p) const;
+};
+
+// display sequence:
+//   id, count, min, mean, p50, p90, p99, p999, max
+struct ZmHistogramTelemetry {
+  ZmIDString	id;		// primary key
+  uint64_t	count = 0;	// graphable
+  uint64_t	min = 0;	// graphable
+  uint64_t	max = 0;	// graphable (*)
+  uint64_t	mean = 0;	// graphable
+  uint64_t	p50 = 0;	// graphable (*)
+  uint64_t	p90 = 0;	// graphable
+  uint64_t	p99 = 0;	// graphable (*)
+  uint64_t	p999 = 0;	// graphable (*)
+};
+
+typedef void (*ZmHistogramStatsFn)();
+
+// named histogram; aggregates statistics from ZmHistogramT
+class ZmAPI ZmHistogram : public ZmObject {
+friend ZmHistogramMgr;
+friend ZmHistogramMgr_;
+template <auto> friend class ZmHistogramT;
+
+  using Lock = ZmPLock;
+  using Guard = ZmGuard<Lock>;
+
+  using StatsFn = ZmHistogramStatsFn;
+
+  static const char *IDAxor(const ZmHistogram *this_) {
+    return this_->m_id;
+  }
+
+  ZmHistogram(const char *id, StatsFn statsFn) :
+      m_id{id}, m_statsFn{statsFn} { }
+
+  // aggregate statistics from ZmHistogramT
+  void stats(const ZmHistogramStats &s) const { m_stats.add(s); }
+
+public:
+  const char *id() const { return m_id; }
+
+  // aggregates statistics from all threads; the caller must serialize
+  // calls to stats() and telemetry(), e.g. by calling from a single thread
+  const ZmHistogramStats &stats() const;
+
+  void telemetry(ZmHistogramTelemetry &data) const;
+
+private:
+  void histStats(const ZmHistogramStats &s) const; // called on thread exit
+
+  const char			*m_id;
+  StatsFn			m_statsFn;	// aggregates stats from TLS
+
+  mutable Lock			m_histLock;
+    mutable ZmHistogramStats	  m_histStats;	// stats from exited threads
+  mutable ZmHistogramStats	m_stats;	// aggregated on demand
+};
+
+class ZmAPI ZmHistogramMgr {
+friend ZmHistogram;
+template <auto> friend class ZmHistogramT;
+
+public:
+  static void all(ZmFn<void(ZmHistogram *)> fn);
+
+private:
+  using StatsFn = ZmHistogramStatsFn;
+
+  static ZmHistogram *histogram(const char *id, StatsFn);
+};
+
+// TLS histogram, specific to ID; the first TLS instance for an ID
+// registers the named histogram
+template <auto ID>
+class ZmHistogramT : public ZmObject {
+friend ZmSpecificCtor<ZmHistogramT<ID>>;
+  using TLS = ZmSpecific<ZmHistogramT>;
+
+public:
+  // stats() uses ZmSpecific::all to iterate over all threads and
+  // collect/aggregate statistics for each TLS instance
+  static void stats() {
+    TLS::all([](ZmHistogramT *this_) {
+      this_->m_histogram->stats(this_->m_stats);
+    });
+  }
+
+private:
+  ZmHistogramT() :
+      m_histogram{ZmHistogramMgr::histogram(ID(), &stats)} { }
+
+public:
+  ~ZmHistogramT() { m_histogram->histStats(m_stats); }
+
+  static ZmHistogramT *instance() { return TLS::instance(); }
+
+  static void record(uint64_t v) { instance()->m_stats.record(v); }
+
+  static ZmHistogram *histogram() { return instance()->m_histogram; }
+
+private:
+  ZmHistogram		*m_histogram;
+  ZmHistogramStats	m_stats;
+};
+
+#endif /* ZmHistogram_HH */
@@ -13,6 +13,14 @@
 //
 // use ZmHash for high-contention high-throughput read/write data
 // use ZmLHash for unlocked or mostly uncontended reference data
+//
+// ZmLHashSwiss<> selects a SIMD group-probed ("Swiss table") variant
+// with the same interface - 1-byte hash tags are stored in 16-byte
+// control groups that are probed 16 slots at a time (deletes leave
+// tombstones until resized); it is opt-in, not the default - in ZmLHTest
+// linear probing is faster for hits with both integer and string keys,
+// Swiss probing only wins for misses on large tables with costly
+// key comparisons
 
 #ifndef ZmLHash_HH
 #define ZmLHash_HH
@@ -36,6 +44,10 @@
 
 #include <zlib/ZmHashMgr.hh>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 // NTP (named template parameters):
 //
 // ZmLHashKV<ZtString, ZtString,	// keys are ZtStrings
@@ -52,6 +64,7 @@ struct ZmLHash_Defaults {
   static const char *ID() { return "ZmHash"; }
   enum { Static = 0 };
   enum { Local = 0 };
+  enum { Swiss = 0 };
 };
 
 // ZmLHashKey - key accessor
@@ -113,6 +126,16 @@ struct ZmLHashLocal : public NTP {
   enum { Local = 1 };
 };
 
+// ZmLHashSwiss<> - SIMD group-probed (Swiss table) variant
+// * same interface, duplicate keys are permitted as before
+// * lookups probe 16 slots at a time (SSE2, portable fallback)
+// * deletes leave tombstones, reclaimed when the table is rehashed
+// * dynamically allocated only, incompatible with ZmLHashStatic
+template <typename NTP = ZmLHash_Defaults>
+struct ZmLHashSwiss : public NTP {
+  enum { Swiss = 1 };
+};
+
 template <typename T>
 struct ZmLHash_Ops : public ZuArrayFn<T, ZuCmp<T> > {
   static T *alloc(unsigned size) {
@@ -128,7 +151,7 @@ struct ZmLHash_Ops : public ZuArrayFn<T, ZuCmp<T> > {
 
 template <typename T_, auto KeyAxor, auto ValAxor>
 class ZmLHash_Node {
-template <typename, typename> friend class ZmLHash;
+template <typename, typename, bool> friend class ZmLHash;
 template <typename, typename, typename, unsigned> friend class ZmLHash_;
 
 public:
@@ -363,7 +386,7 @@ protected:
   Node	 		*m_table = nullptr;
 };
 
-template <typename T_, typename NTP = ZmLHash_Defaults>
+template <typename T_, typename NTP = ZmLHash_Defaults, bool = NTP::Swiss>
 class ZmLHash : public ZmLHash_<ZmLHash<T_, NTP>, T_, NTP, NTP::Static> {
 template <typename, typename, typename, unsigned> friend class ZmLHash_;
 
@@ -1104,7 +1127,7 @@ private:
   void delIterate(KeyIterator_ &iterator) {
     int slot = iterator.m_slot;
     if (slot < 0) return;
-    del__(iterator.m_prev < 0 ? (-slot - 2) : iterator.m_prev);
+    del__(m_table[slot].head() ? (-slot - 2) : prev(slot));
     iterator.m_slot = -1;
     if (!m_table[slot]) return;
     for (;;) {
@@ -1119,6 +1142,744 @@ private:
   }
 };
 
+// Swiss table control group - 16 control bytes, probed in parallel
+struct ZmLHash_Group {
+  enum { Size = 16, Shift = 4 };
+  // full slots contain a 7-bit hash tag (high bit clear)
+  enum : uint8_t { Empty = 0x80, Deleted = 0xfe };
+
+#ifdef __SSE2__
+  ZmLHash_Group(const uint8_t *ctrl) :
+    m_ctrl{_mm_load_si128(reinterpret_cast<const __m128i *>(ctrl))} { }
+
+  // bitmask of slots whose control byte is c
+  unsigned match(uint8_t c) const {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(m_ctrl, _mm_set1_epi8(c)));
+  }
+  // bitmask of empty or deleted slots
+  unsigned matchFree() const { return _mm_movemask_epi8(m_ctrl); }
+
+private:
+  __m128i	m_ctrl;
+#else
+  ZmLHash_Group(const uint8_t *ctrl) : m_ctrl{ctrl} { }
+
+  unsigned match(uint8_t c) const {
+    unsigned m = 0;
+    for (unsigned i = 0; i < Size; i++) m |= unsigned(m_ctrl[i] == c)<<i;
+    return m;
+  }
+  unsigned matchFree() const {
+    unsigned m = 0;
+    for (unsigned i = 0; i < Size; i++) m |= unsigned(m_ctrl[i]>>7)<<i;
+    return m;
+  }
+
+private:
+  const uint8_t	*m_ctrl;
+#endif
+
+public:
+  unsigned matchEmpty() const { return match(Empty); }
+  unsigned matchFull() const { return matchFree() ^ ((1U<<Size) - 1); }
+};
+
+// Swiss table probe sequence - triangular, visits every group
+class ZmLHash_Probe {
+public:
+  ZmLHash_Probe() { }
+  ZmLHash_Probe(uint32_t code, unsigned mask) :
+    m_group{(code>>7) & mask}, m_mask{mask} { }
+
+  unsigned offset() const { return m_group<<ZmLHash_Group::Shift; }
+  void next() { m_group = (m_group + ++m_index) & m_mask; }
+
+private:
+  unsigned	m_group = 0;
+  unsigned	m_mask = 0;
+  unsigned	m_index = 0;
+};
+
+template <typename T_, typename NTP>
+class ZmLHash<T_, NTP, true> : public ZmLHash__<NTP> {
+  using Base = ZmLHash__<NTP>;
+
+public:
+  using T = T_;
+  static constexpr auto KeyAxor = NTP::KeyAxor;
+  static constexpr auto ValAxor = NTP::ValAxor;
+  using KeyRet = decltype(KeyAxor(ZuDeclVal<const T &>()));
+  using ValRet = decltype(ValAxor(ZuDeclVal<const T &>()));
+  using Key = ZuRDecay<KeyRet>;
+  using Val = ZuRDecay<ValRet>;
+  using Cmp = typename NTP::template CmpT<Key>;
+  using ValCmp = typename NTP::template ValCmpT<Val>;
+  using HashFn = typename NTP::template HashFnT<Key>;
+  using Lock = typename NTP::Lock;
+  static constexpr auto ID = NTP::ID;
+  enum { Static = NTP::Static };
+
+  ZuAssert(!Static);
+
+  using LockTraits = ZmLockTraits<Lock>;
+  using Guard = ZmGuard<Lock>;
+  using ReadGuard = ZmReadGuard<Lock>;
+
+private:
+  using Group = ZmLHash_Group;
+  using Probe = ZmLHash_Probe;
+
+  // load factor is capped at 7/8 so that probing always terminates
+  enum { MaxLoadFactor = 14 };
+
+  // slots are constructed only while the control byte is full
+  struct Slot {
+    alignas(T) char	data[sizeof(T)];
+  };
+
+  using Base::m_count;
+  using Base::m_lock;
+
+public:
+  using Base::loadFactor_;
+  using Base::loadFactor;
+  using Base::count_;
+
+  unsigned bits() const { return m_bits; }
+  unsigned resized() const { return m_resized.load_(); }
+
+private:
+  // hash codes are re-mixed since the group index and tag are taken
+  // from different bits, and the multiplicative ZuHash functions only
+  // propagate entropy upwards
+  static uint32_t mix(uint32_t code) {
+    code ^= code>>16;
+    code *= 0x85ebca6bU;
+    code ^= code>>13;
+    code *= 0xc2b2ae35U;
+    code ^= code>>16;
+    return code;
+  }
+  static uint8_t tag(uint32_t code) { return code & 0x7f; }
+
+  Probe probe(uint32_t code) const {
+    return Probe{code, (1U<<(m_bits - Group::Shift)) - 1};
+  }
+
+  const T &data(unsigned slot) const {
+    const T *ZuMayAlias(ptr) = reinterpret_cast<const T *>(m_slots[slot].data);
+    return *ptr;
+  }
+  T &data(unsigned slot) {
+    T *ZuMayAlias(ptr) = reinterpret_cast<T *>(m_slots[slot].data);
+    return *ptr;
+  }
+
+  const T *ptr(int slot) const {
+    if (ZuLikely(slot >= 0)) return &data(slot);
+    return nullptr;
+  }
+  KeyRet key(int slot) const {
+    if (ZuLikely(slot >= 0)) return KeyAxor(data(slot));
+    return ZuNullRef<Key, Cmp>();
+  }
+  ValRet val(int slot) const {
+    if (ZuLikely(slot >= 0)) return ValAxor(data(slot));
+    return ZuNullRef<Val, ValCmp>();
+  }
+
+protected:
+  class Iterator_;
+friend Iterator_;
+  class Iterator_ {			// hash iterator
+    Iterator_(const Iterator_ &) = delete;
+    Iterator_ &operator =(const Iterator_ &) = delete;
+
+    using Hash = ZmLHash<T, NTP>;
+
+  friend Hash;
+
+  protected:
+    Iterator_(Iterator_ &&) = default;
+    Iterator_ &operator =(Iterator_ &&) = default;
+
+    Iterator_(Hash &hash) : m_hash(hash), m_slot(-1), m_next(-1) { }
+
+    virtual void lock(Lock &l) = 0;
+    virtual void unlock(Lock &l) = 0;
+
+  public:
+    void reset() { m_hash.startIterate(*this); }
+    const T *iterate() { return m_hash.iterate(*this); }
+    decltype(auto) iterateKey() { return m_hash.iterateKey(*this); }
+    decltype(auto) iterateVal() { return m_hash.iterateVal(*this); }
+
+    unsigned count() const { return m_hash.count_(); }
+
+    bool operator !() const { return m_slot < 0; }
+    ZuOpBool
+
+  protected:
+    Hash	&m_hash;
+    int		m_slot;
+    int		m_next;
+  };
+
+  class KeyIterator_;
+friend KeyIterator_;
+  class KeyIterator_ : protected Iterator_ {
+    KeyIterator_(const KeyIterator_ &) = delete;
+    KeyIterator_ &operator =(const KeyIterator_ &) = delete;
+
+    using Hash = ZmLHash<T, NTP>;
+  friend Hash;
+
+    using Iterator_::m_hash;
+
+  protected:
+    KeyIterator_(KeyIterator_ &&) = default;
+    KeyIterator_ &operator =(KeyIterator_ &&) = default;
+
+    template <typename P>
+    KeyIterator_(Hash &hash, P &&v) :
+	Iterator_{hash}, m_key{ZuFwd<P>(v)} { }
+
+  public:
+    void reset() { m_hash.startIterate(*this); }
+    const T *iterate() { return m_hash.iterate(*this); }
+    decltype(auto) iterateKey() { return m_hash.iterateKey(*this); }
+    decltype(auto) iterateVal() { return m_hash.iterateVal(*this); }
+
+  protected:
+    Key		m_key;
+    Probe	m_probe;
+    unsigned	m_match = 0;	// remaining tag matches in current group
+    uint8_t	m_tag = 0;
+  };
+
+public:
+  class Iterator : public Iterator_ {
+    Iterator(const Iterator &) = delete;
+    Iterator &operator =(const Iterator &) = delete;
+
+    using Hash = ZmLHash<T, NTP>;
+    void lock(Lock &l) { LockTraits::lock(l); }
+    void unlock(Lock &l) { LockTraits::unlock(l); }
+
+    using Iterator_::m_hash;
+
+  public:
+    Iterator(Iterator &&) = default;
+    Iterator &operator =(Iterator &&) = default;
+
+    Iterator(Hash &hash) : Iterator_(hash) { hash.startIterate(*this); }
+    ~Iterator() { m_hash.endIterate(*this); }
+    void del() { m_hash.delIterate(*this); }
+  };
+
+  class ReadIterator : public Iterator_ {
+    ReadIterator(const ReadIterator &) = delete;
+    ReadIterator &operator =(const ReadIterator &) = delete;
+
+    using Hash = ZmLHash<T, NTP>;
+    void lock(Lock &l) { LockTraits::readlock(l); }
+    void unlock(Lock &l) { LockTraits::readunlock(l); }
+
+    using Iterator_::m_hash;
+
+  public:
+    ReadIterator(ReadIterator &&) = default;
+    ReadIterator &operator =(ReadIterator &&) = default;
+
+    ReadIterator(const Hash &hash) : Iterator_(const_cast<Hash &>(hash))
+      { const_cast<Hash &>(hash).startIterate(*this); }
+    ~ReadIterator() { m_hash.endIterate(*this); }
+  };
+
+  class KeyIterator : public KeyIterator_ {
+    KeyIterator(const KeyIterator &) = delete;
+    KeyIterator &operator =(const KeyIterator &) = delete;
+
+    using Hash = ZmLHash<T, NTP>;
+    void lock(Lock &l) { LockTraits::lock(l); }
+    void unlock(Lock &l) { LockTraits::unlock(l); }
+
+    using KeyIterator_::m_hash;
+
+  public:
+    KeyIterator(KeyIterator &&) = default;
+    KeyIterator &operator =(KeyIterator &&) = default;
+
+    template <typename Index_>
+    KeyIterator(Hash &hash, Index_ &&index) :
+	KeyIterator_(hash, ZuFwd<Index_>(index)) { hash.startIterate(*this); }
+    ~KeyIterator() { m_hash.endIterate(*this); }
+    void del() { m_hash.delIterate(*this); }
+  };
+
+  class ReadKeyIterator : public KeyIterator_ {
+    ReadKeyIterator(const ReadKeyIterator &) = delete;
+    ReadKeyIterator &operator =(const ReadKeyIterator &) = delete;
+
+    using Hash = ZmLHash<T, NTP>;
+    void lock(Lock &l) { LockTraits::readlock(l); }
+    void unlock(Lock &l) { LockTraits::readunlock(l); }
+
+    using KeyIterator_::m_hash;
+
+  public:
+    ReadKeyIterator(ReadKeyIterator &&) = default;
+    ReadKeyIterator &operator =(ReadKeyIterator &&) = default;
+
+    template <typename Index_>
+    ReadKeyIterator(const Hash &hash, Index_ &&index) :
+	KeyIterator_(const_cast<Hash &>(hash), ZuFwd<Index_>(index))
+      { const_cast<Hash &>(hash).startIterate(*this); }
+    ~ReadKeyIterator() { m_hash.endIterate(*this); }
+  };
+
+  ZmLHash(ZmHashParams params = ZmHashParams{ID()}) : Base{params},
+      m_bits{params.bits() < Group::Shift ? Group::Shift :
+	params.bits() > 28 ? 28 : params.bits()} {
+    alloc();
+    Base::init();
+  }
+  ZmLHash(const ZmLHash &) = delete;
+  ZmLHash &operator =(const ZmLHash &) = delete;
+  ZmLHash(ZmLHash &&) = delete;
+  ZmLHash &operator =(ZmLHash &&) = delete;
+
+  ~ZmLHash() {
+    Base::final();
+    destroy(m_ctrl, m_slots, 1U<<m_bits);
+  }
+
+  unsigned size() const {
+    return static_cast<double>(static_cast<uint64_t>(1)<<bits()) * loadFactor();
+  }
+
+private:
+  void alloc() {
+    unsigned size = 1U<<m_bits;
+    m_ctrl = static_cast<uint8_t *>(
+	Zm::alignedAlloc(size, Zm::CacheLineSize));
+    m_slots = static_cast<Slot *>(
+	Zm::alignedAlloc(size * sizeof(Slot), Zm::CacheLineSize));
+    if (!m_ctrl || !m_slots) throw std::bad_alloc{};
+    memset(m_ctrl, Group::Empty, size);
+  }
+  static void destroy(uint8_t *ctrl, Slot *slots, unsigned size) {
+    if constexpr (!ZuTraits<T>::IsPOD)
+      for (unsigned i = 0; i < size; i++)
+	if (!(ctrl[i] & 0x80)) {
+	  T *ZuMayAlias(ptr) = reinterpret_cast<T *>(slots[i].data);
+	  ptr->~T();
+	}
+    Zm::alignedFree(ctrl);
+    Zm::alignedFree(slots);
+  }
+
+  // rehash into a new table, discarding tombstones
+  void rehash(unsigned bits) {
+    ++m_resized;
+    unsigned size = 1U<<m_bits;
+    uint8_t *ctrl = m_ctrl;
+    Slot *slots = m_slots;
+    m_bits = bits;
+    alloc();
+    m_deleted = 0;
+    for (unsigned i = 0; i < size; i++)
+      if (!(ctrl[i] & 0x80)) {
+	T *ZuMayAlias(ptr) = reinterpret_cast<T *>(slots[i].data);
+	add__(ZuMv(*ptr), mix(HashFn::hash(KeyAxor(*ptr))));
+      }
+    destroy(ctrl, slots, size);
+  }
+
+public:
+  template <typename P>
+  const T *add(P &&data) {
+    uint32_t code = mix(HashFn::hash(KeyAxor(data)));
+    Guard guard(m_lock);
+    return ptr(add_(ZuFwd<P>(data), code));
+  }
+
+  template <typename P0, typename P1>
+  const T *add(P0 &&p0, P1 &&p1) {
+    return add(ZuFwdTuple(ZuFwd<P0>(p0), ZuFwd<P1>(p1)));
+  }
+
+private:
+  template <typename P>
+  int add_(P &&data, uint32_t code) {
+    unsigned count = m_count.load_();
+    unsigned used = count + m_deleted;
+    unsigned loadFactor = loadFactor_();
+    if (loadFactor > MaxLoadFactor) loadFactor = MaxLoadFactor;
+
+    // widened - count<<5 overflows 32 bits as m_bits approaches 28
+    if (((uint64_t(used)<<4)>>m_bits) >= loadFactor) {
+      // reclaim tombstones in place if that leaves sufficient headroom
+      if (((uint64_t(count)<<5)>>m_bits) < loadFactor)
+	rehash(m_bits);
+      else if (m_bits < 28)
+	rehash(m_bits + 1);
+    }
+
+    if (count + m_deleted + 1 >= (1U<<m_bits)) return -1;
+
+    m_count.store_(count + 1);
+
+    return add__(ZuFwd<P>(data), code);
+  }
+  // insert into the first free slot in the probe sequence
+  template <typename P>
+  int add__(P &&data, uint32_t code) {
+    Probe probe = this->probe(code);
+    for (;;) {
+      unsigned offset = probe.offset();
+      if (unsigned m = Group{m_ctrl + offset}.matchFree()) {
+	unsigned slot = offset + ZuIntrin::ctz(m);
+	if (m_ctrl[slot] == Group::Deleted) --m_deleted;
+	m_ctrl[slot] = tag(code);
+	new (m_slots[slot].data) T{ZuFwd<P>(data)};
+	return slot;
+      }
+      probe.next();
+    }
+  }
+
+  template <typename U, typename V = Key>
+  struct IsKey : public ZuBool<ZuInspect<U, V>::Converts> { };
+  template <typename U, typename R = void>
+  using MatchKey = ZuIfT<IsKey<U>{}, R>;
+  template <typename U, typename V = T>
+  struct IsData : public ZuBool<!IsKey<U>{} && ZuInspect<U, V>::Converts> { };
+  template <typename U, typename R = void>
+  using MatchData = ZuIfT<IsData<U>{}, R>;
+
+  template <typename P>
+  static ZuInline auto matchKey(const P &key) {
+    return [&key](const T &data) -> bool {
+      return Cmp::equals(KeyAxor(data), key);
+    };
+  }
+  template <typename P>
+  static ZuInline auto matchData(const P &data_) {
+    return [&data_](const T &data) -> bool {
+      return data == data_;
+    };
+  }
+
+public:
+  template <typename P>
+  MatchKey<P, bool> exists(const P &key) const {
+    uint32_t code = mix(HashFn::hash(key));
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+    return find_(matchKey(key), code) >= 0;
+  }
+  template <typename P>
+  MatchData<P, bool> exists(const P &data) const {
+    uint32_t code = mix(HashFn::hash(KeyAxor(data)));
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+    return find_(matchData(data), code) >= 0;
+  }
+
+  template <typename P>
+  MatchKey<P, const T *> find(const P &key) const {
+    uint32_t code = mix(HashFn::hash(key));
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+    return ptr(find_(matchKey(key), code));
+  }
+  template <typename P>
+  MatchData<P, const T *> find(const P &data) const {
+    uint32_t code = mix(HashFn::hash(KeyAxor(data)));
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+    return ptr(find_(matchData(data), code));
+  }
+  template <typename P0, typename P1>
+  const T *find(P0 &&p0, P1 &&p1) {
+    return find(ZuFwdTuple(ZuFwd<P0>(p0), ZuFwd<P1>(p1)));
+  }
+
+  template <typename P>
+  MatchKey<P, Key> findKey(const P &key) const {
+    uint32_t code = mix(HashFn::hash(key));
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+    return this->key(find_(matchKey(key), code));
+  }
+  template <typename P>
+  MatchData<P, Key> findKey(const P &data) const {
+    uint32_t code = mix(HashFn::hash(KeyAxor(data)));
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+    return key(find_(matchData(data), code));
+  }
+  template <typename P0, typename P1>
+  Key findKey(P0 &&p0, P1 &&p1) {
+    return findKey(ZuFwdTuple(ZuFwd<P0>(p0), ZuFwd<P1>(p1)));
+  }
+
+  template <typename P>
+  MatchKey<P, Val> findVal(const P &key) const {
+    uint32_t code = mix(HashFn::hash(key));
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+    return val(find_(matchKey(key), code));
+  }
+  template <typename P>
+  MatchData<P, Val> findVal(const P &data) const {
+    uint32_t code = mix(HashFn::hash(KeyAxor(data)));
+    ReadGuard guard(const_cast<Lock &>(m_lock));
+    return val(find_(matchData(data), code));
+  }
+  template <typename P0, typename P1>
+  Val findVal(P0 &&p0, P1 &&p1) {
+    return findVal(ZuFwdTuple(ZuFwd<P0>(p0), ZuFwd<P1>(p1)));
+  }
+
+private:
+  // probe group by group, comparing only slots whose tag matches, until
+  // a group containing an empty slot terminates the sequence
+  template <typename Match>
+  int find_(Match match, uint32_t code) const {
+    uint8_t tag = this->tag(code);
+    Probe probe = this->probe(code);
+    for (;;) {
+      unsigned offset = probe.offset();
+      Group group{m_ctrl + offset};
+      for (unsigned m = group.match(tag); m; m &= m - 1) {
+	unsigned slot = offset + ZuIntrin::ctz(m);
+	if (match(data(slot))) return slot;
+      }
+      if (group.matchEmpty()) return -1;
+      probe.next();
+    }
+  }
+
+public:
+  template <typename P>
+  const T *findAdd(P &&data) {
+    uint32_t code = mix(HashFn::hash(KeyAxor(data)));
+    Guard guard(m_lock);
+    int slot = find_(matchData(data), code);
+    if (slot < 0) slot = add_(ZuFwd<P>(data), code);
+    return ptr(slot);
+  }
+  template <typename P0, typename P1>
+  const T *findAdd(P0 &&p0, P1 &&p1) {
+    return findAdd(ZuFwdTuple(ZuFwd<P0>(p0), ZuFwd<P1>(p1)));
+  }
+
+  template <typename P>
+  MatchKey<P> del(const P &key) {
+    uint32_t code = mix(HashFn::hash(key));
+    Guard guard(m_lock);
+    del_(find_(matchKey(key), code));
+  }
+  template <typename P>
+  MatchData<P> del(const P &data) {
+    uint32_t code = mix(HashFn::hash(KeyAxor(data)));
+    Guard guard(m_lock);
+    del_(find_(matchData(data), code));
+  }
+  template <typename P0, typename P1>
+  void del(P0 &&p0, P1 &&p1) {
+    del(ZuFwdTuple(ZuFwd<P0>(p0), ZuFwd<P1>(p1)));
+  }
+
+  template <typename P>
+  MatchKey<P, Key> delKey(const P &key) {
+    uint32_t code = mix(HashFn::hash(key));
+    Guard guard(m_lock);
+    return delKey_(find_(matchKey(key), code));
+  }
+  template <typename P>
+  MatchData<P, Key> delKey(const P &data) {
+    uint32_t code = mix(HashFn::hash(KeyAxor(data)));
+    Guard guard(m_lock);
+    return delKey_(find_(matchData(data), code));
+  }
+  template <typename P0, typename P1>
+  Key delKey(P0 &&p0, P1 &&p1) {
+    return delKey(ZuFwdTuple(ZuFwd<P0>(p0), ZuFwd<P1>(p1)));
+  }
+
+  template <typename P>
+  MatchKey<P, Val> delVal(const P &key) {
+    uint32_t code = mix(HashFn::hash(key));
+    Guard guard(m_lock);
+    return delVal_(find_(matchKey(key), code));
+  }
+  template <typename P>
+  MatchData<P, Val> delVal(const P &data) {
+    uint32_t code = mix(HashFn::hash(KeyAxor(data)));
+    Guard guard(m_lock);
+    return delVal_(find_(matchData(data), code));
+  }
+  template <typename P0, typename P1>
+  Val delVal(P0 &&p0, P1 &&p1) {
+    return delVal(ZuFwdTuple(ZuFwd<P0>(p0), ZuFwd<P1>(p1)));
+  }
+
+private:
+  // a group that still contains an empty slot has never been full, so
+  // no probe sequence has continued past it and the slot can be emptied;
+  // otherwise a tombstone is left
+  void del__(unsigned slot) {
+    data(slot).~T();
+    unsigned offset = slot & ~(Group::Size - 1);
+    if (Group{m_ctrl + offset}.matchEmpty())
+      m_ctrl[slot] = Group::Empty;
+    else {
+      m_ctrl[slot] = Group::Deleted;
+      ++m_deleted;
+    }
+    if (unsigned count = m_count.load_())
+      m_count.store_(count - 1);
+  }
+
+  void del_(int slot) {
+    if (slot < 0) return;
+    del__(slot);
+  }
+  Key delKey_(int slot) {
+    if (slot < 0) return ZuNullRef<Key, Cmp>();
+    Key key{KeyAxor(ZuMv(data(slot)))};
+    del__(slot);
+    return key;
+  }
+  Val delVal_(int slot) {
+    if (slot < 0) return ZuNullRef<Val, ValCmp>();
+    Val val{ValAxor(ZuMv(data(slot)))};
+    del__(slot);
+    return val;
+  }
+
+public:
+  void clean() {
+    Guard guard(m_lock);
+    unsigned size = 1U<<m_bits;
+
+    for (unsigned i = 0; i < size; i++)
+      if (!(m_ctrl[i] & 0x80)) data(i).~T();
+    memset(m_ctrl, Group::Empty, size);
+    m_deleted = 0;
+    m_count = 0;
+  }
+
+  void telemetry(ZmHashTelemetry &data) const {
+    data.id = ID();
+    data.addr = reinterpret_cast<uintptr_t>(this);
+    data.loadFactor = loadFactor();
+    unsigned count = m_count.load_();
+    unsigned bits = this->bits();
+    data.effLoadFactor = static_cast<double>(count) / (1<<bits);
+    data.nodeSize = sizeof(Slot) + 1;
+    data.count = count;
+    data.resized = resized();
+    data.bits = bits;
+    data.cBits = 0;
+    data.linear = true;
+  }
+
+  auto iterator() { return Iterator{*this}; }
+  template <typename Index_>
+  auto iterator(Index_ &&index) {
+    return KeyIterator{*this, ZuFwd<Index_>(index)};
+  }
+
+  auto readIterator() const { return ReadIterator{*this}; }
+  template <typename Index_>
+  auto readIterator(Index_ &&index) const {
+    return ReadKeyIterator{*this, ZuFwd<Index_>(index)};
+  }
+
+private:
+  // first full slot at or after slot, or -1
+  int nextFull(unsigned slot) const {
+    unsigned size = 1U<<m_bits;
+    if (slot >= size) return -1;
+    unsigned offset = slot & ~(Group::Size - 1);
+    unsigned m = Group{m_ctrl + offset}.matchFull() & (~0U<<(slot - offset));
+    while (!m) {
+      if ((offset += Group::Size) >= size) return -1;
+      m = Group{m_ctrl + offset}.matchFull();
+    }
+    return offset + ZuIntrin::ctz(m);
+  }
+  // next slot matching the iterator's key, or -1
+  int nextKey(KeyIterator_ &iterator) const {
+    for (;;) {
+      unsigned offset = iterator.m_probe.offset();
+      while (unsigned m = iterator.m_match) {
+	iterator.m_match = m & (m - 1);
+	unsigned slot = offset + ZuIntrin::ctz(m);
+	if (Cmp::equals(KeyAxor(data(slot)), iterator.m_key)) return slot;
+      }
+      if (Group{m_ctrl + offset}.matchEmpty()) return -1;
+      iterator.m_probe.next();
+      iterator.m_match =
+	Group{m_ctrl + iterator.m_probe.offset()}.match(iterator.m_tag);
+    }
+  }
+
+  void startIterate(Iterator_ &iterator) {
+    iterator.lock(m_lock);
+    iterator.m_slot = -1;
+    iterator.m_next = nextFull(0);
+  }
+  void startIterate(KeyIterator_ &iterator) {
+    iterator.lock(m_lock);
+    iterator.m_slot = -1;
+    uint32_t code = mix(HashFn::hash(iterator.m_key));
+    iterator.m_tag = tag(code);
+    iterator.m_probe = probe(code);
+    iterator.m_match =
+      Group{m_ctrl + iterator.m_probe.offset()}.match(iterator.m_tag);
+    iterator.m_next = nextKey(iterator);
+  }
+  void iterate_(Iterator_ &iterator) {
+    int slot = iterator.m_slot = iterator.m_next;
+    if (slot >= 0) iterator.m_next = nextFull(slot + 1);
+  }
+  void iterate_(KeyIterator_ &iterator) {
+    int slot = iterator.m_slot = iterator.m_next;
+    if (slot >= 0) iterator.m_next = nextKey(iterator);
+  }
+  template <typename I>
+  const T *iterate(I &iterator) {
+    iterate_(iterator);
+    return ptr(iterator.m_slot);
+  }
+  template <typename I>
+  decltype(auto) iterateKey(I &iterator) {
+    iterate_(iterator);
+    return key(iterator.m_slot);
+  }
+  template <typename I>
+  decltype(auto) iterateVal(I &iterator) {
+    iterate_(iterator);
+    return val(iterator.m_slot);
+  }
+  void endIterate(Iterator_ &iterator) {
+    iterator.unlock(m_lock);
+    iterator.m_slot = iterator.m_next = -1;
+  }
+  // slots never move in a Swiss table, so deletion does not disturb
+  // an iterator's position
+  void delIterate(Iterator_ &iterator) {
+    int slot = iterator.m_slot;
+    if (slot < 0) return;
+    del__(slot);
+    iterator.m_slot = -1;
+  }
+
+  ZmAtomic<unsigned>	m_resized = 0;
+  unsigned		m_bits;
+  unsigned		m_deleted = 0;	// tombstones
+  uint8_t		*m_ctrl = nullptr;
+  Slot			*m_slots = nullptr;
+};
+
 template <typename P0, typename P1, typename NTP = ZmLHash_Defaults>
 using ZmLHashKV =
   ZmLHash<ZuTuple<P0, P1>,
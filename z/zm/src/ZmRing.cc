@@ -1,8 +1,11 @@
 #include <zlib/ZmRing.hh>
 
+#include <zlib/ZuIntrin.hh>
+
 #ifdef linux
 #include <sys/syscall.h>
 #include <sys/mman.h>
+#include <sys/eventfd.h>
 #include <linux/futex.h>
 #endif
 
@@ -10,12 +13,58 @@ namespace ZmRing_ {
 
 #ifdef linux
 
+// reader eventfds, indexed by reader ID; eventfds are retained until
+// the last copy of the ring is destroyed, so that a concurrent wake()
+// never writes to a closed (and possibly re-used) file descriptor
+struct Blocker::Notify : public ZmObject {
+  Notify() { for (unsigned i = 0; i < MaxRdrs; i++) fds[i] = -1; }
+  ~Notify() {
+    for (unsigned i = 0; i < MaxRdrs; i++) if (fds[i] >= 0) ::close(fds[i]);
+  }
+
+  ZmAtomic<uint64_t>	mask = 0;	// subscribed readers
+  int			fds[MaxRdrs];
+};
+
 Blocker::Blocker() { }
-Blocker::Blocker(const Blocker &) { }
-Blocker::~Blocker() { }
+Blocker::Blocker(const Blocker &blocker) : m_notify{blocker.m_notify} { }
+Blocker::~Blocker() { close(); }
+
+bool Blocker::open(bool head, const Params &params)
+{
+  if (head && params.notify && !m_notify) m_notify = new Notify{};
+  return true;
+}
+void Blocker::close()
+{
+  unsubscribe();
+  m_notify = nullptr;
+}
+
+int Blocker::subscribe(unsigned id)
+{
+  if (!m_notify || id >= MaxRdrs) return -1;
+  int &fd = m_notify->fds[id];
+  if (fd < 0 && (fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0)
+    return -1;
+  m_id = id;
+  m_notify->mask |= (1ULL<<id); // release fd
+  return fd;
+}
+
+void Blocker::unsubscribe()
+{
+  if (m_id < 0) return;
+  m_notify->mask &= ~(1ULL<<m_id);
+  m_id = -1;
+}
 
-bool Blocker::open(bool, const Params &) { return true; }
-void Blocker::close() { }
+void Blocker::notified()
+{
+  if (m_id < 0) return;
+  uint64_t v;
+  while (::read(m_notify->fds[m_id], &v, sizeof(uint64_t)) > 0);
+}
 
 #if 0
 #pragma pack(push, 1)
@@ -55,6 +104,7 @@ int Blocker::wait(
     ZmAtomic<uint32_t> &addr, uint32_t val,
     const Params &params)
 {
+  if (m_notify) return Zu::NotReady; // Waiting is set, wake() will notify
   /* new (&logBuf[(logIndex++) & 1023])
     Log{"wait", Zm::now(), 0, this,
       reinterpret_cast<uint32_t *>(&addr), val}; */
@@ -99,6 +149,16 @@ void Blocker::wake(ZmAtomic<uint32_t> &addr)
   /* new (&logBuf[(logIndex++) & 1023])
     Log{"wake", Zm::now(), 0, this,
       reinterpret_cast<uint32_t *>(&addr), addr.load_()}; */
+  if (m_notify) {
+    uint64_t mask = m_notify->mask; // acquire
+    while (mask) {
+      unsigned id = ZuIntrin::ctz(mask);
+      mask &= mask - 1;
+      uint64_t v = 1;
+      ::write(m_notify->fds[id], &v, sizeof(uint64_t));
+    }
+    return;
+  }
   syscall(SYS_futex, reinterpret_cast<volatile int *>(&addr),
       FUTEX_WAKE | FUTEX_PRIVATE_FLAG, INT_MAX, 0, 0, 0);
 }
@@ -135,6 +195,10 @@ void Blocker::close()
   if (m_sem) { CloseHandle(m_sem); m_sem = 0; }
 }
 
+int Blocker::subscribe(unsigned) { return -1; }	// unsupported
+void Blocker::unsubscribe() { }
+void Blocker::notified() { }
+
 int Blocker::wait(
     ZmAtomic<uint32_t> &addr, uint32_t val,
     const Params &params)
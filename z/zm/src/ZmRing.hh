@@ -31,6 +31,8 @@
 #include <zlib/ZmLock.hh>
 #include <zlib/ZmGuard.hh>
 #include <zlib/ZmAtomic.hh>
+#include <zlib/ZmObject.hh>
+#include <zlib/ZmRef.hh>
 #include <zlib/ZuTime.hh>
 #include <zlib/ZmBackTrace.hh>
 
@@ -111,6 +113,7 @@ struct ParamData {
   ZmBitmap	cpuset;
   unsigned	spin = 1000;
   unsigned	timeout = 1;	// milliseconds
+  bool		notify = false;	// readers are notified via notifyFD()
 
   inline const ParamData &data() { return *this; } // upcast
 };
@@ -137,6 +140,7 @@ public:
   Derived &&cpuset(ZmBitmap b) { Data::cpuset = ZuMv(b); return derived(); }
   Derived &&spin(unsigned n) { Data::spin = n; return derived(); }
   Derived &&timeout(unsigned n) { Data::timeout = n; return derived(); }
+  Derived &&notify(bool b) { Data::notify = b; return derived(); }
 };
 
 class Params : public Params_<Params> {
@@ -180,7 +184,19 @@ public:
   // wake up waiters on addr
   void wake(ZmAtomic<uint32_t> &addr);
 
+  // notification (Params::notify, Linux) - wait() returns NotReady
+  // instead of blocking, and wake() signals the eventfd of each
+  // subscribed reader; subscribe() returns the eventfd, -1 on error
+  int subscribe(unsigned id);
+  void unsubscribe();
+  void notified();	// consume pending notifications
+
 protected:
+#ifdef linux
+  struct Notify;
+  ZmRef<Notify>	m_notify;	// shared by all copies, head only
+  int		m_id = -1;	// subscribed reader ID
+#endif
 #ifdef _WIN32
   HANDLE	m_sem = 0;
 #endif
@@ -654,6 +670,18 @@ public:
   // how many times push() was delayed by this ring buffer being full
   unsigned full() const { return m_full; }
 
+  // notification (params().notify) - instead of blocking, shift()
+  // returns nullptr when the ring is empty, having set the Waiting flag
+  // so that the next push() (or eof()) signals notifyFD(); a reader can
+  // therefore register notifyFD() with an event loop (ZiMultiplex),
+  // and when readable, call notified() then shift() until nullptr;
+  // MR readers must attach() beforehand; incompatible with ll
+  int notifyFD() {
+    if (!params().notify || rdrID() < 0) return -1;
+    return m_headBlocker.subscribe(rdrID());
+  }
+  void notified() { m_headBlocker.notified(); }
+
 private:
   using AlignFn::align;
 
@@ -1668,6 +1696,7 @@ done:
 
   // release ID for re-use by future attach
 
+  ring()->headBlocker().unsubscribe();
   ring()->detached(rdrID());
 
   ++(ring()->attSeqNo());
@@ -7,9 +7,11 @@
 // scheduler with thread pool
 
 #include <zlib/ZuBox.hh>
+#include <zlib/ZuIntrin.hh>
 
 #include <zlib/ZmScheduler.hh>
 #include <zlib/ZmTrap.hh>
+#include <zlib/ZmTopology.hh>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -50,6 +52,52 @@ ZmScheduler::ZmScheduler(ZmSchedParams params) : m_params{ZuMv(params)}
     if (!m_params.thread(sid).isolated())
       m_workers[m_nWorkers++] = &m_threads[i];
   }
+  if (m_params.stealing()) initVictims();
+  if (m_params.timerWheel()) m_wheel.init(m_params.quantum());
+}
+
+// topological proximity of two cpusets - the depth of the smallest hwloc
+// object covering both (core, cache, package, NUMA node, machine);
+// unbound threads are treated as furthest away
+static int proximity(const ZmBitmap &l, const ZmBitmap &r)
+{
+  if (!l || !r) return -1;
+  ZmBitmap cpuset = l;
+  cpuset |= r;
+  auto obj = hwloc_get_obj_covering_cpuset(ZmTopology::hwloc(), cpuset);
+  return obj ? static_cast<int>(obj->depth) : -1;
+}
+
+// order each worker's victims by proximity, nearest first; ties are broken
+// by distance in the worker list, so that thieves spread out across siblings
+void ZmScheduler::initVictims()
+{
+  unsigned n = m_nWorkers;
+  auto depth = static_cast<int *>(ZuAlloca(n * sizeof(int)));
+  auto order = static_cast<unsigned *>(ZuAlloca(n * sizeof(unsigned)));
+  if (ZuUnlikely(!depth || !order)) return;
+  for (unsigned i = 0; i < n; i++) {
+    Thread *thread = m_workers[i];
+    const auto &cpuset =
+      m_params.thread((thread - &m_threads[0]) + 1).cpuset();
+    for (unsigned j = 0; j < n; j++)
+      depth[j] = proximity(cpuset,
+	  m_params.thread((m_workers[j] - &m_threads[0]) + 1).cpuset());
+    unsigned m = 0;
+    for (unsigned k = 1; k < n; k++) {
+      unsigned j = (i + k) % n;
+      unsigned l = m++;
+      for (; l > 0 && depth[order[l - 1]] < depth[j]; --l)
+	order[l] = order[l - 1]; // insertion sort (stable)
+      order[l] = j;
+    }
+    // victims is null-terminated
+    auto victims = thread->victims = new Thread *[m + 1];
+    for (unsigned k = 0; k < m; k++) victims[k] = m_workers[order[k]];
+    victims[m] = nullptr;
+    thread->stealRing.init(
+	ZmXRingParams{}.initial(0).increment(StealRing_Increment));
+  }
 }
 
 ZmScheduler::~ZmScheduler()
@@ -58,6 +106,7 @@ ZmScheduler::~ZmScheduler()
     Ring &ring = m_threads[i].ring;
     // ring.detach();
     ring.close();
+    delete [] m_threads[i].victims;
   }
   delete [] m_workers;
   delete [] m_threads;
@@ -141,6 +190,8 @@ bool ZmScheduler::reset()
       if (!thread->thread) {
 	thread->overCount = 0;
 	thread->overRing.clean();
+	thread->stealRing.clean();
+	thread->steals = 0;
 	thread->ring.reset();
       }
     }
@@ -166,7 +217,7 @@ void ZmScheduler::timer()
       {
 	SchedGuard schedGuard(m_schedLock);
 
-	if (Timer *first = m_schedule.minimum()) minimum = first->timeout;
+	minimum = schedMinimum();
       }
 
       if (*minimum)
@@ -178,32 +229,48 @@ void ZmScheduler::timer()
     if (stopped()) return;
 
     ZuTime now = Zm::now();
-    now += m_params.quantum();
 
-    {
+    if (m_params.timerWheel()) {
+      SchedGuard schedGuard(m_schedLock);
+      while (Timer *timer = m_wheel.shift(now))
+	if (ZuUnlikely(!timerRun(timer))) {
+	  m_wheel.add(timer);
+	  schedGuard.unlock();
+	  Zm::sleep(m_params.quantum());
+	  return;
+	}
+    } else {
+      now += m_params.quantum();
       SchedGuard schedGuard(m_schedLock);
       auto i = m_schedule.iterator<ZmRBTreeLessEqual>(now);
       while (Timer *timer = i.iterate()) {
 	i.del(timer);
-	bool ok;
-	unsigned sid = timer->sid;
-	if (ZuLikely(sid))
-	  ok = tryRun_(&m_threads[sid - 1], timer->fn);
-	else
-	  ok = timerAdd(timer->fn);
-	if (ZuUnlikely(!ok)) {
+	if (ZuUnlikely(!timerRun(timer))) {
 	  m_schedule.addNode(timer);
 	  schedGuard.unlock();
 	  Zm::sleep(m_params.quantum());
 	  return;
 	}
-	timer->timeout = ZuTime{};
-	if (timer->transient) delete timer;
       }
     }
   }
 }
 
+// dispatch an expired timer (already removed from the schedule)
+bool ZmScheduler::timerRun(Timer *timer)
+{
+  bool ok;
+  unsigned sid = timer->sid;
+  if (ZuLikely(sid))
+    ok = tryRun_(&m_threads[sid - 1], timer->fn);
+  else
+    ok = timerAdd(timer->fn);
+  if (ZuUnlikely(!ok)) return false;
+  timer->timeout = ZuTime{};
+  if (timer->transient) delete timer;
+  return true;
+}
+
 bool ZmScheduler::timerAdd(Fn &fn)
 {
   if (ZuUnlikely(!m_nWorkers)) return false;
@@ -237,7 +304,7 @@ void ZmScheduler::schedule_(
 	  if (ZuUnlikely(timer->timeout >= timeout)) return;
 	  break;
       }
-      m_schedule.delNode(timer);
+      schedDel(timer);
       timer->timeout = ZuTime{};
     }
 
@@ -249,13 +316,13 @@ void ZmScheduler::schedule_(
       }
     }
 
-    if (Timer *first = m_schedule.minimum())
-      kick = timeout < first->timeout;
+    if (ZuTime minimum = schedMinimum(); *minimum)
+      kick = timeout < minimum;
 
     timer->timeout = timeout;
     timer->sid = sid;
     timer->fn = ZuMv(fn);
-    m_schedule.addNode(timer);
+    schedAdd(timer);
   }
 
   if (kick) wake();
@@ -266,15 +333,127 @@ bool ZmScheduler::del(Timer *timer)
   SchedGuard schedGuard(m_schedLock);
 
   if (!*timer) return false;
-  bool found = !!m_schedule.delNode(timer);
+  bool found = schedDel(timer);
   timer->timeout = ZuTime{};
   if (timer->transient) delete timer;
   return found;
 }
 
+void ZmScheduler::Wheel::init(ZuTime quantum)
+{
+  m_quantum = static_cast<uint64_t>(quantum.nanosecs());
+  if (!m_quantum) m_quantum = 1;
+  m_tick = ticks(Zm::now());
+}
+
+// the level is determined by the most significant bit in which the
+// expiry tick differs from the current tick, so that every timer at
+// level L lies within the current level L+1 slot, after the current
+// level L slot; the lowest occupied level therefore holds the earliest
+// timers, in its lowest occupied slot
+void ZmScheduler::Wheel::add(Timer *timer)
+{
+  uint64_t tick = ticks(timer->timeout);
+  if (tick < m_tick) tick = m_tick;
+  unsigned level = 0;
+  if (uint64_t diff = tick ^ m_tick) {
+    level = (63U - ZuIntrin::clz(diff)) / Bits;
+    if (ZuUnlikely(level >= Levels)) {
+      // beyond the horizon - park in the last slot, re-cascaded on expiry
+      level = Levels - 1;
+      tick = m_tick | ((uint64_t(1)<<(Bits * Levels)) - 1);
+    }
+  }
+  push(timer, level * Slots + ((tick>>(level * Bits)) & (Slots - 1)));
+}
+
+void ZmScheduler::Wheel::del(Timer *timer)
+{
+  Slot &slot = m_slots[timer->wheelSlot];
+  Timer_ *prev = timer->wheelPrev;
+  Timer_ *next = timer->wheelNext;
+  if (prev) prev->wheelNext = next; else slot.head = next;
+  if (next) next->wheelPrev = prev; else slot.tail = prev;
+  timer->wheelPrev = timer->wheelNext = nullptr;
+  if (!slot.head)
+    m_bitmap[timer->wheelSlot>>Bits] &=
+      ~(uint64_t(1)<<(timer->wheelSlot & (Slots - 1)));
+  --m_count;
+}
+
+void ZmScheduler::Wheel::push(Timer_ *timer, unsigned i)
+{
+  Slot &slot = m_slots[i];
+  timer->wheelSlot = i;
+  timer->wheelNext = nullptr;
+  if ((timer->wheelPrev = slot.tail))
+    slot.tail->wheelNext = timer;
+  else
+    slot.head = timer;
+  slot.tail = timer;
+  m_bitmap[i>>Bits] |= uint64_t(1)<<(i & (Slots - 1));
+  ++m_count;
+}
+
+ZmScheduler::Timer_ *ZmScheduler::Wheel::shift(unsigned i)
+{
+  Slot &slot = m_slots[i];
+  Timer_ *timer = slot.head;
+  if (!timer) return nullptr;
+  if (!(slot.head = timer->wheelNext)) {
+    slot.tail = nullptr;
+    m_bitmap[i>>Bits] &= ~(uint64_t(1)<<(i & (Slots - 1)));
+  } else
+    slot.head->wheelPrev = nullptr;
+  timer->wheelNext = nullptr;
+  --m_count;
+  return timer;
+}
+
+int ZmScheduler::Wheel::first(uint64_t &start) const
+{
+  for (unsigned level = 0; level < Levels; level++)
+    if (uint64_t bitmap = m_bitmap[level]) {
+      unsigned slot = ZuIntrin::ctz(bitmap);
+      unsigned shift = level * Bits;
+      start = m_tick;
+      if (shift + Bits < 64) start &= ~((uint64_t(1)<<(shift + Bits)) - 1);
+      start |= static_cast<uint64_t>(slot)<<shift;
+      if (ZuUnlikely(start < m_tick)) start = m_tick; // beyond the horizon
+      return level * Slots + slot;
+    }
+  return -1;
+}
+
+ZuTime ZmScheduler::Wheel::minimum() const
+{
+  uint64_t start;
+  if (first(start) < 0) return {};
+  return time(start);
+}
+
+ZmScheduler::Timer *ZmScheduler::Wheel::shift(ZuTime now_)
+{
+  uint64_t now = ticks(now_);
+  for (;;) {
+    uint64_t start;
+    int i = first(start);
+    if (i < 0 || start > now) {
+      if (now > m_tick) m_tick = now;
+      return nullptr;
+    }
+    m_tick = start;
+    if (i < Slots) return static_cast<Timer *>(shift(unsigned(i)));
+    // cascade the slot down to lower levels
+    while (Timer_ *timer = shift(unsigned(i)))
+      add(static_cast<Timer *>(timer));
+  }
+}
+
 void ZmScheduler::add_(Fn &fn)
 {
   if (ZuUnlikely(!m_nWorkers)) return;
+  if (m_params.stealing()) { steal_(fn); return; }
   unsigned first = m_next++;
   unsigned next = first;
   do {
@@ -284,6 +463,50 @@ void ZmScheduler::add_(Fn &fn)
   run_(m_workers[first % m_nWorkers], fn);
 }
 
+// work-stealing dispatch - jobs added by a worker are queued locally,
+// otherwise they are distributed round-robin; the owner is only woken if
+// idle, failing which the nearest idle sibling is woken to steal the job
+void ZmScheduler::steal_(Fn &fn)
+{
+  Thread *thread = nullptr;
+  {
+    int sid = ZmSelf()->sid();
+    if (sid > 0 && unsigned(sid) <= m_params.nThreads()) {
+      thread = &m_threads[sid - 1];
+      if (!thread->victims || thread->tid != Zm::getTID()) thread = nullptr;
+    }
+  }
+  if (!thread) thread = m_workers[m_next++ % m_nWorkers];
+  thread->stealRing.push(ZuMv(fn));
+  ZmAtomic_fence(); // pairs with idle workers re-checking after ++m_idle
+  if (ZuLikely(!m_idle.load_())) return;
+  if (thread->idle.load_()) { kick(thread); return; }
+  for (Thread **victim = thread->victims; *victim; ++victim)
+    if ((*victim)->idle.load_()) { kick(*victim); return; }
+}
+
+// wake an idle worker by running a no-op on it
+void ZmScheduler::kick(Thread *thread)
+{
+  if (thread->idle.cmpXch(0, 1) != 1) return; // already woken
+  --m_idle;
+  auto noop = []{ };
+  Fn fn{noop};
+  tryRun_(thread, fn);
+}
+
+// steal the oldest job from the nearest busy sibling, re-queuing it locally
+bool ZmScheduler::steal(Thread *thread)
+{
+  for (Thread **victim = thread->victims; *victim; ++victim)
+    if (Fn fn = (*victim)->stealRing.shift()) {
+      thread->steals.store_(thread->steals.load_() + 1);
+      push_(thread, fn);
+      return true;
+    }
+  return false;
+}
+
 void ZmScheduler::run_(Thread *thread, Fn &fn)
 {
   if (ZuLikely(push_(thread, fn))) wake(thread);
@@ -350,6 +573,11 @@ void ZmScheduler::work()
 
   m_threadInitFn();
 
+  if (thread->victims) {
+    workStealing(thread);
+    goto final;
+  }
+
   for (;;) { // Note: this is single-threaded, but overCount is SWMR
     if (ZuLikely(!thread->overCount.load_())) goto shift;
     if (Fn fn = thread->overRing.shift()) {
@@ -371,11 +599,49 @@ shift:
     }
   }
 
+final:
   m_threadFinalFn();
 
   --m_runThreads;
 }
 
+// the ring remains the primary queue for directed work (run(), timers, etc.)
+// - only work placed on a stealRing by add() is eligible for stealing
+void ZmScheduler::workStealing(Thread *thread)
+{
+  auto unidle = [this, thread]() {
+    if (thread->idle.cmpXch(0, 1) == 1) --m_idle;
+  };
+  for (;;) { // Note: overCount is SWMR, as in work()
+    if (ZuUnlikely(thread->overCount.load_()))
+      if (Fn fn = thread->overRing.shift()) {
+	if (ZuLikely(tryPush_(thread, fn)))
+	  --thread->overCount;
+	else
+	  thread->overRing.unshift(ZuMv(fn));
+      }
+    if (void *ptr = thread->ring.tryShift()) {
+      thread->ring.shift2(Fn::invoke(ptr));
+      continue;
+    }
+    if (thread->ring.readStatus() == Zu::EndOfFile) break;
+    if (Fn fn = thread->stealRing.shift()) { push_(thread, fn); continue; }
+    if (steal(thread)) continue;
+    // going idle - re-check for work queued before ++m_idle was visible
+    thread->idle = 1;
+    ++m_idle;
+    if (thread->stealRing.count_()) { unidle(); continue; }
+    if (steal(thread)) { unidle(); continue; }
+    // block on the ring, subject to the ring timeout
+    void *ptr = thread->ring.shift();
+    unidle();
+    if (ptr)
+      thread->ring.shift2(Fn::invoke(ptr));
+    else if (thread->ring.readStatus() == Zu::EndOfFile)
+      break;
+  }
+}
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -10,6 +10,8 @@
 // * integrated with telemetry (ZvTelemetry)
 // * isolated (dedicated) and shared threads
 // * timed events (repeat and one-shot)
+//   - red-black tree (default) or hierarchical timing wheel backend
+// * optional work-stealing dispatch of add() jobs between workers
 // * globally configured CPU affinity, priority, etc.
 // * integrates with telemetry (ZvTelemetry)
 
@@ -88,6 +90,9 @@ struct ZmAPI ZmSchedParams {
 
   ZmSchedParams &&startTimer(bool b) { m_startTimer = b; return ZuMv(*this); }
 
+  ZmSchedParams &&stealing(bool b) { m_stealing = b; return ZuMv(*this); }
+  ZmSchedParams &&timerWheel(bool b) { m_timerWheel = b; return ZuMv(*this); }
+
   template <typename L>
   ZmSchedParams &&thread(unsigned sid, L l) {
     l(m_threads[sid]);
@@ -109,6 +114,9 @@ struct ZmAPI ZmSchedParams {
 
   bool startTimer() const { return m_startTimer; }
 
+  bool stealing() const { return m_stealing; }
+  bool timerWheel() const { return m_timerWheel; }
+
   const Thread &thread(unsigned sid) const { return m_threads[sid]; }
 
 public:
@@ -137,6 +145,9 @@ private:
   bool		m_startTimer = false;
 
   bool		m_ll = false;
+
+  bool		m_stealing = false;
+  bool		m_timerWheel = false;
 };
 
 class ZmAPI ZmScheduler : public ZmEngine<ZmScheduler> {
@@ -191,12 +202,50 @@ private:
   };
   enum { OverRing_Increment = 128 };
 
+  // work-stealing deque - add() jobs are queued here when stealing is
+  // enabled; the owning worker and idle siblings both shift from the head,
+  // so thieves always take the longest-waiting job
+  static const char *StealRing_HeapID() { return "ZmScheduler.StealRing"; }
+  using StealRing_ = ZmXRing<Fn, ZmXRingHeapID<StealRing_HeapID>>;
+  struct StealRing : public StealRing_ {
+    using Lock = ZmPLock;
+    using Guard = ZmGuard<Lock>;
+    using ReadGuard = ZmReadGuard<Lock>;
+
+    ZuInline void push(Fn fn) {
+      Guard guard(m_lock);
+      StealRing_::push(ZuMv(fn));
+      ++m_inCount;
+    }
+    ZuInline Fn shift() {
+      if (!StealRing_::count_()) return Fn{}; // avoid locking when empty
+      Guard guard(m_lock);
+      Fn fn = StealRing_::shift();
+      if (fn) ++m_outCount;
+      return fn;
+    }
+    void stats(uint64_t &inCount, uint64_t &outCount) const {
+      ReadGuard guard(m_lock);
+      inCount = m_inCount;
+      outCount = m_outCount;
+    }
+
+    Lock	m_lock;
+    uint64_t	  m_inCount = 0;
+    uint64_t	  m_outCount = 0;
+  };
+  enum { StealRing_Increment = 128 };
+
 private:
   struct Timer_ {
     Fn		fn;
     unsigned	sid = 0;
     ZuTime	timeout;
     bool	transient = false;
+    // timing wheel linkage
+    Timer_	*wheelPrev = nullptr;
+    Timer_	*wheelNext = nullptr;
+    unsigned	wheelSlot = 0;
 
     Timer_() { }
     Timer_(const Timer_ &) = delete;
@@ -223,6 +272,49 @@ private:
 public:
   using Timer = ScheduleTree::Node;
 
+private:
+  // hierarchical timing wheel - Levels x 64 slots, each level covering
+  // 64x the span of the level below, with a resolution of one quantum;
+  // add() and del() are O(1); per-level occupancy bitmaps locate the
+  // earliest occupied slot without scanning; timers in higher levels are
+  // cascaded down a level when the start of their slot is reached
+  class Wheel {
+  public:
+    enum { Bits = 6, Slots = 1<<Bits, Levels = 10 };
+
+    void init(ZuTime quantum);
+
+    unsigned count() const { return m_count; }
+
+    void add(Timer *timer);
+    void del(Timer *timer);
+
+    // lower bound of the earliest timeout (null if empty)
+    ZuTime minimum() const;
+
+    // shift the next timer due at or before now (null if none)
+    Timer *shift(ZuTime now);
+
+  private:
+    struct Slot { Timer_ *head = nullptr, *tail = nullptr; };
+
+    uint64_t ticks(ZuTime t) const {
+      return static_cast<uint64_t>(t.nanosecs() / m_quantum);
+    }
+    ZuTime time(uint64_t ticks) const {
+      return ZuTime{ZuTime::Nano{static_cast<int128_t>(ticks) * m_quantum}};
+    }
+    int first(uint64_t &start) const; // earliest occupied slot, -1 if empty
+    void push(Timer_ *timer, unsigned slot);
+    Timer_ *shift(unsigned slot);
+
+    uint64_t	m_tick = 0;			// current tick
+    uint64_t	m_quantum = 1;			// nanoseconds per tick
+    uint64_t	m_bitmap[Levels] = { 0 };	// occupancy
+    unsigned	m_count = 0;
+    Slot	m_slots[Levels * Slots];
+  };
+
 public:
   ZmScheduler(ZmSchedParams params = {});
   virtual ~ZmScheduler();
@@ -245,6 +337,9 @@ public:
   // sid is "slot ID" - array index of a specific thread in the pool [0,n)
   //
   // add(fn) - immediate execution (asynchronous) on any worker thread
+  //   if stealing is enabled, fn is queued on the caller's own deque (if
+  //   the caller is a worker), otherwise on the next worker's deque, and
+  //   idle workers steal from busy siblings, nearest first
   // run(sid, fn) - immediate execution (asynchronous) on a specific thread
   // push(sid, fn) - enqueue without waking a specific thread
   // invoke(sid, fn) - immediate execution on a specific thread
@@ -259,6 +354,8 @@ public:
   //     Update - (re)schedule regardless
   //     Advance - reschedule unless outstanding timeout is sooner
   //     Defer - reschedule unless outstanding timeout is later
+  //   if timerWheel is enabled, timers are held in a hierarchical timing
+  //   wheel with a resolution of one quantum, rather than a red-black tree
 
   // add(fn, timeout) -
   //   forwards to run(0, fn, timeout, Update, nullptr)
@@ -316,6 +413,16 @@ private:
 public:
   bool del(Timer *);		// cancel job - returns true if found
 
+  // on(sid) - coroutine hop to thread slot sid (sid == 0 - any worker)
+  //   co_await sched->on(sid) resumes the calling ZmTask on sid; if the
+  //   caller is already running on sid, it continues without suspending
+  //   (see ZmTask.hh)
+  struct On {
+    ZmScheduler	*sched;
+    unsigned	sid;
+  };
+  On on(unsigned sid) { return {this, sid}; }
+
   // returns true if caller is running on thread slot sid
   bool invoked(unsigned sid) const {
     ZmAssert(sid && sid <= m_params.nThreads());
@@ -426,6 +533,14 @@ public:
   const OverRing &overRing(unsigned sid) const {
     return m_threads[sid - 1].overRing;
   }
+  // work-stealing deque depth / statistics (stealing mode only)
+  const StealRing &stealRing(unsigned sid) const {
+    return m_threads[sid - 1].stealRing;
+  }
+  // number of jobs stolen by sid from its siblings
+  uint64_t steals(unsigned sid) const {
+    return m_threads[sid - 1].steals.load_();
+  }
 
   unsigned sid(ZuString s) const {
     unsigned sid;
@@ -469,20 +584,49 @@ private:
     ZmThread		thread;
     ZmAtomic<unsigned>	overCount;
     OverRing		overRing;	// fallback overflow ring
+    // work-stealing (stealing mode, non-isolated workers only)
+    StealRing		stealRing;	// local deque
+    Thread		**victims = nullptr; // siblings, nearest first
+    ZmAtomic<unsigned>	idle;		// blocked awaiting work
+    ZmAtomic<uint64_t>	steals;		// jobs stolen from siblings
   };
 
   void wake(Thread *thread) { (thread->wakeFn)(); }
 
   void timer();
   bool timerAdd(Fn &fn);
+  bool timerRun(Timer *timer);
+
+  // timer backend - red-black tree or timing wheel
+  ZuTime schedMinimum() const {
+    if (m_params.timerWheel()) return m_wheel.minimum();
+    if (Timer *first = m_schedule.minimum()) return first->timeout;
+    return {};
+  }
+  void schedAdd(Timer *timer) {
+    if (m_params.timerWheel())
+      m_wheel.add(timer);
+    else
+      m_schedule.addNode(timer);
+  }
+  bool schedDel(Timer *timer) {
+    if (!m_params.timerWheel()) return !!m_schedule.delNode(timer);
+    m_wheel.del(timer);
+    return true;
+  }
 
   void add_(Fn &fn);
+  void steal_(Fn &fn);
+  void kick(Thread *thread);
+  bool steal(Thread *thread);
   void run_(Thread *thread, Fn &fn);
   bool tryRun_(Thread *thread, Fn &fn);
   bool push_(Thread *thread, Fn &fn);
   bool tryPush_(Thread *thread, Fn &fn);
 
+  void initVictims();
   void work();
+  void workStealing(Thread *thread);
 
   ZmSchedParams			m_params;
 
@@ -492,11 +636,13 @@ private:
 
   SchedLock			m_schedLock;
     ScheduleTree		  m_schedule;
+    Wheel			  m_wheel;
 
   ZmAtomic<unsigned>		m_next;
   Thread			*m_threads;
   unsigned			m_nWorkers = 0;
   Thread			**m_workers;
+  ZmAtomic<unsigned>		m_idle;		// # idle workers (stealing)
 
   SpawnLock			m_spawnLock;
     unsigned			  m_runThreads = 0;
@@ -0,0 +1,284 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// C++20 coroutine tasks running on ZmScheduler threads
+//
+// ZmTask<T> is a lazily-started, move-only coroutine returning T;
+// a task starts when it is either awaited by another task (the awaiting
+// task is then resumed directly when the awaited task completes, without
+// passing through a ring) or detached with spawn()
+//
+// coroutine frames are allocated from ZmVHeap<ZmTask_HeapID>
+//
+// co_await sched->on(sid) - continue on thread slot sid (0 - any worker);
+//   if the task is already running on sid, it continues without suspending
+// co_await ZmTaskSuspend<T>(l) - suspend pending I/O completion (or any
+//   other asynchronous event); l(resume) is called with the task suspended,
+//   and must arrange for resume(value) to be called exactly once, on any
+//   thread; the task continues on the thread that calls resume()
+//
+// ZmTask<int> find(ZmScheduler *sched, unsigned sid, Key key) {
+//   co_await sched->on(sid);
+//   co_return co_await ZmTaskSuspend<int>([key](ZmTaskResume<int> resume) {
+//     lookup(key, [resume](int value) { resume(value); });
+//   });
+// }
+// ZmTask<> update(ZmScheduler *sched, unsigned sid, Key key) {
+//   int value = co_await find(sched, sid, key); // no hop, already on sid
+//   ...
+// }
+// update(sched, sid, key).spawn();
+
+#ifndef ZmTask_HH
+#define ZmTask_HH
+
+#ifndef ZmLib_HH
+#include <zlib/ZmLib.hh>
+#endif
+
+#include <coroutine>
+#include <exception>
+
+#include <zlib/ZmAssert.hh>
+#include <zlib/ZmVHeap.hh>
+#include <zlib/ZmScheduler.hh>
+
+inline constexpr const char *ZmTask_HeapID() { return "ZmTask"; }
+
+template <typename T = void> class ZmTask;
+
+namespace ZmTask_ {
+
+// promise state common to all result types
+struct PromiseBase {
+  std::coroutine_handle<>	continuation;	// awaiting task, if any
+  std::exception_ptr		exception;
+  bool				detached = false;
+
+  static void *operator new(size_t n) {
+    return ZmVHeap<ZmTask_HeapID>::valloc(n);
+  }
+  static void operator delete(void *p) {
+    ZmVHeap<ZmTask_HeapID>::vfree(p);
+  }
+
+  std::suspend_always initial_suspend() noexcept { return {}; }
+
+  // on completion, transfer control to the awaiting task (if any),
+  // or self-destruct if detached; an exception thrown by a detached task
+  // has no-one to report to, so terminates once the frame is freed
+  struct Final {
+    bool await_ready() noexcept { return false; }
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(
+	std::coroutine_handle<Promise> h) noexcept {
+      auto &promise = h.promise();
+      if (promise.continuation) return promise.continuation;
+      if (promise.detached) {
+	std::exception_ptr exception = ZuMv(promise.exception);
+	h.destroy();
+	if (ZuUnlikely(exception))
+	  std::rethrow_exception(ZuMv(exception)); // noexcept - terminates
+      }
+      return std::noop_coroutine();
+    }
+    void await_resume() noexcept { }
+  };
+  Final final_suspend() noexcept { return {}; }
+
+  void unhandled_exception() { exception = std::current_exception(); }
+  void rethrow() {
+    if (ZuUnlikely(exception)) std::rethrow_exception(exception);
+  }
+};
+
+template <typename T>
+struct Promise : public PromiseBase {
+  union { T value; };
+  bool	set = false;
+
+  Promise() { }
+  ~Promise() { if (set) value.~T(); }
+
+  ZmTask<T> get_return_object();
+
+  template <typename V>
+  void return_value(V &&v) {
+    new (&value) T{ZuFwd<V>(v)};
+    set = true;
+  }
+
+  T result() {
+    rethrow();
+    ZmAssert(set);
+    return ZuMv(value);
+  }
+};
+template <>
+struct Promise<void> : public PromiseBase {
+  ZmTask<void> get_return_object();
+
+  void return_void() { }
+
+  void result() { rethrow(); }
+};
+
+} // ZmTask_
+
+template <typename T>
+class ZmTask {
+public:
+  using promise_type = ZmTask_::Promise<T>;
+  using Handle = std::coroutine_handle<promise_type>;
+
+  ZmTask() = default;
+  ZmTask(const ZmTask &) = delete;
+  ZmTask &operator =(const ZmTask &) = delete;
+  ZmTask(ZmTask &&t) : m_handle{t.m_handle} { t.m_handle = nullptr; }
+  ZmTask &operator =(ZmTask &&t) {
+    if (ZuLikely(this != &t)) {
+      if (m_handle) m_handle.destroy();
+      m_handle = t.m_handle;
+      t.m_handle = nullptr;
+    }
+    return *this;
+  }
+  ~ZmTask() { if (m_handle) m_handle.destroy(); }
+
+private:
+  explicit ZmTask(Handle h) : m_handle{h} { }
+
+  friend promise_type;
+
+public:
+  bool operator !() const { return !m_handle; }
+  ZuOpBool
+
+  // start the task on the calling thread, detaching it; the frame
+  // is freed when the task completes, and an exception escaping the
+  // task terminates the process
+  void spawn() && {
+    Handle h = m_handle;
+    ZmAssert(h);
+    m_handle = nullptr;
+    h.promise().detached = true;
+    h.resume();
+  }
+
+  // awaiter - start the task, resuming the awaiting task on completion
+  bool await_ready() const noexcept { return false; }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> h) noexcept {
+    m_handle.promise().continuation = h;
+    return m_handle;
+  }
+  T await_resume() { return m_handle.promise().result(); }
+
+private:
+  Handle	m_handle = nullptr;
+};
+
+template <typename T>
+inline ZmTask<T> ZmTask_::Promise<T>::get_return_object()
+{
+  return ZmTask<T>{std::coroutine_handle<Promise>::from_promise(*this)};
+}
+inline ZmTask<void> ZmTask_::Promise<void>::get_return_object()
+{
+  return ZmTask<void>{std::coroutine_handle<Promise>::from_promise(*this)};
+}
+
+// co_await sched->on(sid)
+struct ZmTaskOn {
+  ZmScheduler::On	on;
+
+  bool await_ready() const {
+    return on.sid && on.sched->invoked(on.sid);
+  }
+  void await_suspend(std::coroutine_handle<> h) const {
+    if (on.sid)
+      on.sched->run(on.sid, [h]() { h.resume(); });
+    else
+      on.sched->add([h]() { h.resume(); });
+  }
+  void await_resume() const noexcept { }
+};
+inline ZmTaskOn operator co_await(ZmScheduler::On on) { return {on}; }
+
+// resumption handle passed to the ZmTaskSuspend() lambda
+template <typename T = void>
+class ZmTaskResume {
+template <typename, typename> friend class ZmTaskSuspend_;
+
+  ZmTaskResume(std::coroutine_handle<> h, T *value, bool *set) :
+    m_handle{h}, m_value{value}, m_set{set} { }
+
+public:
+  template <typename V>
+  void operator ()(V &&v) const {
+    new (m_value) T{ZuFwd<V>(v)};
+    *m_set = true;
+    m_handle.resume();
+  }
+
+private:
+  std::coroutine_handle<>	m_handle;
+  T				*m_value;
+  bool				*m_set;
+};
+template <>
+class ZmTaskResume<void> {
+template <typename, typename> friend class ZmTaskSuspend_;
+
+  ZmTaskResume(std::coroutine_handle<> h) : m_handle{h} { }
+
+public:
+  void operator ()() const { m_handle.resume(); }
+
+private:
+  std::coroutine_handle<>	m_handle;
+};
+
+template <typename T, typename L>
+class ZmTaskSuspend_ {
+public:
+  ZmTaskSuspend_(L l) : m_l{ZuMv(l)} { }
+  ~ZmTaskSuspend_() { if (m_set) m_value.~T(); }
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> h) {
+    m_l(ZmTaskResume<T>{h, &m_value, &m_set});
+  }
+  T await_resume() {
+    ZmAssert(m_set);
+    return ZuMv(m_value);
+  }
+
+private:
+  L		m_l;
+  union { T	m_value; };
+  bool		m_set = false;
+};
+template <typename L>
+class ZmTaskSuspend_<void, L> {
+public:
+  ZmTaskSuspend_(L l) : m_l{ZuMv(l)} { }
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> h) {
+    m_l(ZmTaskResume<void>{h});
+  }
+  void await_resume() const noexcept { }
+
+private:
+  L		m_l;
+};
+
+template <typename T = void, typename L>
+inline ZmTaskSuspend_<T, L> ZmTaskSuspend(L l) {
+  return ZmTaskSuspend_<T, L>{ZuMv(l)};
+}
+
+#endif /* ZmTask_HH */
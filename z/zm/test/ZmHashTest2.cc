@@ -18,6 +18,8 @@
 #include <zlib/ZmThread.hh>
 #include <zlib/ZmSingleton.hh>
 #include <zlib/ZmSpecific.hh>
+#include <zlib/ZmHistogram.hh>
+#include <zlib/ZmTime.hh>
 
 struct Order : public ZuObject {
   static unsigned IDAccessor(const Order *o) { return o->id; }
@@ -38,6 +40,46 @@ using Orders =
       ZmHashLock<ZmNoLock,
 	ZmHashHeapID<HeapID>>>>;
 
+void fail() { Zm::exit(1); }
+
+#define CHECK(x) ((x) ? puts("OK  " #x) : (fail(), puts("NOK " #x)))
+
+// grow a hash from 2^7 slots to n entries, timing every insert
+void grow(const char *title, bool incremental, unsigned n)
+{
+  ZmRef<Orders> orders = new Orders(
+      ZmHashParams().bits(7).loadFactor(1.0).incremental(incremental));
+  ZmHistogramStats stats;
+  for (unsigned i = 0; i < n; i++) {
+    // allocate outside of the timed section
+    Orders::Node *node = new Orders::Node{ZmRef<Order>{new Order(i)}};
+    ZuTime begin = Zm::now();
+    orders->addNode(node);
+    stats.record((Zm::now() - begin).nanosecs());
+  }
+  printf("%s: insert latency (ns) max %llu p50 %llu p99 %llu p99.9 %llu\n",
+      title, (unsigned long long)stats.max,
+      (unsigned long long)stats.percentile(50),
+      (unsigned long long)stats.percentile(99),
+      (unsigned long long)stats.percentile(99.9));
+  ZmHashTelemetry data;
+  orders->telemetry(data);
+  printf("  resized %u times, bits %u\n", data.resized, orders->bits());
+  unsigned found = 0;
+  for (unsigned i = 0; i < n; i++) if (orders->findPtr(i)) ++found;
+  CHECK(found == n);
+  CHECK(orders->count_() == n);
+  for (unsigned i = 0; i < n; i += 2) orders->del(i);
+  CHECK(orders->count_() == n / 2);
+  CHECK(!orders->findPtr(0) && orders->findPtr(1));
+  unsigned iterated = 0;
+  {
+    auto i = orders->readIterator();
+    while (i.iterate()) ++iterated;
+  }
+  CHECK(iterated == n / 2);
+}
+
 int main(int argc, char **argv)
 {
   ZmHeapMgr::init("Orders", 0, ZmHeapConfig{0, 100});
@@ -47,9 +89,13 @@ int main(int argc, char **argv)
   for (unsigned i = 0; i < 100; i++) orders->add(new Order(i));
   ZmRef<Order> o = orders->findVal(0);
   dump(o);
-  Orders::Node *n = orders->del(0);
+  Orders::Node *n = orders->del(0).release();
   dump(n->val());
   delete n;
   o = orders->delVal(1);
   dump(o);
+
+  unsigned count = argc > 1 ? atoi(argv[1]) : 1000000;
+  grow("incremental resize", true, count);
+  grow("full resize", false, count);
 }
@@ -6,10 +6,16 @@
 
 /* test program */
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include <zlib/ZmHash.hh>
 #include <zlib/ZmThread.hh>
 #include <zlib/ZmSemaphore.hh>
 #include <zlib/ZmTrap.hh>
+#include <zlib/ZmHistogram.hh>
+#include <zlib/ZmTime.hh>
 
 struct Connection : public ZmObject { };
 
@@ -48,8 +54,88 @@ void stop() {
   sem.post();
 }
 
+using OrderHash = ZmHashKV<unsigned, unsigned, ZmHashLock<ZmPLock>>;
+
+// grows orderHash, timing every insert, while finder concurrently looks up
+// the orders inserted so far
+struct GrowTest {
+  GrowTest(bool incremental) {
+    orderHash = new OrderHash(ZmHashParams().
+	bits(8).loadFactor(1.0).cBits(4).incremental(incremental));
+  }
+
+  void grower(unsigned n) {
+    printf("Starting grower\n");
+    for (unsigned i = 0; i < n; i++) {
+      ZuTime begin = Zm::now();
+      orderHash->add(i, i);
+      insertLatency.record((Zm::now() - begin).nanosecs());
+      grown.store_(i + 1);
+    }
+    running = false;
+  }
+  void finder() {
+    printf("Starting finder\n");
+    unsigned lookups = 0;
+    while (running) {
+      if (unsigned n = grown.load_()) {
+	unsigned i = lookups++ % n;
+	if (orderHash->findVal(i) != i) {
+	  printf("order %u not found\n", i);
+	  Zm::exit(1);
+	}
+      }
+    }
+  }
+  ZmRef<OrderHash>	orderHash;
+  ZmAtomic<unsigned>	grown = 0;
+  ZmHistogramStats	insertLatency;
+};
+
+void grow(bool incremental, unsigned n)
+{
+  GrowTest test{incremental};
+
+  ZmThread finder{[&test]() { test.finder(); }};
+  ZmThread grower{[&test, n]() { test.grower(n); }};
+
+  grower.join();
+  finder.join();
+
+  const auto &stats = test.insertLatency;
+  printf("%s: insert latency (ns) max %llu p50 %llu p99 %llu p99.9 %llu\n",
+      incremental ? "incremental resize" : "full resize",
+      (unsigned long long)stats.max,
+      (unsigned long long)stats.percentile(50),
+      (unsigned long long)stats.percentile(99),
+      (unsigned long long)stats.percentile(99.9));
+  printf("  %u orders, bits %u\n",
+      test.orderHash->count_(), test.orderHash->bits());
+}
+
+void usage()
+{
+  fputs("usage: ZmHashThread [-g [-i] N]\n"
+    "  -g\tgrow a hash to N orders while concurrently looking them up\n"
+    "  -i\tincremental resize\n", stderr);
+  Zm::exit(1);
+}
+
 int main(int argc, char *argv[])
 {
+  if (argc > 1) {
+    bool incremental = false;
+    unsigned n = 0;
+    if (strcmp(argv[1], "-g")) usage();
+    for (int i = 2; i < argc; i++) {
+      if (!strcmp(argv[i], "-i")) { incremental = true; continue; }
+      if (argv[i][0] == '-' || !(n = atoi(argv[i]))) usage();
+    }
+    if (!n) usage();
+    grow(incremental, n);
+    return 0;
+  }
+
   ZmTrap::sigintFn(stop);
   ZmTrap::trap();
   TestObject prog;
@@ -24,6 +24,96 @@ template <typename Heap> struct S_ : public Heap {
 static constexpr const char *ID() { return "S"; }
 using S = S_<ZmHeap<ID, sizeof(S_<ZuNull>)> >;
 
+// cross-thread producer / consumer benchmark - objects are allocated
+// by one thread and freed by another (e.g. rx thread -> app thread),
+// with and without per-thread magazines, and with allocN() / freeN()
+static constexpr const char *PlainID() { return "P"; }
+static constexpr const char *MagID() { return "M"; }
+using P = S_<ZmHeap<PlainID, sizeof(S_<ZuNull>)> >;
+using M = S_<ZmHeap<MagID, sizeof(S_<ZuNull>)> >;
+
+enum { Batch = 64, NBatches = 16, MagSize = 64 };
+
+struct PC {
+  void		*batches[NBatches][Batch];
+  ZmSemaphore	credits;	// batches available to the producer
+  ZmSemaphore	done;		// batches freed by the consumer
+};
+
+template <typename T, bool Bulk>
+void consume(PC *pc, void **batch)
+{
+  if constexpr (Bulk) {
+    for (unsigned i = 0; i < Batch; i++) {
+      auto t = static_cast<T *>(batch[i]);
+      t->doit();
+      t->~T();
+    }
+    T::freeN(batch, Batch);
+  } else {
+    for (unsigned i = 0; i < Batch; i++) {
+      auto t = static_cast<T *>(batch[i]);
+      t->doit();
+      delete t;
+    }
+  }
+  pc->credits.post();
+  pc->done.post();
+}
+
+template <typename T, bool Bulk>
+void produce(ZmScheduler *s, PC *pc, unsigned n)
+{
+  for (unsigned j = 0; j < n; j++) {
+    pc->credits.wait();
+    void **batch = pc->batches[j % NBatches];
+    if constexpr (Bulk) {
+      T::allocN(batch, Batch);
+      for (unsigned i = 0; i < Batch; i++)
+	new (batch[i]) T{static_cast<int>(j * Batch + i)};
+    } else {
+      for (unsigned i = 0; i < Batch; i++)
+	batch[i] = new T{static_cast<int>(j * Batch + i)};
+    }
+    s->run(2, [pc, batch]() { consume<T, Bulk>(pc, batch); });
+  }
+}
+
+ZmHeapTelemetry heapTelemetry(const char *id)
+{
+  ZmHeapTelemetry data;
+  data.id = id;
+  ZmHeapMgr::all(ZmFn<void(ZmHeapCache *)>{
+    &data, [](ZmHeapTelemetry *data, ZmHeapCache *cache) {
+      if (data->id == cache->info().id) cache->telemetry(*data);
+    }});
+  return data;
+}
+
+template <typename T, bool Bulk>
+void pcBench(ZmScheduler *s, const char *name, const char *id, unsigned n)
+{
+  PC pc;
+  for (unsigned i = 0; i < NBatches; i++) pc.credits.post();
+  n = (n + Batch - 1) / Batch;
+  auto before = heapTelemetry(id);
+  ZuTime start = Zm::now();
+  s->run(1, [s, &pc, n]() { produce<T, Bulk>(s, &pc, n); });
+  for (unsigned j = 0; j < n; j++) pc.done.wait();
+  ZuTime end = Zm::now();
+  end -= start;
+  auto after = heapTelemetry(id);
+  auto cacheAllocs = after.cacheAllocs - before.cacheAllocs;
+  auto frees = after.frees - before.frees;
+  printf("%-16s %6.1f ns/object  magazine hit rate "
+      "alloc %5.1f%% free %5.1f%%\n", name,
+      double(end.nanosecs()) / (double(n) * double(Batch)),
+      cacheAllocs ? double(after.magAllocs - before.magAllocs) * 100 /
+	double(cacheAllocs) : 0.0,
+      frees ? double(after.magFrees - before.magFrees) * 100 /
+	double(frees) : 0.0);
+}
+
 void usage()
 {
   fputs(
@@ -74,5 +164,18 @@ int main(int argc, char **argv)
   ZuTime end = Zm::now();
   end -= start;
   printf("%u.%09u\n", (unsigned)end.sec(), (unsigned)end.nsec());
+
+  ZmHeapMgr::init("P", 0, ZmHeapConfig{0, static_cast<unsigned>(size)});
+  ZmHeapMgr::init("M", 0,
+      ZmHeapConfig{0, static_cast<unsigned>(size), {}, MagSize});
+  {
+    ZmScheduler pc{ZmSchedParams().id("pc").nThreads(2).startTimer(false)};
+    pc.start();
+    pcBench<P, false>(&pc, "new/delete", "P", count);
+    pcBench<M, false>(&pc, "magazine", "M", count);
+    pcBench<M, true>(&pc, "allocN/freeN", "M", count);
+    pc.stop();
+  }
+
   std::cout << ZmHeapMgr::csv();
 }
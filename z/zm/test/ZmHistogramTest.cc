@@ -0,0 +1,99 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+/* test program */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <zlib/ZuTime.hh>
+
+#include <zlib/ZmHistogram.hh>
+#include <zlib/ZmThread.hh>
+#include <zlib/ZmTime.hh>
+
+void fail() { }
+
+#define CHECK(x) ((x) ? puts("OK  " #x) : (fail(), puts("NOK " #x)))
+
+static constexpr const char *LinearID() { return "linear"; }
+static constexpr const char *TimedID() { return "timed"; }
+
+// true if v is within the histogram's precision of expected
+bool near(uint64_t v, uint64_t expected)
+{
+  uint64_t d = v > expected ? v - expected : expected - v;
+  return d * 100 <= expected;
+}
+
+int main()
+{
+  using namespace ZmHistogramBuckets;
+
+  // bucket boundaries are contiguous and monotonic
+  {
+    bool ok = true;
+    for (unsigned i = 1; i < N; i++)
+      if (value(i) <= value(i - 1) ||
+	  bucket(value(i)) != i || bucket(value(i - 1) + 1) != i)
+	ok = false;
+    CHECK(ok);
+    CHECK(bucket(MaxValue) == N - 1);
+    CHECK(bucket(~uint64_t(0)) == N - 1);
+  }
+
+  // 1..100000 recorded by 4 threads, 25000 values each
+  enum { NThreads = 4, NValues = 100000 };
+  {
+    ZmThread threads[NThreads];
+    for (unsigned t = 0; t < NThreads; t++)
+      threads[t] = ZmThread{[t]() {
+	for (unsigned i = t + 1; i <= NValues; i += NThreads)
+	  ZmHistogramT<LinearID>::record(i);
+      }};
+    for (unsigned t = 0; t < NThreads; t++) threads[t].join();
+  }
+  ZmHistogramT<LinearID>::record(0); // this thread
+  {
+    ZmHistogramTelemetry data;
+    ZmHistogramT<LinearID>::histogram()->telemetry(data);
+    CHECK(data.id == "linear");
+    CHECK(data.count == NValues + 1);
+    CHECK(data.min == 0);
+    CHECK(data.max == NValues);
+    CHECK(near(data.mean, NValues / 2));
+    CHECK(near(data.p50, NValues / 2));
+    CHECK(near(data.p90, NValues * 9 / 10));
+    CHECK(near(data.p99, NValues * 99 / 100));
+    CHECK(near(data.p999, NValues * 999 / 1000));
+  }
+
+  // benchmark recording overhead, with the histogram itself
+  {
+    enum { N = 10000000 };
+    ZuTime begin = Zm::now();
+    for (unsigned i = 0; i < N; i++)
+      ZmHistogramT<TimedID>::record(i & 0xffff);
+    ZuTime end = Zm::now();
+    ZmHistogramT<TimedID>::record((end - begin).nanosecs() / N);
+    printf("record: %.2fns\n",
+	double((end - begin).nanosecs()) / double(N));
+  }
+
+  unsigned n = 0;
+  ZmHistogramMgr::all([&n](ZmHistogram *h) {
+    ZmHistogramTelemetry data;
+    h->telemetry(data);
+    printf("%s count=%lu min=%lu mean=%lu p50=%lu p90=%lu p99=%lu "
+	"p99.9=%lu max=%lu\n", data.id.data(),
+	(unsigned long)data.count, (unsigned long)data.min,
+	(unsigned long)data.mean, (unsigned long)data.p50,
+	(unsigned long)data.p90, (unsigned long)data.p99,
+	(unsigned long)data.p999, (unsigned long)data.max);
+    ++n;
+  });
+  CHECK(n == 2);
+}
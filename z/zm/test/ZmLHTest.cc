@@ -84,6 +84,7 @@ using S = String<16>;
 
 using Hash = ZmHashKV<S, int, ZmHashLock<ZmNoLock>>;
 using LHash = ZmLHashKV<S, int, ZmLHashLock<ZmNoLock>>;
+using SHash = ZmLHashKV<S, int, ZmLHashLock<ZmNoLock, ZmLHashSwiss<>>>;
 
 template <typename H>
 struct HashAdapter {
@@ -261,6 +262,8 @@ template <typename H, template <typename> class A> void funcTest()
 
 using PerfHash = ZmHashKV<int, String<16>, ZmHashLock<ZmLock> >;
 using PerfLHash = ZmLHashKV<int, String<16>, ZmLHashLock<ZmLock> >;
+using PerfSHash =
+  ZmLHashKV<int, String<16>, ZmLHashLock<ZmLock, ZmLHashSwiss<>>>;
 
 int perfTestSize = 1000;
 
@@ -299,12 +302,71 @@ template <typename H, template <typename> class A> void perfTest()
   for (int bits = 8; bits < 12; bits++) perfTest_<H, A>(bits);
 }
 
+// read-mostly lookup benchmark - hits, then misses; keys are scattered
+// (sequential integers hash to sequential slots, which flatters linear
+// probing), and are either integers or strings
+using LookupLHash = ZmLHashKV<int, String<16>>;
+using LookupSHash = ZmLHashKV<int, String<16>, ZmLHashSwiss<>>;
+using LookupLHashS = ZmLHashKV<S, int>;
+using LookupSHashS = ZmLHashKV<S, int, ZmLHashSwiss<>>;
+
+// bijective scrambling of i, so that keys are distinct
+inline int lookupKey_(int i) { return int(unsigned(i) * 0x9e3779b1U); }
+template <typename Key> struct LookupKey {
+  static int key(int i) { return lookupKey_(i); }
+};
+template <> struct LookupKey<S> {
+  static S key(int i) {
+    S s;
+    snprintf(s.data(), 16, "k%08x", unsigned(lookupKey_(i)));
+    return s;
+  }
+};
+
+template <typename H>
+void lookupTest(const char *name, double loadFactor, int n)
+{
+  using Key = typename H::Key;
+  using Val = typename H::Val;
+
+  ZmRef<H> h = new H(ZmHashParams().bits(4).loadFactor(loadFactor));
+  Key *keys = new Key[n<<1];
+  for (int i = 0; i < (n<<1); i++) keys[i] = LookupKey<Key>::key(i);
+
+  for (int i = 0; i < n; i++) h->add(keys[i], Val{});
+
+  int reps = 10000000 / n;
+  if (reps < 1) reps = 1;
+
+  unsigned found = 0;
+  ZuTime start = Zm::now();
+  for (int j = 0; j < reps; j++)
+    for (int i = 0; i < n; i++) found += !!h->find(keys[i]);
+  ZuTime hit = Zm::now() - start;
+  CHECK(found == unsigned(reps) * n);
+
+  found = 0;
+  start = Zm::now();
+  for (int j = 0; j < reps; j++)
+    for (int i = n; i < (n<<1); i++) found += !!h->find(keys[i]);
+  ZuTime miss = Zm::now() - start;
+  CHECK(!found);
+
+  delete [] keys;
+
+  printf("%s (n %d, load factor %.3g, bits %u): "
+    "hit %.1fns miss %.1fns\n", name, n, loadFactor, h->bits(),
+    double(hit.nanosecs()) / (double(reps) * n),
+    double(miss.nanosecs()) / (double(reps) * n));
+}
+
 int main(int argc, char **argv)
 {
   ZuTime start, end;
 
   funcTest<Hash, HashAdapter>();
   funcTest<LHash, LHashAdapter>();
+  funcTest<SHash, LHashAdapter>();
 
   if (argc > 1) perfTestSize = atoi(argv[1]);
   if (argc > 2) concurrency = atoi(argv[2]);
@@ -324,4 +386,19 @@ int main(int argc, char **argv)
   end -= start;
   printf("ZmLHash time: %d.%.3d\n",
     (int)end.sec(), (int)(end.nsec() / 1000000));
+
+  start = Zm::now();
+  for (int i = 0; i < 10; i++) perfTest<PerfSHash, LHashAdapter>();
+  end = Zm::now();
+  end -= start;
+  printf("ZmLHashSwiss time: %d.%.3d\n",
+    (int)end.sec(), (int)(end.nsec() / 1000000));
+
+  for (int n : { perfTestSize, 1<<20 })
+    for (double loadFactor : { 0.5, 1.0 }) {
+      lookupTest<LookupLHash>("ZmLHash<int>", loadFactor, n);
+      lookupTest<LookupSHash>("ZmLHashSwiss<int>", loadFactor, n);
+      lookupTest<LookupLHashS>("ZmLHash<string>", loadFactor, n);
+      lookupTest<LookupSHashS>("ZmLHashSwiss<string>", loadFactor, n);
+    }
 }
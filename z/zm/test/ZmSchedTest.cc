@@ -16,6 +16,9 @@
 #include <zlib/ZmSpecific.hh>
 #include <zlib/ZmBackoff.hh>
 #include <zlib/ZmTimeout.hh>
+#include <zlib/ZmSemaphore.hh>
+
+#include <zlib/ZuSort.hh>
 
 struct TLS : public ZmObject {
   TLS() : m_ping(0) {
@@ -84,6 +87,9 @@ void usage()
     "  -n N\tset number of threads to N\n"
     "  -c ID=CPUSET\tset thread ID affinity to CPUSET (e.g. 1=2,4)\n"
     "  -i BITMAP\tset isolation (e.g. 1,3-4)\n"
+    "  -w\tuse the timing wheel timer backend\n"
+    "  -b N\tbenchmark N bursty jobs, round-robin vs. work-stealing\n"
+    "  -t N\tbenchmark N timer operations per thread, tree vs. wheel\n"
     , stderr);
   Zm::exit(1);
 }
@@ -103,6 +109,109 @@ void breakpoint(ZmScheduler::Timer *timer)
 {
 }
 
+// bursty load - every 16th job is slow (100us), the remainder fast (1us);
+// reports queueing latency (add() to start of execution) percentiles
+static void spin(unsigned nsecs)
+{
+  ZuTime end = Zm::now() + ZuTime{ZuTime::Nano{nsecs}};
+  while (Zm::now() < end);
+}
+
+void bench(unsigned nThreads, unsigned nJobs, bool stealing)
+{
+  ZmScheduler s{ZmSchedParams().id(stealing ? "steal" : "rr").
+    nThreads(nThreads).stealing(stealing)};
+  auto latency = new int64_t[nJobs];
+  ZmSemaphore done;
+  ZmAtomic<unsigned> pending = nJobs;
+
+  s.start();
+  ZuTime begin = Zm::now();
+  for (unsigned i = 0; i < nJobs; i++) {
+    ZuTime start = Zm::now();
+    s.add([latency, i, start, &done, &pending]() {
+      latency[i] = (Zm::now() - start).nanosecs();
+      spin((i & 15) ? 1000 : 100000);
+      if (!--pending) done.post();
+    });
+    if ((i & 63) == 63) spin(200000); // bursts of 64
+  }
+  done.wait();
+  ZuTime elapsed = Zm::now() - begin;
+  s.stop();
+
+  ZuSort(latency, nJobs);
+  auto pct = [latency, nJobs](double p) {
+    unsigned i = nJobs * p;
+    return latency[i < nJobs ? i : nJobs - 1];
+  };
+  printf("%s: elapsed %.3fs latency (us) p50 %.1f p99 %.1f p99.9 %.1f "
+      "max %.1f\n", stealing ? "work-stealing" : "round-robin  ",
+      double(elapsed.as_fp()),
+      double(pct(.5)) / 1000.0, double(pct(.99)) / 1000.0,
+      double(pct(.999)) / 1000.0, double(latency[nJobs - 1]) / 1000.0);
+  if (stealing)
+    for (unsigned sid = 1, n = s.params().nThreads(); sid <= n; sid++)
+      printf("  %u: steals %lu\n", sid, (unsigned long)s.steals(sid));
+
+  delete [] latency;
+}
+
+// timer churn - each worker repeatedly arms, re-arms and cancels timers
+// drawn at random from its own set, with timeouts spread over 1-2s (so
+// that none expire during the run); reports mean cost per operation, then
+// verifies that a final batch of short timers all fire
+void churn(unsigned nThreads, unsigned nOps, bool wheel)
+{
+  enum { NTimers = 1024 };
+  ZmScheduler s{ZmSchedParams().id(wheel ? "wheel" : "tree").
+    nThreads(nThreads).timerWheel(wheel)};
+  unsigned n = nThreads * NTimers;
+  auto timers = new ZmScheduler::Timer[n];
+  ZmSemaphore done;
+  ZmAtomic<unsigned> fired = 0;
+
+  s.start();
+  ZuTime begin = Zm::now();
+  for (unsigned sid = 1; sid <= nThreads; sid++) {
+    auto timers_ = &timers[(sid - 1) * NTimers];
+    s.run(sid, [&s, &done, nOps, timers_]() {
+      uint64_t seed = reinterpret_cast<uintptr_t>(timers_) | 1;
+      for (unsigned i = 0; i < nOps; i++) {
+	seed ^= seed<<13; seed ^= seed>>7; seed ^= seed<<17; // xorshift
+	auto timer = &timers_[seed & (NTimers - 1)];
+	ZuTime out = Zm::now() + ZuTime{ZuTime::Nano{
+	  int128_t(1000000000 + (seed>>32) % 1000000000)}};
+	switch (i & 3) {
+	  case 0:
+	  case 1: s.add([]{ }, out, timer); break;
+	  case 2: s.add([]{ }, out, ZmScheduler::Defer, timer); break;
+	  case 3: s.del(timer); break;
+	}
+      }
+      done.post();
+    });
+  }
+  for (unsigned i = 0; i < nThreads; i++) done.wait();
+  ZuTime elapsed = Zm::now() - begin;
+
+  for (unsigned i = 0; i < n; i++) s.del(&timers[i]);
+  ZuTime out = Zm::now();
+  for (unsigned i = 0; i < n; i++)
+    s.add([&fired]() { ++fired; },
+	out + ZuTime{ZuTime::Nano{int128_t(i % 50) * 1000000}}, &timers[i]);
+  Zm::sleep(ZuTime{.5});
+  unsigned late = 0;
+  for (unsigned i = 0; i < n; i++) if (s.del(&timers[i])) ++late;
+  s.stop();
+
+  printf("%s: %.1f ns/op\n", wheel ? "timing wheel" : "rb-tree     ",
+      double(elapsed.nanosecs()) / (double(nOps) * nThreads));
+  if (late || fired.load_() != n) fail("timers did not all fire");
+
+  delete [] timers;
+}
+
 int main(int argc, char **argv)
 {
   {
@@ -120,6 +229,8 @@ int main(int argc, char **argv)
 
   ZmSchedParams params = ZmSchedParams().id("sched");
   ZmBitmap isolation;
+  unsigned nJobs = 0;
+  unsigned nOps = 0;
 
   for (int i = 1; i < argc; i++) {
     if (argv[i][0] != '-') usage();
@@ -143,9 +254,32 @@ int main(int argc, char **argv)
 	if (++i >= argc) usage();
 	isolation = argv[i];
 	break;
+      case 'b':
+	if (++i >= argc) usage();
+	nJobs = ZuBox<unsigned>(argv[i]);
+	break;
+      case 't':
+	if (++i >= argc) usage();
+	nOps = ZuBox<unsigned>(argv[i]);
+	break;
+      case 'w':
+	params.timerWheel(true);
+	break;
     }
   }
 
+  if (nJobs) {
+    bench(params.nThreads(), nJobs, false);
+    bench(params.nThreads(), nJobs, true);
+    return 0;
+  }
+
+  if (nOps) {
+    churn(params.nThreads(), nOps, false);
+    churn(params.nThreads(), nOps, true);
+    return 0;
+  }
+
   {
     int tid = isolation.first();
     do {
@@ -0,0 +1,119 @@
+//  -*- mode:c++; indent-tabs-mode:t; tab-width:8; c-basic-offset:2; -*-
+//  vi: noet ts=8 sw=2 cino=+0,(s,l1,m1,g0,N-s,j1,U1,W2,i2
+
+// (c) Copyright 2024 Psi Labs
+// This code is licensed by the MIT license (see LICENSE for details)
+
+// coroutine task test program
+
+#include <zlib/ZuLib.hh>
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <zlib/ZmTask.hh>
+#include <zlib/ZmScheduler.hh>
+#include <zlib/ZmSemaphore.hh>
+#include <zlib/ZmThread.hh>
+#include <zlib/ZmTime.hh>
+
+void fail() { Zm::exit(1); }
+
+#define CHECK(x) ((x) ? puts("OK  " #x) : (fail(), puts("NOK " #x)))
+
+static unsigned sid() { return ZmSelf()->sid(); }
+
+ZmTask<unsigned> where(ZmScheduler *s, unsigned sid_)
+{
+  co_await s->on(sid_);
+  co_return sid();
+}
+
+// asynchronous "I/O" completed by another thread
+ZmTask<int> io(ZmScheduler *s, unsigned completer, int v)
+{
+  co_return co_await ZmTaskSuspend<int>(
+      [s, completer, v](ZmTaskResume<int> resume) {
+	s->run(completer, [resume, v]() { resume(v * 2); });
+      });
+}
+
+ZmTask<> thrower(ZmScheduler *s)
+{
+  co_await s->on(2);
+  throw 42;
+}
+
+ZmTask<> flow(ZmScheduler *s, ZmSemaphore *done)
+{
+  co_await s->on(1);
+  CHECK(sid() == 1);
+  unsigned i = co_await where(s, 2);
+  CHECK(i == 2);
+  CHECK(sid() == 2);
+  i = co_await where(s, 2); // no hop
+  CHECK(i == 2);
+  int v = co_await io(s, 1, 21);
+  CHECK(v == 42);
+  CHECK(sid() == 1);
+  try {
+    co_await thrower(s);
+    CHECK(false);
+  } catch (int e) {
+    CHECK(e == 42);
+  }
+  done->post();
+}
+
+// continuation-passing baseline - one ring hop per step
+void cps(ZmScheduler *s, unsigned n, ZmSemaphore *done)
+{
+  if (!n) { done->post(); return; }
+  s->run(1, [s, n, done]() { cps(s, n - 1, done); });
+}
+
+ZmTask<unsigned> step(ZmScheduler *s, unsigned i)
+{
+  co_await s->on(1);
+  co_return i + 1;
+}
+
+ZmTask<> steps(ZmScheduler *s, unsigned n, ZmSemaphore *done)
+{
+  co_await s->on(1);
+  unsigned j = 0;
+  for (unsigned i = 0; i < n; i++) j = co_await step(s, j);
+  CHECK(j == n);
+  done->post();
+}
+
+int main(int argc, char **argv)
+{
+  unsigned n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+  ZmScheduler s{ZmSchedParams().id("task").nThreads(2)};
+  s.start();
+
+  ZmSemaphore done;
+
+  flow(&s, &done).spawn();
+  done.wait();
+
+  // same-thread chains - n continuation hops vs. n awaited tasks
+  {
+    ZuTime begin = Zm::now();
+    s.run(1, [&s, n, &done]() { cps(&s, n, &done); });
+    done.wait();
+    ZuTime cpsTime = Zm::now() - begin;
+    begin = Zm::now();
+    steps(&s, n, &done).spawn();
+    done.wait();
+    ZuTime taskTime = Zm::now() - begin;
+    printf("continuations: %.1f ns/step\n",
+	double(cpsTime.nanosecs()) / n);
+    printf("tasks:         %.1f ns/step\n",
+	double(taskTime.nanosecs()) / n);
+  }
+
+  s.stop();
+}
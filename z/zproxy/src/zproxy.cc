@@ -150,7 +150,8 @@ public:
     SuspRecv	= 0x004,	// read suspended
     SuspSend	= 0x008,	// send suspended
     Trace	= 0x010,	// trace
-    Drop	= 0x020		// drop
+    Drop	= 0x020,	// drop
+    Splice	= 0x040		// relay using splice()
   };
 
   Connection(Proxy *proxy,
@@ -244,6 +245,10 @@ public:
   void disconnected(Connection *connection);
 
 private:
+#ifdef ZiMultiplex_EPoll
+  bool splice() const;
+#endif
+
   void status_(ZuVStream &) const;
   template <typename S> void status_(S &s_) const {
     ZuVStream s{s_};
@@ -280,7 +285,8 @@ template <typename S> inline void Connection::print(S &s) const
     ((m_flags & Connection::SuspRecv) ? 'R' : '-') <<
     ((m_flags & Connection::SuspSend) ? 'S' : '-') <<
     ((m_flags & Connection::Trace) ? 'T' : '-') <<
-    ((m_flags & Connection::Drop) ? 'D' : '-') << ']';
+    ((m_flags & Connection::Drop) ? 'D' : '-') <<
+    ((m_flags & Connection::Splice) ? 'Z' : '-') << ']';
 }
 
 struct ListenerPrintIn;
@@ -475,6 +481,7 @@ public:
 	"hold { flag hold } "
 	"trace { flag trace } "
 	"drop { flag drop } "
+	"splice { flag splice } "
 	"latency { param latency } "
 	"frag { param frag } "
 	"pack { param pack } "
@@ -490,6 +497,8 @@ public:
 	    "  --hold\t- hold connections open until released\n"
 	    "  --trace\t- hex dump traffic\n"
 	    "  --drop\t- drop (discard) incoming traffic\n"
+	    "  --splice\t- relay in-kernel using splice() (Linux epoll);\n"
+	    "\t  excludes suspend, trace, drop, latency, frag, pack, delay\n"
 	    "  --latency=N\t- introduce latency of N seconds\n"
 	    "  --frag=N\t- fragment packets into N fragments\n"
 	    "  --pack=N\t- consolidate packets into N bytes\n"
@@ -623,6 +632,12 @@ public:
       cxnPack = args->getInt("pack", INT_MIN, INT_MAX, 0);
       cxnDelay = args->getDbl("delay", 0, 3600, 0);
       reconnectFreq = args->getInt("reconnect", 1, 3600, 1);
+      if (args->getBool("splice")) {
+	if ((cxnFlags & (Connection::SuspRecv | Connection::Trace |
+		Connection::Drop)) ||
+	    cxnLatency || cxnFrag || cxnPack || cxnDelay) throw ZeError();
+	cxnFlags |= Connection::Splice;
+      }
     } catch (...) {
       throw ZcmdUsage();
     }
@@ -1360,11 +1375,29 @@ void Proxy::connected(Connection *connection)
     if (m_app->verbose()) { ZeLOG(Info, status()); }
     m_in->peer(m_out);
     m_out->peer(m_in);
+#ifdef ZiMultiplex_EPoll
+    if (splice()) {
+      m_in->splice(m_out);
+      m_out->splice(m_in);
+      return;
+    }
+#endif
     m_in->recv();
     m_out->recv();
   }
 }
 
+#ifdef ZiMultiplex_EPoll
+bool Proxy::splice() const
+{
+  if (!(m_in->flags() & Connection::Splice)) return false;
+#ifdef ZiMultiplex_IOURing
+  if (m_mx->uring()) return false;
+#endif
+  return true;
+}
+#endif
+
 void Proxy::connect2()
 {
   if (!m_listener) return;
@@ -1514,6 +1547,7 @@ int main(int argc, char **argv)
   static ZvOpt opts[] = {
     { 'v', "verbose", ZvOptType::Flag, "verbose" },
     { 't', "nThreads",  ZvOptType::Param, "mx.nThreads" },
+    { 'u', "uring", ZvOptType::Flag, "mx.uring" },
     { 0 }
   };
 
@@ -1522,7 +1556,8 @@ int main(int argc, char **argv)
     "\n"
     "Options:\n"
     "  -v, --verbose\t- log connection setup and teardown events\n"
-    "  -t, --n-threads=N\t- set number of threads\n";
+    "  -t, --n-threads=N\t- set number of threads\n"
+    "  -u, --uring\t- use io_uring instead of epoll (Linux)\n";
 
   bool interactive = Zrl::interactive();
 
@@ -7,12 +7,21 @@
 // CSV parser
 
 #include <stdio.h>
+#include <string.h>
 #include <ctype.h>
 
+#include <zlib/ZuIntrin.hh>
+
 #include <zlib/ZePlatform.hh>
 
 #include <zlib/ZvCSV.hh>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace ZvCSV_ {
 
 void split(ZuString row, ZtArray<ZtArray<char>> &values)
@@ -93,4 +102,168 @@ void split(ZuString row, ZtArray<ZtArray<char>> &values)
   }
 }
 
+namespace {
+
+// bitmask of delimiters (',', '"' and '\n') in the Width bytes at p
+#ifdef __AVX2__
+enum { Width = 32 };
+ZuInline uint32_t delimiters(const char *p) {
+  __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+  return _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(
+	_mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')),
+	_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'))),
+	_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))));
+}
+#elif defined(__SSE2__)
+enum { Width = 16 };
+ZuInline uint32_t delimiters(const char *p) {
+  __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+  return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(
+	_mm_cmpeq_epi8(v, _mm_set1_epi8(',')),
+	_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))),
+	_mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+}
+#else
+enum { Width = 16 };
+ZuInline uint32_t delimiters(const char *p) {
+  uint32_t m = 0;
+  for (unsigned i = 0; i < Width; i++) {
+    char c = p[i];
+    m |= uint32_t(c == ',' || c == '"' || c == '\n')<<i;
+  }
+  return m;
+}
+#endif
+
+// the final partial block is copied to avoid reading beyond the input
+ZuInline uint32_t delimiters(const char *p, const char *end) {
+  if (ZuLikely(end - p >= Width)) return delimiters(p);
+  char buf[Width] = { 0 };
+  memcpy(buf, p, end - p);
+  return delimiters(buf);
+}
+
+// unquote n bytes at s into out, returns length (<= n)
+unsigned unquote_(const char *s, unsigned n, char *out)
+{
+  enum { Value = 0, Quoted, Quoted2 };
+  int state = Value;
+  unsigned o = 0;
+  for (unsigned i = 0; i < n; i++) {
+    char ch = s[i];
+    switch (state) {
+      case Value:
+	if (ch == '"') { state = Quoted; break; }
+	out[o++] = ch;
+	break;
+      case Quoted:
+	if (ch == '"') { state = Quoted2; break; }
+	out[o++] = ch;
+	break;
+      case Quoted2:
+	if (ch == '"') { out[o++] = ch; state = Quoted; break; }
+	out[o++] = ch;
+	state = Value;
+	break;
+    }
+  }
+  return o;
+}
+
+} // anon namespace
+
+Splitter::Splitter(const char *begin, const char *end) :
+  m_next{begin}, m_end{end}, m_block{begin}
+{
+  if (begin < end) m_mask = delimiters(begin, end);
+}
+
+// delimiters within quotes are skipped by tracking quote parity, which
+// is sufficient to find field and row boundaries; doubled quotes within
+// quotes toggle the parity twice, and are resolved by unquote()
+bool Splitter::row()
+{
+  for (;;) {
+    if (m_next >= m_end) return false;
+    m_fields.clear();
+    const char *start = m_next;	// start of current field
+    const char *end;		// end of row
+    bool inQuote = false, quoted = false;
+    for (;;) {
+      if (!m_mask) {
+	if (m_end - m_block <= Width) { end = m_end; break; }
+	m_block += Width;
+	m_mask = delimiters(m_block, m_end);
+	continue;
+      }
+      const char *p = m_block + ZuIntrin::ctz(m_mask);
+      m_mask &= m_mask - 1;
+      char c = *p;
+      if (c == '"') { inQuote = !inQuote; quoted = true; continue; }
+      if (inQuote) continue;
+      if (c == '\n') { end = p; break; }
+      m_fields.push(ZuString{start, unsigned(p - start)});
+      while (++p < m_end && (*p == ' ' || *p == '\t' || *p == '\r'));
+      start = p;
+    }
+    m_next = end < m_end ? end + 1 : end;
+    // discard trailing white space, including any '\r'
+    while (end > start &&
+	(end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) --end;
+    if (!m_fields.length() && end == start) continue; // empty row
+    m_fields.push(ZuString{start, unsigned(end - start)});
+    if (quoted) unquote();
+    return true;
+  }
+}
+
+// unquote values in the current row containing quotes; the buffer is
+// sized to the row length before any values are written to it, since
+// the unquoted length of each value never exceeds the quoted length
+void Splitter::unquote()
+{
+  unsigned n = m_fields.length();
+  const char *begin = m_fields[0].data();
+  const char *end = m_fields[n - 1].data() + m_fields[n - 1].length();
+  char *out = m_buf.ensure(end - begin);
+  for (unsigned i = 0; i < n; i++) {
+    ZuString &field = m_fields[i];
+    if (!memchr(field.data(), '"', field.length())) continue;
+    unsigned o = unquote_(field.data(), field.length(), out);
+    field = ZuString{out, o};
+    out += o;
+  }
+}
+
+void chunk(const char *begin, const char *end, unsigned n, const char **bounds)
+{
+  bool quoted = false;	// quote parity
+  const char *q = begin;	// parity is known up to q
+  bounds[0] = begin;
+  for (unsigned i = 1; i < n; i++) {
+    const char *p = begin + (end - begin) * i / n;
+    if (p < q) p = q;
+    // advance parity to p
+    while (const char *c = static_cast<const char *>(memchr(q, '"', p - q))) {
+      quoted = !quoted;
+      q = c + 1;
+    }
+    q = p;
+    // find the first newline at or after p that is not quoted
+    while (q < end) {
+      const char *nl = static_cast<const char *>(memchr(q, '\n', end - q));
+      if (!nl) nl = end;
+      while (const char *c =
+	  static_cast<const char *>(memchr(q, '"', nl - q))) {
+	quoted = !quoted;
+	q = c + 1;
+      }
+      q = nl < end ? nl + 1 : end;
+      if (!quoted) break;
+    }
+    bounds[i] = q;
+  }
+  bounds[n] = end;
+}
+
 } // ZvCSV_
@@ -9,6 +9,13 @@
 // Microsoft Excel compatible quoting: a, " ,"",",b -> a| ,",|b
 // Unlike Excel, leading white space is discarded if not quoted
 
+// readFile() memory-maps the input and splits rows in place - delimiters,
+// quotes and newlines are located 16/32 bytes at a time using SSE2/AVX2,
+// fields are ZuString views into the mapping, and the per-row field array
+// and unquoting buffer are re-used, so no heap allocation is performed
+// per row; optionally, row-aligned chunks of the input are parsed in
+// parallel by the worker threads of a ZmScheduler
+
 #ifndef ZvCSV_HH
 #define ZvCSV_HH
 
@@ -26,6 +33,9 @@
 #include <zlib/ZmObject.hh>
 #include <zlib/ZmRBTree.hh>
 #include <zlib/ZmFn.hh>
+#include <zlib/ZmAlloc.hh>
+#include <zlib/ZmBlock.hh>
+#include <zlib/ZmScheduler.hh>
 
 #include <zlib/ZtArray.hh>
 #include <zlib/ZtString.hh>
@@ -33,15 +43,53 @@
 
 #include <zlib/ZePlatform.hh>
 
+#include <zlib/ZiFile.hh>
+
 #include <zlib/ZvError.hh>
 #include <zlib/ZtField.hh>
 #include <zlib/ZvCSV.hh>
 
 #define ZvCSV_MaxLineSize	(8<<10)	// 8K
+#define ZvCSV_ChunkMin		(64<<10) // 64K - minimum parallel chunk size
 
 namespace ZvCSV_ {
   ZvExtern void split(ZuString row, ZtArray<ZtArray<char>> &a);
 
+  // zero-copy row splitter - fields are views into the input, other than
+  // quoted values, which are unquoted into an internal buffer; fields()
+  // remains valid until the next call to row()
+  class ZvAPI Splitter {
+    Splitter(const Splitter &) = delete;
+    Splitter &operator =(const Splitter &) = delete;
+
+  public:
+    using Fields = ZtArray<ZuString>;
+
+    Splitter(const char *begin, const char *end);
+
+    // split the next non-empty row, returns false at end of input
+    bool row();
+
+    const Fields &fields() const { return m_fields; }
+
+    // start of the next row
+    const char *next() const { return m_next; }
+
+  private:
+    void unquote();
+
+    const char	*m_next;	// start of next row
+    const char	*m_end;
+    const char	*m_block;	// current block
+    uint32_t	m_mask = 0;	// unprocessed delimiters in current block
+    Fields	m_fields;
+    ZtArray<char> m_buf;	// unquoted values
+  };
+
+  // divide [begin, end) into n row-aligned chunks, bounds[0..n] inclusive
+  ZvExtern void chunk(
+      const char *begin, const char *end, unsigned n, const char **bounds);
+
   // CSV string quoting
   template <typename Row>
   inline void quote__(Row &row, ZuString s) {
@@ -274,9 +322,7 @@ private:
     for (unsigned i = 0; i < n; i++) headers.push(m_fields[i]->id);
   }
 
-  void header(ColIndex &colIndex, ZuString hdr) const {
-    ZtArray<ZtArray<char>> a;
-    ZvCSV_::split(hdr, a);
+  void header(ColIndex &colIndex, const ZvCSV_::Splitter::Fields &a) const {
     unsigned n = m_fields.length();
     colIndex.null();
     colIndex.length(n);
@@ -289,10 +335,8 @@ private:
   }
 
   void scan(
-      const ColIndex &colIndex, ZuString row,
+      const ColIndex &colIndex, const ZvCSV_::Splitter::Fields &a,
       const ZtFieldVFmt &fmt, T *object) const {
-    ZtArray<ZtArray<char>> a;
-    ZvCSV_::split(row, a);
     unsigned n = a.length();
     unsigned m = colIndex.length();
     for (unsigned i = 0; i < m; i++) {
@@ -338,63 +382,87 @@ private:
 public:
   using FileIOError = ZvCSV_FileIOError;
 
+  // if sched is specified, alloc() and read() are called concurrently
+  // from sched's worker threads and must be thread-safe; rows are not
+  // read in order, and readFile() / readData() block until all workers
+  // have completed, so must not be called from a worker thread
   template <typename Alloc, typename Read>
-  void readFile(const char *fileName, Alloc alloc, Read read) const {
-    FILE *file;
+  void readFile(
+      const char *fileName, Alloc alloc, Read read,
+      ZmScheduler *sched = nullptr) const {
+    ZiFile file;
+    ZeError e;
+
+    if (file.open(fileName, ZiFile::ReadOnly, 0666, &e) != Zi::OK)
+      throw FileIOError(fileName, e);
+    ZiFile::Offset size = file.size();
+    file.close();
+    if (!size) return;
+    if (file.mmap(fileName,
+	  ZiFile::ReadOnly | ZiFile::GC, size, false, 0, 0666, &e) != Zi::OK)
+      throw FileIOError(fileName, e);
+
+    auto data = static_cast<const char *>(file.addr());
+    read_(data, data + size, alloc, read, sched);
+  }
 
-    if (!(file = fopen(fileName, "r")))
-      throw FileIOError(fileName, ZeLastError);
+  template <typename Alloc, typename Read>
+  void readData(
+      ZuString data, Alloc alloc, Read read,
+      ZmScheduler *sched = nullptr) const {
+    read_(data.data(), data.data() + data.length(), alloc, read, sched);
+  }
 
+private:
+  template <typename Alloc, typename Read>
+  void read_(
+      const char *begin, const char *end,
+      Alloc &alloc, Read &read, ZmScheduler *sched) const {
     ColIndex colIndex;
-    ZtString row(ZvCSV_MaxLineSize);
-    const auto &fmt = this->fmt();
-
-    if (char *data = fgets(row.data(), ZvCSV_MaxLineSize - 1, file)) {
-      row.calcLength();
-      row.chomp();
-      header(colIndex, row);
-      row.length(0);
-      while (data = fgets(row.data(), ZvCSV_MaxLineSize - 1, file)) {
-	row.calcLength();
-	row.chomp();
-	if (row.length()) {
-	  auto object = alloc();
-	  if (!object) break;
-	  scan(colIndex, row, fmt, object);
-	  read(ZuMv(object));
-	  row.length(0);
-	}
-      }
+    {
+      ZvCSV_::Splitter splitter{begin, end};
+      if (!splitter.row()) return;
+      header(colIndex, splitter.fields());
+      begin = splitter.next();
     }
-
-    fclose(file);
+    unsigned n = sched ? sched->nWorkers() : 0;
+    if (n > 1 && (end - begin) / n < ZvCSV_ChunkMin)
+      n = (end - begin) / ZvCSV_ChunkMin;
+    if (n <= 1) {
+      read__(colIndex, begin, end, alloc, read);
+      return;
+    }
+    auto bounds = ZmAlloc(const char *, n + 1);
+    if (!bounds) throw std::bad_alloc{};
+    ZvCSV_::chunk(begin, end, n, &bounds[0]);
+    ZmBlock<>{}(n, [
+	this, sched, &colIndex, &bounds, &alloc, &read
+    ](unsigned i, auto done) {
+      sched->run(sched->workerID(i), [
+	  this, &colIndex, begin = bounds[i], end = bounds[i + 1],
+	  &alloc, &read, done = ZuMv(done)
+      ]() mutable {
+	read__(colIndex, begin, end, alloc, read);
+	done();
+      });
+    });
   }
 
   template <typename Alloc, typename Read>
-  void readData(ZuString data, Alloc alloc, Read read) const {
-    ColIndex colIndex;
+  void read__(
+      const ColIndex &colIndex, const char *begin, const char *end,
+      Alloc &alloc, Read &read) const {
+    ZvCSV_::Splitter splitter{begin, end};
     const auto &fmt = this->fmt();
-
-    ZtArray<ZtArray<char>> rows;
-    if (!ZtREGEX("\n").split(data, rows)) return;
-    ZtString row{ZvCSV_MaxLineSize};
-    row.init(rows[0].data(), rows[0].length());
-    row.chomp();
-    header(colIndex, row);
-    row.length(0);
-    for (unsigned i = 1; i < rows.length(); i++) {
-      row.init(rows[i].data(), rows[i].length());
-      row.chomp();
-      if (row.length()) {
-	auto object = alloc();
-	if (!object) break;
-	scan(colIndex, row, fmt, object);
-	read(ZuMv(object));
-	row.length(0);
-      }
+    while (splitter.row()) {
+      auto object = alloc();
+      if (!object) break;
+      scan(colIndex, splitter.fields(), fmt, object);
+      read(ZuMv(object));
     }
   }
 
+public:
   auto writeFile(const char *fileName, const ColNames &columns) const {
     FILE *file;
 
@@ -215,6 +215,8 @@ struct ZvQueueTelemetry {
   uint32_t	size = 0;	// 0 for Rx, Tx
   uint32_t	full = 0;	// dynamic - how many times queue overflowed
   int8_t	type = -1;	// primary key - QueueType
+  uint64_t	steals = 0;	// dynamic - jobs stolen (work-stealing deques)
+  uint64_t	dropped = 0;	// dynamic - messages dropped (non-blocking)
 };
 
 struct ZvEngineMgr {
@@ -28,13 +28,15 @@ struct Data {
   double	loadFactor;
   uint8_t	bits;
   uint8_t	cBits;
+  bool		incremental = false;
 };
 
 ZtFieldTbl(Data,
     (((id),		(Ctor<0>, Keys<0>)),	(String)),
     (((bits),		(Ctor<2>)),		(UInt8)),
     (((loadFactor),	(Ctor<1>)),		(Float)),
-    (((cBits),		(Ctor<3>)),		(UInt8)));
+    (((cBits),		(Ctor<3>)),		(UInt8)),
+    (((incremental),	(Ctor<4>)),		(Bool)));
 
 class CSV : public ZvCSV<Data> {
 public:
@@ -45,7 +47,8 @@ public:
 	  ZmHashMgr::init(data->id, ZmHashParams{}.
 	      bits(data->bits).
 	      loadFactor(data->loadFactor).
-	      cBits(data->cBits));
+	      cBits(data->cBits).
+	      incremental(data->incremental));
 	});
   }
 
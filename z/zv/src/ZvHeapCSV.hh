@@ -28,6 +28,7 @@ struct Data {
   uint16_t	partition;
   uint8_t	alignment;
   ZmBitmap	cpuset;
+  uint32_t	magSize;
 };
 
 ZtFieldTbl(Data,
@@ -35,7 +36,8 @@ ZtFieldTbl(Data,
     (((partition),	(Ctor<2>, Keys<0>)),		(UInt16)),
     (((alignment),	(Ctor<3>)),			(UInt8)),
     (((cacheSize),	(Ctor<1>)),			(UInt64)),
-    (((cpuset),		(Ctor<4>)),			(String)));
+    (((cpuset),		(Ctor<4>)),			(String)),
+    (((magSize),	(Ctor<5>)),			(UInt32)));
 
 class CSV : public ZvCSV<Data> {
 public:
@@ -46,7 +48,8 @@ public:
 	  ZmHeapMgr::init(data->id, data->partition, ZmHeapConfig{
 	      data->alignment,
 	      data->cacheSize,
-	      data->cpuset});
+	      data->cpuset,
+	      data->magSize});
 	});
   }
 
@@ -104,6 +104,8 @@ struct ZvMxParams : public ZiMxParams {
       sched.spin(cf->getInt("spin", 0, INT_MAX, sched.spin()));
       sched.timeout(cf->getInt("timeout", 0, 3600, sched.timeout()));
       sched.startTimer(cf->getBool("startTimer", sched.startTimer()));
+      sched.stealing(cf->getBool("stealing", sched.stealing()));
+      sched.timerWheel(cf->getBool("timerWheel", sched.timerWheel()));
       if (ZmRef<ZvCf> threadsCf = cf->getCf("threads")) {
 	threadsCf->all([&sched](ZvCfNode *node) {
 	  if (auto threadCf = node->getCf()) {
@@ -132,6 +134,17 @@ struct ZvMxParams : public ZiMxParams {
 #ifdef ZiMultiplex_EPoll
     epollMaxFDs(cf->getInt("epollMaxFDs", 1, 100000, epollMaxFDs()));
     epollQuantum(cf->getInt("epollQuantum", 1, 1024, epollQuantum()));
+    rxBatch(cf->getInt("rxBatch", 1, 64, rxBatch()));
+    txBatch(cf->getInt("txBatch", 1, 64, txBatch()));
+    pollSpin(cf->getInt("pollSpin", 0, INT_MAX, pollSpin()));
+    pollYield(cf->getInt("pollYield", 0, INT_MAX, pollYield()));
+    busyPoll(cf->getInt("busyPoll", 0, 1000000, busyPoll()));
+    zeroCopyMin(cf->getInt("zeroCopyMin", 0, INT_MAX, zeroCopyMin()));
+#endif
+#ifdef ZiMultiplex_IOURing
+    uring(cf->getBool("uring", uring()));
+    uringDepth(cf->getInt("uringDepth", 8, 32768, uringDepth()));
+    uringBufs(cf->getInt("uringBufs", 1, 32768, uringBufs()));
 #endif
     rxBufSize(cf->getInt("rcvBufSize", 0, INT_MAX, rxBufSize()));
     txBufSize(cf->getInt("sndBufSize", 0, INT_MAX, txBufSize()));
@@ -7,8 +7,12 @@
 #include <zlib/ZuLib.hh>
 
 #include <stddef.h>
+#include <stdlib.h>
 
 #include <zlib/ZmList.hh>
+#include <zlib/ZmAtomic.hh>
+#include <zlib/ZmScheduler.hh>
+#include <zlib/ZmTime.hh>
 
 #include <zlib/ZtEnum.hh>
 
@@ -68,8 +72,77 @@ struct RowSet {
   }
 };
 
-int main()
+// benchmark - read nRows using 1 thread, then nThreads worker threads;
+// returns false if any rows were lost or corrupted
+bool bench(unsigned nRows, unsigned nThreads)
 {
+  ZvCSV<Row> csv;
+
+  ZuGuard cleanup([]() { ZiFile::remove("bench.csv"); });
+
+  {
+    auto fn = csv.writeFile("bench.csv");
+    Row row;
+    row.m_string = "bench";
+    row.m_bool = 1;
+    row.m_enum = 42;
+    row.m_time = ZuDateTime{2011, 11, 11, 12, 12, 12};
+    row.m_flags = 3;
+    for (unsigned i = 0; i < nRows; i++) {
+      row.m_int = i;
+      row.m_float = double(i) / 1000.0;
+      fn(&row);
+    }
+    fn(nullptr);
+  }
+
+  ZmAtomic<uint64_t> count = 0, total = 0;
+  // alloc() returns a TLS row, read() is thread-safe
+  auto alloc = []() { static thread_local Row row; return &row; };
+  auto read = [&count, &total](Row *row) {
+    ++count;
+    total += row->m_int;
+  };
+  bool ok = true;
+  auto report = [&count, &total, &ok, nRows](
+      const char *name, ZuTime elapsed) {
+    double secs = double(elapsed.as_fp());
+    bool match = count == nRows &&
+      total == uint64_t(nRows) * (nRows - 1) / 2;
+    printf("%s: %u rows in %.3fs (%.0f rows/s)%s\n",
+	name, unsigned(count), secs, double(count) / secs,
+	match ? "" : " MISMATCH");
+    if (!match) ok = false;
+    count = 0, total = 0;
+  };
+
+  {
+    ZuTime start = Zm::now();
+    csv.readFile("bench.csv", alloc, read);
+    report("serial", Zm::now() - start);
+  }
+
+  {
+    ZmScheduler sched{ZmSchedParams().id("csv").nThreads(nThreads)};
+    sched.start();
+    ZuTime start = Zm::now();
+    csv.readFile("bench.csv", alloc, read, &sched);
+    report("parallel", Zm::now() - start);
+    sched.stop();
+  }
+
+  return ok;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc > 3) {
+    std::cerr << "Usage: CSVTest [ROWS [THREADS]]\n";
+    Zm::exit(1);
+  }
+  unsigned nRows = argc > 1 ? atoi(argv[1]) : 0;
+  unsigned nThreads = argc > 2 ? atoi(argv[2]) : 4;
+
   try {
     {
       ZiFile file;
@@ -122,6 +195,10 @@ int main()
 	fn(nullptr);
       }
     }
+    if (nRows && !bench(nRows, nThreads)) {
+      std::cerr << "benchmark row count/total mismatch\n";
+      Zm::exit(1);
+    }
   } catch (const ZvError &e) {
     std::cerr << "ZvError: " << e << '\n';
     Zm::exit(1);